@@ -19,18 +19,36 @@
 
 #include <atomic>
 #include <cstdint>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
+#include "cyber/base/macros.h"
+
 namespace apollo {
 namespace cyber {
 namespace base {
 /**
- * @brief A implementation of lock-free fixed size hash map
+ * @brief A implementation of lock-free resizable hash map
+ *
+ * Keys live in open addressing tables with bounded linear probing. When the
+ * probe window of a key is full in every table, a new table twice as large as
+ * the last one is appended, so the map grows online without moving entries.
+ * Has/Get only do atomic loads over a bounded number of slots and never wait
+ * for writers.
+ *
+ * A key keeps its slot once inserted, Remove only drops its value. Removed
+ * slots are never reused by other keys: setting the same key again takes its
+ * old slot back, but the memory of the map grows with the number of distinct
+ * keys ever inserted, not with Size(). Handing a slot over to another key
+ * would race with lock-free readers comparing its key and with writers of the
+ * removed key, so the map is meant for long lived keys such as channel, node
+ * or task ids. As before, a value pointer returned by Get is released by a
+ * later Set or Remove of the same key.
  *
  * @tparam K Type of key, must be integral
  * @tparam V Type of value
- * @tparam 128 Size of hash table
+ * @tparam 128 Initial size of hash table
  * @tparam 0 Type traits, use for checking types of key & value
  */
 template <typename K, typename V, std::size_t TableSize = 128,
@@ -38,258 +56,228 @@ template <typename K, typename V, std::size_t TableSize = 128,
                                       (TableSize & (TableSize - 1)) == 0,
                                   int>::type = 0>
 class AtomicHashMap {
+  static_assert(TableSize > 0, "TableSize must be greater than 0");
+
  public:
-  AtomicHashMap() : capacity_(TableSize), mode_num_(capacity_ - 1) {}
+  AtomicHashMap() : head_(new Table(TableSize)) {}
   AtomicHashMap(const AtomicHashMap &other) = delete;
   AtomicHashMap &operator=(const AtomicHashMap &other) = delete;
 
+  ~AtomicHashMap() {
+    Table *table = head_;
+    while (table) {
+      Table *next = table->next.load(std::memory_order_acquire);
+      delete table;
+      table = next;
+    }
+  }
+
   bool Has(K key) {
-    uint64_t index = key & mode_num_;
-    return table_[index].Has(key);
+    std::atomic<V *> *value_ptr = Find(key);
+    return value_ptr != nullptr &&
+           value_ptr->load(std::memory_order_acquire) != nullptr;
   }
 
   bool Get(K key, V **value) {
-    uint64_t index = key & mode_num_;
-    return table_[index].Get(key, value);
+    std::atomic<V *> *value_ptr = Find(key);
+    if (value_ptr == nullptr) {
+      return false;
+    }
+    V *val = value_ptr->load(std::memory_order_acquire);
+    if (val == nullptr) {
+      return false;
+    }
+    *value = val;
+    return true;
   }
 
   bool Get(K key, V *value) {
-    uint64_t index = key & mode_num_;
     V *val = nullptr;
-    bool res = table_[index].Get(key, &val);
+    bool res = Get(key, &val);
     if (res) {
       *value = *val;
     }
     return res;
   }
 
-  void Set(K key) {
-    uint64_t index = key & mode_num_;
-    table_[index].Insert(key);
-  }
+  void Set(K key) { Store(key, new V()); }
 
-  void Set(K key, const V &value) {
-    uint64_t index = key & mode_num_;
-    table_[index].Insert(key, value);
-  }
+  void Set(K key, const V &value) { Store(key, new V(value)); }
 
-  void Set(K key, V &&value) {
-    uint64_t index = key & mode_num_;
-    table_[index].Insert(key, std::forward<V>(value));
-  }
+  void Set(K key, V &&value) { Store(key, new V(std::forward<V>(value))); }
 
- private:
-  struct Entry {
-    Entry() {}
-    explicit Entry(K key) : key(key) {
-      value_ptr.store(new V(), std::memory_order_release);
-    }
-    Entry(K key, const V &value) : key(key) {
-      value_ptr.store(new V(value), std::memory_order_release);
+  bool Remove(K key) {
+    std::atomic<V *> *value_ptr = Find(key);
+    if (value_ptr == nullptr) {
+      return false;
     }
-    Entry(K key, V &&value) : key(key) {
-      value_ptr.store(new V(std::forward<V>(value)), std::memory_order_release);
+    V *old_value = value_ptr->exchange(nullptr, std::memory_order_acq_rel);
+    if (old_value == nullptr) {
+      return false;
     }
-    ~Entry() { delete value_ptr.load(std::memory_order_acquire); }
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    delete old_value;
+    return true;
+  }
 
-    K key = 0;
-    std::atomic<V *> value_ptr = {nullptr};
-    std::atomic<Entry *> next = {nullptr};
-  };
+  std::size_t Size() const { return size_.load(std::memory_order_relaxed); }
 
-  class Bucket {
-   public:
-    Bucket() : head_(new Entry()) {}
-    ~Bucket() {
-      Entry *ite = head_;
-      while (ite) {
-        auto tmp = ite->next.load(std::memory_order_acquire);
-        delete ite;
-        ite = tmp;
-      }
+  std::size_t Capacity() const {
+    std::size_t capacity = 0;
+    for (Table *table = head_; table != nullptr;
+         table = table->next.load(std::memory_order_acquire)) {
+      capacity += table->capacity;
     }
+    return capacity;
+  }
 
-    bool Has(K key) {
-      Entry *m_target = head_->next.load(std::memory_order_acquire);
-      while (Entry *target = m_target) {
-        if (target->key < key) {
-          m_target = target->next.load(std::memory_order_acquire);
-          continue;
-        } else {
-          return target->key == key;
-        }
+ private:
+  // length of the probe window of a key in every table
+  static constexpr std::size_t kMaxProbe = 8;
+
+  // The state of a slot is EMPTY, BUSY while its key is being written, or
+  // READY with the upper bits of the key hash as a tag. States are kept apart
+  // from keys and values, so a probe window spans at most two cache lines and
+  // keys are only read when the tag matches.
+  static constexpr uint32_t EMPTY = 0;
+  static constexpr uint32_t BUSY = 1;
+  static constexpr uint32_t READY = 2;
+
+  struct Table {
+    explicit Table(std::size_t capacity)
+        : capacity(capacity),
+          mask(capacity - 1),
+          states(new std::atomic<uint32_t>[capacity]),
+          keys(new K[capacity]),
+          values(new std::atomic<V *>[capacity]) {
+      for (std::size_t i = 0; i < capacity; ++i) {
+        states[i].store(EMPTY, std::memory_order_relaxed);
+        values[i].store(nullptr, std::memory_order_relaxed);
       }
-      return false;
     }
-
-    bool Find(K key, Entry **prev_ptr, Entry **target_ptr) {
-      Entry *prev = head_;
-      Entry *m_target = head_->next.load(std::memory_order_acquire);
-      while (Entry *target = m_target) {
-        if (target->key == key) {
-          *prev_ptr = prev;
-          *target_ptr = target;
-          return true;
-        } else if (target->key > key) {
-          *prev_ptr = prev;
-          *target_ptr = target;
-          return false;
-        } else {
-          prev = target;
-          m_target = target->next.load(std::memory_order_acquire);
-        }
+    ~Table() {
+      for (std::size_t i = 0; i < capacity; ++i) {
+        delete values[i].load(std::memory_order_acquire);
       }
-      *prev_ptr = prev;
-      *target_ptr = nullptr;
-      return false;
     }
 
-    void Insert(K key, const V &value) {
-      Entry *prev = nullptr;
-      Entry *target = nullptr;
-      Entry *new_entry = nullptr;
-      V *new_value = nullptr;
-      while (true) {
-        if (Find(key, &prev, &target)) {
-          // key exists, update value
-          if (!new_value) {
-            new_value = new V(value);
-          }
-          auto old_val_ptr = target->value_ptr.load(std::memory_order_acquire);
-          if (target->value_ptr.compare_exchange_strong(
-                  old_val_ptr, new_value, std::memory_order_acq_rel,
-                  std::memory_order_relaxed)) {
-            delete old_val_ptr;
-            if (new_entry) {
-              delete new_entry;
-              new_entry = nullptr;
-            }
-            return;
-          }
-          continue;
-        } else {
-          if (!new_entry) {
-            new_entry = new Entry(key, value);
-          }
-          new_entry->next.store(target, std::memory_order_release);
-          if (prev->next.compare_exchange_strong(target, new_entry,
-                                                 std::memory_order_acq_rel,
-                                                 std::memory_order_relaxed)) {
-            // Insert success
-            if (new_value) {
-              delete new_value;
-              new_value = nullptr;
-            }
-            return;
-          }
-          // another entry has been inserted, retry
-        }
-      }
+    const std::size_t capacity;
+    const std::size_t mask;
+    std::unique_ptr<std::atomic<uint32_t>[]> states;
+    std::unique_ptr<K[]> keys;
+    std::unique_ptr<std::atomic<V *>[]> values;
+    std::atomic<Table *> next = {nullptr};
+  };
+
+  static uint64_t Hash(K key) {
+    // keys are often ids that are hashes already, but sequential ids would
+    // build long runs under linear probing, so spread the bits first
+    uint64_t h = static_cast<uint64_t>(key);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  static uint32_t ReadyState(uint64_t hash) {
+    return static_cast<uint32_t>(hash >> 32) << 2 | READY;
+  }
+
+  static std::size_t ProbeNum(const Table *table) {
+    if (table->capacity < kMaxProbe) {
+      return table->capacity;
     }
+    return kMaxProbe;
+  }
 
-    void Insert(K key, V &&value) {
-      Entry *prev = nullptr;
-      Entry *target = nullptr;
-      Entry *new_entry = nullptr;
-      V *new_value = nullptr;
-      while (true) {
-        if (Find(key, &prev, &target)) {
-          // key exists, update value
-          if (!new_value) {
-            new_value = new V(std::forward<V>(value));
-          }
-          auto old_val_ptr = target->value_ptr.load(std::memory_order_acquire);
-          if (target->value_ptr.compare_exchange_strong(
-                  old_val_ptr, new_value, std::memory_order_acq_rel,
-                  std::memory_order_relaxed)) {
-            delete old_val_ptr;
-            if (new_entry) {
-              delete new_entry;
-              new_entry = nullptr;
-            }
-            return;
-          }
-          continue;
-        } else {
-          if (!new_entry) {
-            new_entry = new Entry(key, value);
-          }
-          new_entry->next.store(target, std::memory_order_release);
-          if (prev->next.compare_exchange_strong(target, new_entry,
-                                                 std::memory_order_acq_rel,
-                                                 std::memory_order_relaxed)) {
-            // Insert success
-            if (new_value) {
-              delete new_value;
-              new_value = nullptr;
-            }
-            return;
-          }
-          // another entry has been inserted, retry
+  // A key is placed in the first table whose probe window still has an empty
+  // slot. Slots never become empty again, so meeting an empty slot proves
+  // that the key is neither in this table nor in any later one. A BUSY slot
+  // is skipped, if it turns out to hold the key, the insert simply has not
+  // happened yet from the point of view of this reader.
+  std::atomic<V *> *Find(K key) {
+    const uint64_t hash = Hash(key);
+    const uint32_t ready = ReadyState(hash);
+    for (Table *table = head_; table != nullptr;
+         table = table->next.load(std::memory_order_acquire)) {
+      const std::size_t probe_num = ProbeNum(table);
+      for (std::size_t i = 0; i < probe_num; ++i) {
+        const std::size_t index = (hash + i) & table->mask;
+        uint32_t state = table->states[index].load(std::memory_order_acquire);
+        if (state == EMPTY) {
+          return nullptr;
+        }
+        if (state == ready && table->keys[index] == key) {
+          return &table->values[index];
         }
       }
     }
+    return nullptr;
+  }
 
-    void Insert(K key) {
-      Entry *prev = nullptr;
-      Entry *target = nullptr;
-      Entry *new_entry = nullptr;
-      V *new_value = nullptr;
-      while (true) {
-        if (Find(key, &prev, &target)) {
-          // key exists, update value
-          if (!new_value) {
-            new_value = new V();
-          }
-          auto old_val_ptr = target->value_ptr.load(std::memory_order_acquire);
-          if (target->value_ptr.compare_exchange_strong(
-                  old_val_ptr, new_value, std::memory_order_acq_rel,
-                  std::memory_order_relaxed)) {
-            delete old_val_ptr;
-            if (new_entry) {
-              delete new_entry;
-              new_entry = nullptr;
-            }
-            return;
-          }
-          continue;
-        } else {
-          if (!new_entry) {
-            new_entry = new Entry(key);
-          }
-          new_entry->next.store(target, std::memory_order_release);
-          if (prev->next.compare_exchange_strong(target, new_entry,
+  std::atomic<V *> *FindOrInsert(K key) {
+    const uint64_t hash = Hash(key);
+    const uint32_t ready = ReadyState(hash);
+    Table *table = head_;
+    while (true) {
+      const std::size_t probe_num = ProbeNum(table);
+      for (std::size_t i = 0; i < probe_num; ++i) {
+        const std::size_t index = (hash + i) & table->mask;
+        std::atomic<uint32_t> &slot_state = table->states[index];
+        uint32_t state = slot_state.load(std::memory_order_acquire);
+        if (state == EMPTY) {
+          if (slot_state.compare_exchange_strong(state, BUSY,
                                                  std::memory_order_acq_rel,
-                                                 std::memory_order_relaxed)) {
-            // Insert success
-            if (new_value) {
-              delete new_value;
-              new_value = nullptr;
-            }
-            return;
+                                                 std::memory_order_acquire)) {
+            table->keys[index] = key;
+            slot_state.store(ready, std::memory_order_release);
+            return &table->values[index];
           }
-          // another entry has been inserted, retry
+          // another key has taken the slot, state holds it now
+        }
+        // a slot whose value has been removed still belongs to its key, and
+        // is only taken back by that same key below
+        // writers have to know the key of the slot to avoid duplicates
+        while (state == BUSY) {
+          cpu_relax();
+          state = slot_state.load(std::memory_order_acquire);
+        }
+        if (state == ready && table->keys[index] == key) {
+          return &table->values[index];
         }
       }
+      table = NextTable(table);
     }
+  }
 
-    bool Get(K key, V **value) {
-      Entry *prev = nullptr;
-      Entry *target = nullptr;
-      if (Find(key, &prev, &target)) {
-        *value = target->value_ptr.load(std::memory_order_acquire);
-        return true;
-      }
-      return false;
+  Table *NextTable(Table *table) {
+    Table *next = table->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      return next;
     }
+    Table *new_table = new Table(table->capacity * 2);
+    if (table->next.compare_exchange_strong(next, new_table,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+      return new_table;
+    }
+    // another table has been appended, next holds it now
+    delete new_table;
+    return next;
+  }
 
-    Entry *head_;
-  };
+  void Store(K key, V *new_value) {
+    std::atomic<V *> *value_ptr = FindOrInsert(key);
+    V *old_value = value_ptr->exchange(new_value, std::memory_order_acq_rel);
+    if (old_value == nullptr) {
+      size_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      delete old_value;
+    }
+  }
 
- private:
-  Bucket table_[TableSize];
-  uint64_t capacity_;
-  uint64_t mode_num_;
+  Table *const head_;
+  std::atomic<std::size_t> size_ = {0};
 };
 
 }  // namespace base
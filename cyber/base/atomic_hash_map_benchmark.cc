@@ -0,0 +1,161 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "cyber/base/atomic_hash_map.h"
+
+namespace apollo {
+namespace cyber {
+namespace base {
+namespace {
+
+// The previous fixed size map with sorted chained buckets, kept here as the
+// reference to compare against.
+template <typename K, typename V, std::size_t TableSize = 128>
+class ChainedHashMap {
+ public:
+  ChainedHashMap() = default;
+  ~ChainedHashMap() {
+    for (auto& head : table_) {
+      Entry* entry = head.next.load(std::memory_order_acquire);
+      while (entry) {
+        Entry* next = entry->next.load(std::memory_order_acquire);
+        delete entry;
+        entry = next;
+      }
+    }
+  }
+
+  bool Get(K key, V* value) {
+    Entry* entry = table_[key & (TableSize - 1)].next.load(
+        std::memory_order_acquire);
+    while (entry && entry->key < key) {
+      entry = entry->next.load(std::memory_order_acquire);
+    }
+    if (entry == nullptr || entry->key != key) {
+      return false;
+    }
+    *value = *entry->value_ptr.load(std::memory_order_acquire);
+    return true;
+  }
+
+  void Set(K key, const V& value) {
+    Entry* new_entry = new Entry(key, value);
+    while (true) {
+      Entry* prev = &table_[key & (TableSize - 1)];
+      Entry* target = prev->next.load(std::memory_order_acquire);
+      while (target && target->key < key) {
+        prev = target;
+        target = target->next.load(std::memory_order_acquire);
+      }
+      if (target && target->key == key) {
+        V* old_value = target->value_ptr.exchange(
+            new_entry->value_ptr.exchange(nullptr), std::memory_order_acq_rel);
+        delete old_value;
+        delete new_entry;
+        return;
+      }
+      new_entry->next.store(target, std::memory_order_release);
+      if (prev->next.compare_exchange_strong(target, new_entry,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_relaxed)) {
+        return;
+      }
+    }
+  }
+
+ private:
+  struct Entry {
+    Entry() = default;
+    Entry(K key, const V& value) : key(key), value_ptr(new V(value)) {}
+    ~Entry() { delete value_ptr.load(std::memory_order_acquire); }
+
+    K key = 0;
+    std::atomic<V*> value_ptr = {nullptr};
+    std::atomic<Entry*> next = {nullptr};
+  };
+
+  Entry table_[TableSize];
+};
+
+std::vector<uint64_t> RandomKeys(int64_t num) {
+  std::mt19937_64 engine(num);
+  std::vector<uint64_t> keys(num);
+  for (auto& key : keys) {
+    key = engine();
+  }
+  return keys;
+}
+
+template <typename Map>
+void BM_Get(benchmark::State& state) {  // NOLINT
+  static Map* map = nullptr;
+  static std::vector<uint64_t> keys;
+  if (state.thread_index == 0) {
+    keys = RandomKeys(state.range(0));
+    map = new Map();
+    for (auto key : keys) {
+      map->Set(key, key);
+    }
+  }
+  uint64_t value = 0;
+  size_t index = state.thread_index;
+  for (auto _ : state) {
+    map->Get(keys[index % keys.size()], &value);
+    benchmark::DoNotOptimize(value);
+    index += 7;
+  }
+  if (state.thread_index == 0) {
+    delete map;
+    map = nullptr;
+  }
+}
+
+template <typename Map>
+void BM_Set(benchmark::State& state) {  // NOLINT
+  const auto keys = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    Map map;
+    for (auto key : keys) {
+      map.Set(key, key);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+using ChainedMap = ChainedHashMap<uint64_t, uint64_t>;
+using OpenMap = AtomicHashMap<uint64_t, uint64_t>;
+
+BENCHMARK_TEMPLATE(BM_Get, ChainedMap)->Range(16, 16 << 10);
+BENCHMARK_TEMPLATE(BM_Get, OpenMap)->Range(16, 16 << 10);
+BENCHMARK_TEMPLATE(BM_Get, ChainedMap)->Arg(4096)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(BM_Get, OpenMap)->Arg(4096)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(BM_Set, ChainedMap)->Range(16, 16 << 10);
+BENCHMARK_TEMPLATE(BM_Set, OpenMap)->Range(16, 16 << 10);
+
+}  // namespace
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -16,6 +16,7 @@
 
 #include "cyber/base/atomic_hash_map.h"
 
+#include <atomic>
 #include <string>
 #include <thread>
 
@@ -98,6 +99,90 @@ TEST(AtomicHashMapTest, concurrency) {
   EXPECT_EQ("0", *str);
 }
 
+TEST(AtomicHashMapTest, remove) {
+  AtomicHashMap<uint64_t, int> map;
+  int value = 0;
+  EXPECT_FALSE(map.Remove(1));
+  for (uint64_t i = 0; i < 100; i++) {
+    map.Set(i, static_cast<int>(i));
+  }
+  EXPECT_EQ(100, map.Size());
+  for (uint64_t i = 0; i < 100; i += 2) {
+    EXPECT_TRUE(map.Remove(i));
+    EXPECT_FALSE(map.Remove(i));
+  }
+  EXPECT_EQ(50, map.Size());
+  for (uint64_t i = 0; i < 100; i++) {
+    EXPECT_EQ(i % 2 == 1, map.Has(i));
+    EXPECT_EQ(i % 2 == 1, map.Get(i, &value));
+  }
+  map.Set(10, 100);
+  EXPECT_TRUE(map.Get(10, &value));
+  EXPECT_EQ(100, value);
+  EXPECT_EQ(51, map.Size());
+
+  // a key set again after its removal takes its old slot back
+  const std::size_t capacity = map.Capacity();
+  for (int round = 0; round < 100; round++) {
+    for (uint64_t i = 0; i < 100; i += 2) {
+      map.Set(i, round);
+      EXPECT_TRUE(map.Remove(i));
+    }
+  }
+  EXPECT_EQ(capacity, map.Capacity());
+  EXPECT_EQ(50, map.Size());
+}
+
+TEST(AtomicHashMapTest, grow) {
+  AtomicHashMap<uint64_t, uint64_t, 8> map;
+  EXPECT_EQ(8, map.Capacity());
+  uint64_t value = 0;
+  for (uint64_t i = 0; i < 10000; i++) {
+    map.Set(i * 7919, i);
+  }
+  EXPECT_EQ(10000, map.Size());
+  EXPECT_GE(map.Capacity(), 10000);
+  for (uint64_t i = 0; i < 10000; i++) {
+    EXPECT_TRUE(map.Get(i * 7919, &value));
+    EXPECT_EQ(i, value);
+  }
+  EXPECT_FALSE(map.Has(7918));
+}
+
+TEST(AtomicHashMapTest, read_while_grow) {
+  AtomicHashMap<uint64_t, uint64_t, 16> map;
+  const uint64_t key_num = 64 * 1024;
+  std::atomic<uint64_t> inserted = {0};
+  std::atomic<bool> failed = {false};
+
+  std::thread writer([&]() {
+    for (uint64_t i = 0; i < key_num; i++) {
+      map.Set(i, i);
+      inserted.store(i + 1, std::memory_order_release);
+    }
+  });
+  std::thread readers[4];
+  for (auto& reader : readers) {
+    reader = std::thread([&]() {
+      uint64_t value = 0;
+      while (inserted.load(std::memory_order_acquire) < key_num) {
+        uint64_t visible = inserted.load(std::memory_order_acquire);
+        for (uint64_t i = 0; i < visible; i += 97) {
+          if (!map.Get(i, &value) || value != i) {
+            failed = true;
+          }
+        }
+      }
+    });
+  }
+  writer.join();
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_FALSE(failed);
+  EXPECT_EQ(key_num, map.Size());
+}
+
 }  // namespace base
 }  // namespace cyber
 }  // namespace apollo
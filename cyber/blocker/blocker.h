@@ -17,9 +17,10 @@
 #ifndef CYBER_BLOCKER_BLOCKER_H_
 #define CYBER_BLOCKER_BLOCKER_H_
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
-#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -60,6 +61,16 @@ struct BlockerAttr {
   std::string channel_name;
 };
 
+/**
+ * @brief Blocker keeps the latest `capacity` published messages in a fixed
+ * size ring indexed by an atomic publish counter.
+ *
+ * Observe only records the window of the ring that is visible at that moment
+ * and a reference to the latest message, so Observe and GetLatestObserved are
+ * O(1). The observed messages are copied out of the ring only when they are
+ * iterated, or when a publish is about to overwrite a slot of an observed
+ * window that has not been copied yet.
+ */
 template <typename T>
 class Blocker : public BlockerBase {
   friend class BlockerManager;
@@ -67,10 +78,10 @@ class Blocker : public BlockerBase {
  public:
   using MessageType = T;
   using MessagePtr = std::shared_ptr<T>;
-  using MessageQueue = std::list<MessagePtr>;
+  using MessageQueue = std::vector<MessagePtr>;
   using Callback = std::function<void(const MessagePtr&)>;
   using CallbackMap = std::unordered_map<std::string, Callback>;
-  using Iterator = typename std::list<std::shared_ptr<T>>::const_iterator;
+  using Iterator = typename MessageQueue::const_iterator;
 
   explicit Blocker(const BlockerAttr& attr);
   virtual ~Blocker();
@@ -104,9 +115,25 @@ class Blocker : public BlockerBase {
   void Enqueue(const MessagePtr& msg);
   void Notify(const MessagePtr& msg);
 
+  // the caller must hold msg_mutex_
+  const MessagePtr& Slot(uint64_t index) const {
+    return ring_[index % ring_.size()];
+  }
+  void CopyObserved() const;
+  void ResetRing(size_t capacity);
+
   BlockerAttr attr_;
-  MessageQueue observed_msg_queue_;
-  MessageQueue published_msg_queue_;
+  // published messages are [published_begin_, published_end_) of the ring
+  MessageQueue ring_;
+  std::atomic<uint64_t> published_begin_ = {0};
+  std::atomic<uint64_t> published_end_ = {0};
+  // observed messages are [observed_begin_, observed_end_) of the ring until
+  // they are copied into observed_msg_queue_, latest first
+  uint64_t observed_begin_ = 0;
+  uint64_t observed_end_ = 0;
+  MessagePtr observed_latest_ = nullptr;
+  mutable MessageQueue observed_msg_queue_;
+  mutable bool observed_copied_ = true;
   mutable std::mutex msg_mutex_;
 
   CallbackMap published_callbacks_;
@@ -116,11 +143,13 @@ class Blocker : public BlockerBase {
 };
 
 template <typename T>
-Blocker<T>::Blocker(const BlockerAttr& attr) : attr_(attr), dummy_msg_() {}
+Blocker<T>::Blocker(const BlockerAttr& attr) : attr_(attr), dummy_msg_() {
+  ring_.resize(attr_.capacity);
+}
 
 template <typename T>
 Blocker<T>::~Blocker() {
-  published_msg_queue_.clear();
+  ring_.clear();
   observed_msg_queue_.clear();
   published_callbacks_.clear();
 }
@@ -140,8 +169,11 @@ template <typename T>
 void Blocker<T>::Reset() {
   {
     std::lock_guard<std::mutex> lock(msg_mutex_);
+    observed_begin_ = observed_end_ = 0;
+    observed_latest_ = nullptr;
     observed_msg_queue_.clear();
-    published_msg_queue_.clear();
+    observed_copied_ = true;
+    ResetRing(attr_.capacity);
   }
   {
     std::lock_guard<std::mutex> lock(cb_mutex_);
@@ -152,31 +184,40 @@ void Blocker<T>::Reset() {
 template <typename T>
 void Blocker<T>::ClearObserved() {
   std::lock_guard<std::mutex> lock(msg_mutex_);
+  observed_begin_ = observed_end_ = 0;
+  observed_latest_ = nullptr;
   observed_msg_queue_.clear();
+  observed_copied_ = true;
 }
 
 template <typename T>
 void Blocker<T>::ClearPublished() {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  published_msg_queue_.clear();
+  CopyObserved();
+  ResetRing(attr_.capacity);
 }
 
 template <typename T>
 void Blocker<T>::Observe() {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  observed_msg_queue_ = published_msg_queue_;
+  observed_begin_ = published_begin_.load(std::memory_order_relaxed);
+  observed_end_ = published_end_.load(std::memory_order_relaxed);
+  observed_latest_ =
+      observed_begin_ == observed_end_ ? nullptr : Slot(observed_end_ - 1);
+  observed_msg_queue_.clear();
+  observed_copied_ = false;
 }
 
 template <typename T>
 bool Blocker<T>::IsObservedEmpty() const {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  return observed_msg_queue_.empty();
+  return observed_latest_ == nullptr;
 }
 
 template <typename T>
 bool Blocker<T>::IsPublishedEmpty() const {
-  std::lock_guard<std::mutex> lock(msg_mutex_);
-  return published_msg_queue_.empty();
+  return published_begin_.load(std::memory_order_acquire) ==
+         published_end_.load(std::memory_order_acquire);
 }
 
 template <typename T>
@@ -199,46 +240,51 @@ bool Blocker<T>::Unsubscribe(const std::string& callback_id) {
 template <typename T>
 auto Blocker<T>::GetLatestObserved() const -> const MessageType& {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  if (observed_msg_queue_.empty()) {
+  if (observed_latest_ == nullptr) {
     return dummy_msg_;
   }
-  return *observed_msg_queue_.front();
+  return *observed_latest_;
 }
 
 template <typename T>
 auto Blocker<T>::GetLatestObservedPtr() const -> const MessagePtr {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  if (observed_msg_queue_.empty()) {
-    return nullptr;
-  }
-  return observed_msg_queue_.front();
+  return observed_latest_;
 }
 
 template <typename T>
 auto Blocker<T>::GetOldestObservedPtr() const -> const MessagePtr {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  if (observed_msg_queue_.empty()) {
+  if (observed_latest_ == nullptr) {
     return nullptr;
   }
-  return observed_msg_queue_.back();
+  if (observed_copied_) {
+    return observed_msg_queue_.back();
+  }
+  return Slot(observed_begin_);
 }
 
 template <typename T>
 auto Blocker<T>::GetLatestPublishedPtr() const -> const MessagePtr {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  if (published_msg_queue_.empty()) {
+  uint64_t end = published_end_.load(std::memory_order_relaxed);
+  if (published_begin_.load(std::memory_order_relaxed) == end) {
     return nullptr;
   }
-  return published_msg_queue_.front();
+  return Slot(end - 1);
 }
 
 template <typename T>
 auto Blocker<T>::ObservedBegin() const -> Iterator {
+  std::lock_guard<std::mutex> lock(msg_mutex_);
+  CopyObserved();
   return observed_msg_queue_.begin();
 }
 
 template <typename T>
 auto Blocker<T>::ObservedEnd() const -> Iterator {
+  std::lock_guard<std::mutex> lock(msg_mutex_);
+  CopyObserved();
   return observed_msg_queue_.end();
 }
 
@@ -250,10 +296,19 @@ size_t Blocker<T>::capacity() const {
 template <typename T>
 void Blocker<T>::set_capacity(size_t capacity) {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  attr_.capacity = capacity;
-  while (published_msg_queue_.size() > capacity) {
-    published_msg_queue_.pop_back();
+  CopyObserved();
+  uint64_t end = published_end_.load(std::memory_order_relaxed);
+  uint64_t begin = published_begin_.load(std::memory_order_relaxed);
+  if (end - begin > capacity) {
+    begin = end - capacity;
+  }
+  MessageQueue ring(capacity);
+  for (uint64_t i = begin; i < end; ++i) {
+    ring[i % capacity] = Slot(i);
   }
+  ring_.swap(ring);
+  attr_.capacity = capacity;
+  published_begin_.store(begin, std::memory_order_release);
 }
 
 template <typename T>
@@ -263,14 +318,22 @@ const std::string& Blocker<T>::channel_name() const {
 
 template <typename T>
 void Blocker<T>::Enqueue(const MessagePtr& msg) {
-  if (attr_.capacity == 0) {
+  std::lock_guard<std::mutex> lock(msg_mutex_);
+  if (ring_.empty()) {
     return;
   }
-  std::lock_guard<std::mutex> lock(msg_mutex_);
-  published_msg_queue_.push_front(msg);
-  while (published_msg_queue_.size() > attr_.capacity) {
-    published_msg_queue_.pop_back();
+  uint64_t end = published_end_.load(std::memory_order_relaxed);
+  uint64_t begin = published_begin_.load(std::memory_order_relaxed);
+  if (end - begin == ring_.size()) {
+    // the oldest message is dropped, keep it if it is still observed
+    if (!observed_copied_ && begin >= observed_begin_ &&
+        begin < observed_end_) {
+      CopyObserved();
+    }
+    published_begin_.store(begin + 1, std::memory_order_release);
   }
+  ring_[end % ring_.size()] = msg;
+  published_end_.store(end + 1, std::memory_order_release);
 }
 
 template <typename T>
@@ -281,6 +344,26 @@ void Blocker<T>::Notify(const MessagePtr& msg) {
   }
 }
 
+template <typename T>
+void Blocker<T>::CopyObserved() const {
+  if (observed_copied_) {
+    return;
+  }
+  observed_msg_queue_.reserve(observed_end_ - observed_begin_);
+  for (uint64_t i = observed_end_; i > observed_begin_; --i) {
+    observed_msg_queue_.emplace_back(Slot(i - 1));
+  }
+  observed_copied_ = true;
+}
+
+template <typename T>
+void Blocker<T>::ResetRing(size_t capacity) {
+  MessageQueue ring(capacity);
+  ring_.swap(ring);
+  published_begin_.store(0, std::memory_order_release);
+  published_end_.store(0, std::memory_order_release);
+}
+
 }  // namespace blocker
 }  // namespace cyber
 }  // namespace apollo
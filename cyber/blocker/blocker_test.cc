@@ -17,6 +17,7 @@
 #include "cyber/blocker/blocker.h"
 
 #include <memory>
+#include <string>
 
 #include "gtest/gtest.h"
 
@@ -97,6 +98,47 @@ TEST(BlockerTest, publish) {
   EXPECT_TRUE(blocker.IsObservedEmpty());
 }
 
+TEST(BlockerTest, observe) {
+  BlockerAttr attr(3, "channel");
+  Blocker<UnitTest> blocker(attr);
+
+  for (int i = 0; i < 5; ++i) {
+    auto msg = std::make_shared<UnitTest>();
+    msg->set_case_name("publish_" + std::to_string(i));
+    blocker.Publish(msg);
+  }
+  blocker.Observe();
+  EXPECT_EQ(blocker.GetLatestObserved().case_name(), "publish_4");
+  EXPECT_EQ(blocker.GetOldestObservedPtr()->case_name(), "publish_2");
+
+  // publishing after Observe must not change what has been observed
+  for (int i = 5; i < 8; ++i) {
+    auto msg = std::make_shared<UnitTest>();
+    msg->set_case_name("publish_" + std::to_string(i));
+    blocker.Publish(msg);
+  }
+  EXPECT_EQ(blocker.GetLatestObserved().case_name(), "publish_4");
+  EXPECT_EQ(blocker.GetOldestObservedPtr()->case_name(), "publish_2");
+  EXPECT_EQ(blocker.GetLatestPublishedPtr()->case_name(), "publish_7");
+  std::string observed;
+  for (auto it = blocker.ObservedBegin(); it != blocker.ObservedEnd(); ++it) {
+    observed += (*it)->case_name().back();
+  }
+  EXPECT_EQ(observed, "432");
+
+  blocker.set_capacity(2);
+  blocker.Observe();
+  observed.clear();
+  for (auto it = blocker.ObservedBegin(); it != blocker.ObservedEnd(); ++it) {
+    observed += (*it)->case_name().back();
+  }
+  EXPECT_EQ(observed, "76");
+
+  blocker.ClearPublished();
+  EXPECT_TRUE(blocker.IsPublishedEmpty());
+  EXPECT_EQ(blocker.GetOldestObservedPtr()->case_name(), "publish_6");
+}
+
 TEST(BlockerTest, subscribe) {
   BlockerAttr attr(10, "channel");
   Blocker<UnitTest> blocker(attr);
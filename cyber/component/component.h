@@ -144,6 +144,7 @@ bool Component<M0, NullType, NullType, NullType>::Process(
   if (is_shutdown_.load()) {
     return true;
   }
+  event::TraceScope trace_scope(trace_name_);
   return Proc(msg);
 }
 
@@ -225,6 +226,7 @@ bool Component<M0, M1, NullType, NullType>::Process(
   if (is_shutdown_.load()) {
     return true;
   }
+  event::TraceScope trace_scope(trace_name_);
   return Proc(msg0, msg1);
 }
 
@@ -322,6 +324,7 @@ bool Component<M0, M1, M2, NullType>::Process(const std::shared_ptr<M0>& msg0,
   if (is_shutdown_.load()) {
     return true;
   }
+  event::TraceScope trace_scope(trace_name_);
   return Proc(msg0, msg1, msg2);
 }
 
@@ -433,6 +436,7 @@ bool Component<M0, M1, M2, M3>::Process(const std::shared_ptr<M0>& msg0,
   if (is_shutdown_.load()) {
     return true;
   }
+  event::TraceScope trace_scope(trace_name_);
   return Proc(msg0, msg1, msg2, msg3);
 }
 
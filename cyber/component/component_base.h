@@ -29,6 +29,7 @@
 #include "cyber/class_loader/class_loader.h"
 #include "cyber/common/environment.h"
 #include "cyber/common/file.h"
+#include "cyber/event/trace.h"
 #include "cyber/node/node.h"
 #include "cyber/scheduler/scheduler.h"
 
@@ -59,6 +60,23 @@ class ComponentBase : public std::enable_shared_from_this<ComponentBase> {
     scheduler::Instance()->RemoveTask(node_->Name());
   }
 
+  /**
+   * @brief Applies the flag file of the component ahead of Initialize, which
+   * then leaves gflags alone. The mainboard applies the flag files of all
+   * components in dag order this way before initializing them in parallel.
+   */
+  void ApplyFlagFile(const std::string& flag_file_path) {
+    flag_file_applied_ = true;
+    if (flag_file_path.empty()) {
+      return;
+    }
+    std::string path = flag_file_path;
+    if (path[0] != '/') {
+      path = common::GetAbsolutePath(common::WorkRoot(), path);
+    }
+    google::SetCommandLineOption("flagfile", path.c_str());
+  }
+
   template <typename T>
   bool GetProtoConfig(T* config) const {
     return common::GetProtoFromFile(config_file_path_, config);
@@ -70,6 +88,12 @@ class ComponentBase : public std::enable_shared_from_this<ComponentBase> {
   const std::string& ConfigFilePath() const { return config_file_path_; }
 
   void LoadConfigFiles(const ComponentConfig& config) {
+    // keeps the default name once the registry holds too many names
+    const char* trace_name =
+        event::TraceRegistry::Instance()->InternName(config.name());
+    if (trace_name != nullptr) {
+      trace_name_ = trace_name;
+    }
     if (!config.config_file_path().empty()) {
       if (config.config_file_path()[0] != '/') {
         config_file_path_ = common::GetAbsolutePath(common::WorkRoot(),
@@ -79,17 +103,18 @@ class ComponentBase : public std::enable_shared_from_this<ComponentBase> {
       }
     }
 
-    if (!config.flag_file_path().empty()) {
-      std::string flag_file_path = config.flag_file_path();
-      if (flag_file_path[0] != '/') {
-        flag_file_path =
-            common::GetAbsolutePath(common::WorkRoot(), flag_file_path);
-      }
-      google::SetCommandLineOption("flagfile", flag_file_path.c_str());
+    if (!flag_file_applied_) {
+      ApplyFlagFile(config.flag_file_path());
     }
   }
 
   void LoadConfigFiles(const TimerComponentConfig& config) {
+    // keeps the default name once the registry holds too many names
+    const char* trace_name =
+        event::TraceRegistry::Instance()->InternName(config.name());
+    if (trace_name != nullptr) {
+      trace_name_ = trace_name;
+    }
     if (!config.config_file_path().empty()) {
       if (config.config_file_path()[0] != '/') {
         config_file_path_ = common::GetAbsolutePath(common::WorkRoot(),
@@ -99,19 +124,17 @@ class ComponentBase : public std::enable_shared_from_this<ComponentBase> {
       }
     }
 
-    if (!config.flag_file_path().empty()) {
-      std::string flag_file_path = config.flag_file_path();
-      if (flag_file_path[0] != '/') {
-        flag_file_path =
-            common::GetAbsolutePath(common::WorkRoot(), flag_file_path);
-      }
-      google::SetCommandLineOption("flagfile", flag_file_path.c_str());
+    if (!flag_file_applied_) {
+      ApplyFlagFile(config.flag_file_path());
     }
   }
 
   std::atomic<bool> is_shutdown_ = {false};
   std::shared_ptr<Node> node_ = nullptr;
   std::string config_file_path_ = "";
+  bool flag_file_applied_ = false;
+  // every Proc is traced under the name of the component
+  const char* trace_name_ = "component";
   std::vector<std::shared_ptr<ReaderBase>> readers_;
 };
 
@@ -29,6 +29,7 @@ bool TimerComponent::Process() {
   if (is_shutdown_.load()) {
     return true;
   }
+  event::TraceScope trace_scope(trace_name_);
   return Proc();
 }
 
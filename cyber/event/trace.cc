@@ -0,0 +1,351 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/event/trace.h"
+
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+using common::GlobalData;
+
+namespace {
+
+uint64_t RoundUpToPowerOfTwo(uint64_t value) {
+  uint64_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+double Percentile(const std::vector<double>& sorted, double ratio) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  auto index = static_cast<size_t>(ratio * static_cast<double>(sorted.size()));
+  return sorted[std::min(index, sorted.size() - 1)];
+}
+
+std::string EscapeJson(const std::string& str) {
+  static const char kHex[] = "0123456789abcdef";
+  std::string ret;
+  ret.reserve(str.size());
+  for (char c : str) {
+    const auto byte = static_cast<unsigned char>(c);
+    if (c == '"' || c == '\\') {
+      ret.push_back('\\');
+      ret.push_back(c);
+    } else if (byte < 0x20) {
+      // control characters are not allowed in json strings
+      ret.append("\\u00");
+      ret.push_back(kHex[byte >> 4]);
+      ret.push_back(kHex[byte & 0xf]);
+    } else {
+      ret.push_back(c);
+    }
+  }
+  return ret;
+}
+
+}  // namespace
+
+TraceBuffer::TraceBuffer(uint32_t capacity)
+    : capacity_(RoundUpToPowerOfTwo(std::max(capacity, 2u))),
+      mask_(capacity_ - 1),
+      slots_(new Slot[capacity_]) {}
+
+void TraceBuffer::Snapshot(std::vector<TraceEvent>* events) const {
+  const uint64_t finished = finished_.load(std::memory_order_acquire);
+  uint64_t first = cleared_.load(std::memory_order_acquire);
+  if (finished > capacity_) {
+    first = std::max(first, finished - capacity_);
+  }
+  std::vector<TraceEvent> copied;
+  if (finished > first) {
+    copied.reserve(finished - first);
+  }
+  for (uint64_t index = first; index < finished; ++index) {
+    const Slot& slot = slots_[index & mask_];
+    TraceEvent event;
+    event.name = slot.name.load(std::memory_order_relaxed);
+    event.begin = slot.begin.load(std::memory_order_relaxed);
+    event.end = slot.end.load(std::memory_order_relaxed);
+    copied.push_back(event);
+  }
+  // the slot of an index is reused by the record of index + capacity, so the
+  // copies of the slots reused since the copy started are dropped
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const uint64_t started = started_.load(std::memory_order_relaxed);
+  uint64_t valid = first;
+  if (started > capacity_) {
+    valid = std::max(valid, started - capacity_);
+  }
+  for (uint64_t index = valid; index < finished; ++index) {
+    const TraceEvent& event = copied[index - first];
+    if (event.name != nullptr && event.end >= event.begin) {
+      events->push_back(event);
+    }
+  }
+}
+
+TraceRegistry::TraceRegistry()
+    : start_ticks_(TraceTicks()),
+      start_time_(std::chrono::steady_clock::now()) {
+  auto& global_conf = GlobalData::Instance()->Config();
+  if (global_conf.has_perf_conf()) {
+    const auto& perf_conf = global_conf.perf_conf();
+    enabled_.store(perf_conf.trace_enable());
+    buffer_capacity_ = perf_conf.trace_buffer_size();
+    trace_file_ = perf_conf.trace_file();
+  }
+}
+
+TraceRegistry::~TraceRegistry() {}
+
+TraceRegistry::LocalBufferHolder::~LocalBufferHolder() {
+  if (buffer != nullptr) {
+    auto registry = TraceRegistry::Instance(false);
+    if (registry != nullptr) {
+      registry->ReleaseBuffer(buffer);
+    }
+  }
+}
+
+TraceBuffer* TraceRegistry::AcquireBuffer() {
+  char thread_name[16] = {0};
+  pthread_getname_np(pthread_self(), thread_name, sizeof(thread_name));
+  std::lock_guard<std::mutex> lock(mutex_);
+  TraceBuffer* buffer = nullptr;
+  // events of exited threads are kept until there are too many buffers, then
+  // the buffer of an exited thread is reused and its events are dropped
+  if (buffers_.size() >= kMaxBufferNum) {
+    for (auto& retired : buffers_) {
+      if (retired->retired_) {
+        buffer = retired.get();
+        buffer->Clear();
+        break;
+      }
+    }
+  }
+  if (buffer == nullptr) {
+    buffers_.emplace_back(new TraceBuffer(buffer_capacity_));
+    buffer = buffers_.back().get();
+  }
+  buffer->retired_ = false;
+  buffer->tid_ = static_cast<int>(syscall(SYS_gettid));
+  buffer->thread_name_ = thread_name;
+  return buffer;
+}
+
+void TraceRegistry::ReleaseBuffer(TraceBuffer* buffer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffer->retired_ = true;
+}
+
+const char* TraceRegistry::InternName(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto search = names_.find(name);
+  if (search != names_.end()) {
+    return search->c_str();
+  }
+  if (names_.size() >= kMaxNameNum) {
+    if (!names_full_) {
+      names_full_ = true;
+      AWARN << "more than " << kMaxNameNum
+            << " trace names, scopes of new names are not traced.";
+    }
+    return nullptr;
+  }
+  return names_.insert(name).first->c_str();
+}
+
+std::vector<TraceRegistry::ThreadEvents> TraceRegistry::SnapshotAll() {
+  std::vector<ThreadEvents> threads;
+  std::lock_guard<std::mutex> lock(mutex_);
+  threads.reserve(buffers_.size());
+  for (const auto& buffer : buffers_) {
+    ThreadEvents thread;
+    thread.tid = buffer->tid_;
+    thread.thread_name = buffer->thread_name_;
+    buffer->Snapshot(&thread.events);
+    if (!thread.events.empty()) {
+      threads.push_back(std::move(thread));
+    }
+  }
+  return threads;
+}
+
+double TraceRegistry::NanosecondsPerTick() {
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+  // the counter is calibrated against the steady clock over the lifetime of
+  // the registry, a short one would give a coarse ratio
+  constexpr auto kMinCalibration = std::chrono::milliseconds(10);
+  auto elapsed = std::chrono::steady_clock::now() - start_time_;
+  if (elapsed < kMinCalibration) {
+    std::this_thread::sleep_for(kMinCalibration - elapsed);
+  }
+  const uint64_t ticks = TraceTicks();
+  elapsed = std::chrono::steady_clock::now() - start_time_;
+  if (ticks <= start_ticks_) {
+    return 1.0;
+  }
+  return static_cast<double>(
+             std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                 .count()) /
+         static_cast<double>(ticks - start_ticks_);
+#else
+  return 1.0;
+#endif
+}
+
+std::vector<TraceStatistics> TraceRegistry::Aggregate() {
+  struct PathRecord {
+    uint64_t call_num = 0;
+    uint64_t cycle = 0;
+    double cycle_ms = 0.0;
+    std::vector<double> cycle_durations_ms;
+  };
+
+  const double ms_per_tick = NanosecondsPerTick() / 1e6;
+  std::map<std::string, PathRecord> records;
+  uint64_t cycle = 0;
+  for (auto& thread : SnapshotAll()) {
+    auto& events = thread.events;
+    // outer scopes first, an outer scope begins no later and ends no earlier
+    // than the scopes it encloses
+    std::sort(events.begin(), events.end(),
+              [](const TraceEvent& lhs, const TraceEvent& rhs) {
+                return lhs.begin != rhs.begin ? lhs.begin < rhs.begin
+                                              : lhs.end > rhs.end;
+              });
+    std::vector<std::pair<uint64_t, std::string>> stack;
+    for (const auto& event : events) {
+      while (!stack.empty() && stack.back().first < event.end) {
+        stack.pop_back();
+      }
+      std::string path = stack.empty()
+                             ? std::string(event.name)
+                             : stack.back().second + ";" + event.name;
+      if (stack.empty()) {
+        ++cycle;
+      }
+      auto& record = records[path];
+      if (record.call_num > 0 && record.cycle != cycle) {
+        record.cycle_durations_ms.push_back(record.cycle_ms);
+        record.cycle_ms = 0.0;
+      }
+      ++record.call_num;
+      record.cycle = cycle;
+      record.cycle_ms +=
+          static_cast<double>(event.end - event.begin) * ms_per_tick;
+      stack.emplace_back(event.end, std::move(path));
+    }
+  }
+
+  std::vector<TraceStatistics> statistics;
+  statistics.reserve(records.size());
+  for (auto& item : records) {
+    auto& durations = item.second.cycle_durations_ms;
+    durations.push_back(item.second.cycle_ms);
+    std::sort(durations.begin(), durations.end());
+    TraceStatistics stat;
+    stat.path = item.first;
+    stat.cycle_num = durations.size();
+    stat.call_num = item.second.call_num;
+    double sum = 0.0;
+    for (double duration : durations) {
+      sum += duration;
+    }
+    stat.mean_ms = sum / static_cast<double>(durations.size());
+    stat.p50_ms = Percentile(durations, 0.5);
+    stat.p90_ms = Percentile(durations, 0.9);
+    stat.p99_ms = Percentile(durations, 0.99);
+    stat.max_ms = durations.back();
+    statistics.push_back(std::move(stat));
+  }
+  return statistics;
+}
+
+std::string TraceRegistry::ChromeTraceJson() {
+  const double us_per_tick = NanosecondsPerTick() / 1e3;
+  const int pid = GlobalData::Instance()->ProcessId();
+  std::ostringstream out;
+  out.precision(3);
+  out << std::fixed << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto& thread : SnapshotAll()) {
+    out << (first ? "" : ",")
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+        << ",\"tid\":" << thread.tid << ",\"args\":{\"name\":\""
+        << EscapeJson(thread.thread_name) << "\"}}";
+    first = false;
+    for (const auto& event : thread.events) {
+      // events recorded before the registry existed are clamped to its start
+      const uint64_t begin = std::max(event.begin, start_ticks_);
+      const uint64_t end = std::max(event.end, begin);
+      out << ",{\"name\":\"" << EscapeJson(event.name)
+          << "\",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << thread.tid
+          << ",\"ts\":"
+          << static_cast<double>(begin - start_ticks_) * us_per_tick
+          << ",\"dur\":" << static_cast<double>(end - begin) * us_per_tick
+          << "}";
+    }
+  }
+  out << "]}";
+  return out.str();
+}
+
+bool TraceRegistry::DumpChromeTrace(const std::string& file_path) {
+  std::ofstream file(file_path, std::ios::out | std::ios::trunc);
+  if (!file.is_open()) {
+    AERROR << "open trace file " << file_path << " failed.";
+    return false;
+  }
+  file << ChromeTraceJson();
+  return file.good();
+}
+
+void TraceRegistry::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& buffer : buffers_) {
+    buffer->Clear();
+  }
+}
+
+void TraceRegistry::Shutdown() {
+  if (!trace_file_.empty() && DumpChromeTrace(trace_file_)) {
+    AINFO << "trace is written to " << trace_file_;
+  }
+}
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,241 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_EVENT_TRACE_H_
+#define CYBER_EVENT_TRACE_H_
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "cyber/base/macros.h"
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+// Reads the time stamp counter of the cpu, or a monotonic clock in
+// nanoseconds where there is no counter readable from user space.
+inline uint64_t TraceTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  uint64_t ticks;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+  return ticks;
+#else
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+#endif
+}
+
+struct TraceEvent {
+  const char* name = nullptr;
+  uint64_t begin = 0;
+  uint64_t end = 0;
+};
+
+// Statistics of a scope over the recorded cycles. A cycle is one run of an
+// outermost scope, such as one Proc of a component, and the durations of a
+// scope that runs several times in a cycle are summed up.
+struct TraceStatistics {
+  // names of the enclosing scopes and of this one, separated by ';'
+  std::string path;
+  uint64_t cycle_num = 0;
+  uint64_t call_num = 0;
+  double mean_ms = 0.0;
+  double p50_ms = 0.0;
+  double p90_ms = 0.0;
+  double p99_ms = 0.0;
+  double max_ms = 0.0;
+};
+
+// Events of one thread, in a ring written by that thread only. Readers copy
+// it while it is written and drop the slots that may have been overwritten
+// during the copy.
+class TraceBuffer {
+ public:
+  explicit TraceBuffer(uint32_t capacity);
+
+  void Record(const char* name, uint64_t begin, uint64_t end) {
+    const uint64_t index = started_.load(std::memory_order_relaxed);
+    started_.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    Slot& slot = slots_[index & mask_];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin.store(begin, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+    finished_.store(index + 1, std::memory_order_release);
+  }
+
+  void Snapshot(std::vector<TraceEvent>* events) const;
+
+  void Clear() {
+    cleared_.store(finished_.load(std::memory_order_acquire),
+                   std::memory_order_release);
+  }
+
+ private:
+  friend class TraceRegistry;
+
+  struct Slot {
+    std::atomic<const char*> name = {nullptr};
+    std::atomic<uint64_t> begin = {0};
+    std::atomic<uint64_t> end = {0};
+  };
+
+  const uint64_t capacity_;
+  const uint64_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> started_ = {0};
+  std::atomic<uint64_t> finished_ = {0};
+  std::atomic<uint64_t> cleared_ = {0};
+
+  // guarded by the mutex of the registry
+  int tid_ = 0;
+  std::string thread_name_;
+  bool retired_ = false;
+};
+
+/**
+ * @brief Registry of the scoped traces of all threads.
+ *
+ * Scopes are recorded as begin and end ticks into a buffer of the thread,
+ * nothing is locked, allocated or formatted on the way. Recorded events are
+ * turned into per cycle statistics of every scope path, or into a Chrome
+ * trace (chrome://tracing, Perfetto) on demand. Tracing is enabled by
+ * perf_conf.trace_enable of cyber.pb.conf or with set_enabled.
+ */
+class TraceRegistry {
+ public:
+  ~TraceRegistry();
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+  void set_enabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+
+  void Record(const char* name, uint64_t begin, uint64_t end) {
+    LocalBuffer()->Record(name, begin, end);
+  }
+
+  // Names of scopes are not copied. A name built at runtime has to be
+  // interned once, the returned pointer stays valid for the whole process.
+  // Interned names are never freed, so at most kMaxNameNum of them are kept
+  // and nullptr is returned for any new name beyond that.
+  const char* InternName(const std::string& name);
+
+  std::vector<TraceStatistics> Aggregate();
+
+  std::string ChromeTraceJson();
+  bool DumpChromeTrace(const std::string& file_path);
+
+  void Clear();
+
+  // Dumps the trace to perf_conf.trace_file if it is set.
+  void Shutdown();
+
+ private:
+  struct ThreadEvents {
+    int tid = 0;
+    std::string thread_name;
+    std::vector<TraceEvent> events;
+  };
+
+  // Hands the buffer back to the registry when its thread exits.
+  struct LocalBufferHolder {
+    ~LocalBufferHolder();
+    TraceBuffer* buffer = nullptr;
+  };
+
+  TraceBuffer* LocalBuffer() {
+    static thread_local LocalBufferHolder holder;
+    if (cyber_unlikely(holder.buffer == nullptr)) {
+      holder.buffer = AcquireBuffer();
+    }
+    return holder.buffer;
+  }
+
+  TraceBuffer* AcquireBuffer();
+  void ReleaseBuffer(TraceBuffer* buffer);
+  std::vector<ThreadEvents> SnapshotAll();
+  double NanosecondsPerTick();
+
+  // threads that keep a buffer beyond this number may reuse the buffers of
+  // exited threads
+  static constexpr size_t kMaxBufferNum = 64;
+  // names built at runtime, e.g. with ids in them, would otherwise grow the
+  // table without bound
+  static constexpr size_t kMaxNameNum = 4096;
+
+  std::atomic<bool> enabled_ = {false};
+  uint32_t buffer_capacity_ = 1 << 14;
+  std::string trace_file_;
+  const uint64_t start_ticks_;
+  const std::chrono::steady_clock::time_point start_time_;
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<TraceBuffer>> buffers_;
+  std::unordered_set<std::string> names_;
+  bool names_full_ = false;
+
+  DECLARE_SINGLETON(TraceRegistry)
+};
+
+// Records the time from its construction to its destruction. The name has to
+// outlive the process, a string literal or a name from InternName.
+class TraceScope {
+ public:
+  explicit TraceScope(const char* name)
+      : name_(TraceRegistry::Instance()->enabled() ? name : nullptr),
+        begin_(name_ != nullptr ? TraceTicks() : 0) {}
+
+  ~TraceScope() {
+    if (name_ != nullptr) {
+      TraceRegistry::Instance()->Record(name_, begin_, TraceTicks());
+    }
+  }
+
+ private:
+  const char* name_;
+  uint64_t begin_;
+
+  DISALLOW_COPY_AND_ASSIGN(TraceScope);
+};
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
+
+#define CYBER_TRACE_CONCAT_INNER(a, b) a##b
+#define CYBER_TRACE_CONCAT(a, b) CYBER_TRACE_CONCAT_INNER(a, b)
+#define CYBER_TRACE_SCOPE(name)      \
+  ::apollo::cyber::event::TraceScope \
+      CYBER_TRACE_CONCAT(_cyber_trace_scope_, __LINE__)(name)
+
+#endif  // CYBER_EVENT_TRACE_H_
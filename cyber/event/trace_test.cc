@@ -0,0 +1,171 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/event/trace.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+const TraceStatistics* FindPath(const std::vector<TraceStatistics>& stats,
+                                const std::string& path) {
+  for (const auto& stat : stats) {
+    if (stat.path == path) {
+      return &stat;
+    }
+  }
+  return nullptr;
+}
+
+TEST(TraceTest, disabled) {
+  auto registry = TraceRegistry::Instance();
+  registry->set_enabled(false);
+  registry->Clear();
+  { CYBER_TRACE_SCOPE("disabled"); }
+  EXPECT_TRUE(registry->Aggregate().empty());
+}
+
+TEST(TraceTest, nested_scopes) {
+  auto registry = TraceRegistry::Instance();
+  registry->set_enabled(true);
+  registry->Clear();
+  for (int i = 0; i < 3; ++i) {
+    CYBER_TRACE_SCOPE("proc");
+    {
+      CYBER_TRACE_SCOPE("stage");
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    {
+      CYBER_TRACE_SCOPE("stage");
+      CYBER_TRACE_SCOPE("inner");
+    }
+  }
+  auto stats = registry->Aggregate();
+  registry->set_enabled(false);
+  ASSERT_EQ(3, stats.size());
+
+  auto proc = FindPath(stats, "proc");
+  ASSERT_NE(nullptr, proc);
+  EXPECT_EQ(3, proc->cycle_num);
+  EXPECT_EQ(3, proc->call_num);
+  EXPECT_GE(proc->p50_ms, 1.0);
+  EXPECT_LE(proc->p50_ms, proc->max_ms);
+
+  // both stages of a cycle add up to one sample
+  auto stage = FindPath(stats, "proc;stage");
+  ASSERT_NE(nullptr, stage);
+  EXPECT_EQ(3, stage->cycle_num);
+  EXPECT_EQ(6, stage->call_num);
+  EXPECT_LE(stage->mean_ms, proc->mean_ms);
+
+  auto inner = FindPath(stats, "proc;stage;inner");
+  ASSERT_NE(nullptr, inner);
+  EXPECT_EQ(3, inner->call_num);
+}
+
+TEST(TraceTest, threads) {
+  auto registry = TraceRegistry::Instance();
+  registry->set_enabled(true);
+  registry->Clear();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([] {
+      for (int j = 0; j < 100; ++j) {
+        CYBER_TRACE_SCOPE("worker");
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto stats = registry->Aggregate();
+  registry->set_enabled(false);
+  auto worker = FindPath(stats, "worker");
+  ASSERT_NE(nullptr, worker);
+  EXPECT_EQ(400, worker->call_num);
+}
+
+TEST(TraceTest, ring_overwrite) {
+  auto registry = TraceRegistry::Instance();
+  registry->set_enabled(true);
+  registry->Clear();
+  const uint64_t record_num = 100000;
+  for (uint64_t i = 0; i < record_num; ++i) {
+    CYBER_TRACE_SCOPE("overwrite");
+  }
+  auto stats = registry->Aggregate();
+  registry->set_enabled(false);
+  auto overwrite = FindPath(stats, "overwrite");
+  ASSERT_NE(nullptr, overwrite);
+  EXPECT_GT(overwrite->call_num, 0);
+  EXPECT_LT(overwrite->call_num, record_num);
+}
+
+TEST(TraceTest, chrome_trace) {
+  auto registry = TraceRegistry::Instance();
+  registry->set_enabled(true);
+  registry->Clear();
+  const std::string name = "component \"a\"";
+  const char* interned = registry->InternName(name);
+  EXPECT_EQ(interned, registry->InternName(name));
+  { TraceScope scope(interned); }
+  auto json = registry->ChromeTraceJson();
+  registry->set_enabled(false);
+  EXPECT_EQ(0, json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, json.find("\"name\":\"component \\\"a\\\"\""));
+  EXPECT_NE(std::string::npos, json.find("\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, json.find("\"ph\":\"M\""));
+  EXPECT_EQ("]}", json.substr(json.size() - 2));
+}
+
+TEST(TraceTest, chrome_trace_control_characters) {
+  auto registry = TraceRegistry::Instance();
+  registry->set_enabled(true);
+  registry->Clear();
+  { TraceScope scope(registry->InternName("line\nbreak\t\x01")); }
+  auto json = registry->ChromeTraceJson();
+  registry->set_enabled(false);
+  EXPECT_NE(std::string::npos,
+            json.find("\"name\":\"line\\u000abreak\\u0009\\u0001\""));
+  EXPECT_EQ(std::string::npos, json.find('\n'));
+}
+
+// fills the name table, so it has to stay the last test
+TEST(TraceTest, intern_name_limit) {
+  auto registry = TraceRegistry::Instance();
+  const char* first = registry->InternName("limit_0");
+  ASSERT_NE(nullptr, first);
+  int interned_num = 1;
+  while (interned_num < (1 << 16) &&
+         registry->InternName("limit_" + std::to_string(interned_num)) !=
+             nullptr) {
+    ++interned_num;
+  }
+  EXPECT_LT(interned_num, 1 << 16);
+  EXPECT_EQ(nullptr, registry->InternName("limit_" +
+                                          std::to_string(interned_num)));
+  EXPECT_EQ(first, registry->InternName("limit_0"));
+}
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
@@ -32,6 +32,7 @@
 #include "cyber/common/file.h"
 #include "cyber/common/global_data.h"
 #include "cyber/data/data_dispatcher.h"
+#include "cyber/event/trace.h"
 #include "cyber/logger/async_logger.h"
 #include "cyber/node/node.h"
 #include "cyber/scheduler/scheduler.h"
@@ -143,6 +144,7 @@ void Clear() {
   scheduler::CleanUp();
   service_discovery::TopologyManager::CleanUp();
   transport::Transport::CleanUp();
+  event::TraceRegistry::CleanUp();
   StopLogger();
   SetState(STATE_SHUTDOWN);
 }
@@ -19,6 +19,8 @@
 #include <getopt.h>
 #include <libgen.h>
 
+#include <algorithm>
+
 using apollo::cyber::common::GlobalData;
 
 namespace apollo {
@@ -34,10 +36,14 @@ void ModuleArgument::DisplayUsage() {
            "namespace for running this module, default in manager process\n"
         << "    -s, --sched_name=sched_name: sched policy "
            "conf for hole process, sched_name should be conf in cyber.pb.conf\n"
+        << "    -j, --init_threads=N: initialize components of different "
+           "module libraries on N threads, components of the same library "
+           "are always initialized in dag order, with N > 1 the flag files "
+           "of all components are applied before the first Init, default 1\n"
         << "Example:\n"
         << "    " << binary_name_ << " -h\n"
         << "    " << binary_name_ << " -d dag_conf_file1 -d dag_conf_file2 "
-        << "-p process_group -s sched_name\n";
+        << "-p process_group -s sched_name -j 4\n";
 }
 
 void ModuleArgument::ParseArgument(const int argc, char* const argv[]) {
@@ -55,7 +61,8 @@ void ModuleArgument::ParseArgument(const int argc, char* const argv[]) {
   GlobalData::Instance()->SetProcessGroup(process_group_);
   GlobalData::Instance()->SetSchedName(sched_name_);
   AINFO << "binary_name_ is " << binary_name_ << ", process_group_ is "
-        << process_group_ << ", has " << dag_conf_list_.size() << " dag conf";
+        << process_group_ << ", has " << dag_conf_list_.size() << " dag conf"
+        << ", init_threads is " << init_thread_num_;
   for (std::string& dag : dag_conf_list_) {
     AINFO << "dag_conf: " << dag;
   }
@@ -64,12 +71,13 @@ void ModuleArgument::ParseArgument(const int argc, char* const argv[]) {
 void ModuleArgument::GetOptions(const int argc, char* const argv[]) {
   opterr = 0;  // extern int opterr
   int long_index = 0;
-  const std::string short_opts = "hd:p:s:";
+  const std::string short_opts = "hd:p:s:j:";
   static const struct option long_opts[] = {
       {"help", no_argument, nullptr, 'h'},
       {"dag_conf", required_argument, nullptr, 'd'},
       {"process_name", required_argument, nullptr, 'p'},
       {"sched_name", required_argument, nullptr, 's'},
+      {"init_threads", required_argument, nullptr, 'j'},
       {NULL, no_argument, nullptr, 0}};
 
   // log command for info
@@ -108,6 +116,15 @@ void ModuleArgument::GetOptions(const int argc, char* const argv[]) {
       case 's':
         sched_name_ = std::string(optarg);
         break;
+      case 'j':
+        try {
+          init_thread_num_ = std::max(1, std::stoi(optarg));
+        } catch (const std::exception& e) {
+          AERROR << "invalid init_threads: " << optarg << ", " << e.what();
+          DisplayUsage();
+          exit(1);
+        }
+        break;
       case 'h':
         DisplayUsage();
         exit(0);
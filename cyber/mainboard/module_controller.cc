@@ -16,8 +16,12 @@
 
 #include "cyber/mainboard/module_controller.h"
 
+#include <algorithm>
+#include <future>
+#include <unordered_map>
 #include <utility>
 
+#include "cyber/base/thread_pool.h"
 #include "cyber/common/environment.h"
 #include "cyber/common/file.h"
 #include "cyber/component/component_base.h"
@@ -31,10 +35,12 @@ void ModuleController::Clear() {
     component->Shutdown();
   }
   component_list_.clear();  // keep alive
+  pending_components_.clear();
   class_loader_manager_.UnloadAllLibrary();
 }
 
 bool ModuleController::LoadAll() {
+  load_start_ = std::chrono::steady_clock::now();
   const std::string work_root = common::WorkRoot();
   const std::string current_path = common::GetCurrentPath();
   const std::string dag_root_path = common::GetAbsolutePath(work_root, "dag");
@@ -61,14 +67,20 @@ bool ModuleController::LoadAll() {
     total_component_nums += scheduler::Instance()->TaskPoolSize();
   }
   common::GlobalData::Instance()->SetComponentNums(total_component_nums);
+  bool success = true;
   for (auto module_path : paths) {
     AINFO << "Start initialize dag: " << module_path;
     if (!LoadModule(module_path)) {
       AERROR << "Failed to load module: " << module_path;
-      return false;
+      success = false;
+      break;
     }
   }
-  return true;
+  if (success) {
+    success = InitComponents();
+  }
+  ReportTimeline();
+  return success;
 }
 
 bool ModuleController::LoadModule(const DagConfig& dag_config) {
@@ -88,31 +100,175 @@ bool ModuleController::LoadModule(const DagConfig& dag_config) {
       return false;
     }
 
+    // libraries are loaded one by one: the class loader registers the
+    // classes of a library through process wide state during dlopen
     class_loader_manager_.LoadLibrary(load_path);
 
+    // with a single init thread every component is initialized right after
+    // it is created, with more threads they are only created here and are
+    // initialized all together in InitComponents
     for (auto& component : module_config.components()) {
       const std::string& class_name = component.class_name();
       std::shared_ptr<ComponentBase> base =
           class_loader_manager_.CreateClassObj<ComponentBase>(class_name);
-      if (base == nullptr || !base->Initialize(component.config())) {
+      if (base == nullptr) {
+        AERROR << "Failed to create component: " << class_name;
+        return false;
+      }
+      PendingComponent pending;
+      pending.library = load_path;
+      pending.component = base;
+      pending.flag_file_path = component.config().flag_file_path();
+      pending.initialize = [base, config = component.config()]() {
+        return base->Initialize(config);
+      };
+      pending.timeline.name = component.config().name();
+      pending.timeline.library = load_path;
+      if (!AddComponent(std::move(pending))) {
         return false;
       }
-      component_list_.emplace_back(std::move(base));
     }
 
     for (auto& component : module_config.timer_components()) {
       const std::string& class_name = component.class_name();
       std::shared_ptr<ComponentBase> base =
           class_loader_manager_.CreateClassObj<ComponentBase>(class_name);
-      if (base == nullptr || !base->Initialize(component.config())) {
+      if (base == nullptr) {
+        AERROR << "Failed to create component: " << class_name;
+        return false;
+      }
+      PendingComponent pending;
+      pending.library = load_path;
+      pending.component = base;
+      pending.flag_file_path = component.config().flag_file_path();
+      pending.initialize = [base, config = component.config()]() {
+        return base->Initialize(config);
+      };
+      pending.timeline.name = component.config().name();
+      pending.timeline.library = load_path;
+      if (!AddComponent(std::move(pending))) {
         return false;
       }
-      component_list_.emplace_back(std::move(base));
     }
   }
   return true;
 }
 
+bool ModuleController::AddComponent(PendingComponent pending) {
+  if (args_.GetInitThreadNum() > 1) {
+    pending_components_.emplace_back(std::move(pending));
+    return true;
+  }
+  // load, create and init stay interleaved as they have always been, so a
+  // failed Init stops the libraries after it from being loaded at all
+  bool success = InitComponent(&pending);
+  startup_timeline_.emplace_back(pending.timeline);
+  if (success) {
+    component_list_.emplace_back(pending.component);
+  }
+  return success;
+}
+
+bool ModuleController::InitComponents() {
+  bool success = true;
+  const size_t thread_num = static_cast<size_t>(args_.GetInitThreadNum());
+
+  // components of the same library may share static state and may rely on
+  // the dag order, so they form a chain that is initialized in order, while
+  // chains of different libraries are independent of each other
+  std::vector<std::vector<PendingComponent*>> chains;
+  std::unordered_map<std::string, size_t> chain_index;
+  for (auto& pending : pending_components_) {
+    auto search = chain_index.find(pending.library);
+    if (search == chain_index.end()) {
+      search = chain_index.emplace(pending.library, chains.size()).first;
+      chains.emplace_back();
+    }
+    chains[search->second].emplace_back(&pending);
+  }
+
+  if (chains.size() <= 1) {
+    for (auto& pending : pending_components_) {
+      if (!InitComponent(&pending)) {
+        success = false;
+        break;
+      }
+    }
+  } else {
+    // gflags are process wide and read by the Init of other chains, so the
+    // flag files are applied here in dag order, and only the bodies of the
+    // inits run in parallel. Unlike a sequential startup, an Init therefore
+    // also sees the values set by the flag files of components later in the
+    // dag, components that cache FLAGS_* in Init should keep one init thread.
+    for (auto& pending : pending_components_) {
+      pending.component->ApplyFlagFile(pending.flag_file_path);
+    }
+    auto init_chain = [this](const std::vector<PendingComponent*>& chain) {
+      for (auto pending : chain) {
+        if (!InitComponent(pending)) {
+          return false;
+        }
+      }
+      return true;
+    };
+    base::ThreadPool pool(std::min(thread_num, chains.size()), chains.size());
+    std::vector<std::future<bool>> results;
+    for (auto& chain : chains) {
+      results.emplace_back(pool.Enqueue(init_chain, std::cref(chain)));
+    }
+    for (auto& result : results) {
+      if (!result.valid() || !result.get()) {
+        success = false;
+      }
+    }
+  }
+
+  // keep the dag order for shutdown, whatever order the inits finished in
+  for (auto& pending : pending_components_) {
+    startup_timeline_.emplace_back(pending.timeline);
+    if (pending.timeline.success) {
+      component_list_.emplace_back(pending.component);
+    }
+  }
+  pending_components_.clear();
+  return success;
+}
+
+bool ModuleController::InitComponent(PendingComponent* pending) {
+  auto elapsed_ms = [this]() {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - load_start_)
+        .count();
+  };
+  pending->timeline.start_ms = elapsed_ms();
+  pending->timeline.success = pending->initialize();
+  pending->timeline.end_ms = elapsed_ms();
+  if (!pending->timeline.success) {
+    AERROR << "Failed to initialize component: " << pending->timeline.name
+           << ", library: " << pending->library;
+  }
+  return pending->timeline.success;
+}
+
+void ModuleController::ReportTimeline() {
+  auto timeline = startup_timeline_;
+  std::sort(timeline.begin(), timeline.end(),
+            [](const ComponentTimeline& lhs, const ComponentTimeline& rhs) {
+              return lhs.start_ms < rhs.start_ms;
+            });
+  double end_ms = 0.0;
+  for (auto& item : timeline) {
+    AINFO << "startup timeline: component[" << item.name << "] start at "
+          << item.start_ms << " ms, took " << item.end_ms - item.start_ms
+          << " ms" << (item.success ? "" : " (failed)")
+          << ", library: " << item.library;
+    end_ms = std::max(end_ms, item.end_ms);
+  }
+  AINFO << "startup timeline: " << timeline.size()
+        << " components initialized in " << end_ms << " ms with "
+        << args_.GetInitThreadNum() << " init threads";
+}
+
 bool ModuleController::LoadModule(const std::string& path) {
   DagConfig dag_config;
   if (!common::GetProtoFromFile(path, &dag_config)) {
@@ -16,6 +16,8 @@
 #ifndef CYBER_MAINBOARD_MODULE_CONTROLLER_H_
 #define CYBER_MAINBOARD_MODULE_CONTROLLER_H_
 
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -32,6 +34,16 @@ namespace mainboard {
 
 using apollo::cyber::proto::DagConfig;
 
+// One entry of the startup timeline, offsets are relative to the start of
+// LoadAll.
+struct ComponentTimeline {
+  std::string name;
+  std::string library;
+  double start_ms = 0.0;
+  double end_ms = 0.0;
+  bool success = false;
+};
+
 class ModuleController {
  public:
   explicit ModuleController(const ModuleArgument& args);
@@ -41,9 +53,26 @@ class ModuleController {
   bool LoadAll();
   void Clear();
 
+  const std::vector<ComponentTimeline>& startup_timeline() const {
+    return startup_timeline_;
+  }
+
  private:
+  // A component that has been created but not initialized yet.
+  struct PendingComponent {
+    std::string library;
+    std::shared_ptr<ComponentBase> component;
+    std::string flag_file_path;
+    std::function<bool()> initialize;
+    ComponentTimeline timeline;
+  };
+
   bool LoadModule(const std::string& path);
   bool LoadModule(const DagConfig& dag_config);
+  bool AddComponent(PendingComponent pending);
+  bool InitComponents();
+  bool InitComponent(PendingComponent* pending);
+  void ReportTimeline();
   int GetComponentNum(const std::string& path);
   int total_component_nums = 0;
   bool has_timer_component = false;
@@ -51,6 +80,9 @@ class ModuleController {
   ModuleArgument args_;
   class_loader::ClassLoaderManager class_loader_manager_;
   std::vector<std::shared_ptr<ComponentBase>> component_list_;
+  std::vector<PendingComponent> pending_components_;
+  std::vector<ComponentTimeline> startup_timeline_;
+  std::chrono::steady_clock::time_point load_start_;
 };
 
 inline ModuleController::ModuleController(const ModuleArgument& args)
@@ -18,7 +18,6 @@
 #define CYBER_NODE_READER_H_
 
 #include <algorithm>
-#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -71,8 +70,7 @@ class Reader : public ReaderBase {
   using ReceiverPtr = std::shared_ptr<transport::Receiver<MessageT>>;
   using ChangeConnection =
       typename service_discovery::Manager::ChangeConnection;
-  using Iterator =
-      typename std::list<std::shared_ptr<MessageT>>::const_iterator;
+  using Iterator = typename blocker::Blocker<MessageT>::Iterator;
 
   /**
    * Constructor a Reader object.
@@ -307,8 +305,10 @@ void Reader<MessageT>::Shutdown() {
 template <typename MessageT>
 void Reader<MessageT>::JoinTheTopology() {
   // add listener
-  change_conn_ = channel_manager_->AddChangeListener(std::bind(
-      &Reader<MessageT>::OnChannelChange, this, std::placeholders::_1));
+  change_conn_ = channel_manager_->AddChangeListener(
+      this->role_attr_.channel_name(),
+      std::bind(&Reader<MessageT>::OnChannelChange, this,
+                std::placeholders::_1));
 
   // get peer writers
   const std::string& channel_name = this->role_attr_.channel_name();
@@ -172,8 +172,10 @@ bool Writer<MessageT>::Write(const std::shared_ptr<MessageT>& msg_ptr) {
 template <typename MessageT>
 void Writer<MessageT>::JoinTheTopology() {
   // add listener
-  change_conn_ = channel_manager_->AddChangeListener(std::bind(
-      &Writer<MessageT>::OnChannelChange, this, std::placeholders::_1));
+  change_conn_ = channel_manager_->AddChangeListener(
+      this->role_attr_.channel_name(),
+      std::bind(&Writer<MessageT>::OnChannelChange, this,
+                std::placeholders::_1));
 
   // get peer readers
   const std::string& channel_name = this->role_attr_.channel_name();
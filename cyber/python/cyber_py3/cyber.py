@@ -30,6 +30,8 @@ from google.protobuf.descriptor_pb2 import FileDescriptorProto
 
 PY_CALLBACK_TYPE = ctypes.CFUNCTYPE(ctypes.c_int, ctypes.c_char_p)
 PY_CALLBACK_TYPE_T = ctypes.CFUNCTYPE(ctypes.c_int, ctypes.c_char_p)
+# max number of cached messages handled by one reader callback
+READ_BATCH_SIZE = 64
 
 # init vars
 wrapper_lib_path = os.path.abspath(os.path.join(os.path.dirname(__file__),
@@ -214,8 +216,15 @@ class Node(object):
 
     def reader_callback(self, name):
         sub = self.subs[name.decode('utf8')]
-        msg_str = _CYBER.PyReader_read(sub[0], False)
-        if len(msg_str) > 0:
+        # drain every cached message at once, callbacks of messages handled
+        # here find an empty cache and return right away
+        data, sizes = _CYBER.PyReader_read_batch(
+            sub[0], READ_BATCH_SIZE, False)
+        view = memoryview(data)
+        offset = 0
+        for size in sizes:
+            msg_str = bytes(view[offset:offset + size])
+            offset += size
             if sub[3] != "RawData":
                 proto = sub[3]()
                 proto.ParseFromString(msg_str)
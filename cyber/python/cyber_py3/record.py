@@ -71,6 +71,34 @@ class RecordReader(object):
                 # print "No message more."
                 break
 
+    ##
+    # @brief Read messages from bag file in batches.
+    #
+    # Each batch is read by a single call that releases the GIL, payloads of
+    # the batch share one buffer and are handed out as memoryview slices of
+    # it, so no per message copy is made. Use bytes(message) to keep one.
+    #
+    # @param batch_size the max number of messages in one batch.
+    # @param start_time the start time to read.
+    # @param end_time the end time to read.
+    # @param channels the channels to read, all channels if None.
+    #
+    # @return return lists of PyBagMessage(channel, data, data_type, timestamp)
+    def read_message_batches(self, batch_size=1024, start_time=0,
+                             end_time=18446744073709551615, channels=None):
+        while True:
+            data, index, end = _CYBER_RECORD.PyRecordReader_ReadMessages(
+                self.record_reader, batch_size, start_time, end_time,
+                channels)
+            if index:
+                view = memoryview(data)
+                yield [PyBagMessage(channel_name, view[offset:offset + size],
+                                    data_type, timestamp)
+                       for channel_name, data_type, timestamp, offset, size
+                       in index]
+            if end:
+                break
+
     ##
     # @brief Return message count of the channel in current record file.
     #
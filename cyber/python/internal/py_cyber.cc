@@ -229,10 +229,56 @@ PyObject *cyber_PyReader_read(PyObject *self, PyObject *args) {
 
   bool wait = (r == 1);
 
-  const std::string reader_ret = reader->read(wait);
+  // waiting for a message must not block the python threads that produce it
+  std::string reader_ret;
+  Py_BEGIN_ALLOW_THREADS;
+  reader_ret = reader->read(wait);
+  Py_END_ALLOW_THREADS;
   return C_STR_TO_PY_BYTES(reader_ret);
 }
 
+PyObject *cyber_PyReader_read_batch(PyObject *self, PyObject *args) {
+  PyObject *pyobj_reader = nullptr;
+  uint64_t max_num = 0;
+  PyObject *pyobj_iswait = nullptr;
+
+  if (!PyArg_ParseTuple(args,
+                        const_cast<char *>("OKO:cyber_PyReader_read_batch"),
+                        &pyobj_reader, &max_num, &pyobj_iswait)) {
+    AERROR << "cyber_PyReader_read_batch:PyArg_ParseTuple failed!";
+    Py_INCREF(Py_None);
+    return Py_None;
+  }
+  PyReader *reader =
+      PyObjectToPtr<PyReader *>(pyobj_reader, "apollo_cyber_pyreader");
+  if (nullptr == reader) {
+    AERROR << "cyber_PyReader_read_batch:PyReader ptr is null!";
+    Py_INCREF(Py_None);
+    return Py_None;
+  }
+
+  int r = PyObject_IsTrue(pyobj_iswait);
+  if (r == -1) {
+    AERROR << "cyber_PyReader_read_batch:pyobj_iswait is error!";
+    Py_INCREF(Py_None);
+    return Py_None;
+  }
+
+  bool wait = (r == 1);
+
+  std::string buffer;
+  std::vector<size_t> sizes;
+  Py_BEGIN_ALLOW_THREADS;
+  reader->read_batch(max_num, wait, &buffer, &sizes);
+  Py_END_ALLOW_THREADS;
+
+  PyObject *pyobj_sizes = PyList_New(sizes.size());
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    PyList_SetItem(pyobj_sizes, i, PyLong_FromSize_t(sizes[i]));
+  }
+  return Py_BuildValue("(NN)", C_STR_TO_PY_BYTES(buffer), pyobj_sizes);
+}
+
 PyObject *cyber_PyReader_register_func(PyObject *self, PyObject *args) {
   PyObject *pyobj_regist_fun = nullptr;
   PyObject *pyobj_reader = nullptr;
@@ -851,6 +897,7 @@ static PyMethodDef _cyber_methods[] = {
     {"delete_PyReader", cyber_delete_PyReader, METH_VARARGS, ""},
     {"PyReader_register_func", cyber_PyReader_register_func, METH_VARARGS, ""},
     {"PyReader_read", cyber_PyReader_read, METH_VARARGS, ""},
+    {"PyReader_read_batch", cyber_PyReader_read_batch, METH_VARARGS, ""},
 
     // PyClient fun
     {"new_PyClient", cyber_new_PyClient, METH_VARARGS, ""},
@@ -148,6 +148,27 @@ class PyReader {
     return msg;
   }
 
+  /**
+   * @brief Move up to max_num cached messages into buffer back to back, the
+   * size of each one is appended to sizes. Blocks until at least one message
+   * arrives if wait is true.
+   */
+  size_t read_batch(size_t max_num, bool wait, std::string* buffer,
+                    std::vector<size_t>* sizes) {
+    std::unique_lock<std::mutex> ul(msg_lock_);
+    if (wait) {
+      msg_cond_.wait(ul, [this] { return !this->cache_.empty(); });
+    }
+    size_t num = 0;
+    while (num < max_num && !cache_.empty()) {
+      buffer->append(cache_.front());
+      sizes->emplace_back(cache_.front().size());
+      cache_.pop_front();
+      ++num;
+    }
+    return num;
+  }
+
  private:
   void cb(const std::shared_ptr<const message::PyMessageWrap>& message) {
     {
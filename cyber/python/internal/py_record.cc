@@ -23,6 +23,7 @@
 
 #include <Python.h>
 
+namespace record = apollo::cyber::record;
 using apollo::cyber::record::PyRecordReader;
 using apollo::cyber::record::PyRecordWriter;
 
@@ -91,7 +92,10 @@ PyObject *cyber_PyRecordReader_ReadMessage(PyObject *self, PyObject *args) {
     return nullptr;
   }
 
-  const auto result = reader->ReadMessage(begin_time, end_time);
+  record::BagMessage result;
+  Py_BEGIN_ALLOW_THREADS;
+  result = reader->ReadMessage(begin_time, end_time);
+  Py_END_ALLOW_THREADS;
   PyObject *pyobj_bag_message = PyDict_New();
 
   PyObject *bld_name = Py_BuildValue("s", result.channel_name.c_str());
@@ -122,6 +126,66 @@ PyObject *cyber_PyRecordReader_ReadMessage(PyObject *self, PyObject *args) {
   return pyobj_bag_message;
 }
 
+PyObject *cyber_PyRecordReader_ReadMessages(PyObject *self, PyObject *args) {
+  PyObject *pyobj_reader = nullptr;
+  uint64_t max_num = 0;
+  uint64_t begin_time = 0;
+  uint64_t end_time = std::numeric_limits<uint64_t>::max();
+  PyObject *pyobj_channels = nullptr;
+  if (!PyArg_ParseTuple(args,
+                        const_cast<char *>("OKKKO:PyRecordReader_ReadMessages"),
+                        &pyobj_reader, &max_num, &begin_time, &end_time,
+                        &pyobj_channels)) {
+    return nullptr;
+  }
+
+  auto *reader = reinterpret_cast<PyRecordReader *>(PyCapsule_GetPointer(
+      pyobj_reader, "apollo_cyber_record_pyrecordfilereader"));
+  if (nullptr == reader) {
+    AERROR << "PyRecordReader_ReadMessages ptr is null!";
+    return nullptr;
+  }
+
+  std::set<std::string> channels;
+  if (pyobj_channels != Py_None) {
+    PyObject *pyobj_iter = PyObject_GetIter(pyobj_channels);
+    if (pyobj_iter == nullptr) {
+      AERROR << "PyRecordReader_ReadMessages: channels is not iterable!";
+      return nullptr;
+    }
+    while (PyObject *pyobj_channel = PyIter_Next(pyobj_iter)) {
+      const char *channel = PyUnicode_AsUTF8(pyobj_channel);
+      if (channel != nullptr) {
+        channels.emplace(channel);
+      }
+      Py_DECREF(pyobj_channel);
+    }
+    Py_DECREF(pyobj_iter);
+    if (PyErr_Occurred()) {
+      return nullptr;
+    }
+  }
+
+  // reading and decompressing chunks does not touch python objects
+  record::BagMessageBatch batch;
+  Py_BEGIN_ALLOW_THREADS;
+  batch = reader->ReadMessages(max_num, begin_time, end_time, channels);
+  Py_END_ALLOW_THREADS;
+
+  PyObject *pyobj_data = C_STR_TO_PY_BYTES(batch.data);
+  PyObject *pyobj_index = PyList_New(batch.messages.size());
+  size_t pos = 0;
+  for (const auto &msg : batch.messages) {
+    PyList_SetItem(pyobj_index, pos++,
+                   Py_BuildValue("(ssKnn)", msg.channel_name.c_str(),
+                                 msg.data_type.c_str(), msg.timestamp,
+                                 static_cast<Py_ssize_t>(msg.offset),
+                                 static_cast<Py_ssize_t>(msg.size)));
+  }
+  return Py_BuildValue("(NNO)", pyobj_data, pyobj_index,
+                       batch.end ? Py_True : Py_False);
+}
+
 PyObject *cyber_PyRecordReader_GetMessageNumber(PyObject *self,
                                                 PyObject *args) {
   PyObject *pyobj_reader = nullptr;
@@ -524,6 +588,8 @@ static PyMethodDef _cyber_record_methods[] = {
     {"delete_PyRecordReader", cyber_delete_PyRecordReader, METH_VARARGS, ""},
     {"PyRecordReader_ReadMessage", cyber_PyRecordReader_ReadMessage,
      METH_VARARGS, ""},
+    {"PyRecordReader_ReadMessages", cyber_PyRecordReader_ReadMessages,
+     METH_VARARGS, ""},
     {"PyRecordReader_GetMessageNumber", cyber_PyRecordReader_GetMessageNumber,
      METH_VARARGS, ""},
     {"PyRecordReader_GetMessageType", cyber_PyRecordReader_GetMessageType,
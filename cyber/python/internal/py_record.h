@@ -26,6 +26,7 @@
 #include <set>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "cyber/message/protobuf_factory.h"
 #include "cyber/message/py_message.h"
@@ -47,6 +48,22 @@ struct BagMessage {
   bool end = true;
 };
 
+// Index of one message inside BagMessageBatch::data.
+struct BagMessageIndex {
+  uint64_t timestamp = 0;
+  std::string channel_name = "";
+  std::string data_type = "";
+  size_t offset = 0;
+  size_t size = 0;
+};
+
+// Messages read in one call, their payloads are packed back to back in data.
+struct BagMessageBatch {
+  std::string data = "";
+  std::vector<BagMessageIndex> messages;
+  bool end = true;
+};
+
 class PyRecordReader {
  public:
   explicit PyRecordReader(const std::string& file) {
@@ -56,6 +73,7 @@ class PyRecordReader {
   BagMessage ReadMessage(
       uint64_t begin_time = 0,
       uint64_t end_time = std::numeric_limits<uint64_t>::max()) {
+    std::lock_guard<std::mutex> lg(reader_mutex_);
     BagMessage ret_msg;
     RecordMessage record_message;
     if (!record_reader_->ReadMessage(&record_message, begin_time, end_time)) {
@@ -72,6 +90,42 @@ class PyRecordReader {
     return ret_msg;
   }
 
+  /**
+   * @brief Read up to max_num messages into one batch, only messages of
+   * channels are kept unless channels is empty. The reader is locked but the
+   * caller does not need the GIL, so python bindings release it around this.
+   */
+  BagMessageBatch ReadMessages(
+      size_t max_num, uint64_t begin_time = 0,
+      uint64_t end_time = std::numeric_limits<uint64_t>::max(),
+      const std::set<std::string>& channels = std::set<std::string>()) {
+    std::lock_guard<std::mutex> lg(reader_mutex_);
+    BagMessageBatch batch;
+    batch.end = false;
+    batch.messages.reserve(max_num);
+    RecordMessage record_message;
+    while (batch.messages.size() < max_num) {
+      if (!record_reader_->ReadMessage(&record_message, begin_time,
+                                       end_time)) {
+        batch.end = true;
+        break;
+      }
+      if (!channels.empty() &&
+          channels.count(record_message.channel_name) == 0) {
+        continue;
+      }
+      BagMessageIndex index;
+      index.timestamp = record_message.time;
+      index.offset = batch.data.size();
+      index.size = record_message.content.size();
+      index.channel_name = std::move(record_message.channel_name);
+      index.data_type = record_reader_->GetMessageType(index.channel_name);
+      batch.data.append(record_message.content);
+      batch.messages.emplace_back(std::move(index));
+    }
+    return batch;
+  }
+
   uint64_t GetMessageNumber(const std::string& channel_name) {
     return record_reader_->GetMessageNumber(channel_name);
   }
@@ -90,7 +144,10 @@ class PyRecordReader {
     return org_data;
   }
 
-  void Reset() { record_reader_->Reset(); }
+  void Reset() {
+    std::lock_guard<std::mutex> lg(reader_mutex_);
+    record_reader_->Reset();
+  }
 
   std::set<std::string> GetChannelList() const {
     return record_reader_->GetChannelList();
@@ -98,6 +155,7 @@ class PyRecordReader {
 
  private:
   std::unique_ptr<RecordReader> record_reader_;
+  std::mutex reader_mutex_;
 };
 
 class PyRecordWriter {
@@ -16,6 +16,7 @@
 
 #include "cyber/python/internal/py_record.h"
 
+#include <limits>
 #include <set>
 #include <string>
 #include "gtest/gtest.h"
@@ -75,5 +76,43 @@ TEST(CyberRecordTest, record_readerwriter) {
   EXPECT_TRUE(header.is_complete());
 }
 
+TEST(CyberRecordTest, record_read_messages) {
+  record::PyRecordWriter rec_writer;
+  rec_writer.SetSizeOfFileSegmentation(0);
+  rec_writer.SetIntervalOfFileSegmentation(0);
+
+  EXPECT_TRUE(rec_writer.Open(TEST_RECORD_FILE));
+  rec_writer.WriteChannel(CHAN_1, MSG_TYPE, PROTO_DESC);
+  rec_writer.WriteChannel(CHAN_2, MSG_TYPE, PROTO_DESC);
+  for (uint64_t i = 0; i < 5; ++i) {
+    rec_writer.WriteMessage(CHAN_1, std::to_string(i), 1000 + i * 2);
+    rec_writer.WriteMessage(CHAN_2, MSG_DATA, 1001 + i * 2);
+  }
+  rec_writer.Close();
+
+  record::PyRecordReader rec_reader(TEST_RECORD_FILE);
+  record::BagMessageBatch batch = rec_reader.ReadMessages(4);
+  EXPECT_FALSE(batch.end);
+  ASSERT_EQ(4, batch.messages.size());
+  EXPECT_EQ(CHAN_1, batch.messages[0].channel_name);
+  EXPECT_EQ(MSG_TYPE, batch.messages[0].data_type);
+  EXPECT_EQ(1000, batch.messages[0].timestamp);
+  EXPECT_EQ(CHAN_2, batch.messages[1].channel_name);
+  EXPECT_EQ(MSG_DATA, batch.data.substr(batch.messages[1].offset,
+                                        batch.messages[1].size));
+  EXPECT_EQ("1", batch.data.substr(batch.messages[2].offset,
+                                   batch.messages[2].size));
+
+  rec_reader.Reset();
+  batch = rec_reader.ReadMessages(100, 0, std::numeric_limits<uint64_t>::max(),
+                                  {CHAN_1});
+  EXPECT_TRUE(batch.end);
+  ASSERT_EQ(5, batch.messages.size());
+  EXPECT_EQ("01234", batch.data);
+  for (const auto& msg : batch.messages) {
+    EXPECT_EQ(CHAN_1, msg.channel_name);
+  }
+}
+
 }  // namespace cyber
 }  // namespace apollo
@@ -38,10 +38,17 @@ void SubscriberListener::onNewDataMessage(eprosima::fastrtps::Subscriber* sub) {
   std::lock_guard<std::mutex> lock(mutex_);
   eprosima::fastrtps::SampleInfo_t m_info;
   cyber::transport::UnderlayMessage m;
-  RETURN_IF(!sub->takeNextData(reinterpret_cast<void*>(&m), &m_info));
-  RETURN_IF(m_info.sampleKind != eprosima::fastrtps::ALIVE);
-
-  callback_(m.data());
+  // take every sample queued so far, so that a burst of changes, e.g. when
+  // many processes start at once, is handled as one batch
+  std::vector<std::string> msgs;
+  while (sub->takeNextData(reinterpret_cast<void*>(&m), &m_info)) {
+    if (m_info.sampleKind == eprosima::fastrtps::ALIVE) {
+      msgs.emplace_back(m.data());
+    }
+  }
+  RETURN_IF(msgs.empty());
+
+  callback_(msgs);
 }
 
 void SubscriberListener::onSubscriptionMatched(
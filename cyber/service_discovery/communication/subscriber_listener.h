@@ -20,6 +20,7 @@
 #include <functional>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "fastrtps/Domain.h"
 #include "fastrtps/subscriber/SampleInfo.h"
@@ -32,7 +33,8 @@ namespace service_discovery {
 
 class SubscriberListener : public eprosima::fastrtps::SubscriberListener {
  public:
-  using NewMsgCallback = std::function<void(const std::string&)>;
+  // called with all the messages available when new data arrives
+  using NewMsgCallback = std::function<void(const std::vector<std::string>&)>;
 
   explicit SubscriberListener(const NewMsgCallback& callback);
   virtual ~SubscriberListener();
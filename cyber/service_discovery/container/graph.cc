@@ -17,6 +17,7 @@
 #include "cyber/service_discovery/container/graph.h"
 
 #include <queue>
+#include <utility>
 
 namespace apollo {
 namespace cyber {
@@ -102,6 +103,7 @@ void Graph::Insert(const Edge& e) {
     return;
   }
   WriteLockGuard<AtomicRWLock> lock(rw_lock_);
+  ClearReachable();
   auto& e_v = e.value();
   if (edges_.find(e_v) == edges_.end()) {
     edges_[e_v] = RelatedVertices();
@@ -124,6 +126,7 @@ void Graph::Delete(const Edge& e) {
   if (edges_.find(e_v) == edges_.end()) {
     return;
   }
+  ClearReachable();
 
   if (!e.src().IsDummy()) {
     DeleteOutgoingEdge(e);
@@ -150,10 +153,10 @@ FlowDirection Graph::GetDirectionOf(const Vertice& lhs, const Vertice& rhs) {
   if (list_.count(lhs.GetKey()) == 0 || list_.count(rhs.GetKey()) == 0) {
     return UNREACHABLE;
   }
-  if (LevelTraverse(lhs, rhs)) {
+  if (IsReachable(lhs, rhs)) {
     return UPSTREAM;
   }
-  if (LevelTraverse(rhs, lhs)) {
+  if (IsReachable(rhs, lhs)) {
     return DOWNSTREAM;
   }
   return UNREACHABLE;
@@ -256,26 +259,50 @@ void Graph::DeleteCompleteEdge(const Edge& e) {
   list_[src_v_k].erase(e.GetKey());
 }
 
-bool Graph::LevelTraverse(const Vertice& start, const Vertice& end) {
-  std::unordered_map<std::string, bool> visited;
-  visited[end.GetKey()] = false;
-  std::queue<Vertice> unvisited;
-  unvisited.emplace(start);
+void Graph::ClearReachable() {
+  std::lock_guard<std::mutex> lock(reachable_mutex_);
+  reachable_.clear();
+}
+
+bool Graph::IsReachable(const Vertice& start, const Vertice& end) {
+  // only called with the read lock held, the cached sets stay valid until an
+  // edge is inserted or deleted under the write lock
+  {
+    std::lock_guard<std::mutex> lock(reachable_mutex_);
+    auto search = reachable_.find(start.GetKey());
+    if (search != reachable_.end()) {
+      return search->second.count(end.GetKey()) > 0;
+    }
+  }
+  VerticeKeySet reachable;
+  LevelTraverse(start, &reachable);
+  bool result = reachable.count(end.GetKey()) > 0;
+  std::lock_guard<std::mutex> lock(reachable_mutex_);
+  reachable_.emplace(start.GetKey(), std::move(reachable));
+  return result;
+}
+
+void Graph::LevelTraverse(const Vertice& start, VerticeKeySet* reachable) {
+  // only called with the read lock held, so the adjacency list must not be
+  // modified here, i.e. no operator[] on list_
+  std::queue<const Vertice*> unvisited;
+  unvisited.emplace(&start);
   while (!unvisited.empty()) {
     auto curr = unvisited.front();
     unvisited.pop();
-    if (visited[curr.GetKey()]) {
+    if (!reachable->emplace(curr->GetKey()).second) {
       continue;
     }
-    visited[curr.GetKey()] = true;
-    if (curr == end) {
-      break;
+    auto search = list_.find(curr->GetKey());
+    if (search == list_.end()) {
+      continue;
     }
-    for (auto& item : list_[curr.GetKey()]) {
-      unvisited.push(item.second);
+    for (auto& item : search->second) {
+      if (reachable->count(item.second.GetKey()) == 0) {
+        unvisited.push(&item.second);
+      }
     }
   }
-  return visited[end.GetKey()];
 }
 
 }  // namespace service_discovery
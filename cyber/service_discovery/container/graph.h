@@ -18,8 +18,10 @@
 #define CYBER_SERVICE_DISCOVERY_CONTAINER_GRAPH_H_
 
 #include <cstdint>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "cyber/base/atomic_rw_lock.h"
 
@@ -112,6 +114,9 @@ class Graph {
     VerticeSet dst;
   };
   using EdgeInfo = std::unordered_map<std::string, RelatedVertices>;
+  using VerticeKeySet = std::unordered_set<std::string>;
+  // key: vertice key, value: keys of the vertices reachable from it
+  using ReachableMap = std::unordered_map<std::string, VerticeKeySet>;
 
   void InsertOutgoingEdge(const Edge& e);
   void InsertIncomingEdge(const Edge& e);
@@ -119,11 +124,18 @@ class Graph {
   void DeleteOutgoingEdge(const Edge& e);
   void DeleteIncomingEdge(const Edge& e);
   void DeleteCompleteEdge(const Edge& e);
-  bool LevelTraverse(const Vertice& start, const Vertice& end);
+  void ClearReachable();
+  void LevelTraverse(const Vertice& start, VerticeKeySet* reachable);
+  bool IsReachable(const Vertice& start, const Vertice& end);
 
   EdgeInfo edges_;
   AdjacencyList list_;
   base::AtomicRWLock rw_lock_;
+
+  // filled lazily by GetDirectionOf, so that repeated queries do not
+  // traverse the graph again, and cleared whenever an edge changes
+  ReachableMap reachable_;
+  std::mutex reachable_mutex_;
 };
 
 }  // namespace service_discovery
@@ -205,6 +205,30 @@ TEST(GraphTest, graph) {
   g.Delete(qa);
 }
 
+TEST(GraphTest, direction_after_change) {
+  Graph g;
+  Vertice a("a");
+  Vertice b("b");
+  Vertice c("c");
+
+  g.Insert(Edge(a, b, "ab"));
+  Edge cd(c, Vertice("d"), "cd");
+  g.Insert(cd);
+  EXPECT_EQ(g.GetDirectionOf(a, c), UNREACHABLE);
+  EXPECT_EQ(g.GetDirectionOf(c, a), UNREACHABLE);
+
+  // the directions queried above must not be kept once the graph changes
+  Edge bc(b, c, "bc");
+  g.Insert(bc);
+  EXPECT_EQ(g.GetDirectionOf(a, c), UPSTREAM);
+  EXPECT_EQ(g.GetDirectionOf(c, a), DOWNSTREAM);
+  EXPECT_EQ(g.GetDirectionOf(a, c), UPSTREAM);
+
+  g.Delete(bc);
+  EXPECT_EQ(g.GetDirectionOf(a, c), UNREACHABLE);
+  EXPECT_EQ(g.GetDirectionOf(c, a), UNREACHABLE);
+}
+
 }  // namespace service_discovery
 }  // namespace cyber
 }  // namespace apollo
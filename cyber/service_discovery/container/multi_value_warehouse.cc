@@ -17,6 +17,7 @@
 #include "cyber/service_discovery/container/multi_value_warehouse.h"
 
 #include <algorithm>
+#include <string>
 #include <utility>
 
 #include "cyber/common/log.h"
@@ -40,12 +41,14 @@ bool MultiValueWarehouse::Add(uint64_t key, const RolePtr& role,
   }
   std::pair<uint64_t, RolePtr> role_pair(key, role);
   roles_.insert(role_pair);
+  AddToIndex(key, role);
   return true;
 }
 
 void MultiValueWarehouse::Clear() {
   WriteLockGuard<AtomicRWLock> lock(rw_lock_);
   roles_.clear();
+  process_index_.clear();
 }
 
 std::size_t MultiValueWarehouse::Size() {
@@ -55,6 +58,10 @@ std::size_t MultiValueWarehouse::Size() {
 
 void MultiValueWarehouse::Remove(uint64_t key) {
   WriteLockGuard<AtomicRWLock> lock(rw_lock_);
+  auto range = roles_.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    RemoveFromIndex(key, it->second);
+  }
   roles_.erase(key);
 }
 
@@ -63,6 +70,7 @@ void MultiValueWarehouse::Remove(uint64_t key, const RolePtr& role) {
   auto range = roles_.equal_range(key);
   for (auto it = range.first; it != range.second;) {
     if (it->second->Match(role->attributes())) {
+      RemoveFromIndex(key, it->second);
       it = roles_.erase(it);
     } else {
       ++it;
@@ -72,14 +80,35 @@ void MultiValueWarehouse::Remove(uint64_t key, const RolePtr& role) {
 
 void MultiValueWarehouse::Remove(const RoleAttributes& target_attr) {
   WriteLockGuard<AtomicRWLock> lock(rw_lock_);
-  for (auto it = roles_.begin(); it != roles_.end();) {
-    auto curr_role = it->second;
-    if (curr_role->Match(target_attr)) {
-      it = roles_.erase(it);
+  if (!HasProcessKey(target_attr)) {
+    for (auto it = roles_.begin(); it != roles_.end();) {
+      auto curr_role = it->second;
+      if (curr_role->Match(target_attr)) {
+        RemoveFromIndex(it->first, curr_role);
+        it = roles_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    return;
+  }
+
+  auto search = process_index_.find(ProcessKey(target_attr));
+  if (search == process_index_.end()) {
+    return;
+  }
+  auto& process_roles = search->second;
+  for (auto it = process_roles.begin(); it != process_roles.end();) {
+    if (it->second->Match(target_attr)) {
+      RemoveFromRoles(it->first, it->second);
+      it = process_roles.erase(it);
     } else {
       ++it;
     }
   }
+  if (process_roles.empty()) {
+    process_index_.erase(search);
+  }
 }
 
 bool MultiValueWarehouse::Search(uint64_t key) {
@@ -146,7 +175,9 @@ bool MultiValueWarehouse::Search(const RoleAttributes& target_attr,
                                  RolePtr* first_matched_role) {
   RETURN_VAL_IF_NULL(first_matched_role, false);
   ReadLockGuard<AtomicRWLock> lock(rw_lock_);
-  for (auto& item : roles_) {
+  auto candidates = Candidates(target_attr);
+  RETURN_VAL_IF_NULL2(candidates, false);
+  for (auto& item : *candidates) {
     if (item.second->Match(target_attr)) {
       *first_matched_role = item.second;
       return true;
@@ -171,7 +202,9 @@ bool MultiValueWarehouse::Search(const RoleAttributes& target_attr,
   RETURN_VAL_IF_NULL(matched_roles, false);
   bool find = false;
   ReadLockGuard<AtomicRWLock> lock(rw_lock_);
-  for (auto& item : roles_) {
+  auto candidates = Candidates(target_attr);
+  RETURN_VAL_IF_NULL2(candidates, false);
+  for (auto& item : *candidates) {
     if (item.second->Match(target_attr)) {
       matched_roles->emplace_back(item.second);
       find = true;
@@ -186,7 +219,9 @@ bool MultiValueWarehouse::Search(
   RETURN_VAL_IF_NULL(matched_roles_attr, false);
   bool find = false;
   ReadLockGuard<AtomicRWLock> lock(rw_lock_);
-  for (auto& item : roles_) {
+  auto candidates = Candidates(target_attr);
+  RETURN_VAL_IF_NULL2(candidates, false);
+  for (auto& item : *candidates) {
     if (item.second->Match(target_attr)) {
       matched_roles_attr->emplace_back(item.second->attributes());
       find = true;
@@ -211,6 +246,58 @@ void MultiValueWarehouse::GetAllRoles(std::vector<RoleAttributes>* roles_attr) {
   }
 }
 
+std::string MultiValueWarehouse::ProcessKey(const RoleAttributes& attr) {
+  return attr.host_name() + "+" + std::to_string(attr.process_id());
+}
+
+bool MultiValueWarehouse::HasProcessKey(const RoleAttributes& attr) {
+  return attr.has_host_name() && attr.has_process_id();
+}
+
+void MultiValueWarehouse::AddToIndex(uint64_t key, const RolePtr& role) {
+  process_index_[ProcessKey(role->attributes())].emplace(key, role);
+}
+
+void MultiValueWarehouse::RemoveFromIndex(uint64_t key, const RolePtr& role) {
+  auto search = process_index_.find(ProcessKey(role->attributes()));
+  if (search == process_index_.end()) {
+    return;
+  }
+  auto& process_roles = search->second;
+  auto range = process_roles.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == role) {
+      process_roles.erase(it);
+      break;
+    }
+  }
+  if (process_roles.empty()) {
+    process_index_.erase(search);
+  }
+}
+
+void MultiValueWarehouse::RemoveFromRoles(uint64_t key, const RolePtr& role) {
+  auto range = roles_.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == role) {
+      roles_.erase(it);
+      break;
+    }
+  }
+}
+
+const MultiValueWarehouse::RoleMap* MultiValueWarehouse::Candidates(
+    const RoleAttributes& target_attr) const {
+  if (!HasProcessKey(target_attr)) {
+    return &roles_;
+  }
+  auto search = process_index_.find(ProcessKey(target_attr));
+  if (search == process_index_.end()) {
+    return nullptr;
+  }
+  return &search->second;
+}
+
 }  // namespace service_discovery
 }  // namespace cyber
 }  // namespace apollo
@@ -18,6 +18,7 @@
 #define CYBER_SERVICE_DISCOVERY_CONTAINER_MULTI_VALUE_WAREHOUSE_H_
 
 #include <cstdint>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -67,7 +68,24 @@ class MultiValueWarehouse : public WarehouseBase {
   void GetAllRoles(std::vector<proto::RoleAttributes>* roles_attr) override;
 
  private:
+  // roles grouped by the process they belong to, so that the lookups done
+  // when a whole process joins or leaves the topology do not scan every role
+  // key: host_name + process_id
+  using ProcessIndex = std::unordered_map<std::string, RoleMap>;
+
+  static std::string ProcessKey(const proto::RoleAttributes& attr);
+  static bool HasProcessKey(const proto::RoleAttributes& attr);
+
+  void AddToIndex(uint64_t key, const RolePtr& role);
+  void RemoveFromIndex(uint64_t key, const RolePtr& role);
+  void RemoveFromRoles(uint64_t key, const RolePtr& role);
+
+  // the candidates a target_attr can match, all roles when the target does
+  // not specify a process
+  const RoleMap* Candidates(const proto::RoleAttributes& target_attr) const;
+
   RoleMap roles_;
+  ProcessIndex process_index_;
   base::AtomicRWLock rw_lock_;
 };
 
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 #include "gtest/gtest.h"
 
 namespace apollo {
@@ -232,6 +233,70 @@ TEST(MultiValueWarehouseTest, test1) {
   }
 }
 
+TEST(MultiValueWarehouseTest, process_index) {
+  MultiValueWarehouse wh;
+  RoleAttributes attr;
+  for (int process_id = 0; process_id < 4; ++process_id) {
+    attr.set_host_name("caros");
+    attr.set_process_id(process_id);
+    for (int channel_id = 0; channel_id < 3; ++channel_id) {
+      attr.set_channel_id(channel_id);
+      attr.set_id(process_id * 10 + channel_id);
+      EXPECT_TRUE(wh.Add(channel_id, std::make_shared<RoleWriter>(attr)));
+    }
+  }
+  EXPECT_EQ(wh.Size(), 12);
+
+  RoleAttributes target;
+  target.set_host_name("caros");
+  target.set_process_id(2);
+  std::vector<RolePtr> roles;
+  EXPECT_TRUE(wh.Search(target, &roles));
+  EXPECT_EQ(roles.size(), 3);
+  for (auto& role : roles) {
+    EXPECT_EQ(role->attributes().process_id(), 2);
+  }
+
+  target.set_host_name("other");
+  EXPECT_FALSE(wh.Search(target));
+  wh.Remove(target);
+  EXPECT_EQ(wh.Size(), 12);
+
+  // a key based remove has to keep the process index consistent
+  target.set_host_name("caros");
+  wh.Remove(1);
+  EXPECT_EQ(wh.Size(), 8);
+  roles.clear();
+  EXPECT_TRUE(wh.Search(target, &roles));
+  EXPECT_EQ(roles.size(), 2);
+
+  target.set_channel_id(2);
+  roles.clear();
+  EXPECT_TRUE(wh.Search(target, &roles));
+  EXPECT_EQ(roles.size(), 1);
+
+  target.clear_channel_id();
+  wh.Remove(target);
+  EXPECT_EQ(wh.Size(), 6);
+  EXPECT_FALSE(wh.Search(target));
+
+  std::vector<RoleAttributes> roles_attr;
+  EXPECT_TRUE(wh.Search(0, &roles_attr));
+  EXPECT_EQ(roles_attr.size(), 3);
+
+  // targets without a process fall back to matching every role
+  RoleAttributes host_only;
+  host_only.set_host_name("caros");
+  roles.clear();
+  EXPECT_TRUE(wh.Search(host_only, &roles));
+  EXPECT_EQ(roles.size(), 6);
+  wh.Remove(host_only);
+  EXPECT_EQ(wh.Size(), 0);
+
+  target.set_process_id(3);
+  EXPECT_FALSE(wh.Search(target));
+}
+
 }  // namespace service_discovery
 }  // namespace cyber
 }  // namespace apollo
@@ -41,7 +41,26 @@ ChannelManager::ChannelManager() {
   exempted_msg_types_.emplace(message::MessageType<message::PyMessageWrap>());
 }
 
-ChannelManager::~ChannelManager() {}
+ChannelManager::~ChannelManager() { Shutdown(); }
+
+void ChannelManager::Shutdown() {
+  Manager::Shutdown();
+  std::lock_guard<std::mutex> lock(channel_signals_mutex_);
+  for (auto& item : channel_signals_) {
+    item.second->DisconnectAllSlots();
+  }
+}
+
+ChannelManager::ChangeConnection ChannelManager::AddChangeListener(
+    const std::string& channel_name, const ChangeFunc& func) {
+  uint64_t key = common::GlobalData::RegisterChannel(channel_name);
+  std::lock_guard<std::mutex> lock(channel_signals_mutex_);
+  auto& signal = channel_signals_[key];
+  if (signal == nullptr) {
+    signal = std::make_shared<ChangeSignal>();
+  }
+  return signal->Connect(func);
+}
 
 void ChannelManager::GetChannelNames(std::vector<std::string>* channels) {
   RETURN_IF_NULL(channels);
@@ -138,66 +157,47 @@ void ChannelManager::GetReadersOfChannel(const std::string& channel_name,
 void ChannelManager::GetUpstreamOfNode(const std::string& node_name,
                                        RoleAttrVec* upstream_nodes) {
   RETURN_IF_NULL(upstream_nodes);
-
-  RoleAttrVec readers;
-  GetReadersOfNode(node_name, &readers);
-  if (readers.empty()) {
-    return;
-  }
-  std::unordered_set<std::string> channels;
-  for (auto& reader : readers) {
-    channels.emplace(reader.channel_name());
-  }
-
-  RoleAttrVec writers;
-  for (auto& channel : channels) {
-    GetWritersOfChannel(channel, &writers);
-  }
-
-  std::unordered_map<std::string, proto::RoleAttributes> nodes;
-  for (auto& writer : writers) {
-    proto::RoleAttributes attr;
-    attr.set_host_name(writer.host_name());
-    attr.set_process_id(writer.process_id());
-    attr.set_node_name(writer.node_name());
-    attr.set_node_id(writer.node_id());
-    nodes[attr.node_name()] = attr;
-  }
-  for (auto& item : nodes) {
-    upstream_nodes->emplace_back(item.second);
-  }
+  uint64_t key = common::GlobalData::RegisterNode(node_name);
+  GetPeerNodes(key, &node_readers_, &channel_writers_, upstream_nodes);
 }
 
 void ChannelManager::GetDownstreamOfNode(const std::string& node_name,
                                          RoleAttrVec* downstream_nodes) {
   RETURN_IF_NULL(downstream_nodes);
+  uint64_t key = common::GlobalData::RegisterNode(node_name);
+  GetPeerNodes(key, &node_writers_, &channel_readers_, downstream_nodes);
+}
 
-  RoleAttrVec writers;
-  GetWritersOfNode(node_name, &writers);
-  if (writers.empty()) {
+void ChannelManager::GetPeerNodes(uint64_t node_id,
+                                  MultiValueWarehouse* node_roles,
+                                  MultiValueWarehouse* channel_peers,
+                                  RoleAttrVec* peer_nodes) {
+  // both steps are lookups by id in the warehouses, and only the roles are
+  // shared, the attributes (with their proto_desc) are not copied
+  std::vector<RolePtr> roles;
+  if (!node_roles->Search(node_id, &roles)) {
     return;
   }
-  std::unordered_set<std::string> channels;
-  for (auto& writer : writers) {
-    channels.emplace(writer.channel_name());
-  }
-
-  RoleAttrVec readers;
-  for (auto& channel : channels) {
-    GetReadersOfChannel(channel, &readers);
+  std::unordered_set<uint64_t> channels;
+  std::vector<RolePtr> peers;
+  for (auto& role : roles) {
+    if (channels.emplace(role->attributes().channel_id()).second) {
+      channel_peers->Search(role->attributes().channel_id(), &peers);
+    }
   }
 
   std::unordered_map<std::string, proto::RoleAttributes> nodes;
-  for (auto& reader : readers) {
+  for (auto& peer : peers) {
+    auto& peer_attr = peer->attributes();
     proto::RoleAttributes attr;
-    attr.set_host_name(reader.host_name());
-    attr.set_process_id(reader.process_id());
-    attr.set_node_name(reader.node_name());
-    attr.set_node_id(reader.node_id());
+    attr.set_host_name(peer_attr.host_name());
+    attr.set_process_id(peer_attr.process_id());
+    attr.set_node_name(peer_attr.node_name());
+    attr.set_node_id(peer_attr.node_id());
     nodes[attr.node_name()] = attr;
   }
   for (auto& item : nodes) {
-    downstream_nodes->emplace_back(item.second);
+    peer_nodes->emplace_back(item.second);
   }
 }
 
@@ -236,6 +236,7 @@ void ChannelManager::Dispose(const ChangeMsg& msg) {
     DisposeLeave(msg);
   }
   Notify(msg);
+  NotifyChannel(msg);
 }
 
 void ChannelManager::OnTopoModuleLeave(const std::string& host_name,
@@ -253,11 +254,13 @@ void ChannelManager::OnTopoModuleLeave(const std::string& host_name,
   channel_readers_.Search(attr, &readers_to_remove);
 
   ChangeMsg msg;
+  BeginBatch();
   for (auto& writer : writers_to_remove) {
     Convert(writer->attributes(), RoleType::ROLE_WRITER, OperateType::OPT_LEAVE,
             &msg);
     DisposeLeave(msg);
     Notify(msg);
+    NotifyChannel(msg);
   }
 
   for (auto& reader : readers_to_remove) {
@@ -265,7 +268,9 @@ void ChannelManager::OnTopoModuleLeave(const std::string& host_name,
             &msg);
     DisposeLeave(msg);
     Notify(msg);
+    NotifyChannel(msg);
   }
+  EndBatch();
 }
 
 void ChannelManager::DisposeJoin(const ChangeMsg& msg) {
@@ -311,6 +316,19 @@ void ChannelManager::DisposeLeave(const ChangeMsg& msg) {
   node_graph_.Delete(e);
 }
 
+void ChannelManager::NotifyChannel(const ChangeMsg& msg) {
+  std::shared_ptr<ChangeSignal> signal = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(channel_signals_mutex_);
+    auto search = channel_signals_.find(msg.role_attr().channel_id());
+    if (search == channel_signals_.end()) {
+      return;
+    }
+    signal = search->second;
+  }
+  (*signal)(msg);
+}
+
 void ChannelManager::ScanMessageType(const ChangeMsg& msg) {
   uint64_t key = msg.role_attr().channel_id();
   std::string role_type("reader");
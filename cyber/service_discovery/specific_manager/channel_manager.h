@@ -18,6 +18,7 @@
 #define CYBER_SERVICE_DISCOVERY_SPECIFIC_MANAGER_CHANNEL_MANAGER_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -58,6 +59,27 @@ class ChannelManager : public Manager {
    */
   virtual ~ChannelManager();
 
+  using Manager::AddChangeListener;
+
+  /**
+   * @brief Add topology change listener that is only called for changes of
+   * roles on `channel_name`. Readers and writers only care about their own
+   * channel, so they do not have to be woken up by every change in the
+   * topology.
+   *
+   * @param channel_name the channel we want to listen on
+   * @param func the callback function
+   * @return ChangeConnection Store it to use when you want to stop listening,
+   * `RemoveChangeListener` disconnects it like any other connection.
+   */
+  ChangeConnection AddChangeListener(const std::string& channel_name,
+                                     const ChangeFunc& func);
+
+  /**
+   * @brief Shutdown module
+   */
+  void Shutdown() override;
+
   /**
    * @brief Get all channel names in the topology
    *
@@ -199,10 +221,21 @@ class ChannelManager : public Manager {
   void DisposeJoin(const ChangeMsg& msg);
   void DisposeLeave(const ChangeMsg& msg);
 
+  // the nodes with a role in `channel_peers` on a channel of the roles of
+  // `node_id` in `node_roles`
+  void GetPeerNodes(uint64_t node_id, MultiValueWarehouse* node_roles,
+                    MultiValueWarehouse* channel_peers,
+                    RoleAttrVec* peer_nodes);
+
   void ScanMessageType(const ChangeMsg& msg);
+  void NotifyChannel(const ChangeMsg& msg);
 
   ExemptedMessageTypes exempted_msg_types_;
 
+  // key: channel_id
+  std::unordered_map<uint64_t, std::shared_ptr<ChangeSignal>> channel_signals_;
+  std::mutex channel_signals_mutex_;
+
   Graph node_graph_;
   // key: node_id
   WriterWarehouse node_writers_;
@@ -271,6 +271,113 @@ TEST_F(ChannelManagerTest, change) {
   EXPECT_TRUE(channel_manager_.HasWriter("channel_0"));
 }
 
+TEST_F(ChannelManagerTest, channel_change_listener) {
+  int all_changes = 0;
+  int wasd_changes = 0;
+  int other_changes = 0;
+  auto all_conn = channel_manager_.AddChangeListener(
+      [&all_changes](const ChangeMsg& msg) {
+        (void)msg;
+        ++all_changes;
+      });
+  auto wasd_conn = channel_manager_.AddChangeListener(
+      "wasd", [&wasd_changes](const ChangeMsg& msg) {
+        EXPECT_EQ(msg.role_attr().channel_name(), "wasd");
+        ++wasd_changes;
+      });
+  auto other_conn = channel_manager_.AddChangeListener(
+      "channel_0", [&other_changes](const ChangeMsg& msg) {
+        (void)msg;
+        ++other_changes;
+      });
+
+  RoleAttributes role_attr;
+  role_attr.set_host_name(common::GlobalData::Instance()->HostName());
+  role_attr.set_process_id(common::GlobalData::Instance()->ProcessId());
+  role_attr.set_node_name("channel_change_listener");
+  role_attr.set_node_id(
+      common::GlobalData::RegisterNode("channel_change_listener"));
+  role_attr.set_channel_name("wasd");
+  role_attr.set_channel_id(
+      common::GlobalData::Instance()->RegisterChannel("wasd"));
+  transport::Identity id;
+  role_attr.set_id(id.HashValue());
+
+  // discovery is not started, so nothing is published, but the change is
+  // still disposed locally and dispatched to the listeners
+  channel_manager_.Join(role_attr, RoleType::ROLE_WRITER);
+  channel_manager_.Leave(role_attr, RoleType::ROLE_WRITER);
+  EXPECT_EQ(all_changes, 2);
+  EXPECT_EQ(wasd_changes, 2);
+  EXPECT_EQ(other_changes, 0);
+
+  channel_manager_.RemoveChangeListener(wasd_conn);
+  channel_manager_.Join(role_attr, RoleType::ROLE_READER);
+  EXPECT_EQ(all_changes, 3);
+  EXPECT_EQ(wasd_changes, 2);
+
+  channel_manager_.RemoveChangeListener(all_conn);
+  channel_manager_.RemoveChangeListener(other_conn);
+}
+
+// exposes the batches, which are otherwise only opened by the discovery
+class BatchChannelManager : public ChannelManager {
+ public:
+  using Manager::BeginBatch;
+  using Manager::EndBatch;
+};
+
+TEST(BatchChannelManagerTest, batch_change_listener) {
+  BatchChannelManager channel_manager;
+  std::vector<int> batch_sizes;
+  int changes = 0;
+  auto batch_conn = channel_manager.AddBatchChangeListener(
+      [&batch_sizes](const std::vector<ChangeMsg>& msgs) {
+        batch_sizes.emplace_back(static_cast<int>(msgs.size()));
+      });
+  auto conn = channel_manager.AddChangeListener(
+      [&changes](const ChangeMsg& msg) {
+        (void)msg;
+        ++changes;
+      });
+
+  RoleAttributes role_attr;
+  role_attr.set_host_name(common::GlobalData::Instance()->HostName());
+  role_attr.set_process_id(common::GlobalData::Instance()->ProcessId());
+  role_attr.set_node_name("batch_change_listener");
+  role_attr.set_node_id(
+      common::GlobalData::RegisterNode("batch_change_listener"));
+  role_attr.set_channel_name("batch");
+  role_attr.set_channel_id(
+      common::GlobalData::Instance()->RegisterChannel("batch"));
+  transport::Identity writer_id;
+  role_attr.set_id(writer_id.HashValue());
+
+  // outside of a batch every change is passed on its own
+  channel_manager.Join(role_attr, RoleType::ROLE_WRITER);
+  ASSERT_EQ(batch_sizes.size(), 1);
+  EXPECT_EQ(batch_sizes[0], 1);
+
+  channel_manager.BeginBatch();
+  channel_manager.BeginBatch();
+  channel_manager.Leave(role_attr, RoleType::ROLE_WRITER);
+  transport::Identity reader_id;
+  role_attr.set_id(reader_id.HashValue());
+  channel_manager.Join(role_attr, RoleType::ROLE_READER);
+  channel_manager.Leave(role_attr, RoleType::ROLE_READER);
+  channel_manager.EndBatch();
+  EXPECT_EQ(batch_sizes.size(), 1);
+  channel_manager.EndBatch();
+  // the join and leave of the reader are coalesced
+  ASSERT_EQ(batch_sizes.size(), 2);
+  EXPECT_EQ(batch_sizes[1], 2);
+  EXPECT_EQ(changes, 4);
+
+  channel_manager.RemoveBatchChangeListener(batch_conn);
+  channel_manager.RemoveChangeListener(conn);
+  channel_manager.Shutdown();
+}
+
 TEST_F(ChannelManagerTest, get_upstream_downstream) {
   std::vector<proto::RoleAttributes> nodes;
   for (int i = 0; i < channel_num_; ++i) {
@@ -40,7 +40,8 @@ Manager::Manager()
       channel_name_(""),
       publisher_(nullptr),
       subscriber_(nullptr),
-      listener_(nullptr) {
+      listener_(nullptr),
+      batch_depth_(0) {
   host_name_ = common::GlobalData::Instance()->HostName();
   process_id_ = common::GlobalData::Instance()->ProcessId();
 }
@@ -93,6 +94,7 @@ void Manager::Shutdown() {
 
   StopDiscovery();
   signal_.DisconnectAllSlots();
+  batch_signal_.DisconnectAllSlots();
 }
 
 bool Manager::Join(const RoleAttributes& attr, RoleType role,
@@ -137,6 +139,16 @@ void Manager::RemoveChangeListener(const ChangeConnection& conn) {
   local_conn.Disconnect();
 }
 
+Manager::BatchChangeConnection Manager::AddBatchChangeListener(
+    const BatchChangeFunc& func) {
+  return batch_signal_.Connect(func);
+}
+
+void Manager::RemoveBatchChangeListener(const BatchChangeConnection& conn) {
+  auto local_conn = conn;
+  local_conn.Disconnect();
+}
+
 bool Manager::CreatePublisher(RtpsParticipant* participant) {
   RtpsPublisherAttr pub_attr;
   RETURN_VAL_IF(
@@ -155,7 +167,7 @@ bool Manager::CreateSubscriber(RtpsParticipant* participant) {
           channel_name_, QosProfileConf::QOS_PROFILE_TOPO_CHANGE, &sub_attr),
       false);
   listener_ = new SubscriberListener(
-      std::bind(&Manager::OnRemoteChange, this, std::placeholders::_1));
+      std::bind(&Manager::OnRemoteChanges, this, std::placeholders::_1));
 
   subscriber_ = eprosima::fastrtps::Domain::createSubscriber(
       participant, sub_attr, listener_);
@@ -183,7 +195,58 @@ void Manager::Convert(const RoleAttributes& attr, RoleType role,
   }
 }
 
-void Manager::Notify(const ChangeMsg& msg) { signal_(msg); }
+void Manager::Notify(const ChangeMsg& msg) {
+  signal_(msg);
+
+  {
+    std::lock_guard<std::mutex> lg(batch_mutex_);
+    if (batch_depth_ > 0) {
+      auto& attr = msg.role_attr();
+      std::string key = std::to_string(msg.role_type()) + "/" +
+                        attr.host_name() + "/" +
+                        std::to_string(attr.process_id()) + "/" +
+                        std::to_string(attr.node_id()) + "/" +
+                        std::to_string(attr.channel_id()) + "/" +
+                        std::to_string(attr.service_id()) + "/" +
+                        std::to_string(attr.id());
+      auto search = batch_index_.find(key);
+      if (search == batch_index_.end()) {
+        batch_index_.emplace(key, batch_.size());
+        batch_.emplace_back(msg);
+      } else {
+        batch_[search->second] = msg;
+      }
+      return;
+    }
+  }
+  batch_signal_(ChangeMsgVec{msg});
+}
+
+void Manager::BeginBatch() {
+  std::lock_guard<std::mutex> lg(batch_mutex_);
+  ++batch_depth_;
+}
+
+void Manager::EndBatch() {
+  ChangeMsgVec batch;
+  {
+    std::lock_guard<std::mutex> lg(batch_mutex_);
+    if (--batch_depth_ > 0 || batch_.empty()) {
+      return;
+    }
+    batch.swap(batch_);
+    batch_index_.clear();
+  }
+  batch_signal_(batch);
+}
+
+void Manager::OnRemoteChanges(const std::vector<std::string>& msg_strs) {
+  BeginBatch();
+  for (auto& msg_str : msg_strs) {
+    OnRemoteChange(msg_str);
+  }
+  EndBatch();
+}
 
 void Manager::OnRemoteChange(const std::string& msg_str) {
   if (is_shutdown_.load()) {
@@ -21,6 +21,8 @@
 #include <functional>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "fastrtps/Domain.h"
 #include "fastrtps/attributes/PublisherAttributes.h"
@@ -53,6 +55,10 @@ class Manager {
   using ChangeSignal = base::Signal<const ChangeMsg&>;
   using ChangeFunc = std::function<void(const ChangeMsg&)>;
   using ChangeConnection = base::Connection<const ChangeMsg&>;
+  using ChangeMsgVec = std::vector<ChangeMsg>;
+  using BatchChangeSignal = base::Signal<const ChangeMsgVec&>;
+  using BatchChangeFunc = std::function<void(const ChangeMsgVec&)>;
+  using BatchChangeConnection = base::Connection<const ChangeMsgVec&>;
 
   using RtpsParticipant = eprosima::fastrtps::Participant;
   using RtpsPublisherAttr = eprosima::fastrtps::PublisherAttributes;
@@ -126,6 +132,25 @@ class Manager {
    */
   void RemoveChangeListener(const ChangeConnection& conn);
 
+  /**
+   * @brief Add topology change listener that is called once per discovery
+   * cycle, i.e. for all the changes received from the network at once or
+   * caused by a process leaving, instead of once per change. Of several
+   * changes of the same role in a cycle only the last one is passed.
+   *
+   * @param func the callback function
+   * @return BatchChangeConnection Store it to use when you want to stop
+   * listening.
+   */
+  BatchChangeConnection AddBatchChangeListener(const BatchChangeFunc& func);
+
+  /**
+   * @brief Remove our listener for batched topology change.
+   *
+   * @param conn is the return value of `AddBatchChangeListener`
+   */
+  void RemoveBatchChangeListener(const BatchChangeConnection& conn);
+
   /**
    * @brief Called when a process' topology manager instance leave
    *
@@ -147,7 +172,12 @@ class Manager {
                ChangeMsg* msg);
 
   void Notify(const ChangeMsg& msg);
+  // the changes notified in between are passed to the batch listeners at
+  // once, when the outermost batch ends
+  void BeginBatch();
+  void EndBatch();
   bool Publish(const ChangeMsg& msg);
+  void OnRemoteChanges(const std::vector<std::string>& msg_strs);
   void OnRemoteChange(const std::string& msg_str);
   bool IsFromSameProcess(const ChangeMsg& msg);
 
@@ -164,6 +194,12 @@ class Manager {
   SubscriberListener* listener_;
 
   ChangeSignal signal_;
+  BatchChangeSignal batch_signal_;
+  ChangeMsgVec batch_;
+  // key: the role a change of the batch is about, value: its index in batch_
+  std::unordered_map<std::string, std::size_t> batch_index_;
+  int batch_depth_;
+  std::mutex batch_mutex_;
 };
 
 }  // namespace service_discovery
@@ -71,11 +71,13 @@ void NodeManager::OnTopoModuleLeave(const std::string& host_name,
   }
 
   ChangeMsg msg;
+  BeginBatch();
   for (auto& node : nodes_to_remove) {
     Convert(node->attributes(), RoleType::ROLE_NODE, OperateType::OPT_LEAVE,
             &msg);
     Notify(msg);
   }
+  EndBatch();
 }
 
 void NodeManager::DisposeJoin(const ChangeMsg& msg) {
@@ -86,6 +86,7 @@ void ServiceManager::OnTopoModuleLeave(const std::string& host_name,
   }
 
   ChangeMsg msg;
+  BeginBatch();
   for (auto& server : servers_to_remove) {
     Convert(server->attributes(), RoleType::ROLE_SERVER, OperateType::OPT_LEAVE,
             &msg);
@@ -97,6 +98,7 @@ void ServiceManager::OnTopoModuleLeave(const std::string& host_name,
             &msg);
     Notify(msg);
   }
+  EndBatch();
 }
 
 void ServiceManager::DisposeJoin(const ChangeMsg& msg) {
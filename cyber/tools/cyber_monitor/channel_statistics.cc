@@ -0,0 +1,288 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/tools/cyber_monitor/channel_statistics.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+#include "cyber/service_discovery/topology_manager.h"
+#include "cyber/state.h"
+#include "cyber/time/time.h"
+#include "cyber/transport/transport.h"
+
+using apollo::cyber::Time;
+using apollo::cyber::common::GlobalData;
+using apollo::cyber::message::RawMessage;
+using apollo::cyber::proto::ChangeMsg;
+using apollo::cyber::proto::OperateType;
+using apollo::cyber::proto::RoleAttributes;
+using apollo::cyber::proto::RoleType;
+using apollo::cyber::transport::MessageInfo;
+using apollo::cyber::transport::Transport;
+
+namespace {
+
+uint64_t Percentile(const std::vector<uint64_t>& sorted, double ratio) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  auto index =
+      static_cast<size_t>(ratio * static_cast<double>(sorted.size()));
+  return sorted[std::min(index, sorted.size() - 1)];
+}
+
+std::string EscapeJson(const std::string& str) {
+  std::string ret;
+  ret.reserve(str.size());
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      ret.push_back('\\');
+    }
+    ret.push_back(c);
+  }
+  return ret;
+}
+
+}  // namespace
+
+void ChannelStatistics::Update(uint64_t message_size,
+                               const MessageInfo& msg_info,
+                               uint64_t arrival_ns) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++message_num_;
+  bytes_ += message_size;
+  if (sizes_.size() < kMaxSizeSamples) {
+    sizes_.push_back(message_size);
+  }
+
+  if (last_arrival_ns_ != 0 && arrival_ns > last_arrival_ns_) {
+    double interval =
+        static_cast<double>(arrival_ns - last_arrival_ns_) / 1000000.0;
+    ++interval_num_;
+    double delta = interval - interval_mean_;
+    interval_mean_ += delta / static_cast<double>(interval_num_);
+    interval_m2_ += delta * (interval - interval_mean_);
+    interval_max_ = std::max(interval_max_, interval);
+  }
+  last_arrival_ns_ = arrival_ns;
+
+  auto& last_seq = last_seq_[msg_info.sender_id().HashValue()];
+  if (last_seq != 0 && msg_info.seq_num() > last_seq + 1) {
+    lost_num_ += msg_info.seq_num() - last_seq - 1;
+  }
+  last_seq = msg_info.seq_num();
+}
+
+ChannelStatistics::Snapshot ChannelStatistics::TakeSnapshot(uint64_t now_ns) {
+  Snapshot snapshot;
+  std::vector<uint64_t> sizes;
+  uint64_t bytes = 0;
+  uint64_t window_ns = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (window_start_ns_ != 0 && now_ns > window_start_ns_) {
+      window_ns = now_ns - window_start_ns_;
+    }
+    window_start_ns_ = now_ns;
+    snapshot.message_num = message_num_;
+    snapshot.lost_num = lost_num_;
+    bytes = bytes_;
+    sizes.swap(sizes_);
+    snapshot.interval_mean_ms = interval_mean_;
+    snapshot.interval_max_ms = interval_max_;
+    if (interval_num_ > 1) {
+      snapshot.jitter_ms =
+          std::sqrt(interval_m2_ / static_cast<double>(interval_num_ - 1));
+    }
+    message_num_ = 0;
+    lost_num_ = 0;
+    bytes_ = 0;
+    interval_num_ = 0;
+    interval_mean_ = 0.0;
+    interval_m2_ = 0.0;
+    interval_max_ = 0.0;
+  }
+
+  // sorting happens outside of the lock, receivers are never held up by it
+  if (window_ns > 0) {
+    double window_sec = static_cast<double>(window_ns) / 1000000000.0;
+    snapshot.rate_hz = static_cast<double>(snapshot.message_num) / window_sec;
+    snapshot.bandwidth_bps = static_cast<double>(bytes) / window_sec;
+  }
+  std::sort(sizes.begin(), sizes.end());
+  snapshot.size_p50 = Percentile(sizes, 0.5);
+  snapshot.size_p90 = Percentile(sizes, 0.9);
+  snapshot.size_p99 = Percentile(sizes, 0.99);
+  snapshot.size_max = sizes.empty() ? 0 : sizes.back();
+  return snapshot;
+}
+
+StatisticsMonitor::StatisticsMonitor(const std::string& specified_channel,
+                                     const std::string& output_file,
+                                     uint32_t interval_ms)
+    : specified_channel_(specified_channel),
+      output_file_(output_file),
+      interval_ms_(interval_ms == 0 ? 1000 : interval_ms),
+      node_name_("MonitorStatistics" + std::to_string(getpid())) {}
+
+StatisticsMonitor::~StatisticsMonitor() {
+  if (channel_manager_ != nullptr) {
+    channel_manager_->RemoveChangeListener(change_conn_);
+  }
+  std::lock_guard<std::mutex> lock(readers_mutex_);
+  for (auto& item : readers_) {
+    if (channel_manager_ != nullptr) {
+      channel_manager_->Leave(item.second.attr, RoleType::ROLE_READER);
+    }
+    item.second.receiver = nullptr;
+  }
+  readers_.clear();
+}
+
+bool StatisticsMonitor::OpenOutput() {
+  output_.open(output_file_, std::ios::out | std::ios::app);
+  if (!output_.is_open()) {
+    AERROR << "open statistics file " << output_file_ << " failed.";
+    return false;
+  }
+  return true;
+}
+
+bool StatisticsMonitor::Run() {
+  if (!OpenOutput()) {
+    return false;
+  }
+
+  channel_manager_ =
+      apollo::cyber::service_discovery::TopologyManager::Instance()
+          ->channel_manager();
+  change_conn_ = channel_manager_->AddChangeListener(
+      [this](const ChangeMsg& change_msg) { OnTopologyChange(change_msg); });
+
+  std::vector<RoleAttributes> writers;
+  channel_manager_->GetWriters(&writers);
+  for (auto& writer : writers) {
+    AddWriter(writer);
+  }
+
+  while (apollo::cyber::OK()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms_));
+    WriteSnapshot();
+  }
+  return true;
+}
+
+void StatisticsMonitor::OnTopologyChange(const ChangeMsg& change_msg) {
+  if (change_msg.role_type() != RoleType::ROLE_WRITER) {
+    return;
+  }
+  if (change_msg.operate_type() == OperateType::OPT_JOIN) {
+    AddWriter(change_msg.role_attr());
+  } else {
+    RemoveWriter(change_msg.role_attr());
+  }
+}
+
+void StatisticsMonitor::AddWriter(const RoleAttributes& writer_attr) {
+  const std::string& channel_name = writer_attr.channel_name();
+  if (!specified_channel_.empty() && specified_channel_ != channel_name) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(readers_mutex_);
+  auto iter = readers_.find(channel_name);
+  if (iter == readers_.end()) {
+    ChannelReader reader;
+    reader.statistics.reset(new ChannelStatistics(writer_attr.message_type()));
+    reader.statistics->TakeSnapshot(Time::MonoTime().ToNanosecond());
+
+    auto global_data = GlobalData::Instance();
+    reader.attr.set_host_name(global_data->HostName());
+    reader.attr.set_host_ip(global_data->HostIp());
+    reader.attr.set_process_id(global_data->ProcessId());
+    reader.attr.set_node_name(node_name_);
+    reader.attr.set_node_id(GlobalData::RegisterNode(node_name_));
+    reader.attr.set_channel_name(channel_name);
+    reader.attr.set_channel_id(GlobalData::RegisterChannel(channel_name));
+    reader.attr.set_message_type(writer_attr.message_type());
+
+    // RawMessage keeps the payload as bytes, nothing is parsed here
+    ChannelStatistics* statistics = reader.statistics.get();
+    reader.receiver = Transport::Instance()->CreateReceiver<RawMessage>(
+        reader.attr,
+        [statistics](const std::shared_ptr<RawMessage>& msg,
+                     const MessageInfo& msg_info, const RoleAttributes&) {
+          statistics->Update(msg->message.size(), msg_info,
+                             Time::MonoTime().ToNanosecond());
+        });
+    if (reader.receiver == nullptr) {
+      AERROR << "create receiver for " << channel_name << " failed.";
+      return;
+    }
+    reader.attr.set_id(reader.receiver->id().HashValue());
+    channel_manager_->Join(reader.attr, RoleType::ROLE_READER);
+    iter = readers_.emplace(channel_name, std::move(reader)).first;
+  }
+  iter->second.receiver->Enable(writer_attr);
+}
+
+void StatisticsMonitor::RemoveWriter(const RoleAttributes& writer_attr) {
+  std::lock_guard<std::mutex> lock(readers_mutex_);
+  auto iter = readers_.find(writer_attr.channel_name());
+  if (iter != readers_.end()) {
+    iter->second.receiver->Disable(writer_attr);
+  }
+}
+
+void StatisticsMonitor::WriteSnapshot() {
+  uint64_t now = Time::MonoTime().ToNanosecond();
+  std::ostringstream out;
+  // wall time in ns, a double in seconds would be printed with 6 digits only
+  out << "{\"timestamp\":" << Time::Now().ToNanosecond() << ",\"channels\":[";
+  {
+    std::lock_guard<std::mutex> lock(readers_mutex_);
+    bool first = true;
+    for (auto& item : readers_) {
+      auto snapshot = item.second.statistics->TakeSnapshot(now);
+      out << (first ? "" : ",") << "{\"name\":\"" << EscapeJson(item.first)
+          << "\",\"type\":\""
+          << EscapeJson(item.second.statistics->message_type())
+          << "\",\"messages\":" << snapshot.message_num
+          << ",\"lost\":" << snapshot.lost_num
+          << ",\"rate_hz\":" << snapshot.rate_hz
+          << ",\"bandwidth_bps\":" << snapshot.bandwidth_bps
+          << ",\"size_p50\":" << snapshot.size_p50
+          << ",\"size_p90\":" << snapshot.size_p90
+          << ",\"size_p99\":" << snapshot.size_p99
+          << ",\"size_max\":" << snapshot.size_max
+          << ",\"interval_mean_ms\":" << snapshot.interval_mean_ms
+          << ",\"interval_max_ms\":" << snapshot.interval_max_ms
+          << ",\"jitter_ms\":" << snapshot.jitter_ms << "}";
+      first = false;
+    }
+  }
+  out << "]}";
+  output_ << out.str() << std::endl;
+}
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef TOOLS_CVT_MONITOR_CHANNEL_STATISTICS_H_
+#define TOOLS_CVT_MONITOR_CHANNEL_STATISTICS_H_
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/proto/role_attributes.pb.h"
+#include "cyber/proto/topology_change.pb.h"
+
+#include "cyber/message/raw_message.h"
+#include "cyber/service_discovery/specific_manager/channel_manager.h"
+#include "cyber/transport/message/message_info.h"
+#include "cyber/transport/receiver/receiver.h"
+
+// Statistics of one channel, accumulated over the current window.
+class ChannelStatistics {
+ public:
+  struct Snapshot {
+    uint64_t message_num = 0;
+    uint64_t lost_num = 0;
+    double rate_hz = 0.0;
+    double bandwidth_bps = 0.0;
+    uint64_t size_p50 = 0;
+    uint64_t size_p90 = 0;
+    uint64_t size_p99 = 0;
+    uint64_t size_max = 0;
+    double interval_mean_ms = 0.0;
+    double interval_max_ms = 0.0;
+    double jitter_ms = 0.0;
+  };
+
+  explicit ChannelStatistics(const std::string& message_type)
+      : message_type_(message_type) {}
+
+  // Called for every message, only its size and MessageInfo are used.
+  void Update(uint64_t message_size,
+              const apollo::cyber::transport::MessageInfo& msg_info,
+              uint64_t arrival_ns);
+
+  // Returns the statistics of the window that ends at now_ns and starts a new
+  // one.
+  Snapshot TakeSnapshot(uint64_t now_ns);
+
+  const std::string& message_type() const { return message_type_; }
+
+ private:
+  // at most this many sizes are kept per window for the percentiles
+  static constexpr size_t kMaxSizeSamples = 1 << 16;
+
+  std::string message_type_;
+  std::mutex mutex_;
+  uint64_t window_start_ns_ = 0;
+  uint64_t message_num_ = 0;
+  uint64_t lost_num_ = 0;
+  uint64_t bytes_ = 0;
+  std::vector<uint64_t> sizes_;
+  uint64_t last_arrival_ns_ = 0;
+  // inter-arrival times in ms, Welford's online mean and variance
+  uint64_t interval_num_ = 0;
+  double interval_mean_ = 0.0;
+  double interval_m2_ = 0.0;
+  double interval_max_ = 0.0;
+  // last sequence number of every writer, for loss detection
+  std::unordered_map<uint64_t, uint64_t> last_seq_;
+};
+
+// Headless monitor: subscribes to channels at the transport level without
+// deserializing their payloads and writes a snapshot of the statistics of
+// every channel to a file as one json object per line.
+class StatisticsMonitor {
+ public:
+  StatisticsMonitor(const std::string& specified_channel,
+                    const std::string& output_file, uint32_t interval_ms);
+  ~StatisticsMonitor();
+
+  // Blocks until cyber is shut down.
+  bool Run();
+
+  // Opens the output file for appending, Run calls it first.
+  bool OpenOutput();
+
+  // Appends one json line with the statistics of the current window of every
+  // channel, Run calls it every interval.
+  void WriteSnapshot();
+
+ private:
+  struct ChannelReader {
+    std::unique_ptr<ChannelStatistics> statistics;
+    std::shared_ptr<
+        apollo::cyber::transport::Receiver<apollo::cyber::message::RawMessage>>
+        receiver;
+    apollo::cyber::proto::RoleAttributes attr;
+  };
+
+  void OnTopologyChange(const apollo::cyber::proto::ChangeMsg& change_msg);
+  void AddWriter(const apollo::cyber::proto::RoleAttributes& writer_attr);
+  void RemoveWriter(const apollo::cyber::proto::RoleAttributes& writer_attr);
+
+  std::string specified_channel_;
+  std::string output_file_;
+  uint32_t interval_ms_;
+  std::string node_name_;
+  std::ofstream output_;
+  std::shared_ptr<apollo::cyber::service_discovery::ChannelManager>
+      channel_manager_ = nullptr;
+  apollo::cyber::service_discovery::ChannelManager::ChangeConnection
+      change_conn_;
+  std::mutex readers_mutex_;
+  std::map<std::string, ChannelReader> readers_;
+};
+
+#endif  // TOOLS_CVT_MONITOR_CHANNEL_STATISTICS_H_
@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/tools/cyber_monitor/channel_statistics.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/transport/common/identity.h"
+#include "cyber/transport/message/message_info.h"
+
+using apollo::cyber::transport::Identity;
+using apollo::cyber::transport::MessageInfo;
+
+namespace {
+
+const uint64_t kMsToNs = 1000000UL;
+
+const char TEST_STATISTICS_FILE[] = "/tmp/channel_statistics_test.json";
+
+uint64_t ParseTimestamp(const std::string& line) {
+  const std::string key = "{\"timestamp\":";
+  EXPECT_EQ(0, line.compare(0, key.size(), key));
+  size_t end = line.find(',', key.size());
+  EXPECT_NE(std::string::npos, end);
+  return std::stoull(line.substr(key.size(), end - key.size()));
+}
+
+}  // namespace
+
+TEST(ChannelStatisticsTest, intervals) {
+  ChannelStatistics statistics("apollo.test.Message");
+  const uint64_t start_ns = 1000 * kMsToNs;
+  statistics.TakeSnapshot(start_ns);
+
+  // 10, 20 and 30 ms apart
+  Identity sender;
+  uint64_t seq = 0;
+  for (uint64_t arrival_ms : {0, 10, 30, 60}) {
+    statistics.Update(100, MessageInfo(sender, ++seq),
+                      start_ns + arrival_ms * kMsToNs);
+  }
+  auto snapshot = statistics.TakeSnapshot(start_ns + 1000 * kMsToNs);
+  EXPECT_EQ(4U, snapshot.message_num);
+  EXPECT_EQ(0U, snapshot.lost_num);
+  EXPECT_DOUBLE_EQ(4.0, snapshot.rate_hz);
+  EXPECT_DOUBLE_EQ(400.0, snapshot.bandwidth_bps);
+  EXPECT_DOUBLE_EQ(20.0, snapshot.interval_mean_ms);
+  EXPECT_DOUBLE_EQ(30.0, snapshot.interval_max_ms);
+  // sample standard deviation of 10, 20 and 30
+  EXPECT_DOUBLE_EQ(10.0, snapshot.jitter_ms);
+
+  // the next window starts empty
+  snapshot = statistics.TakeSnapshot(start_ns + 2000 * kMsToNs);
+  EXPECT_EQ(0U, snapshot.message_num);
+  EXPECT_DOUBLE_EQ(0.0, snapshot.rate_hz);
+  EXPECT_DOUBLE_EQ(0.0, snapshot.interval_mean_ms);
+  EXPECT_DOUBLE_EQ(0.0, snapshot.jitter_ms);
+}
+
+TEST(ChannelStatisticsTest, size_percentiles) {
+  ChannelStatistics statistics("apollo.test.Message");
+  statistics.TakeSnapshot(kMsToNs);
+
+  // sizes 1 to 100, not in order
+  Identity sender;
+  uint64_t seq = 0;
+  for (uint64_t i = 0; i < 100; ++i) {
+    const uint64_t size = (i * 37) % 100 + 1;
+    statistics.Update(size, MessageInfo(sender, ++seq), (i + 2) * kMsToNs);
+  }
+  auto snapshot = statistics.TakeSnapshot(1001 * kMsToNs);
+  EXPECT_EQ(100U, snapshot.message_num);
+  EXPECT_EQ(51U, snapshot.size_p50);
+  EXPECT_EQ(91U, snapshot.size_p90);
+  EXPECT_EQ(100U, snapshot.size_p99);
+  EXPECT_EQ(100U, snapshot.size_max);
+  EXPECT_DOUBLE_EQ(5050.0, snapshot.bandwidth_bps);
+}
+
+TEST(ChannelStatisticsTest, lost_messages) {
+  ChannelStatistics statistics("apollo.test.Message");
+  statistics.TakeSnapshot(kMsToNs);
+
+  // sequence numbers are counted per writer
+  Identity sender_a;
+  Identity sender_b;
+  uint64_t arrival_ns = 2 * kMsToNs;
+  for (uint64_t seq : {1, 2, 5}) {
+    statistics.Update(10, MessageInfo(sender_a, seq), ++arrival_ns);
+  }
+  for (uint64_t seq : {1, 3, 4}) {
+    statistics.Update(10, MessageInfo(sender_b, seq), ++arrival_ns);
+  }
+  auto snapshot = statistics.TakeSnapshot(1001 * kMsToNs);
+  EXPECT_EQ(6U, snapshot.message_num);
+  EXPECT_EQ(3U, snapshot.lost_num);
+
+  // the last sequence numbers outlive the window
+  statistics.Update(10, MessageInfo(sender_a, 6), 1002 * kMsToNs);
+  statistics.Update(10, MessageInfo(sender_b, 8), 1003 * kMsToNs);
+  snapshot = statistics.TakeSnapshot(2001 * kMsToNs);
+  EXPECT_EQ(2U, snapshot.message_num);
+  EXPECT_EQ(3U, snapshot.lost_num);
+}
+
+TEST(StatisticsMonitorTest, snapshot_timestamp) {
+  const uint32_t interval_ms = 100;
+  std::remove(TEST_STATISTICS_FILE);
+  {
+    StatisticsMonitor monitor("", TEST_STATISTICS_FILE, interval_ms);
+    ASSERT_TRUE(monitor.OpenOutput());
+    monitor.WriteSnapshot();
+    std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+    monitor.WriteSnapshot();
+  }
+
+  std::ifstream input(TEST_STATISTICS_FILE);
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(input, line)) {
+    lines.push_back(line);
+  }
+  ASSERT_EQ(2U, lines.size());
+  EXPECT_NE(std::string::npos, lines[0].find("\"channels\":[]"));
+
+  uint64_t first = ParseTimestamp(lines[0]);
+  uint64_t second = ParseTimestamp(lines[1]);
+  ASSERT_GT(second, first);
+  EXPECT_GE(second - first, interval_ms * 1000000UL);
+  EXPECT_LT(second - first, 10 * interval_ms * 1000000UL);
+  std::remove(TEST_STATISTICS_FILE);
+}
@@ -15,10 +15,15 @@
  *****************************************************************************/
 
 #include <csignal>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "cyber/init.h"
 #include "cyber/service_discovery/topology_manager.h"
+#include "cyber/tools/cyber_monitor/channel_statistics.h"
 #include "cyber/tools/cyber_monitor/cyber_topology_message.h"
 #include "cyber/tools/cyber_monitor/general_channel_message.h"
 #include "cyber/tools/cyber_monitor/screen.h"
@@ -32,6 +37,9 @@ void printHelp(const char *cmd_name) {
             << cmd_name << "  [option]\nOption:\n"
             << "   -h print help info\n"
             << "   -c specify one channel\n"
+            << "   -s write channel statistics to the file instead of the\n"
+            << "      interactive screen, payloads are not deserialized\n"
+            << "   -i interval of statistics snapshots in ms, default 1000\n"
             << "Interactive Command:\n"
             << Screen::InteractiveCmdStr << std::endl;
 }
@@ -40,11 +48,18 @@ enum COMMAND {
   TOO_MANY_PARAMETER,
   HELP,       // 2
   NO_OPTION,  // 1
-  CHANNEL     // 3 -> 4
+  CHANNEL,    // 3 -> 4
+  STATISTICS
 };
 
-COMMAND ParseOption(int argc, char *const argv[], std::string *command_val) {
-  if (argc > 4) {
+struct Options {
+  std::string channel;
+  std::string statistics_file;
+  uint32_t interval_ms = 1000;
+};
+
+COMMAND ParseOption(int argc, char *const argv[], Options *options) {
+  if (argc > 7) {
     return TOO_MANY_PARAMETER;
   }
   int index = 1;
@@ -56,25 +71,32 @@ COMMAND ParseOption(int argc, char *const argv[], std::string *command_val) {
     if (strcmp(opt, "-h") == 0) {
       return HELP;
     }
-    if (strcmp(opt, "-c") == 0) {
-      if (argv[index + 1]) {
-        *command_val = argv[index + 1];
-        return CHANNEL;
+    if (argv[index + 1]) {
+      if (strcmp(opt, "-c") == 0) {
+        options->channel = argv[++index];
+      } else if (strcmp(opt, "-s") == 0) {
+        options->statistics_file = argv[++index];
+      } else if (strcmp(opt, "-i") == 0) {
+        options->interval_ms =
+            static_cast<uint32_t>(strtoul(argv[++index], nullptr, 10));
       }
     }
 
     ++index;
   }
 
-  return NO_OPTION;
+  if (!options->statistics_file.empty()) {
+    return STATISTICS;
+  }
+  return options->channel.empty() ? NO_OPTION : CHANNEL;
 }
 
 }  // namespace
 
 int main(int argc, char *argv[]) {
-  std::string val;
+  Options options;
 
-  COMMAND com = ParseOption(argc, argv, &val);
+  COMMAND com = ParseOption(argc, argv, &options);
 
   switch (com) {
     case TOO_MANY_PARAMETER:
@@ -91,17 +113,27 @@ int main(int argc, char *argv[]) {
   FLAGS_alsologtostderr = 0;
   FLAGS_colorlogtostderr = 0;
 
-  CyberTopologyMessage topology_msg(val);
+  if (com == STATISTICS) {
+    StatisticsMonitor monitor(options.channel, options.statistics_file,
+                              options.interval_ms);
+    return monitor.Run() ? 0 : -1;
+  }
+
+  CyberTopologyMessage topology_msg(options.channel);
 
+  // one call per discovery cycle, not per changed reader or writer
   auto topology_callback =
-      [&topology_msg](const apollo::cyber::proto::ChangeMsg &change_msg) {
-        topology_msg.TopologyChanged(change_msg);
+      [&topology_msg](
+          const std::vector<apollo::cyber::proto::ChangeMsg> &change_msgs) {
+        for (auto &change_msg : change_msgs) {
+          topology_msg.TopologyChanged(change_msg);
+        }
       };
 
   auto channel_manager =
       apollo::cyber::service_discovery::TopologyManager::Instance()
           ->channel_manager();
-  channel_manager->AddChangeListener(topology_callback);
+  channel_manager->AddBatchChangeListener(topology_callback);
 
   std::vector<apollo::cyber::proto::RoleAttributes> role_vec;
   channel_manager->GetWriters(&role_vec);
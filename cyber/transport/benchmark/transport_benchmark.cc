@@ -0,0 +1,517 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Transport microbenchmark. For every combination of transport mode, message
+// size and reader count it publishes a fixed number of messages and reports
+// throughput, end-to-end latency percentiles and process CPU time per
+// delivered message. Results are printed as a table and optionally written
+// as JSON so that runs can be compared by scripts.
+//
+// usage: transport_benchmark [-m intra,shm,rtps,hybrid] [-s 64,1K,1M]
+//                            [-r 1,4] [-n 1000] [-f 100] [-w 50] [-o out.json]
+//
+// The shm notifier (condition / multicast) is taken from cyber.pb.conf like
+// in any other cyber process and is recorded in every result entry.
+
+#include <getopt.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/proto/unit_test.pb.h"
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+#include "cyber/common/util.h"
+#include "cyber/init.h"
+#include "cyber/time/time.h"
+#include "cyber/transport/shm/condition_notifier.h"
+#include "cyber/transport/transport.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using apollo::cyber::proto::Chatter;
+
+struct BenchmarkParam {
+  std::vector<OptionalMode> modes = {OptionalMode::INTRA, OptionalMode::SHM,
+                                     OptionalMode::RTPS, OptionalMode::HYBRID};
+  std::vector<uint64_t> sizes = {64,         1024,       16 * 1024,
+                                 256 * 1024, 1024 * 1024, 16 * 1024 * 1024};
+  std::vector<int> reader_nums = {1, 4};
+  int message_num = 1000;
+  int warmup_num = 50;
+  double frequency = 100.0;
+  std::string output_file;
+};
+
+struct BenchmarkResult {
+  std::string mode;
+  std::string notifier;
+  uint64_t size = 0;
+  int reader_num = 0;
+  uint64_t sent = 0;
+  uint64_t received = 0;
+  double duration_s = 0.0;
+  double msgs_per_s = 0.0;
+  double mbytes_per_s = 0.0;
+  double latency_us_min = 0.0;
+  double latency_us_p50 = 0.0;
+  double latency_us_p99 = 0.0;
+  double latency_us_p999 = 0.0;
+  double latency_us_max = 0.0;
+  double cpu_us_per_msg = 0.0;
+};
+
+namespace {
+
+const char* ModeName(OptionalMode mode) {
+  switch (mode) {
+    case OptionalMode::INTRA:
+      return "intra";
+    case OptionalMode::SHM:
+      return "shm";
+    case OptionalMode::RTPS:
+      return "rtps";
+    default:
+      return "hybrid";
+  }
+}
+
+bool ParseMode(const std::string& name, OptionalMode* mode) {
+  if (name == "intra") {
+    *mode = OptionalMode::INTRA;
+  } else if (name == "shm") {
+    *mode = OptionalMode::SHM;
+  } else if (name == "rtps") {
+    *mode = OptionalMode::RTPS;
+  } else if (name == "hybrid") {
+    *mode = OptionalMode::HYBRID;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Accepts plain byte counts as well as K/M suffixes, e.g. "64", "4K", "16M".
+bool ParseSize(const std::string& str, uint64_t* size) {
+  if (str.empty()) {
+    return false;
+  }
+  char* end = nullptr;
+  uint64_t value = std::strtoull(str.c_str(), &end, 10);
+  if (end == str.c_str()) {
+    return false;
+  }
+  std::string suffix(end);
+  if (suffix == "K" || suffix == "k") {
+    value *= 1024;
+  } else if (suffix == "M" || suffix == "m") {
+    value *= 1024 * 1024;
+  } else if (!suffix.empty()) {
+    return false;
+  }
+  *size = value;
+  return value > 0;
+}
+
+std::vector<std::string> Split(const std::string& str) {
+  std::vector<std::string> items;
+  std::stringstream ss(str);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) {
+      items.emplace_back(item);
+    }
+  }
+  return items;
+}
+
+uint64_t CpuTimeUs() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<uint64_t>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) *
+             1000000 +
+         usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+double Percentile(const std::vector<uint64_t>& sorted, double ratio) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  size_t index = static_cast<size_t>(ratio * (sorted.size() - 1) + 0.5);
+  return static_cast<double>(sorted[std::min(index, sorted.size() - 1)]) /
+         1000.0;
+}
+
+std::string NotifierType() {
+  auto& g_conf = common::GlobalData::Instance()->Config();
+  if (g_conf.has_transport_conf() && g_conf.transport_conf().has_shm_conf() &&
+      g_conf.transport_conf().shm_conf().has_notifier_type()) {
+    return g_conf.transport_conf().shm_conf().notifier_type();
+  }
+  return ConditionNotifier::Type();
+}
+
+}  // namespace
+
+class TransportBenchmark {
+ public:
+  explicit TransportBenchmark(const BenchmarkParam& param) : param_(param) {}
+
+  bool Run(std::vector<BenchmarkResult>* results);
+
+ private:
+  bool RunCase(OptionalMode mode, uint64_t size, int reader_num,
+               BenchmarkResult* result);
+
+  BenchmarkParam param_;
+  uint64_t case_index_ = 0;
+};
+
+bool TransportBenchmark::Run(std::vector<BenchmarkResult>* results) {
+  for (auto mode : param_.modes) {
+    for (auto size : param_.sizes) {
+      for (auto reader_num : param_.reader_nums) {
+        BenchmarkResult result;
+        if (!RunCase(mode, size, reader_num, &result)) {
+          AERROR << "benchmark case failed, mode: " << ModeName(mode)
+                 << ", size: " << size << ", readers: " << reader_num;
+          return false;
+        }
+        results->emplace_back(result);
+      }
+    }
+  }
+  return true;
+}
+
+bool TransportBenchmark::RunCase(OptionalMode mode, uint64_t size,
+                                 int reader_num, BenchmarkResult* result) {
+  // every case gets its own channel so that late messages of the previous
+  // case can never be counted twice
+  std::string channel_name =
+      "/transport_benchmark/" + std::to_string(case_index_++);
+  RoleAttributes attr;
+  attr.set_host_name(common::GlobalData::Instance()->HostName());
+  attr.set_host_ip(common::GlobalData::Instance()->HostIp());
+  attr.set_process_id(common::GlobalData::Instance()->ProcessId());
+  attr.set_channel_name(channel_name);
+  attr.set_channel_id(common::Hash(channel_name));
+  attr.mutable_qos_profile()->CopyFrom(QosProfileConf::QOS_PROFILE_DEFAULT);
+
+  std::mutex latency_mutex;
+  std::vector<uint64_t> latencies;
+  latencies.reserve(static_cast<size_t>(param_.message_num) * reader_num);
+  std::atomic<uint64_t> received = {0};
+  std::atomic<bool> measuring = {false};
+
+  auto listener = [&](const std::shared_ptr<Chatter>& msg,
+                      const MessageInfo& msg_info,
+                      const RoleAttributes& attr) {
+    (void)msg_info;
+    (void)attr;
+    uint64_t now = Time::Now().ToNanosecond();
+    if (!measuring.load(std::memory_order_acquire)) {
+      return;
+    }
+    received.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(latency_mutex);
+    latencies.emplace_back(now > msg->timestamp() ? now - msg->timestamp()
+                                                  : 0);
+  };
+
+  auto transport = Transport::Instance();
+  auto transmitter = transport->CreateTransmitter<Chatter>(attr, mode);
+  RETURN_VAL_IF_NULL(transmitter, false);
+  std::vector<std::shared_ptr<Receiver<Chatter>>> receivers;
+  for (int i = 0; i < reader_num; ++i) {
+    auto receiver = transport->CreateReceiver<Chatter>(attr, listener, mode);
+    RETURN_VAL_IF_NULL(receiver, false);
+    receivers.emplace_back(receiver);
+  }
+  if (mode == OptionalMode::HYBRID) {
+    // without topology discovery the hybrid endpoints have to be paired by
+    // hand, exactly as service discovery would do for matching roles
+    for (auto& receiver : receivers) {
+      transmitter->Enable(receiver->attributes());
+      receiver->Enable(transmitter->attributes());
+    }
+  }
+
+  // give rtps time to match the writer with its readers
+  if (mode == OptionalMode::RTPS || mode == OptionalMode::HYBRID) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  }
+
+  auto msg = std::make_shared<Chatter>();
+  msg->mutable_content()->assign(size, 'x');
+  const auto interval =
+      param_.frequency > 0.0
+          ? std::chrono::nanoseconds(static_cast<int64_t>(1e9 /
+                                                          param_.frequency))
+          : std::chrono::nanoseconds(0);
+
+  auto publish = [&](int num) {
+    auto next = std::chrono::steady_clock::now();
+    for (int i = 0; i < num; ++i) {
+      msg->set_seq(i);
+      msg->set_timestamp(Time::Now().ToNanosecond());
+      transmitter->Transmit(msg);
+      if (interval.count() > 0) {
+        next += interval;
+        std::this_thread::sleep_until(next);
+      }
+    }
+  };
+
+  publish(param_.warmup_num);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  measuring.store(true, std::memory_order_release);
+  uint64_t cpu_start = CpuTimeUs();
+  auto start = std::chrono::steady_clock::now();
+  publish(param_.message_num);
+
+  // wait for in-flight messages, but do not hang on lossy transports
+  const uint64_t expected =
+      static_cast<uint64_t>(param_.message_num) * reader_num;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (received.load() < expected &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  auto end = std::chrono::steady_clock::now();
+  uint64_t cpu_end = CpuTimeUs();
+  measuring.store(false, std::memory_order_release);
+
+  for (auto& receiver : receivers) {
+    receiver->Disable();
+  }
+  transmitter->Disable();
+
+  std::vector<uint64_t> sorted;
+  {
+    std::lock_guard<std::mutex> lock(latency_mutex);
+    sorted = latencies;
+  }
+  std::sort(sorted.begin(), sorted.end());
+
+  result->mode = ModeName(mode);
+  result->notifier = NotifierType();
+  result->size = size;
+  result->reader_num = reader_num;
+  result->sent = param_.message_num;
+  result->received = sorted.size();
+  result->duration_s =
+      std::chrono::duration<double>(end - start).count();
+  if (result->duration_s > 0.0) {
+    result->msgs_per_s =
+        static_cast<double>(result->received) / result->duration_s;
+    result->mbytes_per_s = result->msgs_per_s * static_cast<double>(size) /
+                           (1024.0 * 1024.0);
+  }
+  if (!sorted.empty()) {
+    result->latency_us_min = static_cast<double>(sorted.front()) / 1000.0;
+    result->latency_us_p50 = Percentile(sorted, 0.5);
+    result->latency_us_p99 = Percentile(sorted, 0.99);
+    result->latency_us_p999 = Percentile(sorted, 0.999);
+    result->latency_us_max = static_cast<double>(sorted.back()) / 1000.0;
+    result->cpu_us_per_msg = static_cast<double>(cpu_end - cpu_start) /
+                             static_cast<double>(sorted.size());
+  }
+  return true;
+}
+
+void PrintResults(const std::vector<BenchmarkResult>& results) {
+  std::cout << std::left << std::setw(8) << "mode" << std::setw(11) << "size"
+            << std::setw(8) << "readers" << std::setw(12) << "recv/sent"
+            << std::setw(12) << "msg/s" << std::setw(10) << "MB/s"
+            << std::setw(10) << "p50(us)" << std::setw(10) << "p99(us)"
+            << std::setw(11) << "p999(us)" << std::setw(10) << "cpu/msg(us)"
+            << std::endl;
+  for (auto& r : results) {
+    std::cout << std::left << std::fixed << std::setprecision(1)
+              << std::setw(8) << r.mode << std::setw(11) << r.size
+              << std::setw(8) << r.reader_num << std::setw(12)
+              << (std::to_string(r.received) + "/" +
+                  std::to_string(r.sent * r.reader_num))
+              << std::setw(12) << r.msgs_per_s << std::setw(10)
+              << r.mbytes_per_s << std::setw(10) << r.latency_us_p50
+              << std::setw(10) << r.latency_us_p99 << std::setw(11)
+              << r.latency_us_p999 << std::setw(10) << r.cpu_us_per_msg
+              << std::endl;
+  }
+}
+
+bool WriteResults(const std::string& file,
+                  const std::vector<BenchmarkResult>& results) {
+  std::ofstream ofs(file);
+  if (!ofs.is_open()) {
+    AERROR << "open output file failed: " << file;
+    return false;
+  }
+  ofs << std::fixed << std::setprecision(3) << "[\n";
+  for (size_t i = 0; i < results.size(); ++i) {
+    auto& r = results[i];
+    ofs << "  {\"mode\": \"" << r.mode << "\", \"notifier\": \"" << r.notifier
+        << "\", \"size\": " << r.size << ", \"readers\": " << r.reader_num
+        << ", \"sent\": " << r.sent << ", \"received\": " << r.received
+        << ", \"duration_s\": " << r.duration_s
+        << ", \"msgs_per_s\": " << r.msgs_per_s
+        << ", \"mbytes_per_s\": " << r.mbytes_per_s
+        << ", \"latency_us\": {\"min\": " << r.latency_us_min
+        << ", \"p50\": " << r.latency_us_p50 << ", \"p99\": " << r.latency_us_p99
+        << ", \"p999\": " << r.latency_us_p999
+        << ", \"max\": " << r.latency_us_max << "}"
+        << ", \"cpu_us_per_msg\": " << r.cpu_us_per_msg << "}"
+        << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  ofs << "]\n";
+  return true;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+namespace {
+
+const char BENCHMARK_OPTIONS[] = "m:s:r:n:w:f:o:h";
+
+void DisplayUsage(const std::string& binary) {
+  std::cout << "usage: " << binary << " [options]\n"
+            << "\t-m, --modes intra,shm,rtps,hybrid\ttransport modes\n"
+            << "\t-s, --sizes 64,1K,16M\t\t\tmessage sizes in bytes\n"
+            << "\t-r, --readers 1,4\t\t\treader counts per channel\n"
+            << "\t-n, --messages 1000\t\t\tmessages measured per case\n"
+            << "\t-w, --warmup 50\t\t\t\tmessages sent before measuring\n"
+            << "\t-f, --frequency 100\t\t\tpublish rate in Hz, 0 for max\n"
+            << "\t-o, --output file.json\t\t\twrite results as json\n"
+            << "\t-h, --help\t\t\t\tshow this help message\n"
+            << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  using apollo::cyber::transport::BenchmarkParam;
+  using apollo::cyber::transport::BenchmarkResult;
+  using apollo::cyber::transport::OptionalMode;
+  using apollo::cyber::transport::ParseMode;
+  using apollo::cyber::transport::ParseSize;
+  using apollo::cyber::transport::Split;
+
+  const struct option long_options[] = {
+      {"modes", required_argument, nullptr, 'm'},
+      {"sizes", required_argument, nullptr, 's'},
+      {"readers", required_argument, nullptr, 'r'},
+      {"messages", required_argument, nullptr, 'n'},
+      {"warmup", required_argument, nullptr, 'w'},
+      {"frequency", required_argument, nullptr, 'f'},
+      {"output", required_argument, nullptr, 'o'},
+      {"help", no_argument, nullptr, 'h'},
+      {nullptr, 0, nullptr, 0}};
+
+  BenchmarkParam param;
+  int opt = 0;
+  while ((opt = getopt_long(argc, argv, BENCHMARK_OPTIONS, long_options,
+                            nullptr)) != -1) {
+    switch (opt) {
+      case 'm': {
+        param.modes.clear();
+        for (auto& name : Split(optarg)) {
+          OptionalMode mode;
+          if (!ParseMode(name, &mode)) {
+            std::cout << "unknown mode: " << name << std::endl;
+            return -1;
+          }
+          param.modes.emplace_back(mode);
+        }
+        break;
+      }
+      case 's': {
+        param.sizes.clear();
+        for (auto& item : Split(optarg)) {
+          uint64_t size = 0;
+          if (!ParseSize(item, &size)) {
+            std::cout << "invalid size: " << item << std::endl;
+            return -1;
+          }
+          param.sizes.emplace_back(size);
+        }
+        break;
+      }
+      case 'r':
+        param.reader_nums.clear();
+        for (auto& item : Split(optarg)) {
+          param.reader_nums.emplace_back(std::max(1, std::atoi(item.c_str())));
+        }
+        break;
+      case 'n':
+        param.message_num = std::max(1, std::atoi(optarg));
+        break;
+      case 'w':
+        param.warmup_num = std::max(0, std::atoi(optarg));
+        break;
+      case 'f':
+        param.frequency = std::max(0.0, std::atof(optarg));
+        break;
+      case 'o':
+        param.output_file = optarg;
+        break;
+      case 'h':
+      default:
+        DisplayUsage(argv[0]);
+        return opt == 'h' ? 0 : -1;
+    }
+  }
+  if (param.modes.empty() || param.sizes.empty() ||
+      param.reader_nums.empty()) {
+    DisplayUsage(argv[0]);
+    return -1;
+  }
+
+  apollo::cyber::Init(argv[0]);
+  apollo::cyber::transport::Transport::Instance();
+
+  std::vector<BenchmarkResult> results;
+  apollo::cyber::transport::TransportBenchmark benchmark(param);
+  bool ok = benchmark.Run(&results);
+  apollo::cyber::transport::PrintResults(results);
+  if (!param.output_file.empty()) {
+    ok = apollo::cyber::transport::WriteResults(param.output_file, results) &&
+         ok;
+  }
+
+  apollo::cyber::transport::Transport::Instance()->Shutdown();
+  apollo::cyber::Clear();
+  return ok ? 0 : -1;
+}
@@ -16,6 +16,10 @@
 
 #include "cyber/transport/rtps/participant.h"
 
+#include <memory>
+
+#include "fastrtps/transport/UDPv4TransportDescriptor.h"
+
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/proto/transport_conf.pb.h"
@@ -133,12 +137,43 @@ void Participant::CreateFastRtpsParticipant(
   locator.set_IP4_address(239, 255, 0, 1);
   attr.rtps.builtin.metatrafficMulticastLocatorList.push_back(locator);
 
+  FillInLargeMessageAttr(*part_attr_conf, &attr);
+
   fastrtps_participant_ =
       eprosima::fastrtps::Domain::createParticipant(attr, listener);
   RETURN_IF_NULL(fastrtps_participant_);
   eprosima::fastrtps::Domain::registerType(fastrtps_participant_, &type_);
 }
 
+void Participant::FillInLargeMessageAttr(
+    const proto::RtpsParticipantAttr& conf,
+    eprosima::fastrtps::ParticipantAttributes* attr) {
+  if (conf.send_socket_buffer_size() > 0) {
+    attr->rtps.sendSocketBufferSize = conf.send_socket_buffer_size();
+  }
+  if (conf.listen_socket_buffer_size() > 0) {
+    attr->rtps.listenSocketBufferSize = conf.listen_socket_buffer_size();
+  }
+  if (conf.throughput_bytes_per_period() > 0 &&
+      conf.throughput_period_ms() > 0) {
+    attr->rtps.throughputController.bytesPerPeriod =
+        conf.throughput_bytes_per_period();
+    attr->rtps.throughputController.periodMillisecs =
+        conf.throughput_period_ms();
+  }
+  if (conf.max_message_size() > 0) {
+    // the fragment size is a property of the transport, so replace the
+    // builtin udp transport with an explicitly configured one
+    auto udp_transport =
+        std::make_shared<eprosima::fastrtps::rtps::UDPv4TransportDescriptor>();
+    udp_transport->maxMessageSize = conf.max_message_size();
+    udp_transport->sendBufferSize = attr->rtps.sendSocketBufferSize;
+    udp_transport->receiveBufferSize = attr->rtps.listenSocketBufferSize;
+    attr->rtps.useBuiltinTransports = false;
+    attr->rtps.userTransports.push_back(udp_transport);
+  }
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
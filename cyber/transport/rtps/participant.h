@@ -22,6 +22,8 @@
 #include <mutex>
 #include <string>
 
+#include "cyber/proto/transport_conf.pb.h"
+
 #include "cyber/transport/rtps/underlay_message_type.h"
 #include "fastrtps/Domain.h"
 #include "fastrtps/attributes/ParticipantAttributes.h"
@@ -51,6 +53,9 @@ class Participant {
   void CreateFastRtpsParticipant(
       const std::string& name, int send_port,
       eprosima::fastrtps::ParticipantListener* listener);
+  static void FillInLargeMessageAttr(
+      const proto::RtpsParticipantAttr& conf,
+      eprosima::fastrtps::ParticipantAttributes* attr);
 
   std::atomic<bool> shutdown_;
   std::string name_;
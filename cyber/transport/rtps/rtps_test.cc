@@ -14,6 +14,7 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <cstring>
 #include <string>
 #include <utility>
 
@@ -207,6 +208,55 @@ TEST(UnderlayMessageTest, underlay_message_test) {
   EXPECT_EQ("", message4.datatype());
 }
 
+TEST(UnderlayMessageTest, data_writer_test) {
+  const std::string payload(100000, 'p');
+  UnderlayMessage staged;
+  staged.timestamp(1);
+  staged.seq(2);
+  staged.data(payload);
+  staged.datatype("datatype");
+
+  UnderlayMessage deferred;
+  deferred.timestamp(1);
+  deferred.seq(2);
+  deferred.data_writer(payload.size(), [&payload](char* dst, size_t size) {
+    memcpy(dst, payload.data(), size);
+    return true;
+  });
+  deferred.datatype("datatype");
+  EXPECT_EQ(payload.size(), deferred.data_size());
+  EXPECT_TRUE(deferred.data().empty());
+  EXPECT_EQ(UnderlayMessage::getCdrSerializedSize(staged),
+            UnderlayMessage::getCdrSerializedSize(deferred));
+
+  UnderlayMessageType type;
+  uint32_t size = type.getSerializedSizeProvider(&deferred)();
+  eprosima::fastrtps::rtps::SerializedPayload_t staged_payload(size);
+  eprosima::fastrtps::rtps::SerializedPayload_t deferred_payload(size);
+  EXPECT_TRUE(type.serialize(&staged, &staged_payload));
+  EXPECT_TRUE(type.serialize(&deferred, &deferred_payload));
+  ASSERT_EQ(staged_payload.length, deferred_payload.length);
+  EXPECT_EQ(0, memcmp(staged_payload.data, deferred_payload.data,
+                      staged_payload.length));
+
+  UnderlayMessage result;
+  EXPECT_TRUE(type.deserialize(&deferred_payload, &result));
+  EXPECT_EQ(1, result.timestamp());
+  EXPECT_EQ(2, result.seq());
+  EXPECT_EQ(payload, result.data());
+  EXPECT_EQ("datatype", result.datatype());
+
+  UnderlayMessage failed;
+  failed.data_writer(16, [](char* dst, size_t size) {
+    (void)dst;
+    (void)size;
+    return false;
+  });
+  eprosima::fastrtps::rtps::SerializedPayload_t failed_payload(
+      type.getSerializedSizeProvider(&failed)());
+  EXPECT_FALSE(type.serialize(&failed, &failed_payload));
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
@@ -16,6 +16,8 @@
 
 #include "cyber/transport/rtps/sub_listener.h"
 
+#include <utility>
+
 #include "cyber/common/log.h"
 #include "cyber/common/util.h"
 
@@ -57,9 +59,9 @@ void SubListener::onNewDataMessage(eprosima::fastrtps::Subscriber* sub) {
       m_info.related_sample_identity.sequence_number().low;
   msg_info_.set_seq_num(seq_num);
 
-  // fetch message string
+  // hand the deserialized buffer over to the dispatcher without copying it
   std::shared_ptr<std::string> msg_str =
-      std::make_shared<std::string>(m.data());
+      std::make_shared<std::string>(std::move(m.data()));
 
   // callback
   callback_(channel_id, msg_str, msg_info_);
@@ -23,6 +23,7 @@
 #include "cyber/transport/rtps/underlay_message.h"
 
 #include "fastcdr/exceptions/BadParamException.h"
+#include "fastcdr/exceptions/NotEnoughMemoryException.h"
 
 namespace apollo {
 namespace cyber {
@@ -31,6 +32,7 @@ namespace transport {
 UnderlayMessage::UnderlayMessage() {
   m_timestamp = 0;
   m_seq = 0;
+  m_data_size = 0;
 }
 
 UnderlayMessage::~UnderlayMessage() {}
@@ -40,6 +42,8 @@ UnderlayMessage::UnderlayMessage(const UnderlayMessage& x) {
   m_seq = x.m_seq;
   m_data = x.m_data;
   m_datatype = x.m_datatype;
+  m_data_size = x.m_data_size;
+  m_data_writer = x.m_data_writer;
 }
 
 UnderlayMessage::UnderlayMessage(UnderlayMessage&& x) {
@@ -47,6 +51,8 @@ UnderlayMessage::UnderlayMessage(UnderlayMessage&& x) {
   m_seq = x.m_seq;
   m_data = std::move(x.m_data);
   m_datatype = std::move(x.m_datatype);
+  m_data_size = x.m_data_size;
+  m_data_writer = std::move(x.m_data_writer);
 }
 
 UnderlayMessage& UnderlayMessage::operator=(const UnderlayMessage& x) {
@@ -54,6 +60,8 @@ UnderlayMessage& UnderlayMessage::operator=(const UnderlayMessage& x) {
   m_seq = x.m_seq;
   m_data = x.m_data;
   m_datatype = x.m_datatype;
+  m_data_size = x.m_data_size;
+  m_data_writer = x.m_data_writer;
 
   return *this;
 }
@@ -63,6 +71,8 @@ UnderlayMessage& UnderlayMessage::operator=(UnderlayMessage&& x) {
   m_seq = x.m_seq;
   m_data = std::move(x.m_data);
   m_datatype = std::move(x.m_datatype);
+  m_data_size = x.m_data_size;
+  m_data_writer = std::move(x.m_data_writer);
 
   return *this;
 }
@@ -97,7 +107,7 @@ size_t UnderlayMessage::getCdrSerializedSize(const UnderlayMessage& data,
 
   current_alignment += 4 +
                        eprosima::fastcdr::Cdr::alignment(current_alignment, 4) +
-                       data.data().size() + 1;
+                       data.data_size() + 1;
 
   current_alignment += 4 +
                        eprosima::fastcdr::Cdr::alignment(current_alignment, 4) +
@@ -111,7 +121,23 @@ void UnderlayMessage::serialize(eprosima::fastcdr::Cdr& scdr) const {
 
   scdr << m_seq;
 
-  scdr << m_data;
+  if (m_data_writer) {
+    // same layout as a CDR string: length with terminator, bytes, terminator
+    scdr << static_cast<uint32_t>(m_data_size + 1);
+    char* dst = scdr.getCurrentPosition();
+    if (!scdr.jump(m_data_size)) {
+      throw eprosima::fastcdr::exception::NotEnoughMemoryException(
+          eprosima::fastcdr::exception::NotEnoughMemoryException::
+              NOT_ENOUGH_MEMORY_MESSAGE_DEFAULT);
+    }
+    if (!m_data_writer(dst, m_data_size)) {
+      throw eprosima::fastcdr::exception::BadParamException(
+          "failed to write underlay message data");
+    }
+    scdr << static_cast<char>('\0');
+  } else {
+    scdr << m_data;
+  }
   scdr << m_datatype;
 }
 
@@ -20,6 +20,7 @@
 #include <cstdint>
 
 #include <array>
+#include <functional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -128,6 +129,33 @@ class UnderlayMessage {
    * @return Reference to member data
    */
   inline std::string& data() { return m_data; }
+
+  /*!
+   * @brief Callback that writes exactly size bytes of member data into dst.
+   */
+  using DataWriter = std::function<bool(char* dst, size_t size)>;
+
+  /*!
+   * @brief This function defers member data to a writer that is invoked during
+   * CDR serialization, so the payload is produced in place inside the
+   * serialization buffer instead of being staged in member data first. The
+   * wire format is identical to the one produced from member data.
+   * @param _size Number of bytes the writer will produce
+   * @param _writer Writer invoked with the destination in the CDR buffer
+   */
+  inline void data_writer(size_t _size, const DataWriter& _writer) {
+    m_data_size = _size;
+    m_data_writer = _writer;
+  }
+
+  /*!
+   * @brief This function returns the size of member data, taking a deferred
+   * writer into account.
+   * @return Size of member data in bytes
+   */
+  inline size_t data_size() const {
+    return m_data_writer ? m_data_size : m_data.size();
+  }
   /*!
    * @brief This function copies the value in member datatype
    * @param _datatype New value to be copied in member datatype
@@ -210,6 +238,8 @@ class UnderlayMessage {
   int32_t m_seq;
   std::string m_data;
   std::string m_datatype;
+  size_t m_data_size;
+  DataWriter m_data_writer;
 };
 
 }  // namespace transport
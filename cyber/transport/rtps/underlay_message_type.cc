@@ -23,6 +23,7 @@
 
 #include "fastcdr/Cdr.h"
 #include "fastcdr/FastBuffer.h"
+#include "fastcdr/exceptions/Exception.h"
 
 #include "cyber/common/log.h"
 
@@ -60,7 +61,12 @@ bool UnderlayMessageType::serialize(void* data, SerializedPayload_t* payload) {
                                                                  : CDR_LE;
   // Serialize encapsulation
   ser.serialize_encapsulation();
-  p_type->serialize(ser);  // Serialize the object:
+  try {
+    p_type->serialize(ser);  // Serialize the object:
+  } catch (eprosima::fastcdr::exception::Exception& e) {
+    AERROR << "serialize underlay message failed: " << e.what();
+    return false;
+  }
   payload->length =
       (uint32_t)ser.getSerializedDataLength();  // Get the serialized length
   return true;
@@ -103,8 +103,17 @@ bool RtpsTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
     return false;
   }
 
+  // serialize straight into the rtps payload instead of staging the bytes in
+  // a std::string that fast-rtps would have to copy again
   UnderlayMessage m;
-  RETURN_VAL_IF(!message::SerializeToString(msg, &m.data()), false);
+  int msg_size = message::ByteSize(msg);
+  if (msg_size >= 0) {
+    m.data_writer(msg_size, [&msg](char* dst, size_t size) {
+      return message::SerializeToArray(msg, dst, static_cast<int>(size));
+    });
+  } else {
+    RETURN_VAL_IF(!message::SerializeToString(msg, &m.data()), false);
+  }
 
   eprosima::fastrtps::rtps::WriteParams wparams;
 
@@ -16,14 +16,14 @@
 
 /**
  * @file
- * @brief Defines the templated AABoxKDTree2dNode class.
+ * @brief Defines the templated AABoxKDTree2d class.
  */
 
 #pragma once
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
-#include <memory>
 #include <vector>
 
 #include "cyber/common/log.h"
@@ -53,63 +53,193 @@ struct AABoxKDTreeParams {
 };
 
 /**
- * @class AABoxKDTree2dNode
- * @brief The class of KD-tree node of axis-aligned bounding box.
+ * @class AABoxKDTreeNode
+ * @brief A node of AABoxKDTree2d. It is plain data, so that the nodes of a
+ * tree can be written to and read from files as they are.
+ */
+struct AABoxKDTreeNode {
+  // Boundary
+  double min_x = 0.0;
+  double max_x = 0.0;
+  double min_y = 0.0;
+  double max_y = 0.0;
+  double partition_position = 0.0;
+  // The Partition of AABoxKDTree2d.
+  int partition = 1;
+  // Indices of the sub-nodes, -1 if there is none.
+  int left = -1;
+  int right = -1;
+  // Objects of this node are [begin, end) of the object arrays, objects of
+  // the whole subtree rooted at this node are [begin, subtree_end).
+  int begin = 0;
+  int end = 0;
+  int subtree_end = 0;
+};
+
+/**
+ * @class AABoxKDTreeLayout
+ * @brief The nodes and the object order of a built AABoxKDTree2d, with the
+ * objects as indices into the vector the tree was built from. A tree is
+ * restored from its layout without sorting any object again.
+ */
+struct AABoxKDTreeLayout {
+  std::vector<AABoxKDTreeNode> nodes;
+  std::vector<int> sorted_by_min;
+  std::vector<int> sorted_by_max;
+
+  /**
+   * @brief Whether the layout is the one of a tree of object_num objects,
+   * which it has to be to restore a tree from it.
+   */
+  bool IsValid(const size_t object_num) const {
+    if (sorted_by_min.size() != object_num ||
+        sorted_by_max.size() != object_num) {
+      return false;
+    }
+    if (nodes.empty()) {
+      return object_num == 0;
+    }
+    const int node_num = static_cast<int>(nodes.size());
+    const int size = static_cast<int>(object_num);
+    int end = 0;
+    for (int i = 0; i < node_num; ++i) {
+      const AABoxKDTreeNode &node = nodes[i];
+      // nodes are in pre-order, with their objects one after another
+      if (node.begin != end || node.end < node.begin ||
+          node.subtree_end < node.end || node.subtree_end > size ||
+          (node.left >= 0 && (node.left <= i || node.left >= node_num)) ||
+          (node.right >= 0 && (node.right <= i || node.right >= node_num)) ||
+          (node.partition != 1 && node.partition != 2)) {
+        return false;
+      }
+      end = node.end;
+    }
+    if (end != size) {
+      return false;
+    }
+    for (size_t i = 0; i < object_num; ++i) {
+      if (sorted_by_min[i] < 0 || sorted_by_min[i] >= size ||
+          sorted_by_max[i] < 0 || sorted_by_max[i] >= size) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+/**
+ * @class AABoxKDTree2d
+ * @brief The class of KD-tree of Aligned Axis Bounding Box(AABox).
+ *
+ * Nodes are stored in one array in pre-order and searched without recursion.
+ * The objects of every node are stored in two shared arrays, sorted by the
+ * min and by the max bound of the node partition, with the boxes of the
+ * objects next to their bounds. DistanceSquareTo is only called on objects
+ * whose boxes may be close enough, which requires aabox() of an object to
+ * contain the object, as it does for every object type queried by the tree.
  */
 template <class ObjectType>
-class AABoxKDTree2dNode {
+class AABoxKDTree2d {
  public:
   using ObjectPtr = const ObjectType *;
+
   /**
-   * @brief Constructor which takes a vector of objects,
-   *        parameters and depth of the node.
-   * @param objects Objects to build the KD-tree node.
+   * @brief Constructor which takes a vector of objects and parameters.
    * @param params Parameters to build the KD-tree.
-   * @param depth Depth of the KD-tree node.
    */
-  AABoxKDTree2dNode(const std::vector<ObjectPtr> &objects,
-                    const AABoxKDTreeParams &params, int depth)
-      : depth_(depth) {
-    ACHECK(!objects.empty());
-
-    ComputeBoundary(objects);
-    ComputePartition();
-
-    if (SplitToSubNodes(objects, params)) {
-      std::vector<ObjectPtr> left_subnode_objects;
-      std::vector<ObjectPtr> right_subnode_objects;
-      PartitionObjects(objects, &left_subnode_objects, &right_subnode_objects);
-
-      // Split to sub-nodes.
-      if (!left_subnode_objects.empty()) {
-        left_subnode_.reset(new AABoxKDTree2dNode<ObjectType>(
-            left_subnode_objects, params, depth + 1));
+  AABoxKDTree2d(const std::vector<ObjectType> &objects,
+                const AABoxKDTreeParams &params) {
+    if (!objects.empty()) {
+      std::vector<ObjectPtr> object_ptrs;
+      object_ptrs.reserve(objects.size());
+      for (const auto &object : objects) {
+        object_ptrs.push_back(&object);
       }
-      if (!right_subnode_objects.empty()) {
-        right_subnode_.reset(new AABoxKDTree2dNode<ObjectType>(
-            right_subnode_objects, params, depth + 1));
+      sorted_by_min_.Reserve(objects.size());
+      sorted_by_max_.Reserve(objects.size());
+      BuildNode(object_ptrs, params, 0);
+    }
+  }
+
+  /**
+   * @brief Constructor which restores a tree from its layout, see
+   * GetLayout. The layout must be valid for the objects.
+   * @param objects The objects the tree of the layout was built from.
+   * @param layout The layout of the tree.
+   */
+  AABoxKDTree2d(const std::vector<ObjectType> &objects,
+                const AABoxKDTreeLayout &layout) {
+    ACHECK(layout.IsValid(objects.size()));
+    nodes_ = layout.nodes;
+    sorted_by_min_.Reserve(objects.size());
+    sorted_by_max_.Reserve(objects.size());
+    for (const Node &node : nodes_) {
+      const bool partition_x = node.partition == PARTITION_X;
+      for (int i = node.begin; i < node.end; ++i) {
+        ObjectPtr object = &objects[layout.sorted_by_min[i]];
+        sorted_by_min_.Append(object, partition_x ? object->aabox().min_x()
+                                                  : object->aabox().min_y());
+        object = &objects[layout.sorted_by_max[i]];
+        sorted_by_max_.Append(object, partition_x ? object->aabox().max_x()
+                                                  : object->aabox().max_y());
       }
-    } else {
-      InitObjects(objects);
     }
   }
 
   /**
-   * @brief Get the nearest object to a target point by the KD-tree
-   *        rooted at this node.
+   * @brief Get the layout of the tree, to restore it later on.
+   * @param objects The objects the tree was built from.
+   * @param layout The layout of the tree.
+   */
+  void GetLayout(const std::vector<ObjectType> &objects,
+                 AABoxKDTreeLayout *const layout) const {
+    layout->nodes = nodes_;
+    layout->sorted_by_min.clear();
+    layout->sorted_by_max.clear();
+    layout->sorted_by_min.reserve(objects.size());
+    layout->sorted_by_max.reserve(objects.size());
+    for (ObjectPtr object : sorted_by_min_.objects) {
+      layout->sorted_by_min.push_back(static_cast<int>(object - &objects[0]));
+    }
+    for (ObjectPtr object : sorted_by_max_.objects) {
+      layout->sorted_by_max.push_back(static_cast<int>(object - &objects[0]));
+    }
+  }
+
+  /**
+   * @brief Get the nearest object to a target point.
    * @param point The target point. Search it's nearest object.
    * @return The nearest object to the target point.
    */
   ObjectPtr GetNearestObject(const Vec2d &point) const {
-    ObjectPtr nearest_object = nullptr;
-    double min_distance_sqr = std::numeric_limits<double>::infinity();
-    GetNearestObjectInternal(point, &min_distance_sqr, &nearest_object);
-    return nearest_object;
+    if (nodes_.empty()) {
+      return nullptr;
+    }
+    return GetNearestObjectInternal(point, LocalQueryBuffer());
+  }
+
+  /**
+   * @brief Get the nearest objects to a batch of target points.
+   * @param points The target points.
+   * @param nearest_objects The nearest object to every target point, in the
+   *        order of the points.
+   */
+  void GetNearestObjects(const std::vector<Vec2d> &points,
+                         std::vector<ObjectPtr> *const nearest_objects) const {
+    nearest_objects->clear();
+    if (nodes_.empty()) {
+      nearest_objects->resize(points.size(), nullptr);
+      return;
+    }
+    nearest_objects->reserve(points.size());
+    QueryBuffer *buffer = LocalQueryBuffer();
+    for (const auto &point : points) {
+      nearest_objects->push_back(GetNearestObjectInternal(point, buffer));
+    }
   }
 
   /**
-   * @brief Get objects within a distance to a point by the KD-tree
-   *        rooted at this node.
+   * @brief Get objects within a distance to a point.
    * @param point The center point of the range to search objects.
    * @param distance The radius of the range to search objects.
    * @return All objects within the specified distance to the specified point.
@@ -117,353 +247,475 @@ class AABoxKDTree2dNode {
   std::vector<ObjectPtr> GetObjects(const Vec2d &point,
                                     const double distance) const {
     std::vector<ObjectPtr> result_objects;
-    GetObjectsInternal(point, distance, Square(distance), &result_objects);
+    if (!nodes_.empty()) {
+      GetObjectsInternal(point, distance, LocalQueryBuffer(), &result_objects);
+    }
     return result_objects;
   }
 
+  /**
+   * @brief Get objects within a distance to every point of a batch. The tree
+   *        is traversed once for the whole batch, every node is visited with
+   *        all the points in range of it.
+   * @param points The center points of the ranges to search objects.
+   * @param distance The radius of the ranges to search objects.
+   * @param result_objects All objects within the specified distance to every
+   *        point, in the order of the points, each in the order GetObjects of
+   *        the point returns them. The vectors are cleared and reused.
+   */
+  void GetObjects(
+      const std::vector<Vec2d> &points, const double distance,
+      std::vector<std::vector<ObjectPtr>> *const result_objects) const {
+    result_objects->resize(points.size());
+    for (auto &objects : *result_objects) {
+      objects.clear();
+    }
+    if (!nodes_.empty() && !points.empty()) {
+      GetObjectsInternal(points, distance, LocalQueryBuffer(), result_objects);
+    }
+  }
+
   /**
    * @brief Get the axis-aligned bounding box of the objects.
    * @return The axis-aligned bounding box of the objects.
    */
   AABox2d GetBoundingBox() const {
-    return AABox2d({min_x_, min_y_}, {max_x_, max_y_});
+    if (nodes_.empty()) {
+      return AABox2d();
+    }
+    const Node &root = nodes_.front();
+    return AABox2d({root.min_x, root.min_y}, {root.max_x, root.max_y});
   }
 
  private:
-  void InitObjects(const std::vector<ObjectPtr> &objects) {
-    num_objects_ = static_cast<int>(objects.size());
-    objects_sorted_by_min_ = objects;
-    objects_sorted_by_max_ = objects;
-    std::sort(objects_sorted_by_min_.begin(), objects_sorted_by_min_.end(),
+  enum Partition {
+    PARTITION_X = 1,
+    PARTITION_Y = 2,
+  };
+
+  using Node = AABoxKDTreeNode;
+
+  // The partition bound an object is sorted by, with the box of the object
+  // next to it. The bound and the box are read together while scanning the
+  // objects of a node, so they share a cache line.
+  struct ObjectBound {
+    double bound = 0.0;
+    double min_x = 0.0;
+    double max_x = 0.0;
+    double min_y = 0.0;
+    double max_y = 0.0;
+  };
+
+  struct ObjectArrays {
+    void Reserve(size_t size) {
+      objects.reserve(size);
+      bounds.reserve(size);
+    }
+
+    void Append(ObjectPtr object, double bound) {
+      const AABox2d &box = object->aabox();
+      objects.push_back(object);
+      bounds.push_back(
+          {bound, box.min_x(), box.max_x(), box.min_y(), box.max_y()});
+    }
+
+    std::vector<ObjectPtr> objects;
+    std::vector<ObjectBound> bounds;
+  };
+
+  // A node to search in a batch search, with the range of the indices of the
+  // points in range of its parent.
+  struct BatchFrame {
+    int node = 0;
+    int begin = 0;
+    int end = 0;
+  };
+
+  // Scratch space of the queries, reused by every query of a thread.
+  struct QueryBuffer {
+    std::vector<int> stack;
+    std::vector<BatchFrame> frames;
+    std::vector<int> point_indices;
+  };
+
+  static QueryBuffer *LocalQueryBuffer() {
+    static thread_local QueryBuffer buffer;
+    return &buffer;
+  }
+
+  int BuildNode(const std::vector<ObjectPtr> &objects,
+                const AABoxKDTreeParams &params, int depth) {
+    ACHECK(!objects.empty());
+    const int index = static_cast<int>(nodes_.size());
+    nodes_.emplace_back();
+    Node node;
+    ComputeBoundary(objects, &node);
+    ComputePartition(&node);
+
+    std::vector<ObjectPtr> left_subnode_objects;
+    std::vector<ObjectPtr> right_subnode_objects;
+    if (SplitToSubNodes(objects, node, params, depth)) {
+      std::vector<ObjectPtr> other_objects;
+      PartitionObjects(objects, node, &left_subnode_objects,
+                       &right_subnode_objects, &other_objects);
+      InitObjects(other_objects, &node);
+    } else {
+      InitObjects(objects, &node);
+    }
+    nodes_[index] = node;
+
+    // Split to sub-nodes. nodes_ may be reallocated, so it is indexed again.
+    if (!left_subnode_objects.empty()) {
+      const int left = BuildNode(left_subnode_objects, params, depth + 1);
+      nodes_[index].left = left;
+    }
+    if (!right_subnode_objects.empty()) {
+      const int right = BuildNode(right_subnode_objects, params, depth + 1);
+      nodes_[index].right = right;
+    }
+    nodes_[index].subtree_end = static_cast<int>(sorted_by_min_.objects.size());
+    return index;
+  }
+
+  void InitObjects(const std::vector<ObjectPtr> &objects, Node *const node) {
+    const bool partition_x = node->partition == PARTITION_X;
+    std::vector<ObjectPtr> objects_sorted_by_min = objects;
+    std::vector<ObjectPtr> objects_sorted_by_max = objects;
+    std::sort(objects_sorted_by_min.begin(), objects_sorted_by_min.end(),
               [&](ObjectPtr obj1, ObjectPtr obj2) {
-                return partition_ == PARTITION_X
+                return partition_x
                            ? obj1->aabox().min_x() < obj2->aabox().min_x()
                            : obj1->aabox().min_y() < obj2->aabox().min_y();
               });
-    std::sort(objects_sorted_by_max_.begin(), objects_sorted_by_max_.end(),
+    std::sort(objects_sorted_by_max.begin(), objects_sorted_by_max.end(),
               [&](ObjectPtr obj1, ObjectPtr obj2) {
-                return partition_ == PARTITION_X
+                return partition_x
                            ? obj1->aabox().max_x() > obj2->aabox().max_x()
                            : obj1->aabox().max_y() > obj2->aabox().max_y();
               });
-    objects_sorted_by_min_bound_.reserve(num_objects_);
-    for (ObjectPtr object : objects_sorted_by_min_) {
-      objects_sorted_by_min_bound_.push_back(partition_ == PARTITION_X
-                                                 ? object->aabox().min_x()
-                                                 : object->aabox().min_y());
-    }
-    objects_sorted_by_max_bound_.reserve(num_objects_);
-    for (ObjectPtr object : objects_sorted_by_max_) {
-      objects_sorted_by_max_bound_.push_back(partition_ == PARTITION_X
-                                                 ? object->aabox().max_x()
-                                                 : object->aabox().max_y());
+    node->begin = static_cast<int>(sorted_by_min_.objects.size());
+    for (ObjectPtr object : objects_sorted_by_min) {
+      sorted_by_min_.Append(object, partition_x ? object->aabox().min_x()
+                                                : object->aabox().min_y());
     }
+    for (ObjectPtr object : objects_sorted_by_max) {
+      sorted_by_max_.Append(object, partition_x ? object->aabox().max_x()
+                                                : object->aabox().max_y());
+    }
+    node->end = static_cast<int>(sorted_by_min_.objects.size());
   }
 
-  bool SplitToSubNodes(const std::vector<ObjectPtr> &objects,
-                       const AABoxKDTreeParams &params) {
-    if (params.max_depth >= 0 && depth_ >= params.max_depth) {
+  static bool SplitToSubNodes(const std::vector<ObjectPtr> &objects,
+                              const Node &node,
+                              const AABoxKDTreeParams &params, int depth) {
+    if (params.max_depth >= 0 && depth >= params.max_depth) {
       return false;
     }
     if (static_cast<int>(objects.size()) <= std::max(1, params.max_leaf_size)) {
       return false;
     }
     if (params.max_leaf_dimension >= 0.0 &&
-        std::max(max_x_ - min_x_, max_y_ - min_y_) <=
+        std::max(node.max_x - node.min_x, node.max_y - node.min_y) <=
             params.max_leaf_dimension) {
       return false;
     }
     return true;
   }
 
-  double LowerDistanceSquareToPoint(const Vec2d &point) const {
+  static double LowerDistanceSquareToPoint(const Node &node,
+                                           const Vec2d &point) {
     double dx = 0.0;
-    if (point.x() < min_x_) {
-      dx = min_x_ - point.x();
-    } else if (point.x() > max_x_) {
-      dx = point.x() - max_x_;
+    if (point.x() < node.min_x) {
+      dx = node.min_x - point.x();
+    } else if (point.x() > node.max_x) {
+      dx = point.x() - node.max_x;
     }
     double dy = 0.0;
-    if (point.y() < min_y_) {
-      dy = min_y_ - point.y();
-    } else if (point.y() > max_y_) {
-      dy = point.y() - max_y_;
+    if (point.y() < node.min_y) {
+      dy = node.min_y - point.y();
+    } else if (point.y() > node.max_y) {
+      dy = point.y() - node.max_y;
     }
     return dx * dx + dy * dy;
   }
 
-  double UpperDistanceSquareToPoint(const Vec2d &point) const {
-    const double dx =
-        (point.x() > mid_x_ ? (point.x() - min_x_) : (point.x() - max_x_));
-    const double dy =
-        (point.y() > mid_y_ ? (point.y() - min_y_) : (point.y() - max_y_));
+  static double UpperDistanceSquareToPoint(const Node &node,
+                                           const Vec2d &point) {
+    const double mid_x = (node.min_x + node.max_x) / 2.0;
+    const double mid_y = (node.min_y + node.max_y) / 2.0;
+    const double dx = (point.x() > mid_x ? (point.x() - node.min_x)
+                                         : (point.x() - node.max_x));
+    const double dy = (point.y() > mid_y ? (point.y() - node.min_y)
+                                         : (point.y() - node.max_y));
     return dx * dx + dy * dy;
   }
 
-  void GetAllObjects(std::vector<ObjectPtr> *const result_objects) const {
-    result_objects->insert(result_objects->end(),
-                           objects_sorted_by_min_.begin(),
-                           objects_sorted_by_min_.end());
-    if (left_subnode_ != nullptr) {
-      left_subnode_->GetAllObjects(result_objects);
-    }
-    if (right_subnode_ != nullptr) {
-      right_subnode_->GetAllObjects(result_objects);
-    }
+  // Lower bound of the squared distance from the point to an object. It is
+  // branch free, so that objects far from the point are skipped without a
+  // call to DistanceSquareTo and without mispredictions.
+  static double BoxDistanceSquareToPoint(const ObjectBound &box,
+                                         const Vec2d &point) {
+    const double dx_min = box.min_x - point.x();
+    const double dx_max = point.x() - box.max_x;
+    double dx = dx_min > dx_max ? dx_min : dx_max;
+    dx = dx > 0.0 ? dx : 0.0;
+    const double dy_min = box.min_y - point.y();
+    const double dy_max = point.y() - box.max_y;
+    double dy = dy_min > dy_max ? dy_min : dy_max;
+    dy = dy > 0.0 ? dy : 0.0;
+    return dx * dx + dy * dy;
   }
 
   void GetObjectsInternal(const Vec2d &point, const double distance,
-                          const double distance_sqr,
+                          QueryBuffer *const buffer,
                           std::vector<ObjectPtr> *const result_objects) const {
-    if (LowerDistanceSquareToPoint(point) > distance_sqr) {
-      return;
+    const double distance_sqr = Square(distance);
+    std::vector<int> &stack = buffer->stack;
+    stack.clear();
+    stack.push_back(0);
+    while (!stack.empty()) {
+      const Node &node = nodes_[stack.back()];
+      stack.pop_back();
+      if (LowerDistanceSquareToPoint(node, point) > distance_sqr) {
+        continue;
+      }
+      if (UpperDistanceSquareToPoint(node, point) <= distance_sqr) {
+        // The whole subtree is in range.
+        result_objects->insert(
+            result_objects->end(),
+            sorted_by_min_.objects.begin() + node.begin,
+            sorted_by_min_.objects.begin() + node.subtree_end);
+        continue;
+      }
+      ScanObjectsInRange(node, point, distance, distance_sqr, result_objects);
+      // Sub-nodes are visited left first, as the recursive search did.
+      if (node.right >= 0) {
+        stack.push_back(node.right);
+      }
+      if (node.left >= 0) {
+        stack.push_back(node.left);
+      }
     }
-    if (UpperDistanceSquareToPoint(point) <= distance_sqr) {
-      GetAllObjects(result_objects);
-      return;
+  }
+
+  void GetObjectsInternal(
+      const std::vector<Vec2d> &points, const double distance,
+      QueryBuffer *const buffer,
+      std::vector<std::vector<ObjectPtr>> *const result_objects) const {
+    const double distance_sqr = Square(distance);
+    const int point_num = static_cast<int>(points.size());
+    std::vector<BatchFrame> &frames = buffer->frames;
+    std::vector<int> &point_indices = buffer->point_indices;
+    frames.clear();
+    point_indices.clear();
+    for (int i = 0; i < point_num; ++i) {
+      point_indices.push_back(i);
+    }
+    frames.push_back({0, 0, point_num});
+    while (!frames.empty()) {
+      const BatchFrame frame = frames.back();
+      frames.pop_back();
+      // The frames left are of ancestors or of their siblings, whose point
+      // ranges end no later than the range of this frame.
+      point_indices.resize(frame.end);
+      const Node &node = nodes_[frame.node];
+      const int begin = frame.end;
+      for (int i = frame.begin; i < frame.end; ++i) {
+        const int index = point_indices[i];
+        const Vec2d &point = points[index];
+        if (LowerDistanceSquareToPoint(node, point) > distance_sqr) {
+          continue;
+        }
+        std::vector<ObjectPtr> &objects = (*result_objects)[index];
+        if (UpperDistanceSquareToPoint(node, point) <= distance_sqr) {
+          // The whole subtree is in range.
+          objects.insert(objects.end(),
+                         sorted_by_min_.objects.begin() + node.begin,
+                         sorted_by_min_.objects.begin() + node.subtree_end);
+          continue;
+        }
+        ScanObjectsInRange(node, point, distance, distance_sqr, &objects);
+        point_indices.push_back(index);
+      }
+      const int end = static_cast<int>(point_indices.size());
+      if (begin == end) {
+        continue;
+      }
+      // Sub-nodes are visited left first, as the single point search does.
+      if (node.right >= 0) {
+        frames.push_back({node.right, begin, end});
+      }
+      if (node.left >= 0) {
+        frames.push_back({node.left, begin, end});
+      }
     }
-    const double pvalue = (partition_ == PARTITION_X ? point.x() : point.y());
-    if (pvalue < partition_position_) {
+  }
+
+  // Appends the objects of a node, not of its sub-nodes, in range of a point.
+  void ScanObjectsInRange(const Node &node, const Vec2d &point,
+                          const double distance, const double distance_sqr,
+                          std::vector<ObjectPtr> *const result_objects) const {
+    const double pvalue =
+        (node.partition == PARTITION_X ? point.x() : point.y());
+    if (pvalue < node.partition_position) {
       const double limit = pvalue + distance;
-      for (int i = 0; i < num_objects_; ++i) {
-        if (objects_sorted_by_min_bound_[i] > limit) {
+      for (int i = node.begin; i < node.end; ++i) {
+        const ObjectBound &bound = sorted_by_min_.bounds[i];
+        if (bound.bound > limit) {
           break;
         }
-        ObjectPtr object = objects_sorted_by_min_[i];
+        if (BoxDistanceSquareToPoint(bound, point) > distance_sqr) {
+          continue;
+        }
+        ObjectPtr object = sorted_by_min_.objects[i];
         if (object->DistanceSquareTo(point) <= distance_sqr) {
           result_objects->push_back(object);
         }
       }
     } else {
       const double limit = pvalue - distance;
-      for (int i = 0; i < num_objects_; ++i) {
-        if (objects_sorted_by_max_bound_[i] < limit) {
+      for (int i = node.begin; i < node.end; ++i) {
+        const ObjectBound &bound = sorted_by_max_.bounds[i];
+        if (bound.bound < limit) {
           break;
         }
-        ObjectPtr object = objects_sorted_by_max_[i];
+        if (BoxDistanceSquareToPoint(bound, point) > distance_sqr) {
+          continue;
+        }
+        ObjectPtr object = sorted_by_max_.objects[i];
         if (object->DistanceSquareTo(point) <= distance_sqr) {
           result_objects->push_back(object);
         }
       }
     }
-    if (left_subnode_ != nullptr) {
-      left_subnode_->GetObjectsInternal(point, distance, distance_sqr,
-                                        result_objects);
-    }
-    if (right_subnode_ != nullptr) {
-      right_subnode_->GetObjectsInternal(point, distance, distance_sqr,
-                                         result_objects);
-    }
   }
 
-  void GetNearestObjectInternal(const Vec2d &point,
-                                double *const min_distance_sqr,
-                                ObjectPtr *const nearest_object) const {
-    if (LowerDistanceSquareToPoint(point) >= *min_distance_sqr - kMathEpsilon) {
-      return;
-    }
-    const double pvalue = (partition_ == PARTITION_X ? point.x() : point.y());
-    const bool search_left_first = (pvalue < partition_position_);
-    if (search_left_first) {
-      if (left_subnode_ != nullptr) {
-        left_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                nearest_object);
-      }
-    } else {
-      if (right_subnode_ != nullptr) {
-        right_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                 nearest_object);
-      }
-    }
-    if (*min_distance_sqr <= kMathEpsilon) {
-      return;
-    }
-
-    if (search_left_first) {
-      for (int i = 0; i < num_objects_; ++i) {
-        const double bound = objects_sorted_by_min_bound_[i];
-        if (bound > pvalue && Square(bound - pvalue) > *min_distance_sqr) {
+  ObjectPtr GetNearestObjectInternal(const Vec2d &point,
+                                     QueryBuffer *const buffer) const {
+    ObjectPtr nearest_object = nullptr;
+    double min_distance_sqr = std::numeric_limits<double>::infinity();
+    // Nodes whose nearer sub-node is being searched, their objects and their
+    // farther sub-nodes are searched after it, as the recursive search did.
+    std::vector<int> &stack = buffer->stack;
+    stack.clear();
+    int index = 0;
+    while (true) {
+      while (index >= 0) {
+        const Node &node = nodes_[index];
+        if (LowerDistanceSquareToPoint(node, point) >=
+            min_distance_sqr - kMathEpsilon) {
           break;
         }
-        ObjectPtr object = objects_sorted_by_min_[i];
-        const double distance_sqr = object->DistanceSquareTo(point);
-        if (distance_sqr < *min_distance_sqr) {
-          *min_distance_sqr = distance_sqr;
-          *nearest_object = object;
-        }
+        stack.push_back(index);
+        const double pvalue =
+            (node.partition == PARTITION_X ? point.x() : point.y());
+        index = pvalue < node.partition_position ? node.left : node.right;
       }
-    } else {
-      for (int i = 0; i < num_objects_; ++i) {
-        const double bound = objects_sorted_by_max_bound_[i];
-        if (bound < pvalue && Square(bound - pvalue) > *min_distance_sqr) {
-          break;
-        }
-        ObjectPtr object = objects_sorted_by_max_[i];
-        const double distance_sqr = object->DistanceSquareTo(point);
-        if (distance_sqr < *min_distance_sqr) {
-          *min_distance_sqr = distance_sqr;
-          *nearest_object = object;
-        }
+      if (stack.empty()) {
+        break;
       }
+      const Node &node = nodes_[stack.back()];
+      stack.pop_back();
+      const double pvalue =
+          (node.partition == PARTITION_X ? point.x() : point.y());
+      const bool search_left_first = (pvalue < node.partition_position);
+      ScanNearestObject(node, point, pvalue, search_left_first,
+                        &min_distance_sqr, &nearest_object);
+      if (min_distance_sqr <= kMathEpsilon) {
+        break;
+      }
+      index = search_left_first ? node.right : node.left;
     }
-    if (*min_distance_sqr <= kMathEpsilon) {
-      return;
-    }
-    if (search_left_first) {
-      if (right_subnode_ != nullptr) {
-        right_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                 nearest_object);
+    return nearest_object;
+  }
+
+  void ScanNearestObject(const Node &node, const Vec2d &point,
+                         const double pvalue, const bool search_left_first,
+                         double *const min_distance_sqr,
+                         ObjectPtr *const nearest_object) const {
+    const ObjectArrays &arrays =
+        search_left_first ? sorted_by_min_ : sorted_by_max_;
+    for (int i = node.begin; i < node.end; ++i) {
+      const ObjectBound &bound = arrays.bounds[i];
+      const bool outside =
+          search_left_first ? bound.bound > pvalue : bound.bound < pvalue;
+      if (outside && Square(bound.bound - pvalue) > *min_distance_sqr) {
+        break;
       }
-    } else {
-      if (left_subnode_ != nullptr) {
-        left_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                nearest_object);
+      if (BoxDistanceSquareToPoint(bound, point) >= *min_distance_sqr) {
+        continue;
+      }
+      ObjectPtr object = arrays.objects[i];
+      const double distance_sqr = object->DistanceSquareTo(point);
+      if (distance_sqr < *min_distance_sqr) {
+        *min_distance_sqr = distance_sqr;
+        *nearest_object = object;
       }
     }
   }
 
-  void ComputeBoundary(const std::vector<ObjectPtr> &objects) {
-    min_x_ = std::numeric_limits<double>::infinity();
-    min_y_ = std::numeric_limits<double>::infinity();
-    max_x_ = -std::numeric_limits<double>::infinity();
-    max_y_ = -std::numeric_limits<double>::infinity();
+  static void ComputeBoundary(const std::vector<ObjectPtr> &objects,
+                              Node *const node) {
+    node->min_x = std::numeric_limits<double>::infinity();
+    node->min_y = std::numeric_limits<double>::infinity();
+    node->max_x = -std::numeric_limits<double>::infinity();
+    node->max_y = -std::numeric_limits<double>::infinity();
     for (ObjectPtr object : objects) {
-      min_x_ = std::fmin(min_x_, object->aabox().min_x());
-      max_x_ = std::fmax(max_x_, object->aabox().max_x());
-      min_y_ = std::fmin(min_y_, object->aabox().min_y());
-      max_y_ = std::fmax(max_y_, object->aabox().max_y());
-    }
-    mid_x_ = (min_x_ + max_x_) / 2.0;
-    mid_y_ = (min_y_ + max_y_) / 2.0;
-    ACHECK(!std::isinf(max_x_) && !std::isinf(max_y_) && !std::isinf(min_x_) &&
-           !std::isinf(min_y_))
+      node->min_x = std::fmin(node->min_x, object->aabox().min_x());
+      node->max_x = std::fmax(node->max_x, object->aabox().max_x());
+      node->min_y = std::fmin(node->min_y, object->aabox().min_y());
+      node->max_y = std::fmax(node->max_y, object->aabox().max_y());
+    }
+    ACHECK(!std::isinf(node->max_x) && !std::isinf(node->max_y) &&
+           !std::isinf(node->min_x) && !std::isinf(node->min_y))
         << "the provided object box size is infinity";
   }
 
-  void ComputePartition() {
-    if (max_x_ - min_x_ >= max_y_ - min_y_) {
-      partition_ = PARTITION_X;
-      partition_position_ = (min_x_ + max_x_) / 2.0;
+  static void ComputePartition(Node *const node) {
+    if (node->max_x - node->min_x >= node->max_y - node->min_y) {
+      node->partition = PARTITION_X;
+      node->partition_position = (node->min_x + node->max_x) / 2.0;
     } else {
-      partition_ = PARTITION_Y;
-      partition_position_ = (min_y_ + max_y_) / 2.0;
+      node->partition = PARTITION_Y;
+      node->partition_position = (node->min_y + node->max_y) / 2.0;
     }
   }
 
-  void PartitionObjects(const std::vector<ObjectPtr> &objects,
-                        std::vector<ObjectPtr> *const left_subnode_objects,
-                        std::vector<ObjectPtr> *const right_subnode_objects) {
+  static void PartitionObjects(
+      const std::vector<ObjectPtr> &objects, const Node &node,
+      std::vector<ObjectPtr> *const left_subnode_objects,
+      std::vector<ObjectPtr> *const right_subnode_objects,
+      std::vector<ObjectPtr> *const other_objects) {
     left_subnode_objects->clear();
     right_subnode_objects->clear();
-    std::vector<ObjectPtr> other_objects;
-    if (partition_ == PARTITION_X) {
+    other_objects->clear();
+    if (node.partition == PARTITION_X) {
       for (ObjectPtr object : objects) {
-        if (object->aabox().max_x() <= partition_position_) {
+        if (object->aabox().max_x() <= node.partition_position) {
           left_subnode_objects->push_back(object);
-        } else if (object->aabox().min_x() >= partition_position_) {
+        } else if (object->aabox().min_x() >= node.partition_position) {
           right_subnode_objects->push_back(object);
         } else {
-          other_objects.push_back(object);
+          other_objects->push_back(object);
         }
       }
     } else {
       for (ObjectPtr object : objects) {
-        if (object->aabox().max_y() <= partition_position_) {
+        if (object->aabox().max_y() <= node.partition_position) {
           left_subnode_objects->push_back(object);
-        } else if (object->aabox().min_y() >= partition_position_) {
+        } else if (object->aabox().min_y() >= node.partition_position) {
           right_subnode_objects->push_back(object);
         } else {
-          other_objects.push_back(object);
+          other_objects->push_back(object);
         }
       }
     }
-    InitObjects(other_objects);
-  }
-
- private:
-  int num_objects_ = 0;
-  std::vector<ObjectPtr> objects_sorted_by_min_;
-  std::vector<ObjectPtr> objects_sorted_by_max_;
-  std::vector<double> objects_sorted_by_min_bound_;
-  std::vector<double> objects_sorted_by_max_bound_;
-  int depth_ = 0;
-
-  // Boundary
-  double min_x_ = 0.0;
-  double max_x_ = 0.0;
-  double min_y_ = 0.0;
-  double max_y_ = 0.0;
-  double mid_x_ = 0.0;
-  double mid_y_ = 0.0;
-
-  enum Partition {
-    PARTITION_X = 1,
-    PARTITION_Y = 2,
-  };
-  Partition partition_ = PARTITION_X;
-  double partition_position_ = 0.0;
-
-  std::unique_ptr<AABoxKDTree2dNode<ObjectType>> left_subnode_ = nullptr;
-  std::unique_ptr<AABoxKDTree2dNode<ObjectType>> right_subnode_ = nullptr;
-};
-
-/**
- * @class AABoxKDTree2d
- * @brief The class of KD-tree of Aligned Axis Bounding Box(AABox).
- */
-template <class ObjectType>
-class AABoxKDTree2d {
- public:
-  using ObjectPtr = const ObjectType *;
-
-  /**
-   * @brief Constructor which takes a vector of objects and parameters.
-   * @param params Parameters to build the KD-tree.
-   */
-  AABoxKDTree2d(const std::vector<ObjectType> &objects,
-                const AABoxKDTreeParams &params) {
-    if (!objects.empty()) {
-      std::vector<ObjectPtr> object_ptrs;
-      for (const auto &object : objects) {
-        object_ptrs.push_back(&object);
-      }
-      root_.reset(new AABoxKDTree2dNode<ObjectType>(object_ptrs, params, 0));
-    }
   }
 
-  /**
-   * @brief Get the nearest object to a target point.
-   * @param point The target point. Search it's nearest object.
-   * @return The nearest object to the target point.
-   */
-  ObjectPtr GetNearestObject(const Vec2d &point) const {
-    return root_ == nullptr ? nullptr : root_->GetNearestObject(point);
-  }
-
-  /**
-   * @brief Get objects within a distance to a point.
-   * @param point The center point of the range to search objects.
-   * @param distance The radius of the range to search objects.
-   * @return All objects within the specified distance to the specified point.
-   */
-  std::vector<ObjectPtr> GetObjects(const Vec2d &point,
-                                    const double distance) const {
-    if (root_ == nullptr) {
-      return {};
-    }
-    return root_->GetObjects(point, distance);
-  }
-
-  /**
-   * @brief Get the axis-aligned bounding box of the objects.
-   * @return The axis-aligned bounding box of the objects.
-   */
-  AABox2d GetBoundingBox() const {
-    return root_ == nullptr ? AABox2d() : root_->GetBoundingBox();
-  }
-
- private:
-  std::unique_ptr<AABoxKDTree2dNode<ObjectType>> root_ = nullptr;
+  // Nodes in pre-order, the root is the first one.
+  std::vector<Node> nodes_;
+  ObjectArrays sorted_by_min_;
+  ObjectArrays sorted_by_max_;
 };
 
 }  // namespace math
@@ -118,6 +118,98 @@ TEST(AABoxKDTree2dNode, OverallTests) {
   }
 }
 
+TEST(AABoxKDTree2d, BatchQueries) {
+  const int kNumBoxes = 200;
+  const int kNumQueries = 500;
+  const double kSize = 100;
+  std::vector<Object> objects;
+  for (int i = 0; i < kNumBoxes; ++i) {
+    const double cx = RandomDouble(-kSize, kSize);
+    const double cy = RandomDouble(-kSize, kSize);
+    const double dx = RandomDouble(-kSize / 10.0, kSize / 10.0);
+    const double dy = RandomDouble(-kSize / 10.0, kSize / 10.0);
+    objects.emplace_back(cx - dx, cy - dy, cx + dx, cy + dy, i);
+  }
+  AABoxKDTreeParams params;
+  params.max_leaf_size = 4;
+  AABoxKDTree2d<Object> kdtree(objects, params);
+
+  std::vector<Vec2d> points;
+  for (int i = 0; i < kNumQueries; ++i) {
+    points.emplace_back(RandomDouble(-kSize * 1.5, kSize * 1.5),
+                        RandomDouble(-kSize * 1.5, kSize * 1.5));
+  }
+  std::vector<const Object *> nearest_objects;
+  kdtree.GetNearestObjects(points, &nearest_objects);
+  ASSERT_EQ(points.size(), nearest_objects.size());
+  std::vector<std::vector<const Object *>> result_objects;
+  kdtree.GetObjects(points, kSize / 5.0, &result_objects);
+  ASSERT_EQ(points.size(), result_objects.size());
+  for (int i = 0; i < kNumQueries; ++i) {
+    EXPECT_EQ(kdtree.GetNearestObject(points[i]), nearest_objects[i]);
+    EXPECT_EQ(kdtree.GetObjects(points[i], kSize / 5.0), result_objects[i]);
+  }
+  // the results of the former batch are cleared
+  kdtree.GetObjects(points, kSize / 2.0, &result_objects);
+  ASSERT_EQ(points.size(), result_objects.size());
+  for (int i = 0; i < kNumQueries; ++i) {
+    EXPECT_EQ(kdtree.GetObjects(points[i], kSize / 2.0), result_objects[i]);
+  }
+
+  AABoxKDTree2d<Object> empty_kdtree({}, params);
+  empty_kdtree.GetNearestObjects(points, &nearest_objects);
+  ASSERT_EQ(points.size(), nearest_objects.size());
+  EXPECT_EQ(nullptr, nearest_objects.front());
+  empty_kdtree.GetObjects(points, kSize, &result_objects);
+  ASSERT_EQ(points.size(), result_objects.size());
+  EXPECT_TRUE(result_objects.front().empty());
+}
+
+TEST(AABoxKDTree2d, Layout) {
+  const int kNumBoxes = 200;
+  const int kNumQueries = 500;
+  const double kSize = 100;
+  std::vector<Object> objects;
+  for (int i = 0; i < kNumBoxes; ++i) {
+    const double cx = RandomDouble(-kSize, kSize);
+    const double cy = RandomDouble(-kSize, kSize);
+    const double dx = RandomDouble(-kSize / 10.0, kSize / 10.0);
+    const double dy = RandomDouble(-kSize / 10.0, kSize / 10.0);
+    objects.emplace_back(cx - dx, cy - dy, cx + dx, cy + dy, i);
+  }
+  AABoxKDTreeParams params;
+  params.max_leaf_size = 4;
+  AABoxKDTree2d<Object> kdtree(objects, params);
+  AABoxKDTreeLayout layout;
+  kdtree.GetLayout(objects, &layout);
+  EXPECT_TRUE(layout.IsValid(objects.size()));
+  EXPECT_FALSE(layout.IsValid(objects.size() + 1));
+
+  // the restored tree is the same tree over a copy of the objects
+  const std::vector<Object> copied_objects = objects;
+  AABoxKDTree2d<Object> restored_kdtree(copied_objects, layout);
+  for (int i = 0; i < kNumQueries; ++i) {
+    const Vec2d point(RandomDouble(-kSize * 1.5, kSize * 1.5),
+                      RandomDouble(-kSize * 1.5, kSize * 1.5));
+    EXPECT_EQ(kdtree.GetNearestObject(point)->id(),
+              restored_kdtree.GetNearestObject(point)->id());
+    const auto objects_in_range = kdtree.GetObjects(point, kSize / 5.0);
+    const auto restored_objects_in_range =
+        restored_kdtree.GetObjects(point, kSize / 5.0);
+    ASSERT_EQ(objects_in_range.size(), restored_objects_in_range.size());
+    for (size_t j = 0; j < objects_in_range.size(); ++j) {
+      EXPECT_EQ(objects_in_range[j]->id(), restored_objects_in_range[j]->id());
+    }
+  }
+
+  layout.sorted_by_max.back() = kNumBoxes;
+  EXPECT_FALSE(layout.IsValid(objects.size()));
+  layout.sorted_by_max.back() = 0;
+  layout.nodes.front().left = 0;
+  EXPECT_FALSE(layout.IsValid(objects.size()));
+  EXPECT_TRUE(AABoxKDTreeLayout().IsValid(0));
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
@@ -0,0 +1,217 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/batch_math.h"
+
+#include <algorithm>
+
+#include "cyber/common/log.h"
+#include "modules/common/math/math_utils.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+// NormalizeAngle without fmod, the result is in [-pi, pi)
+inline double SignedAngle(const double angle) {
+  constexpr double kRound = 6755399441055744.0;
+  const double turns = (angle + M_PI) * (0.5 * M_1_PI);
+  double floor_turns = (turns + kRound) - kRound;
+  floor_turns = floor_turns > turns ? floor_turns - 1.0 : floor_turns;
+  return angle - floor_turns * (2.0 * M_PI);
+}
+
+// angles beyond the range of the reduction of FastSinCos
+void SinCosOfLargeAngles(const double *angles, const size_t num, double *sin,
+                         double *cos) {
+  for (size_t i = 0; i < num; ++i) {
+    if (std::fabs(angles[i]) > kMaxBatchAngle) {
+      if (sin != nullptr) {
+        sin[i] = std::sin(angles[i]);
+      }
+      if (cos != nullptr) {
+        cos[i] = std::cos(angles[i]);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void SinCos(const double *angles, const size_t num, double *sin,
+            double *cos) {
+  // the outputs must not overlap the angles, which are read again for the
+  // large ones
+  if (sin != nullptr && cos != nullptr) {
+    for (size_t i = 0; i < num; ++i) {
+      FastSinCos(angles[i], &sin[i], &cos[i]);
+    }
+  } else if (sin != nullptr) {
+    for (size_t i = 0; i < num; ++i) {
+      double c = 0.0;
+      FastSinCos(angles[i], &sin[i], &c);
+    }
+  } else if (cos != nullptr) {
+    for (size_t i = 0; i < num; ++i) {
+      double s = 0.0;
+      FastSinCos(angles[i], &s, &cos[i]);
+    }
+  }
+  SinCosOfLargeAngles(angles, num, sin, cos);
+}
+
+void SinCos(const std::vector<double> &angles, std::vector<double> *sin,
+            std::vector<double> *cos) {
+  if (sin != nullptr) {
+    sin->resize(angles.size());
+  }
+  if (cos != nullptr) {
+    cos->resize(angles.size());
+  }
+  SinCos(angles.data(), angles.size(), sin == nullptr ? nullptr : sin->data(),
+         cos == nullptr ? nullptr : cos->data());
+}
+
+void Atan2(const double *y, const double *x, const size_t num,
+           double *angles) {
+  for (size_t i = 0; i < num; ++i) {
+    angles[i] = FastAtan2(y[i], x[i]);
+  }
+}
+
+void Atan2(const std::vector<double> &y, const std::vector<double> &x,
+           std::vector<double> *angles) {
+  CHECK_EQ(y.size(), x.size());
+  angles->resize(y.size());
+  Atan2(y.data(), x.data(), y.size(), angles->data());
+}
+
+void Hypot(const double *x, const double *y, const size_t num,
+           double *lengths) {
+  for (size_t i = 0; i < num; ++i) {
+    lengths[i] = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+  }
+}
+
+void Hypot(const std::vector<double> &x, const std::vector<double> &y,
+           std::vector<double> *lengths) {
+  CHECK_EQ(x.size(), y.size());
+  lengths->resize(x.size());
+  Hypot(x.data(), y.data(), x.size(), lengths->data());
+}
+
+void Lerp(const double *x0, const double *x1, const double *weights,
+          const size_t num, double *x) {
+  for (size_t i = 0; i < num; ++i) {
+    x[i] = (1.0 - weights[i]) * x0[i] + weights[i] * x1[i];
+  }
+}
+
+void Slerp(const double *a0, const double *a1, const double *weights,
+           const size_t num, double *a) {
+  for (size_t i = 0; i < num; ++i) {
+    const double a0_n = SignedAngle(a0[i]);
+    double d = SignedAngle(a1[i]) - a0_n;
+    d = d > M_PI ? d - 2.0 * M_PI : d;
+    d = d < -M_PI ? d + 2.0 * M_PI : d;
+    a[i] = SignedAngle(a0_n + d * weights[i]);
+  }
+}
+
+void InterpolatePathPoints(const std::vector<PathPoint> &path,
+                           const std::vector<double> &s,
+                           std::vector<PathPoint> *points) {
+  CHECK_GE(path.size(), 2U);
+  // the fields of the path in arrays of their own, which are denser in the
+  // cache than the protos
+  enum Field { X, Y, THETA, KAPPA, DKAPPA, DDKAPPA, FIELD_NUM };
+  const size_t path_size = path.size();
+  std::vector<double> path_s(path_size);
+  std::vector<double> path_fields(FIELD_NUM * path_size);
+  for (size_t i = 0; i < path_size; ++i) {
+    path_s[i] = path[i].s();
+    path_fields[X * path_size + i] = path[i].x();
+    path_fields[Y * path_size + i] = path[i].y();
+    path_fields[THETA * path_size + i] = path[i].theta();
+    path_fields[KAPPA * path_size + i] = path[i].kappa();
+    path_fields[DKAPPA * path_size + i] = path[i].dkappa();
+    path_fields[DDKAPPA * path_size + i] = path[i].ddkappa();
+  }
+  points->resize(s.size());
+
+  // points are interpolated in chunks, the enclosing pairs of points of a
+  // chunk gathered into arrays which stay in the cache
+  constexpr size_t kChunkSize = 64;
+  size_t indices[kChunkSize];
+  double first[kChunkSize];
+  double second[kChunkSize];
+  double values[FIELD_NUM][kChunkSize];
+  double weights[kChunkSize];
+  size_t index = 0;
+  for (size_t begin = 0; begin < s.size(); begin += kChunkSize) {
+    const size_t num = std::min(kChunkSize, s.size() - begin);
+    for (size_t i = 0; i < num; ++i) {
+      const double query_s = s[begin + i];
+      // sorted s only moves the index forward by a few points, other s are
+      // searched for without branches on the comparisons
+      if (query_s < path_s[index] || query_s >= path_s[index + 1]) {
+        const double *base = path_s.data();
+        size_t size = path_size - 1;
+        while (size > 1) {
+          const size_t half = size / 2;
+          base = base[half] <= query_s ? base + half : base;
+          size -= half;
+        }
+        index = base - path_s.data();
+      }
+      indices[i] = index;
+      const double ds = path_s[index + 1] - path_s[index];
+      weights[i] =
+          std::fabs(ds) <= kMathEpsilon ? 0.0 : (query_s - path_s[index]) / ds;
+    }
+
+    for (int field = X; field < FIELD_NUM; ++field) {
+      const double *field_values = path_fields.data() + field * path_size;
+      for (size_t i = 0; i < num; ++i) {
+        first[i] = field_values[indices[i]];
+        second[i] = field_values[indices[i] + 1];
+      }
+      if (field == THETA) {
+        Slerp(first, second, weights, num, values[field]);
+      } else {
+        Lerp(first, second, weights, num, values[field]);
+      }
+    }
+
+    for (size_t i = 0; i < num; ++i) {
+      PathPoint &point = (*points)[begin + i];
+      point.Clear();
+      point.set_x(values[X][i]);
+      point.set_y(values[Y][i]);
+      point.set_theta(values[THETA][i]);
+      point.set_kappa(values[KAPPA][i]);
+      point.set_dkappa(values[DKAPPA][i]);
+      point.set_ddkappa(values[DDKAPPA][i]);
+      point.set_s(s[begin + i]);
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
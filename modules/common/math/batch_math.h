@@ -0,0 +1,211 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Trigonometric and interpolation kernels over arrays.
+ *
+ * The kernels have no branches and no calls into libm, so that the compiler
+ * vectorizes their loops. Over finite inputs sin and cos are within 2.3e-16
+ * and atan2 within 4.5e-16 (absolute) of their std:: counterparts. SinCos
+ * keeps this accuracy for angles up to kMaxBatchAngle in magnitude and passes
+ * larger ones on to std::sin and std::cos. Signed zeros are not told apart,
+ * Atan2(0, -0) is 0.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "modules/common_msgs/basic_msgs/pnc_point.pb.h"
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+// The argument reduction of SinCos keeps its accuracy up to this angle.
+constexpr double kMaxBatchAngle = 1.0e5;
+
+namespace internal {
+
+// sin(x) and cos(x) for |x| <= pi / 4, the polynomials of Cephes
+inline double SinKernel(const double x) {
+  const double z = x * x;
+  return x + x * z *
+                 ((((((1.58962301576546568060e-10 * z -
+                       2.50507477628578072866e-8) *
+                          z +
+                      2.75573136213857245213e-6) *
+                         z -
+                     1.98412698295895385996e-4) *
+                        z +
+                    8.33333333332211858878e-3) *
+                       z -
+                   1.66666666666666307295e-1));
+}
+
+inline double CosKernel(const double x) {
+  const double z = x * x;
+  return 1.0 - 0.5 * z +
+         z * z *
+             (((((-1.13585365213876817300e-11 * z +
+                  2.08757008419747316778e-9) *
+                     z -
+                 2.75573141792967388112e-7) *
+                    z +
+                2.48015872888517045348e-5) *
+                   z -
+               1.38888888888730564116e-3) *
+                  z +
+              4.16666666666665929218e-2);
+}
+
+// atan(x) for |x| <= tan(pi / 8)
+inline double AtanKernel(const double x) {
+  const double z = x * x;
+  const double p = (((-8.750608600031904122785e-1 * z -
+                      1.615753718733365076637e1) *
+                         z -
+                     7.500855792314704667340e1) *
+                        z -
+                    1.228866684490136173410e2) *
+                       z -
+                   6.485021904942025371773e1;
+  const double q = ((((z + 2.485846490142306297962e1) * z +
+                      1.650270098316988542046e2) *
+                         z +
+                     4.328810604912902668951e2) *
+                        z +
+                    4.853903996359136964868e2) *
+                       z +
+                   1.945506571482613964425e2;
+  return x + x * z * p / q;
+}
+
+}  // namespace internal
+
+/**
+ * @brief Sine and cosine of an angle, see kMaxBatchAngle for the range.
+ * Angles beyond it, and NaN, give the sine and cosine of 0.
+ */
+inline void FastSinCos(const double angle, double *sin, double *cos) {
+  // out of range angles are replaced before the reduction, their quadrant
+  // would not fit the int it is converted to
+  const double x = std::fabs(angle) <= kMaxBatchAngle ? angle : 0.0;
+  // x = quadrant * pi / 2 + r, pi / 2 in three parts of which the products
+  // with quadrant are exact
+  constexpr double kTwoOverPi = 0.63661977236758134308;
+  constexpr double kPiOverTwo1 = 1.57079625129699707031;
+  constexpr double kPiOverTwo2 = 7.54978941586159635335e-8;
+  constexpr double kPiOverTwo3 = 5.39030285815811905290e-15;
+  // rounds to the nearest integer without a call to libm
+  constexpr double kRound = 6755399441055744.0;
+  const double quadrant = (x * kTwoOverPi + kRound) - kRound;
+  const double r = ((x - quadrant * kPiOverTwo1) -
+                    quadrant * kPiOverTwo2) -
+                   quadrant * kPiOverTwo3;
+  const double s = internal::SinKernel(r);
+  const double c = internal::CosKernel(r);
+  const int q = static_cast<int>(quadrant) & 3;
+  const double swapped_sin = (q & 1) ? c : s;
+  const double swapped_cos = (q & 1) ? s : c;
+  *sin = (q & 2) ? -swapped_sin : swapped_sin;
+  *cos = ((q + 1) & 2) ? -swapped_cos : swapped_cos;
+}
+
+/**
+ * @brief atan2(y, x) in [-pi, pi] of finite y and x.
+ */
+inline double FastAtan2(const double y, const double x) {
+  constexpr double kTanPiOverEight = 0.41421356237309504880;
+  constexpr double kPiOverFour = 0.78539816339744830962;
+  // the part of pi / 4 beyond its double
+  constexpr double kPiOverFourLow = 3.061616997868382943e-17;
+  const double abs_x = std::fabs(x);
+  const double abs_y = std::fabs(y);
+  const double max = abs_x > abs_y ? abs_x : abs_y;
+  const double min = abs_x > abs_y ? abs_y : abs_x;
+  // a in [0, 1], atan(a) in [0, pi / 4]
+  const double a = max > 0.0 ? min / max : 0.0;
+  const bool reduced = a > kTanPiOverEight;
+  const double t = reduced ? (a - 1.0) / (a + 1.0) : a;
+  double angle = internal::AtanKernel(t);
+  angle = reduced ? kPiOverFour + (angle + kPiOverFourLow) : angle;
+  angle = abs_y > abs_x ? M_PI_2 - angle : angle;
+  angle = x < 0.0 ? M_PI - angle : angle;
+  return y < 0.0 ? -angle : angle;
+}
+
+/**
+ * @brief Batched sin and cos of num angles, either output may be nullptr.
+ */
+void SinCos(const double *angles, const size_t num, double *sin, double *cos);
+
+void SinCos(const std::vector<double> &angles, std::vector<double> *sin,
+            std::vector<double> *cos);
+
+/**
+ * @brief Batched atan2(y[i], x[i]).
+ */
+void Atan2(const double *y, const double *x, const size_t num, double *angles);
+
+void Atan2(const std::vector<double> &y, const std::vector<double> &x,
+           std::vector<double> *angles);
+
+/**
+ * @brief Batched sqrt(x[i]^2 + y[i]^2). Unlike std::hypot, squares of
+ * magnitudes beyond 1e154 overflow.
+ */
+void Hypot(const double *x, const double *y, const size_t num,
+           double *lengths);
+
+void Hypot(const std::vector<double> &x, const std::vector<double> &y,
+           std::vector<double> *lengths);
+
+/**
+ * @brief Batched x0[i] + weights[i] * (x1[i] - x0[i]).
+ */
+void Lerp(const double *x0, const double *x1, const double *weights,
+          const size_t num, double *x);
+
+/**
+ * @brief Batched interpolation of angles along the shorter arc, normalized
+ * to [-pi, pi), the batched counterpart of slerp.
+ */
+void Slerp(const double *a0, const double *a1, const double *weights,
+           const size_t num, double *a);
+
+/**
+ * @brief Path points at the given s, linearly interpolated between the
+ * points of a path sorted by s, and extrapolated beyond both of its ends,
+ * like InterpolateUsingLinearApproximation on the enclosing pair of points.
+ * @param path The path with at least two points.
+ * @param s The s of the points to interpolate, in any order.
+ * @param points The interpolated points, one for each s.
+ */
+void InterpolatePathPoints(const std::vector<PathPoint> &path,
+                           const std::vector<double> &s,
+                           std::vector<PathPoint> *points);
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,182 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/math/batch_math.h"
+#include "modules/common/math/linear_interpolation.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+std::vector<double> RandomValues(int64_t num, double min, double max) {
+  std::mt19937 engine(static_cast<unsigned int>(num));
+  std::uniform_real_distribution<double> distribution(min, max);
+  std::vector<double> values(num);
+  for (auto& value : values) {
+    value = distribution(engine);
+  }
+  return values;
+}
+
+void BM_StdSinCos(benchmark::State& state) {  // NOLINT
+  const auto angles = RandomValues(state.range(0), -M_PI, M_PI);
+  std::vector<double> sin(angles.size());
+  std::vector<double> cos(angles.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < angles.size(); ++i) {
+      sin[i] = std::sin(angles[i]);
+      cos[i] = std::cos(angles[i]);
+    }
+    benchmark::DoNotOptimize(sin.data());
+    benchmark::DoNotOptimize(cos.data());
+  }
+  state.SetItemsProcessed(state.iterations() * angles.size());
+}
+
+void BM_BatchSinCos(benchmark::State& state) {  // NOLINT
+  const auto angles = RandomValues(state.range(0), -M_PI, M_PI);
+  std::vector<double> sin;
+  std::vector<double> cos;
+  for (auto _ : state) {
+    SinCos(angles, &sin, &cos);
+    benchmark::DoNotOptimize(sin.data());
+    benchmark::DoNotOptimize(cos.data());
+  }
+  state.SetItemsProcessed(state.iterations() * angles.size());
+}
+
+void BM_StdAtan2(benchmark::State& state) {  // NOLINT
+  const auto y = RandomValues(state.range(0), -10.0, 10.0);
+  const auto x = RandomValues(state.range(0) + 1, -10.0, 10.0);
+  std::vector<double> angles(y.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < y.size(); ++i) {
+      angles[i] = std::atan2(y[i], x[i]);
+    }
+    benchmark::DoNotOptimize(angles.data());
+  }
+  state.SetItemsProcessed(state.iterations() * y.size());
+}
+
+void BM_BatchAtan2(benchmark::State& state) {  // NOLINT
+  const auto y = RandomValues(state.range(0), -10.0, 10.0);
+  auto x = RandomValues(state.range(0) + 1, -10.0, 10.0);
+  x.pop_back();
+  std::vector<double> angles;
+  for (auto _ : state) {
+    Atan2(y, x, &angles);
+    benchmark::DoNotOptimize(angles.data());
+  }
+  state.SetItemsProcessed(state.iterations() * y.size());
+}
+
+void BM_StdHypot(benchmark::State& state) {  // NOLINT
+  const auto x = RandomValues(state.range(0), -10.0, 10.0);
+  const auto y = RandomValues(state.range(0) + 1, -10.0, 10.0);
+  std::vector<double> lengths(x.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < x.size(); ++i) {
+      lengths[i] = std::hypot(x[i], y[i]);
+    }
+    benchmark::DoNotOptimize(lengths.data());
+  }
+  state.SetItemsProcessed(state.iterations() * x.size());
+}
+
+void BM_BatchHypot(benchmark::State& state) {  // NOLINT
+  const auto x = RandomValues(state.range(0), -10.0, 10.0);
+  auto y = RandomValues(state.range(0) + 1, -10.0, 10.0);
+  y.pop_back();
+  std::vector<double> lengths;
+  for (auto _ : state) {
+    Hypot(x, y, &lengths);
+    benchmark::DoNotOptimize(lengths.data());
+  }
+  state.SetItemsProcessed(state.iterations() * x.size());
+}
+
+std::vector<PathPoint> Path(int64_t num) {
+  std::vector<PathPoint> path;
+  for (int64_t i = 0; i < num; ++i) {
+    const double s = 0.5 * static_cast<double>(i);
+    PathPoint point;
+    point.set_x(s);
+    point.set_y(10.0 * std::sin(s / 50.0));
+    point.set_theta(std::atan(0.2 * std::cos(s / 50.0)));
+    point.set_kappa(0.01);
+    point.set_s(s);
+    path.push_back(point);
+  }
+  return path;
+}
+
+void BM_InterpolateUsingLinearApproximation(
+    benchmark::State& state) {  // NOLINT
+  const auto path = Path(1000);
+  const auto s = RandomValues(state.range(0), 0.0, path.back().s());
+  std::vector<PathPoint> points(s.size());
+  auto comp = [](const double s, const PathPoint& point) {
+    return s < point.s();
+  };
+  for (auto _ : state) {
+    for (size_t i = 0; i < s.size(); ++i) {
+      // the search of DiscretizedPath::Evaluate
+      const size_t upper = std::upper_bound(path.begin() + 1, path.end() - 1,
+                                            s[i], comp) -
+                           path.begin();
+      const size_t index = upper - 1;
+      points[i] = InterpolateUsingLinearApproximation(path[index],
+                                                      path[index + 1], s[i]);
+    }
+    benchmark::DoNotOptimize(points.data());
+  }
+  state.SetItemsProcessed(state.iterations() * s.size());
+}
+
+void BM_InterpolatePathPoints(benchmark::State& state) {  // NOLINT
+  const auto path = Path(1000);
+  const auto s = RandomValues(state.range(0), 0.0, path.back().s());
+  std::vector<PathPoint> points;
+  for (auto _ : state) {
+    InterpolatePathPoints(path, s, &points);
+    benchmark::DoNotOptimize(points.data());
+  }
+  state.SetItemsProcessed(state.iterations() * s.size());
+}
+
+BENCHMARK(BM_StdSinCos)->Range(64, 1 << 14);
+BENCHMARK(BM_BatchSinCos)->Range(64, 1 << 14);
+BENCHMARK(BM_StdAtan2)->Range(64, 1 << 14);
+BENCHMARK(BM_BatchAtan2)->Range(64, 1 << 14);
+BENCHMARK(BM_StdHypot)->Range(64, 1 << 14);
+BENCHMARK(BM_BatchHypot)->Range(64, 1 << 14);
+BENCHMARK(BM_InterpolateUsingLinearApproximation)->Range(64, 1 << 12);
+BENCHMARK(BM_InterpolatePathPoints)->Range(64, 1 << 12);
+
+}  // namespace
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -0,0 +1,192 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/batch_math.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/common/math/linear_interpolation.h"
+#include "modules/common/math/math_utils.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+std::vector<double> RandomValues(const size_t num, const double min,
+                                 const double max) {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> distribution(min, max);
+  std::vector<double> values(num);
+  for (auto &value : values) {
+    value = distribution(generator);
+  }
+  return values;
+}
+
+}  // namespace
+
+TEST(BatchMathTest, SinCos) {
+  auto angles = RandomValues(100000, -100.0, 100.0);
+  // quadrant boundaries, zero and both ends of the reduction
+  for (int i = -8; i <= 8; ++i) {
+    angles.push_back(i * M_PI_4);
+  }
+  angles.push_back(kMaxBatchAngle);
+  angles.push_back(-kMaxBatchAngle);
+  angles.push_back(3.0 * kMaxBatchAngle);
+  angles.push_back(1.0e-300);
+
+  std::vector<double> sin;
+  std::vector<double> cos;
+  SinCos(angles, &sin, &cos);
+  ASSERT_EQ(angles.size(), sin.size());
+  ASSERT_EQ(angles.size(), cos.size());
+  double max_error = 0.0;
+  for (size_t i = 0; i < angles.size(); ++i) {
+    max_error = std::max(max_error, std::fabs(sin[i] - std::sin(angles[i])));
+    max_error = std::max(max_error, std::fabs(cos[i] - std::cos(angles[i])));
+  }
+  EXPECT_LE(max_error, 2.3e-16);
+
+  std::vector<double> sin_only;
+  SinCos(angles, &sin_only, nullptr);
+  for (size_t i = 0; i < angles.size(); ++i) {
+    EXPECT_EQ(sin[i], sin_only[i]);
+  }
+}
+
+TEST(BatchMathTest, SinCosHugeAngles) {
+  // far beyond the range of an int quadrant, run under ubsan by
+  // batch_math_ubsan_test
+  const std::vector<double> angles = {1.0e10, -1.0e10, 6.0e15, 1.0e300};
+  std::vector<double> sin;
+  std::vector<double> cos;
+  SinCos(angles, &sin, &cos);
+  for (size_t i = 0; i < angles.size(); ++i) {
+    EXPECT_EQ(std::sin(angles[i]), sin[i]);
+    EXPECT_EQ(std::cos(angles[i]), cos[i]);
+  }
+
+  double s = 1.0;
+  double c = 0.0;
+  FastSinCos(1.0e10, &s, &c);
+  EXPECT_EQ(0.0, s);
+  EXPECT_EQ(1.0, c);
+}
+
+TEST(BatchMathTest, SinCosSmallAngles) {
+  const auto angles = RandomValues(100000, -2.0 * M_PI, 2.0 * M_PI);
+  std::vector<double> sin;
+  std::vector<double> cos;
+  SinCos(angles, &sin, &cos);
+  for (size_t i = 0; i < angles.size(); ++i) {
+    EXPECT_NEAR(std::sin(angles[i]), sin[i], 2.3e-16);
+    EXPECT_NEAR(std::cos(angles[i]), cos[i], 2.3e-16);
+  }
+}
+
+TEST(BatchMathTest, Atan2) {
+  auto y = RandomValues(100000, -50.0, 50.0);
+  auto x = RandomValues(100000, -50.0, 50.0);
+  std::reverse(x.begin(), x.end());
+  // axes, diagonals and the origin
+  const std::vector<double> special = {0.0, 1.0, -1.0, 1e-300, -3.0};
+  for (double sy : special) {
+    for (double sx : special) {
+      y.push_back(sy);
+      x.push_back(sx);
+    }
+  }
+  std::vector<double> angles;
+  Atan2(y, x, &angles);
+  ASSERT_EQ(y.size(), angles.size());
+  for (size_t i = 0; i < y.size(); ++i) {
+    EXPECT_NEAR(std::atan2(y[i], x[i]), angles[i], 4.5e-16)
+        << "y: " << y[i] << " x: " << x[i];
+  }
+}
+
+TEST(BatchMathTest, Hypot) {
+  const auto x = RandomValues(1000, -1e6, 1e6);
+  const auto y = RandomValues(1000, -1e-3, 1e-3);
+  std::vector<double> lengths;
+  Hypot(x, y, &lengths);
+  for (size_t i = 0; i < x.size(); ++i) {
+    EXPECT_NEAR(std::hypot(x[i], y[i]), lengths[i],
+                2e-16 * std::fabs(lengths[i]));
+  }
+}
+
+TEST(BatchMathTest, Slerp) {
+  const size_t num = 10000;
+  const auto a0 = RandomValues(num, -10.0, 10.0);
+  auto a1 = RandomValues(num, -10.0, 10.0);
+  std::reverse(a1.begin(), a1.end());
+  const auto weights = RandomValues(num, -0.5, 1.5);
+  std::vector<double> a(num);
+  Slerp(a0.data(), a1.data(), weights.data(), num, a.data());
+  for (size_t i = 0; i < num; ++i) {
+    const double expected = slerp(a0[i], 0.0, a1[i], 1.0, weights[i]);
+    // the same angle on either side of -pi
+    EXPECT_NEAR(0.0, NormalizeAngle(expected - a[i]), 1e-12);
+    EXPECT_GE(a[i], -M_PI);
+    EXPECT_LT(a[i], M_PI);
+  }
+}
+
+TEST(BatchMathTest, InterpolatePathPoints) {
+  std::vector<PathPoint> path;
+  for (int i = 0; i < 50; ++i) {
+    PathPoint point;
+    point.set_s(0.5 * i);
+    point.set_x(std::cos(0.1 * i) * 10.0);
+    point.set_y(std::sin(0.1 * i) * 10.0);
+    point.set_theta(NormalizeAngle(0.1 * i + M_PI_2));
+    point.set_kappa(0.1);
+    point.set_dkappa(0.01 * i);
+    point.set_ddkappa(-0.001 * i);
+    path.push_back(point);
+  }
+  const auto s = RandomValues(1000, -1.0, 26.0);
+  std::vector<PathPoint> points;
+  InterpolatePathPoints(path, s, &points);
+  ASSERT_EQ(s.size(), points.size());
+  for (size_t i = 0; i < s.size(); ++i) {
+    size_t index = 0;
+    while (index + 2 < path.size() && path[index + 1].s() <= s[i]) {
+      ++index;
+    }
+    const auto expected =
+        InterpolateUsingLinearApproximation(path[index], path[index + 1], s[i]);
+    EXPECT_NEAR(expected.x(), points[i].x(), 1e-12);
+    EXPECT_NEAR(expected.y(), points[i].y(), 1e-12);
+    EXPECT_NEAR(0.0, NormalizeAngle(expected.theta() - points[i].theta()),
+                1e-12);
+    EXPECT_NEAR(expected.kappa(), points[i].kappa(), 1e-12);
+    EXPECT_NEAR(expected.dkappa(), points[i].dkappa(), 1e-12);
+    EXPECT_NEAR(expected.ddkappa(), points[i].ddkappa(), 1e-12);
+    EXPECT_DOUBLE_EQ(s[i], points[i].s());
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
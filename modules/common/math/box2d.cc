@@ -18,13 +18,13 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <utility>
 
 #include "absl/strings/str_cat.h"
 #include "cyber/common/log.h"
 
 #include "modules/common/math/math_utils.h"
-#include "modules/common/math/polygon2d.h"
 
 namespace apollo {
 namespace common {
@@ -48,6 +48,43 @@ double PtSegDistance(double query_x, double query_y, double start_x,
   return std::abs(x0 * dy - y0 * dx) / length;
 }
 
+// The separating axis test of two boxes whose axis-aligned bounding boxes
+// overlap. The four axes are tested without short-circuiting, since the
+// projections are cheaper to compute together than to branch on.
+bool SeparatingAxisOverlap(const Box2d &box1, const Box2d &box2) {
+  const double shift_x = box2.center_x() - box1.center_x();
+  const double shift_y = box2.center_y() - box1.center_y();
+  const double cos1 = box1.cos_heading();
+  const double sin1 = box1.sin_heading();
+  const double cos2 = box2.cos_heading();
+  const double sin2 = box2.sin_heading();
+
+  const double dx1 = cos1 * box1.half_length();
+  const double dy1 = sin1 * box1.half_length();
+  const double dx2 = sin1 * box1.half_width();
+  const double dy2 = -cos1 * box1.half_width();
+  const double dx3 = cos2 * box2.half_length();
+  const double dy3 = sin2 * box2.half_length();
+  const double dx4 = sin2 * box2.half_width();
+  const double dy4 = -cos2 * box2.half_width();
+
+  const bool axis1 = std::abs(shift_x * cos1 + shift_y * sin1) <=
+                     std::abs(dx3 * cos1 + dy3 * sin1) +
+                         std::abs(dx4 * cos1 + dy4 * sin1) +
+                         box1.half_length();
+  const bool axis2 = std::abs(shift_x * sin1 - shift_y * cos1) <=
+                     std::abs(dx3 * sin1 - dy3 * cos1) +
+                         std::abs(dx4 * sin1 - dy4 * cos1) + box1.half_width();
+  const bool axis3 = std::abs(shift_x * cos2 + shift_y * sin2) <=
+                     std::abs(dx1 * cos2 + dy1 * sin2) +
+                         std::abs(dx2 * cos2 + dy2 * sin2) +
+                         box2.half_length();
+  const bool axis4 = std::abs(shift_x * sin2 - shift_y * cos2) <=
+                     std::abs(dx1 * sin2 - dy1 * cos2) +
+                         std::abs(dx2 * sin2 - dy2 * cos2) + box2.half_width();
+  return axis1 & axis2 & axis3 & axis4;
+}
+
 }  // namespace
 
 Box2d::Box2d(const Vec2d &center, const double heading, const double length,
@@ -84,12 +121,16 @@ void Box2d::InitCorners() {
   const double dy1 = sin_heading_ * half_length_;
   const double dx2 = sin_heading_ * half_width_;
   const double dy2 = -cos_heading_ * half_width_;
-  corners_.clear();
-  corners_.emplace_back(center_.x() + dx1 + dx2, center_.y() + dy1 + dy2);
-  corners_.emplace_back(center_.x() + dx1 - dx2, center_.y() + dy1 - dy2);
-  corners_.emplace_back(center_.x() - dx1 - dx2, center_.y() - dy1 - dy2);
-  corners_.emplace_back(center_.x() - dx1 + dx2, center_.y() - dy1 + dy2);
-
+  corners_[0] = Vec2d(center_.x() + dx1 + dx2, center_.y() + dy1 + dy2);
+  corners_[1] = Vec2d(center_.x() + dx1 - dx2, center_.y() + dy1 - dy2);
+  corners_[2] = Vec2d(center_.x() - dx1 - dx2, center_.y() - dy1 - dy2);
+  corners_[3] = Vec2d(center_.x() - dx1 + dx2, center_.y() - dy1 + dy2);
+
+  // the extremes are recomputed, a box may have been moved or rotated
+  max_x_ = std::numeric_limits<double>::lowest();
+  min_x_ = std::numeric_limits<double>::max();
+  max_y_ = std::numeric_limits<double>::lowest();
+  min_y_ = std::numeric_limits<double>::max();
   for (auto &corner : corners_) {
     max_x_ = std::fmax(corner.x(), max_x_);
     min_x_ = std::fmin(corner.x(), min_x_);
@@ -109,6 +150,7 @@ Box2d::Box2d(const AABox2d &aabox)
       sin_heading_(0.0) {
   CHECK_GT(length_, -kMathEpsilon);
   CHECK_GT(width_, -kMathEpsilon);
+  InitCorners();
 }
 
 Box2d Box2d::CreateAABox(const Vec2d &one_corner,
@@ -124,10 +166,12 @@ void Box2d::GetAllCorners(std::vector<Vec2d> *const corners) const {
   if (corners == nullptr) {
     return;
   }
-  *corners = corners_;
+  corners->assign(corners_.begin(), corners_.end());
 }
 
-std::vector<Vec2d> Box2d::GetAllCorners() const { return corners_; }
+std::vector<Vec2d> Box2d::GetAllCorners() const {
+  return std::vector<Vec2d>(corners_.begin(), corners_.end());
+}
 
 bool Box2d::IsPointIn(const Vec2d &point) const {
   const double x0 = point.x() - center_.x();
@@ -272,7 +316,19 @@ double Box2d::DistanceTo(const LineSegment2d &line_segment) const {
 }
 
 double Box2d::DistanceTo(const Box2d &box) const {
-  return Polygon2d(box).DistanceTo(*this);
+  if (HasOverlap(box)) {
+    return 0.0;
+  }
+  // The closest points of two disjoint convex polygons include a corner of
+  // one of them, so the distance is the smallest corner to box distance.
+  double distance = std::numeric_limits<double>::infinity();
+  for (const auto &corner : box.corners_) {
+    distance = std::min(distance, DistanceTo(corner));
+  }
+  for (const auto &corner : corners_) {
+    distance = std::min(distance, box.DistanceTo(corner));
+  }
+  return distance;
 }
 
 bool Box2d::HasOverlap(const Box2d &box) const {
@@ -280,35 +336,25 @@ bool Box2d::HasOverlap(const Box2d &box) const {
       box.min_y() > max_y()) {
     return false;
   }
+  return SeparatingAxisOverlap(*this, box);
+}
 
-  const double shift_x = box.center_x() - center_.x();
-  const double shift_y = box.center_y() - center_.y();
+bool Box2d::HasOverlap(absl::Span<const Box2d> boxes) const {
+  // Most boxes are rejected by the bounding box test, so the loop keeps its
+  // early exits, a branch free loop over all the tests is several times
+  // slower.
+  return std::any_of(boxes.begin(), boxes.end(),
+                     [this](const Box2d &box) { return HasOverlap(box); });
+}
 
-  const double dx1 = cos_heading_ * half_length_;
-  const double dy1 = sin_heading_ * half_length_;
-  const double dx2 = sin_heading_ * half_width_;
-  const double dy2 = -cos_heading_ * half_width_;
-  const double dx3 = box.cos_heading() * box.half_length();
-  const double dy3 = box.sin_heading() * box.half_length();
-  const double dx4 = box.sin_heading() * box.half_width();
-  const double dy4 = -box.cos_heading() * box.half_width();
-
-  return std::abs(shift_x * cos_heading_ + shift_y * sin_heading_) <=
-             std::abs(dx3 * cos_heading_ + dy3 * sin_heading_) +
-                 std::abs(dx4 * cos_heading_ + dy4 * sin_heading_) +
-                 half_length_ &&
-         std::abs(shift_x * sin_heading_ - shift_y * cos_heading_) <=
-             std::abs(dx3 * sin_heading_ - dy3 * cos_heading_) +
-                 std::abs(dx4 * sin_heading_ - dy4 * cos_heading_) +
-                 half_width_ &&
-         std::abs(shift_x * box.cos_heading() + shift_y * box.sin_heading()) <=
-             std::abs(dx1 * box.cos_heading() + dy1 * box.sin_heading()) +
-                 std::abs(dx2 * box.cos_heading() + dy2 * box.sin_heading()) +
-                 box.half_length() &&
-         std::abs(shift_x * box.sin_heading() - shift_y * box.cos_heading()) <=
-             std::abs(dx1 * box.sin_heading() - dy1 * box.cos_heading()) +
-                 std::abs(dx2 * box.sin_heading() - dy2 * box.cos_heading()) +
-                 box.half_width();
+void Box2d::GetOverlaps(absl::Span<const Box2d> boxes,
+                        std::vector<size_t> *const overlap_indices) const {
+  overlap_indices->clear();
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    if (HasOverlap(boxes[i])) {
+      overlap_indices->push_back(i);
+    }
+  }
 }
 
 AABox2d Box2d::GetAABox() const {
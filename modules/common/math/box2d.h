@@ -22,10 +22,13 @@
 
 #pragma once
 
+#include <array>
 #include <limits>
 #include <string>
 #include <vector>
 
+#include "absl/types/span.h"
+
 #include "modules/common/math/aabox2d.h"
 #include "modules/common/math/line_segment2d.h"
 #include "modules/common/math/vec2d.h"
@@ -170,6 +173,12 @@ class Box2d {
    */
   std::vector<Vec2d> GetAllCorners() const;
 
+  /**
+   * @brief Getter of the corners of the box, without copying them
+   * @return The corners of the box, in the same order as GetAllCorners
+   */
+  const std::array<Vec2d, 4> &corners() const { return corners_; }
+
   /**
    * @brief Tests points for membership in the box
    * @param point A point that we wish to test for membership in the box
@@ -219,6 +228,22 @@ class Box2d {
    */
   bool HasOverlap(const Box2d &box) const;
 
+  /**
+   * @brief Determines whether this box overlaps any of the given boxes
+   * @param boxes The other boxes
+   * @return True if it overlaps at least one of them
+   */
+  bool HasOverlap(absl::Span<const Box2d> boxes) const;
+
+  /**
+   * @brief Finds the boxes which overlap this box
+   * @param boxes The other boxes
+   * @param overlap_indices The indices of the boxes overlapping this box, in
+   *        increasing order
+   */
+  void GetOverlaps(absl::Span<const Box2d> boxes,
+                   std::vector<size_t> *const overlap_indices) const;
+
   /**
    * @brief Gets the smallest axes-aligned box containing the current one
    * @return An axes-aligned box
@@ -268,7 +293,7 @@ class Box2d {
   double cos_heading_ = 1.0;
   double sin_heading_ = 0.0;
 
-  std::vector<Vec2d> corners_;
+  std::array<Vec2d, 4> corners_;
 
   double max_x_ = std::numeric_limits<double>::lowest();
   double min_x_ = std::numeric_limits<double>::max();
@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/math/box2d.h"
+#include "modules/common/math/polygon2d.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+// Obstacle sized boxes scattered around the ego box, a few of them overlap.
+std::vector<Box2d> RandomBoxes(int64_t num) {
+  std::mt19937 engine(static_cast<unsigned int>(num));
+  std::uniform_real_distribution<double> position(-50.0, 50.0);
+  std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+  std::uniform_real_distribution<double> size(0.5, 5.0);
+  std::vector<Box2d> boxes;
+  boxes.reserve(num);
+  for (int64_t i = 0; i < num; ++i) {
+    boxes.emplace_back(Vec2d(position(engine), position(engine)),
+                       heading(engine), size(engine), size(engine));
+  }
+  return boxes;
+}
+
+const Box2d kEgoBox({0.0, 0.0}, 0.3, 4.9, 1.9);
+
+void BM_Construct(benchmark::State& state) {  // NOLINT
+  double heading = 0.0;
+  for (auto _ : state) {
+    Box2d box({1.0, 2.0}, heading, 4.9, 1.9);
+    box.Shift({0.5, 0.5});
+    benchmark::DoNotOptimize(box);
+    heading += 0.01;
+  }
+}
+
+void BM_HasOverlap(benchmark::State& state) {  // NOLINT
+  const auto boxes = RandomBoxes(state.range(0));
+  for (auto _ : state) {
+    bool overlap = false;
+    for (const auto& box : boxes) {
+      overlap |= kEgoBox.HasOverlap(box);
+    }
+    benchmark::DoNotOptimize(overlap);
+  }
+  state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+
+void BM_GetOverlaps(benchmark::State& state) {  // NOLINT
+  const auto boxes = RandomBoxes(state.range(0));
+  std::vector<size_t> overlap_indices;
+  for (auto _ : state) {
+    kEgoBox.GetOverlaps(boxes, &overlap_indices);
+    benchmark::DoNotOptimize(overlap_indices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+
+void BM_BatchHasOverlap(benchmark::State& state) {  // NOLINT
+  // only boxes which do not overlap, so that every box is tested
+  std::vector<Box2d> boxes;
+  for (const auto& box : RandomBoxes(state.range(0) * 2)) {
+    if (!kEgoBox.HasOverlap(box) &&
+        boxes.size() < static_cast<size_t>(state.range(0))) {
+      boxes.push_back(box);
+    }
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kEgoBox.HasOverlap(boxes));
+  }
+  state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+
+void BM_BoxDistanceToBox(benchmark::State& state) {  // NOLINT
+  const auto boxes = RandomBoxes(state.range(0));
+  for (auto _ : state) {
+    double distance = 0.0;
+    for (const auto& box : boxes) {
+      distance += kEgoBox.DistanceTo(box);
+    }
+    benchmark::DoNotOptimize(distance);
+  }
+  state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+
+void BM_PolygonDistanceToBox(benchmark::State& state) {  // NOLINT
+  const auto boxes = RandomBoxes(state.range(0));
+  const Polygon2d polygon(kEgoBox);
+  for (auto _ : state) {
+    double distance = 0.0;
+    for (const auto& box : boxes) {
+      distance += polygon.DistanceTo(box);
+    }
+    benchmark::DoNotOptimize(distance);
+  }
+  state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+
+BENCHMARK(BM_Construct);
+BENCHMARK(BM_HasOverlap)->Range(8, 1 << 10);
+BENCHMARK(BM_GetOverlaps)->Range(8, 1 << 10);
+BENCHMARK(BM_BatchHasOverlap)->Range(8, 1 << 10);
+BENCHMARK(BM_BoxDistanceToBox)->Range(8, 1 << 10);
+BENCHMARK(BM_PolygonDistanceToBox)->Range(8, 1 << 10);
+
+}  // namespace
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+BENCHMARK_MAIN();
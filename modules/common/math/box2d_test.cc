@@ -234,6 +234,65 @@ TEST(Box2dTest, RotateFromCenterAndShift) {
   EXPECT_NEAR(corners[3].y(), 38.0, 1e-5);
 }
 
+TEST(Box2dTest, ShiftUpdatesExtremes) {
+  Box2d box({0, 0}, 0, 4, 2);
+  box.Shift({30, 40});
+  EXPECT_NEAR(box.min_x(), 28.0, 1e-5);
+  EXPECT_NEAR(box.max_x(), 32.0, 1e-5);
+  EXPECT_NEAR(box.min_y(), 39.0, 1e-5);
+  EXPECT_NEAR(box.max_y(), 41.0, 1e-5);
+
+  const Box2d aabox(AABox2d({4, 5}, 2, 2));
+  EXPECT_NEAR(aabox.min_x(), 3.0, 1e-5);
+  EXPECT_NEAR(aabox.max_y(), 6.0, 1e-5);
+  EXPECT_TRUE(aabox.HasOverlap(Box2d({4, 4}, 0, 2, 2)));
+  EXPECT_FALSE(aabox.HasOverlap(box1));
+  EXPECT_EQ(4U, aabox.GetAllCorners().size());
+}
+
+TEST(Box2dTest, BatchHasOverlap) {
+  const Box2d box({0, 0}, 0.3, 6, 3);
+  std::vector<Box2d> boxes;
+  for (int i = 0; i < 37; ++i) {
+    boxes.emplace_back(Vec2d(-12.0 + 0.7 * i, 2.0 - 0.11 * i), 0.41 * i,
+                       1.0 + 0.1 * (i % 5), 1.0 + 0.2 * (i % 3));
+  }
+  std::vector<size_t> overlap_indices;
+  box.GetOverlaps(boxes, &overlap_indices);
+  std::vector<size_t> expected_indices;
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    if (box.HasOverlap(boxes[i])) {
+      expected_indices.push_back(i);
+    }
+  }
+  EXPECT_FALSE(expected_indices.empty());
+  EXPECT_LT(expected_indices.size(), boxes.size());
+  EXPECT_EQ(expected_indices, overlap_indices);
+  EXPECT_TRUE(box.HasOverlap(boxes));
+
+  std::vector<Box2d> far_boxes;
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    if (!box.HasOverlap(boxes[i])) {
+      far_boxes.push_back(boxes[i]);
+    }
+  }
+  EXPECT_FALSE(box.HasOverlap(far_boxes));
+  EXPECT_FALSE(box.HasOverlap(std::vector<Box2d>()));
+}
+
+TEST(Box2dTest, DistanceToBox) {
+  const Box2d box({1, -1}, 0.5, 4, 2);
+  const Polygon2d poly(box);
+  for (int i = 0; i < 200; ++i) {
+    const Box2d other(Vec2d(-10.0 + 0.1 * i, 8.0 - 0.09 * i), 0.23 * i,
+                      1.0 + 0.03 * (i % 7), 0.5 + 0.05 * (i % 11));
+    EXPECT_NEAR(poly.DistanceTo(Polygon2d(other)), box.DistanceTo(other),
+                1e-5);
+    EXPECT_NEAR(poly.DistanceTo(Polygon2d(other)), poly.DistanceTo(other),
+                1e-5);
+  }
+}
+
 TEST(Box2dTest, TestByRandom) {
   bool ambiguous = false;
   for (int iter = 0; iter < 10000; ++iter) {
@@ -83,6 +83,37 @@ void CartesianFrenetConverter::cartesian_to_frenet(
   *ptr_s = rs;
 }
 
+void CartesianFrenetConverter::cartesian_to_frenet(
+    const std::vector<double>& rs, const std::vector<double>& rx,
+    const std::vector<double>& ry, const std::vector<double>& rtheta,
+    const std::vector<double>& x, const std::vector<double>& y,
+    std::vector<double>* ptr_s, std::vector<double>* ptr_d) {
+  const std::size_t size = rs.size();
+  CHECK_EQ(size, rx.size());
+  CHECK_EQ(size, ry.size());
+  CHECK_EQ(size, rtheta.size());
+  CHECK_EQ(size, x.size());
+  CHECK_EQ(size, y.size());
+  ptr_s->assign(rs.begin(), rs.end());
+  ptr_d->resize(size);
+
+  // plain arithmetic over the arrays, without calls in between, so that the
+  // loop is left to the vectorizer of the compiler
+  const double* rx_data = rx.data();
+  const double* ry_data = ry.data();
+  const double* rtheta_data = rtheta.data();
+  const double* x_data = x.data();
+  const double* y_data = y.data();
+  double* d_data = ptr_d->data();
+  for (std::size_t i = 0; i < size; ++i) {
+    const double dx = x_data[i] - rx_data[i];
+    const double dy = y_data[i] - ry_data[i];
+    const double cross_rd_nd =
+        std::cos(rtheta_data[i]) * dy - std::sin(rtheta_data[i]) * dx;
+    d_data[i] = std::copysign(std::sqrt(dx * dx + dy * dy), cross_rd_nd);
+  }
+}
+
 void CartesianFrenetConverter::frenet_to_cartesian(
     const double rs, const double rx, const double ry, const double rtheta,
     const double rkappa, const double rdkappa,
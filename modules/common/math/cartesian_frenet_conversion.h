@@ -21,6 +21,7 @@
 #pragma once
 
 #include <array>
+#include <vector>
 
 #include "modules/common/math/vec2d.h"
 
@@ -62,6 +63,20 @@ class CartesianFrenetConverter {
                                   const double x, const double y, double* ptr_s,
                                   double* ptr_d);
 
+  /**
+   * Batch of the above, every input holds one entry per point, rs, rx, ry and
+   * rtheta being those of the matched reference points. The results are
+   * written into ptr_s and ptr_d in the same order.
+   */
+  static void cartesian_to_frenet(const std::vector<double>& rs,
+                                  const std::vector<double>& rx,
+                                  const std::vector<double>& ry,
+                                  const std::vector<double>& rtheta,
+                                  const std::vector<double>& x,
+                                  const std::vector<double>& y,
+                                  std::vector<double>* ptr_s,
+                                  std::vector<double>* ptr_d);
+
   /**
    * Convert a vehicle state in Frenet frame to Cartesian frame.
    * Combine two independent 1d movement w.r.t. reference line to a 2d movement.
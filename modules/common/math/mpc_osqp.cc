@@ -278,12 +278,90 @@ void MpcOsqp::FreeData(OSQPData *data) {
   c_free(data);
 }
 
+void MpcOsqp::ShiftSolution(const OsqpSolver &solver, std::vector<c_float> *x,
+                            std::vector<c_float> *y) const {
+  // blocks of a trajectory over the horizon move one step forward, the last
+  // block is kept
+  auto shift = [](const c_float *from, size_t offset, size_t block_size,
+                  size_t block_num, std::vector<c_float> *to) {
+    for (size_t i = 0; i < block_num; ++i) {
+      const size_t from_block = std::min(i + 1, block_num - 1);
+      std::copy(from + offset + from_block * block_size,
+                from + offset + (from_block + 1) * block_size,
+                to->begin() + offset + i * block_size);
+    }
+  };
+  const size_t state_total_dim = state_dim_ * (horizon_ + 1);
+  x->resize(num_param_);
+  shift(solver.x(), 0, state_dim_, horizon_ + 1, x);
+  shift(solver.x(), state_total_dim, control_dim_, horizon_, x);
+  // dynamics first, then the bounds in the order of x
+  y->resize(state_total_dim + num_param_);
+  shift(solver.y(), 0, state_dim_, horizon_ + 1, y);
+  shift(solver.y(), state_total_dim, state_dim_, horizon_ + 1, y);
+  shift(solver.y(), 2 * state_total_dim, control_dim_, horizon_, y);
+}
+
+bool MpcOsqp::SolveWithSolver(std::vector<double> *control_cmd) {
+  std::vector<c_float> P_data;
+  std::vector<c_int> P_indices;
+  std::vector<c_int> P_indptr;
+  CalculateKernel(&P_data, &P_indices, &P_indptr);
+  std::vector<c_float> A_data;
+  std::vector<c_int> A_indices;
+  std::vector<c_int> A_indptr;
+  CalculateEqualityConstraint(&A_data, &A_indices, &A_indptr);
+  std::vector<c_float> q(gradient_.data(), gradient_.data() + gradient_.size());
+  std::vector<c_float> l(lowerBound_.data(),
+                         lowerBound_.data() + lowerBound_.size());
+  std::vector<c_float> u(upperBound_.data(),
+                         upperBound_.data() + upperBound_.size());
+  ADEBUG << "OSQP data done";
+
+  OSQPSettings *settings = Settings();
+  if (settings == nullptr) {
+    return false;
+  }
+  OsqpSolver *solver = solver_;
+  std::vector<c_float> warm_x;
+  std::vector<c_float> warm_y;
+  if (solver->has_solution() &&
+      solver->n() == static_cast<c_int>(q.size()) &&
+      solver->m() == static_cast<c_int>(l.size())) {
+    ShiftSolution(*solver, &warm_x, &warm_y);
+  }
+
+  const bool setup = solver->Setup(P_data, P_indices, P_indptr, q, A_data,
+                                   A_indices, A_indptr, l, u, *settings);
+  c_free(settings);
+  if (!setup) {
+    return false;
+  }
+  ADEBUG << "OSQP workspace ready, reused: " << solver->reused();
+  if (solver->reused() && !warm_x.empty()) {
+    solver->WarmStart(warm_x, warm_y);
+  }
+  if (!solver->Solve()) {
+    return false;
+  }
+
+  size_t first_control = state_dim_ * (horizon_ + 1);
+  for (size_t i = 0; i < control_dim_; ++i) {
+    control_cmd->at(i) = solver->x()[i + first_control];
+    ADEBUG << "control_cmd:" << i << ":" << control_cmd->at(i);
+  }
+  return true;
+}
+
 bool MpcOsqp::Solve(std::vector<double> *control_cmd) {
   ADEBUG << "Before Calc Gradient";
   CalculateGradient();
   ADEBUG << "After Calc Gradient";
   CalculateConstraintVectors();
   ADEBUG << "MPC2Matrix";
+  if (solver_ != nullptr) {
+    return SolveWithSolver(control_cmd);
+  }
 
   OSQPData *data = Data();
   ADEBUG << "OSQP data done";
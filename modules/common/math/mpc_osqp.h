@@ -26,6 +26,7 @@
 #include "osqp/osqp.h"
 
 #include "cyber/common/log.h"
+#include "modules/common/math/osqp_solver.h"
 
 namespace apollo {
 namespace common {
@@ -55,6 +56,13 @@ class MpcOsqp {
   // control vector
   bool Solve(std::vector<double> *control_cmd);
 
+  /**
+   * @brief Solves with a solver kept by the caller across cycles instead of
+   * a new one. The problem of the previous cycle is updated in place and the
+   * solve starts from its solution shifted by one step of the horizon.
+   */
+  void set_solver(OsqpSolver *solver) { solver_ = solver; }
+
  private:
   void CalculateKernel(std::vector<c_float> *P_data,
                        std::vector<c_int> *P_indices,
@@ -67,6 +75,10 @@ class MpcOsqp {
   OSQPSettings *Settings();
   OSQPData *Data();
   void FreeData(OSQPData *data);
+  bool SolveWithSolver(std::vector<double> *control_cmd);
+  // the previous solution of the solver one step later in the horizon
+  void ShiftSolution(const OsqpSolver &solver, std::vector<c_float> *x,
+                     std::vector<c_float> *y) const;
 
   template <typename T>
   T *CopyData(const std::vector<T> &vec) {
@@ -96,6 +108,7 @@ class MpcOsqp {
   Eigen::VectorXd gradient_;
   Eigen::VectorXd lowerBound_;
   Eigen::VectorXd upperBound_;
+  OsqpSolver *solver_ = nullptr;
 };
 }  // namespace math
 }  // namespace common
@@ -0,0 +1,226 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/osqp_solver.h"
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+OsqpSolver::~OsqpSolver() { Reset(); }
+
+void OsqpSolver::Reset() {
+  if (workspace_ != nullptr) {
+    osqp_cleanup(workspace_);
+    workspace_ = nullptr;
+  }
+  reused_ = false;
+  has_solution_ = false;
+}
+
+bool OsqpSolver::SamePattern(const std::vector<c_int>& P_indices,
+                             const std::vector<c_int>& P_indptr,
+                             const std::vector<c_int>& A_indices,
+                             const std::vector<c_int>& A_indptr,
+                             const size_t n, const size_t m) const {
+  return workspace_ != nullptr && n == q_size_ && m == l_size_ &&
+         P_indptr == P_indptr_ && P_indices == P_indices_ &&
+         A_indptr == A_indptr_ && A_indices == A_indices_ &&
+         // osqp may keep P in a form of its own, the values of P are then
+         // not given in the order of the workspace
+         workspace_->data->P->p[n] == static_cast<c_int>(P_indices.size());
+}
+
+bool OsqpSolver::SameSettings(const OSQPSettings& settings) const {
+  // max_iter, eps_abs and eps_rel are updated in place, all the others are
+  // kept by the workspace from its setup
+  return settings.rho == settings_.rho && settings.sigma == settings_.sigma &&
+         settings.scaling == settings_.scaling &&
+         settings.adaptive_rho == settings_.adaptive_rho &&
+         settings.adaptive_rho_interval == settings_.adaptive_rho_interval &&
+         settings.adaptive_rho_tolerance == settings_.adaptive_rho_tolerance &&
+#ifdef PROFILING
+         settings.adaptive_rho_fraction == settings_.adaptive_rho_fraction &&
+         settings.time_limit == settings_.time_limit &&
+#endif
+         settings.eps_prim_inf == settings_.eps_prim_inf &&
+         settings.eps_dual_inf == settings_.eps_dual_inf &&
+         settings.alpha == settings_.alpha &&
+         settings.linsys_solver == settings_.linsys_solver &&
+         settings.delta == settings_.delta &&
+         settings.polish == settings_.polish &&
+         settings.polish_refine_iter == settings_.polish_refine_iter &&
+         settings.verbose == settings_.verbose &&
+         settings.scaled_termination == settings_.scaled_termination &&
+         settings.check_termination == settings_.check_termination &&
+         settings.warm_start == settings_.warm_start;
+}
+
+bool OsqpSolver::Setup(const std::vector<c_float>& P_data,
+                       const std::vector<c_int>& P_indices,
+                       const std::vector<c_int>& P_indptr,
+                       const std::vector<c_float>& q,
+                       const std::vector<c_float>& A_data,
+                       const std::vector<c_int>& A_indices,
+                       const std::vector<c_int>& A_indptr,
+                       const std::vector<c_float>& l,
+                       const std::vector<c_float>& u,
+                       const OSQPSettings& settings) {
+  const size_t n = q.size();
+  const size_t m = l.size();
+  CHECK_EQ(m, u.size());
+  CHECK_EQ(n + 1, P_indptr.size());
+  CHECK_EQ(n + 1, A_indptr.size());
+
+  if (SamePattern(P_indices, P_indptr, A_indices, A_indptr, n, m) &&
+      SameSettings(settings) && Update(P_data, q, A_data, l, u, settings)) {
+    reused_ = true;
+    return true;
+  }
+
+  Reset();
+  // osqp_setup copies the problem, it is not kept beyond this call
+  OSQPData data;
+  data.n = static_cast<c_int>(n);
+  data.m = static_cast<c_int>(m);
+  data.P = csc_matrix(data.n, data.n, static_cast<c_int>(P_data.size()),
+                      const_cast<c_float*>(P_data.data()),
+                      const_cast<c_int*>(P_indices.data()),
+                      const_cast<c_int*>(P_indptr.data()));
+  data.A = csc_matrix(data.m, data.n, static_cast<c_int>(A_data.size()),
+                      const_cast<c_float*>(A_data.data()),
+                      const_cast<c_int*>(A_indices.data()),
+                      const_cast<c_int*>(A_indptr.data()));
+  data.q = const_cast<c_float*>(q.data());
+  data.l = const_cast<c_float*>(l.data());
+  data.u = const_cast<c_float*>(u.data());
+  settings_ = settings;
+  workspace_ = osqp_setup(&data, &settings_);
+  c_free(data.P);
+  c_free(data.A);
+  if (workspace_ == nullptr) {
+    AERROR << "osqp setup failed.";
+    return false;
+  }
+
+  q_size_ = n;
+  l_size_ = m;
+  P_data_ = P_data;
+  P_indices_ = P_indices;
+  P_indptr_ = P_indptr;
+  A_data_ = A_data;
+  A_indices_ = A_indices;
+  A_indptr_ = A_indptr;
+  return true;
+}
+
+bool OsqpSolver::Update(const std::vector<c_float>& P_data,
+                        const std::vector<c_float>& q,
+                        const std::vector<c_float>& A_data,
+                        const std::vector<c_float>& l,
+                        const std::vector<c_float>& u,
+                        const OSQPSettings& settings) {
+  // the factorization is kept as long as the matrices are unchanged
+  const bool P_changed = P_data != P_data_;
+  const bool A_changed = A_data != A_data_;
+  c_int ret = 0;
+  if (P_changed && A_changed) {
+    ret = osqp_update_P_A(workspace_, P_data.data(), OSQP_NULL,
+                          static_cast<c_int>(P_data.size()), A_data.data(),
+                          OSQP_NULL, static_cast<c_int>(A_data.size()));
+  } else if (P_changed) {
+    ret = osqp_update_P(workspace_, P_data.data(), OSQP_NULL,
+                        static_cast<c_int>(P_data.size()));
+  } else if (A_changed) {
+    ret = osqp_update_A(workspace_, A_data.data(), OSQP_NULL,
+                        static_cast<c_int>(A_data.size()));
+  }
+  if (ret != 0) {
+    AWARN << "osqp matrix update failed, " << ret << ", set up again.";
+    return false;
+  }
+  if (P_changed) {
+    P_data_ = P_data;
+  }
+  if (A_changed) {
+    A_data_ = A_data;
+  }
+
+  if (osqp_update_lin_cost(workspace_, q.data()) != 0 ||
+      osqp_update_bounds(workspace_, l.data(), u.data()) != 0) {
+    AWARN << "osqp vector update failed, set up again.";
+    return false;
+  }
+  if (settings.max_iter != settings_.max_iter) {
+    osqp_update_max_iter(workspace_, settings.max_iter);
+    settings_.max_iter = settings.max_iter;
+  }
+  if (settings.eps_abs != settings_.eps_abs) {
+    osqp_update_eps_abs(workspace_, settings.eps_abs);
+    settings_.eps_abs = settings.eps_abs;
+  }
+  if (settings.eps_rel != settings_.eps_rel) {
+    osqp_update_eps_rel(workspace_, settings.eps_rel);
+    settings_.eps_rel = settings.eps_rel;
+  }
+  return true;
+}
+
+bool OsqpSolver::WarmStart(const std::vector<c_float>& x,
+                           const std::vector<c_float>& y) {
+  if (workspace_ == nullptr || x.size() != q_size_ || y.size() != l_size_) {
+    return false;
+  }
+  return osqp_warm_start(workspace_, x.data(), y.data()) == 0;
+}
+
+bool OsqpSolver::Solve() {
+  has_solution_ = false;
+  if (workspace_ == nullptr) {
+    AERROR << "osqp workspace is not set up.";
+    return false;
+  }
+  osqp_solve(workspace_);
+
+  // the iterates of a failed solve are no start for the next one, which
+  // sets the workspace up again
+  auto status = workspace_->info->status_val;
+  if (status < 0 || (status != 1 && status != 2)) {
+    AERROR << "failed optimization status:\t" << workspace_->info->status;
+    Reset();
+    return false;
+  } else if (workspace_->solution == nullptr) {
+    AERROR << "The solution from OSQP is nullptr";
+    Reset();
+    return false;
+  }
+  has_solution_ = true;
+  return true;
+}
+
+const c_float* OsqpSolver::x() const {
+  return workspace_ == nullptr ? nullptr : workspace_->solution->x;
+}
+
+const c_float* OsqpSolver::y() const {
+  return workspace_ == nullptr ? nullptr : workspace_->solution->y;
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "osqp/osqp.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class OsqpSolver
+ * @brief Keeps an OSQP workspace across solves of problems that share their
+ * sparsity.
+ *
+ * Problems solved at every cycle mostly change their vectors and the values
+ * of their matrices, not the positions of the nonzeros. Such a problem
+ * updates the existing workspace in place: q, l and u are copied in, P and A
+ * are refactorized numerically only when their values changed, and the
+ * solve starts from the previous solution, or from the one given to
+ * WarmStart. A problem of a different size or sparsity sets the workspace up
+ * from scratch.
+ *
+ * Matrices are given in CSC form, as the data, indices and indptr arrays of
+ * csc_matrix. Not thread safe.
+ */
+class OsqpSolver {
+ public:
+  OsqpSolver() = default;
+  OsqpSolver(const OsqpSolver&) = delete;
+  OsqpSolver& operator=(const OsqpSolver&) = delete;
+  ~OsqpSolver();
+
+  /**
+   * @brief Sets the problem
+   *        min 0.5 * x' * P * x + q' * x,  s.t. l <= A * x <= u
+   * up, or updates the current one.
+   * @return False if osqp failed to set the problem up.
+   */
+  bool Setup(const std::vector<c_float>& P_data,
+             const std::vector<c_int>& P_indices,
+             const std::vector<c_int>& P_indptr, const std::vector<c_float>& q,
+             const std::vector<c_float>& A_data,
+             const std::vector<c_int>& A_indices,
+             const std::vector<c_int>& A_indptr, const std::vector<c_float>& l,
+             const std::vector<c_float>& u, const OSQPSettings& settings);
+
+  // Starts the next solve from x and y instead of the last solution.
+  bool WarmStart(const std::vector<c_float>& x, const std::vector<c_float>& y);
+
+  // Returns true if the problem is solved, accurately or not.
+  bool Solve();
+
+  // Drops the workspace, the next Setup starts from scratch.
+  void Reset();
+
+  // Whether the last Setup has updated the previous workspace.
+  bool reused() const { return reused_; }
+
+  bool has_solution() const { return has_solution_; }
+
+  // The primal and dual solution of the last solve, of n and m entries.
+  const c_float* x() const;
+  const c_float* y() const;
+  c_int n() const { return static_cast<c_int>(q_size_); }
+  c_int m() const { return static_cast<c_int>(l_size_); }
+
+  const OSQPWorkspace* workspace() const { return workspace_; }
+
+ private:
+  bool SamePattern(const std::vector<c_int>& P_indices,
+                   const std::vector<c_int>& P_indptr,
+                   const std::vector<c_int>& A_indices,
+                   const std::vector<c_int>& A_indptr, size_t n,
+                   size_t m) const;
+  bool SameSettings(const OSQPSettings& settings) const;
+  bool Update(const std::vector<c_float>& P_data,
+              const std::vector<c_float>& q,
+              const std::vector<c_float>& A_data,
+              const std::vector<c_float>& l, const std::vector<c_float>& u,
+              const OSQPSettings& settings);
+
+  OSQPWorkspace* workspace_ = nullptr;
+  OSQPSettings settings_;
+  bool reused_ = false;
+  bool has_solution_ = false;
+  size_t q_size_ = 0;
+  size_t l_size_ = 0;
+  // the matrices of the workspace, kept to detect what has changed
+  std::vector<c_float> P_data_;
+  std::vector<c_int> P_indices_;
+  std::vector<c_int> P_indptr_;
+  std::vector<c_float> A_data_;
+  std::vector<c_int> A_indices_;
+  std::vector<c_int> A_indptr_;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
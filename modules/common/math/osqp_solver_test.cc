@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/osqp_solver.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+OSQPSettings DefaultSettings() {
+  OSQPSettings settings;
+  osqp_set_default_settings(&settings);
+  settings.polish = true;
+  settings.verbose = false;
+  settings.eps_abs = 1e-6;
+  settings.eps_rel = 1e-6;
+  return settings;
+}
+
+}  // namespace
+
+// min 0.5 * (p0 * x0^2 + p1 * x1^2) + q' * x, s.t. l <= x <= u
+class OsqpSolverTest : public ::testing::Test {
+ protected:
+  bool Setup(const std::vector<c_float>& P_data,
+             const std::vector<c_float>& q, const std::vector<c_float>& l,
+             const std::vector<c_float>& u) {
+    return solver_.Setup(P_data, {0, 1}, {0, 1, 2}, q, {1.0, 1.0}, {0, 1},
+                         {0, 1, 2}, l, u, DefaultSettings());
+  }
+
+  OsqpSolver solver_;
+};
+
+TEST_F(OsqpSolverTest, UpdateInPlace) {
+  ASSERT_TRUE(Setup({1.0, 1.0}, {-1.0, -2.0}, {-10.0, -10.0}, {10.0, 10.0}));
+  EXPECT_FALSE(solver_.reused());
+  ASSERT_TRUE(solver_.Solve());
+  EXPECT_NEAR(1.0, solver_.x()[0], 1e-4);
+  EXPECT_NEAR(2.0, solver_.x()[1], 1e-4);
+
+  // new vectors
+  ASSERT_TRUE(Setup({1.0, 1.0}, {-1.0, -2.0}, {-10.0, -10.0}, {0.5, 10.0}));
+  EXPECT_TRUE(solver_.reused());
+  ASSERT_TRUE(solver_.Solve());
+  EXPECT_NEAR(0.5, solver_.x()[0], 1e-4);
+  EXPECT_NEAR(2.0, solver_.x()[1], 1e-4);
+
+  // new values of P
+  ASSERT_TRUE(Setup({2.0, 4.0}, {-1.0, -2.0}, {-10.0, -10.0}, {10.0, 10.0}));
+  EXPECT_TRUE(solver_.reused());
+  ASSERT_TRUE(solver_.Solve());
+  EXPECT_NEAR(0.5, solver_.x()[0], 1e-4);
+  EXPECT_NEAR(0.5, solver_.x()[1], 1e-4);
+}
+
+TEST_F(OsqpSolverTest, SetupAgain) {
+  ASSERT_TRUE(Setup({1.0, 1.0}, {-1.0, -2.0}, {-10.0, -10.0}, {10.0, 10.0}));
+  ASSERT_TRUE(solver_.Solve());
+
+  // another sparsity, a coupled cost
+  ASSERT_TRUE(solver_.Setup({2.0, 1.0, 2.0}, {0, 0, 1}, {0, 1, 3},
+                            {-3.0, -3.0}, {1.0, 1.0}, {0, 1}, {0, 1, 2},
+                            {-10.0, -10.0}, {10.0, 10.0}, DefaultSettings()));
+  EXPECT_FALSE(solver_.reused());
+  ASSERT_TRUE(solver_.Solve());
+  EXPECT_NEAR(1.0, solver_.x()[0], 1e-4);
+  EXPECT_NEAR(1.0, solver_.x()[1], 1e-4);
+
+  solver_.Reset();
+  EXPECT_FALSE(solver_.has_solution());
+  EXPECT_FALSE(solver_.Solve());
+}
+
+TEST_F(OsqpSolverTest, SetupSettings) {
+  ASSERT_TRUE(Setup({1.0, 1.0}, {-1.0, -2.0}, {-10.0, -10.0}, {10.0, 10.0}));
+
+  // updated in place
+  OSQPSettings settings = DefaultSettings();
+  settings.max_iter *= 2;
+  settings.eps_abs = 1e-5;
+  ASSERT_TRUE(solver_.Setup({1.0, 1.0}, {0, 1}, {0, 1, 2}, {-1.0, -2.0},
+                            {1.0, 1.0}, {0, 1}, {0, 1, 2}, {-10.0, -10.0},
+                            {10.0, 10.0}, settings));
+  EXPECT_TRUE(solver_.reused());
+
+  // part of the setup
+  settings.check_termination += 5;
+  ASSERT_TRUE(solver_.Setup({1.0, 1.0}, {0, 1}, {0, 1, 2}, {-1.0, -2.0},
+                            {1.0, 1.0}, {0, 1}, {0, 1, 2}, {-10.0, -10.0},
+                            {10.0, 10.0}, settings));
+  EXPECT_FALSE(solver_.reused());
+  ASSERT_TRUE(solver_.Solve());
+  EXPECT_NEAR(1.0, solver_.x()[0], 1e-4);
+  EXPECT_NEAR(2.0, solver_.x()[1], 1e-4);
+}
+
+TEST_F(OsqpSolverTest, WarmStart) {
+  ASSERT_TRUE(Setup({1.0, 1.0}, {-1.0, -2.0}, {-10.0, -10.0}, {10.0, 10.0}));
+  ASSERT_TRUE(solver_.Solve());
+  EXPECT_FALSE(solver_.WarmStart({1.0}, {0.0, 0.0}));
+
+  ASSERT_TRUE(Setup({1.0, 1.0}, {-2.0, -1.0}, {-10.0, -10.0}, {10.0, 10.0}));
+  EXPECT_TRUE(solver_.WarmStart({2.0, 1.0}, {0.0, 0.0}));
+  ASSERT_TRUE(solver_.Solve());
+  EXPECT_NEAR(2.0, solver_.x()[0], 1e-4);
+  EXPECT_NEAR(1.0, solver_.x()[1], 1e-4);
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
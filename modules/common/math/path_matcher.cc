@@ -22,6 +22,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <numeric>
 #include <vector>
 
 #include "glog/logging.h"
@@ -118,6 +120,240 @@ PathPoint PathMatcher::FindProjectionPoint(const PathPoint& p0,
   return InterpolateUsingLinearApproximation(p0, p1, p0.s() + delta_s);
 }
 
+IndexedPathMatcher::IndexedPathMatcher(
+    const std::vector<PathPoint>& reference_line)
+    : reference_line_(reference_line) {
+  CHECK_GT(reference_line.size(), 0U);
+
+  double min_x = std::numeric_limits<double>::max();
+  double max_x = std::numeric_limits<double>::lowest();
+  double min_y = std::numeric_limits<double>::max();
+  double max_y = std::numeric_limits<double>::lowest();
+  for (const auto& point : reference_line) {
+    min_x = std::min(min_x, point.x());
+    max_x = std::max(max_x, point.x());
+    min_y = std::min(min_y, point.y());
+    max_y = std::max(max_y, point.y());
+  }
+  sorted_by_x_ = max_x - min_x >= max_y - min_y;
+
+  sorted_indices_.resize(reference_line.size());
+  std::iota(sorted_indices_.begin(), sorted_indices_.end(), 0);
+  auto key = [this](const std::size_t index) {
+    const auto& point = reference_line_[index];
+    return sorted_by_x_ ? point.x() : point.y();
+  };
+  auto key_less = [&key](const std::size_t lhs, const std::size_t rhs) {
+    return key(lhs) < key(rhs);
+  };
+  // most reference lines are monotone along the axis of the larger extent
+  if (!std::is_sorted(sorted_indices_.begin(), sorted_indices_.end(),
+                      key_less)) {
+    std::stable_sort(sorted_indices_.begin(), sorted_indices_.end(), key_less);
+  }
+
+  sorted_keys_.reserve(reference_line.size());
+  sorted_others_.reserve(reference_line.size());
+  for (const std::size_t index : sorted_indices_) {
+    const auto& point = reference_line_[index];
+    sorted_keys_.push_back(sorted_by_x_ ? point.x() : point.y());
+    sorted_others_.push_back(sorted_by_x_ ? point.y() : point.x());
+  }
+}
+
+std::size_t IndexedPathMatcher::NearestIndex(const double x,
+                                             const double y) const {
+  const double key = sorted_by_x_ ? x : y;
+  const double other = sorted_by_x_ ? y : x;
+  const std::size_t size = sorted_keys_.size();
+
+  double distance_min = std::numeric_limits<double>::infinity();
+  std::size_t index_min = reference_line_.size();
+  // the first nearest point along the line wins a tie, as in the linear scan
+  auto visit = [&](const std::size_t sorted_index) {
+    const double d_key = sorted_keys_[sorted_index] - key;
+    const double d_other = sorted_others_[sorted_index] - other;
+    const double distance = sorted_by_x_ ? d_key * d_key + d_other * d_other
+                                         : d_other * d_other + d_key * d_key;
+    const std::size_t index = sorted_indices_[sorted_index];
+    if (distance < distance_min ||
+        (distance == distance_min && index < index_min)) {
+      distance_min = distance;
+      index_min = index;
+    }
+  };
+
+  std::size_t right =
+      std::lower_bound(sorted_keys_.begin(), sorted_keys_.end(), key) -
+      sorted_keys_.begin();
+  std::size_t left = right;
+  while (left > 0 || right < size) {
+    const double gap_left = left > 0
+                                ? key - sorted_keys_[left - 1]
+                                : std::numeric_limits<double>::infinity();
+    const double gap_right = right < size
+                                 ? sorted_keys_[right] - key
+                                 : std::numeric_limits<double>::infinity();
+    // the gap along the sorted axis grows outwards and bounds the distance
+    if (gap_left <= gap_right) {
+      if (gap_left * gap_left > distance_min) {
+        break;
+      }
+      visit(--left);
+    } else {
+      if (gap_right * gap_right > distance_min) {
+        break;
+      }
+      visit(right++);
+    }
+  }
+  return index_min;
+}
+
+double IndexedPathMatcher::ProjectionS(const double x, const double y,
+                                       std::size_t* index_start,
+                                       std::size_t* index_end) const {
+  const std::size_t index_min = NearestIndex(x, y);
+  *index_start = (index_min == 0) ? index_min : index_min - 1;
+  *index_end =
+      (index_min + 1 == reference_line_.size()) ? index_min : index_min + 1;
+
+  const PathPoint& p0 = reference_line_[*index_start];
+  if (*index_start == *index_end) {
+    return p0.s();
+  }
+  // same as FindProjectionPoint
+  const PathPoint& p1 = reference_line_[*index_end];
+  const double v0x = x - p0.x();
+  const double v0y = y - p0.y();
+  const double v1x = p1.x() - p0.x();
+  const double v1y = p1.y() - p0.y();
+  const double v1_norm = std::sqrt(v1x * v1x + v1y * v1y);
+  const double dot = v0x * v1x + v0y * v1y;
+  return p0.s() + dot / v1_norm;
+}
+
+void IndexedPathMatcher::Project(const double x, const double y, double* s,
+                                 double* rx, double* ry,
+                                 double* rtheta) const {
+  std::size_t index_start = 0;
+  std::size_t index_end = 0;
+  *s = ProjectionS(x, y, &index_start, &index_end);
+
+  const PathPoint& p0 = reference_line_[index_start];
+  if (index_start == index_end) {
+    *rx = p0.x();
+    *ry = p0.y();
+    *rtheta = p0.theta();
+    return;
+  }
+  // same as InterpolateUsingLinearApproximation, without the PathPoint
+  const PathPoint& p1 = reference_line_[index_end];
+  const double weight = (*s - p0.s()) / (p1.s() - p0.s());
+  *rx = (1 - weight) * p0.x() + weight * p1.x();
+  *ry = (1 - weight) * p0.y() + weight * p1.y();
+  *rtheta = slerp(p0.theta(), p0.s(), p1.theta(), p1.s(), *s);
+}
+
+PathPoint IndexedPathMatcher::MatchToPath(const double x,
+                                          const double y) const {
+  std::size_t index_start = 0;
+  std::size_t index_end = 0;
+  const double s = ProjectionS(x, y, &index_start, &index_end);
+  if (index_start == index_end) {
+    return reference_line_[index_start];
+  }
+  return InterpolateUsingLinearApproximation(reference_line_[index_start],
+                                             reference_line_[index_end], s);
+}
+
+std::pair<double, double> IndexedPathMatcher::GetPathFrenetCoordinate(
+    const double x, const double y) const {
+  double s = 0.0;
+  double rx = 0.0;
+  double ry = 0.0;
+  double rtheta = 0.0;
+  Project(x, y, &s, &rx, &ry, &rtheta);
+  const double delta_x = x - rx;
+  const double delta_y = y - ry;
+  const double side = std::cos(rtheta) * delta_y - std::sin(rtheta) * delta_x;
+  return std::make_pair(s, std::copysign(std::hypot(delta_x, delta_y), side));
+}
+
+void IndexedPathMatcher::GetPathFrenetCoordinates(
+    const std::vector<Vec2d>& points, std::vector<double>* s,
+    std::vector<double>* l) const {
+  CHECK_NOTNULL(s);
+  CHECK_NOTNULL(l);
+  const std::size_t size = points.size();
+  s->resize(size);
+  l->resize(size);
+  // projections first, then the lateral offsets in a loop of plain
+  // arithmetic over the arrays
+  std::vector<double> delta_x(size);
+  std::vector<double> delta_y(size);
+  std::vector<double> rtheta(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    double rx = 0.0;
+    double ry = 0.0;
+    Project(points[i].x(), points[i].y(), &(*s)[i], &rx, &ry, &rtheta[i]);
+    delta_x[i] = points[i].x() - rx;
+    delta_y[i] = points[i].y() - ry;
+  }
+  double* l_data = l->data();
+  for (std::size_t i = 0; i < size; ++i) {
+    const double side =
+        std::cos(rtheta[i]) * delta_y[i] - std::sin(rtheta[i]) * delta_x[i];
+    l_data[i] = std::copysign(std::hypot(delta_x[i], delta_y[i]), side);
+  }
+}
+
+void IndexedPathMatcher::MatchToPath(
+    const std::vector<double>& s,
+    std::vector<PathPoint>* matched_points) const {
+  CHECK_NOTNULL(matched_points);
+  // existing points are assigned to, without being freed and allocated again
+  matched_points->resize(s.size());
+
+  auto comp = [](const PathPoint& point, const double s) {
+    return point.s() < s;
+  };
+  const std::size_t size = reference_line_.size();
+  // lower bound of the previous query
+  std::size_t lower = 0;
+  for (std::size_t i = 0; i < s.size(); ++i) {
+    const double query_s = s[i];
+    if (lower > 0 && reference_line_[lower - 1].s() >= query_s) {
+      lower = std::lower_bound(reference_line_.begin(),
+                               reference_line_.begin() + lower, query_s, comp) -
+              reference_line_.begin();
+    } else {
+      // galloping forward from the previous lower bound
+      std::size_t upper = lower;
+      std::size_t step = 1;
+      while (upper < size && reference_line_[upper].s() < query_s) {
+        lower = upper + 1;
+        upper += step;
+        step *= 2;
+      }
+      lower = std::lower_bound(reference_line_.begin() + lower,
+                               reference_line_.begin() + std::min(upper, size),
+                               query_s, comp) -
+              reference_line_.begin();
+    }
+
+    auto& matched_point = (*matched_points)[i];
+    if (lower == 0) {
+      matched_point = reference_line_.front();
+    } else if (lower == size) {
+      matched_point = reference_line_.back();
+    } else {
+      matched_point = InterpolateUsingLinearApproximation(
+          reference_line_[lower - 1], reference_line_[lower], query_s);
+    }
+  }
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
@@ -25,6 +25,8 @@
 
 #include "modules/common_msgs/basic_msgs/pnc_point.pb.h"
 
+#include "modules/common/math/vec2d.h"
+
 namespace apollo {
 namespace common {
 namespace math {
@@ -48,6 +50,65 @@ class PathMatcher {
                                        const double x, const double y);
 };
 
+/**
+ * @class IndexedPathMatcher
+ * @brief Matches many points against one reference line, with the same
+ * results as PathMatcher.
+ *
+ * The reference points are sorted once along the axis of the larger extent of
+ * the line. The nearest reference point to a query is searched outwards from
+ * the position of the query on that axis, until the distance along the axis
+ * alone exceeds the best distance found, instead of a scan over the whole
+ * line. Queries by s keep the position of the previous query, so a sequence
+ * of increasing s is matched in one sweep over the line.
+ *
+ * The reference line is not copied and has to outlive the matcher.
+ */
+class IndexedPathMatcher {
+ public:
+  explicit IndexedPathMatcher(const std::vector<PathPoint>& reference_line);
+
+  PathPoint MatchToPath(const double x, const double y) const;
+
+  std::pair<double, double> GetPathFrenetCoordinate(const double x,
+                                                    const double y) const;
+
+  /**
+   * @brief Frenet coordinates of a batch of points.
+   * @param points The points in the cartesian frame.
+   * @param s Output, the s of every point.
+   * @param l Output, the l of every point.
+   */
+  void GetPathFrenetCoordinates(const std::vector<Vec2d>& points,
+                                std::vector<double>* s,
+                                std::vector<double>* l) const;
+
+  /**
+   * @brief Reference points at a batch of s, fastest when s is sorted.
+   */
+  void MatchToPath(const std::vector<double>& s,
+                   std::vector<PathPoint>* matched_points) const;
+
+ private:
+  std::size_t NearestIndex(const double x, const double y) const;
+
+  // s of the projection of a point onto the segment around its nearest
+  // reference point, the reference points of the segment are returned too
+  double ProjectionS(const double x, const double y, std::size_t* index_start,
+                     std::size_t* index_end) const;
+
+  // s, x, y and theta of the projection of a point onto the reference line
+  void Project(const double x, const double y, double* s, double* rx,
+               double* ry, double* rtheta) const;
+
+  const std::vector<PathPoint>& reference_line_;
+  // reference points in the order of the sorted axis
+  bool sorted_by_x_ = true;
+  std::vector<double> sorted_keys_;
+  std::vector<double> sorted_others_;
+  std::vector<std::size_t> sorted_indices_;
+};
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/math/path_matcher.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+// A gently curved reference line with points every 0.5 m, as discretized for
+// lattice planning.
+std::vector<PathPoint> ReferenceLine(int64_t num) {
+  std::vector<PathPoint> reference_line;
+  reference_line.reserve(num);
+  for (int64_t i = 0; i < num; ++i) {
+    const double s = 0.5 * static_cast<double>(i);
+    PathPoint point;
+    point.set_x(s);
+    point.set_y(10.0 * std::sin(s / 50.0));
+    point.set_theta(std::atan(0.2 * std::cos(s / 50.0)));
+    point.set_s(s);
+    reference_line.push_back(point);
+  }
+  return reference_line;
+}
+
+// Corners of obstacles around the reference line.
+std::vector<Vec2d> RandomPoints(const std::vector<PathPoint>& reference_line,
+                                int64_t num) {
+  std::mt19937 engine(static_cast<unsigned int>(num));
+  std::uniform_int_distribution<size_t> index(0, reference_line.size() - 1);
+  std::uniform_real_distribution<double> offset(-8.0, 8.0);
+  std::vector<Vec2d> points;
+  points.reserve(num);
+  for (int64_t i = 0; i < num; ++i) {
+    const auto& point = reference_line[index(engine)];
+    points.emplace_back(point.x() + offset(engine), point.y() + offset(engine));
+  }
+  return points;
+}
+
+constexpr int64_t kReferencePointNum = 1000;
+
+void BM_PathMatcher(benchmark::State& state) {  // NOLINT
+  const auto reference_line = ReferenceLine(kReferencePointNum);
+  const auto points = RandomPoints(reference_line, state.range(0));
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (const auto& point : points) {
+      auto sl = PathMatcher::GetPathFrenetCoordinate(reference_line, point.x(),
+                                                     point.y());
+      sum += sl.first + sl.second;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+void BM_IndexedPathMatcher(benchmark::State& state) {  // NOLINT
+  const auto reference_line = ReferenceLine(kReferencePointNum);
+  const auto points = RandomPoints(reference_line, state.range(0));
+  std::vector<double> s;
+  std::vector<double> l;
+  for (auto _ : state) {
+    // the index is built for every batch
+    IndexedPathMatcher matcher(reference_line);
+    matcher.GetPathFrenetCoordinates(points, &s, &l);
+    benchmark::DoNotOptimize(s.data());
+    benchmark::DoNotOptimize(l.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+void BM_MatchToPathByS(benchmark::State& state) {  // NOLINT
+  const auto reference_line = ReferenceLine(kReferencePointNum);
+  std::vector<double> s;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    s.push_back(reference_line.back().s() * static_cast<double>(i) /
+                static_cast<double>(state.range(0)));
+  }
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (const double query_s : s) {
+      sum += PathMatcher::MatchToPath(reference_line, query_s).x();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * s.size());
+}
+
+void BM_IndexedMatchToPathByS(benchmark::State& state) {  // NOLINT
+  const auto reference_line = ReferenceLine(kReferencePointNum);
+  std::vector<double> s;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    s.push_back(reference_line.back().s() * static_cast<double>(i) /
+                static_cast<double>(state.range(0)));
+  }
+  IndexedPathMatcher matcher(reference_line);
+  std::vector<PathPoint> matched_points;
+  for (auto _ : state) {
+    matcher.MatchToPath(s, &matched_points);
+    benchmark::DoNotOptimize(matched_points.data());
+  }
+  state.SetItemsProcessed(state.iterations() * s.size());
+}
+
+BENCHMARK(BM_PathMatcher)->Range(8, 1 << 10);
+BENCHMARK(BM_IndexedPathMatcher)->Range(8, 1 << 10);
+BENCHMARK(BM_MatchToPathByS)->Range(8, 1 << 10);
+BENCHMARK(BM_IndexedMatchToPathByS)->Range(8, 1 << 10);
+
+}  // namespace
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/path_matcher.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+// a curve that turns back, so that the nearest point along the sorted axis is
+// often not the nearest one
+std::vector<PathPoint> MakeReferenceLine(const int num_points) {
+  std::vector<PathPoint> reference_line;
+  double s = 0.0;
+  for (int i = 0; i < num_points; ++i) {
+    const double t = 0.05 * i;
+    PathPoint point;
+    point.set_x(20.0 * std::sin(t));
+    point.set_y(3.0 * t);
+    point.set_theta(std::atan2(3.0, 20.0 * std::cos(t)));
+    point.set_kappa(0.01 * i);
+    if (!reference_line.empty()) {
+      s += std::hypot(point.x() - reference_line.back().x(),
+                      point.y() - reference_line.back().y());
+    }
+    point.set_s(s);
+    reference_line.push_back(point);
+  }
+  return reference_line;
+}
+
+std::vector<Vec2d> MakePoints(const int num_points) {
+  std::vector<Vec2d> points;
+  for (int i = 0; i < num_points; ++i) {
+    points.emplace_back(-30.0 + 0.37 * (i % 163), -5.0 + 0.53 * (i / 163));
+  }
+  return points;
+}
+
+}  // namespace
+
+TEST(IndexedPathMatcherTest, SameAsPathMatcher) {
+  const auto reference_line = MakeReferenceLine(200);
+  const auto points = MakePoints(163 * 60);
+  IndexedPathMatcher matcher(reference_line);
+
+  std::vector<double> s;
+  std::vector<double> l;
+  matcher.GetPathFrenetCoordinates(points, &s, &l);
+  ASSERT_EQ(points.size(), s.size());
+  ASSERT_EQ(points.size(), l.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto expected = PathMatcher::GetPathFrenetCoordinate(
+        reference_line, points[i].x(), points[i].y());
+    EXPECT_DOUBLE_EQ(expected.first, s[i]);
+    EXPECT_DOUBLE_EQ(expected.second, l[i]);
+
+    const auto sl =
+        matcher.GetPathFrenetCoordinate(points[i].x(), points[i].y());
+    EXPECT_DOUBLE_EQ(expected.first, sl.first);
+    EXPECT_DOUBLE_EQ(expected.second, sl.second);
+  }
+
+  for (size_t i = 0; i < points.size(); i += 97) {
+    const auto expected =
+        PathMatcher::MatchToPath(reference_line, points[i].x(), points[i].y());
+    const auto matched = matcher.MatchToPath(points[i].x(), points[i].y());
+    EXPECT_DOUBLE_EQ(expected.s(), matched.s());
+    EXPECT_DOUBLE_EQ(expected.x(), matched.x());
+    EXPECT_DOUBLE_EQ(expected.y(), matched.y());
+    EXPECT_DOUBLE_EQ(expected.theta(), matched.theta());
+    EXPECT_DOUBLE_EQ(expected.kappa(), matched.kappa());
+  }
+}
+
+TEST(IndexedPathMatcherTest, SinglePoint) {
+  const auto reference_line = MakeReferenceLine(1);
+  IndexedPathMatcher matcher(reference_line);
+  const auto sl = matcher.GetPathFrenetCoordinate(1.0, 1.0);
+  const auto expected =
+      PathMatcher::GetPathFrenetCoordinate(reference_line, 1.0, 1.0);
+  EXPECT_DOUBLE_EQ(expected.first, sl.first);
+  EXPECT_DOUBLE_EQ(expected.second, sl.second);
+}
+
+TEST(IndexedPathMatcherTest, MatchToPathByS) {
+  const auto reference_line = MakeReferenceLine(100);
+  IndexedPathMatcher matcher(reference_line);
+
+  // increasing, then going back and out of both ends
+  std::vector<double> s;
+  for (double query_s = -1.0; query_s < reference_line.back().s() + 1.0;
+       query_s += 0.7) {
+    s.push_back(query_s);
+  }
+  s.push_back(3.0);
+  s.push_back(reference_line[10].s());
+  s.push_back(-5.0);
+
+  std::vector<PathPoint> matched_points;
+  matcher.MatchToPath(s, &matched_points);
+  ASSERT_EQ(s.size(), matched_points.size());
+  for (size_t i = 0; i < s.size(); ++i) {
+    const auto expected = PathMatcher::MatchToPath(reference_line, s[i]);
+    EXPECT_DOUBLE_EQ(expected.s(), matched_points[i].s());
+    EXPECT_DOUBLE_EQ(expected.x(), matched_points[i].x());
+    EXPECT_DOUBLE_EQ(expected.y(), matched_points[i].y());
+    EXPECT_DOUBLE_EQ(expected.theta(), matched_points[i].theta());
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
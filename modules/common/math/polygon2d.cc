@@ -32,8 +32,8 @@ namespace apollo {
 namespace common {
 namespace math {
 
-Polygon2d::Polygon2d(const Box2d &box) {
-  box.GetAllCorners(&points_);
+Polygon2d::Polygon2d(const Box2d &box)
+    : points_(box.corners().begin(), box.corners().end()) {
   BuildFromPoints();
 }
 
@@ -42,15 +42,7 @@ Polygon2d::Polygon2d(std::vector<Vec2d> points) : points_(std::move(points)) {
 }
 
 double Polygon2d::DistanceTo(const Vec2d &point) const {
-  CHECK_GE(points_.size(), 3U);
-  if (IsPointIn(point)) {
-    return 0.0;
-  }
-  double distance = std::numeric_limits<double>::infinity();
-  for (int i = 0; i < num_points_; ++i) {
-    distance = std::min(distance, line_segments_[i].DistanceTo(point));
-  }
-  return distance;
+  return std::sqrt(DistanceSquareTo(point));
 }
 
 double Polygon2d::DistanceSquareTo(const Vec2d &point) const {
@@ -91,7 +83,18 @@ double Polygon2d::DistanceTo(const LineSegment2d &line_segment) const {
 
 double Polygon2d::DistanceTo(const Box2d &box) const {
   CHECK_GE(points_.size(), 3U);
-  return DistanceTo(Polygon2d(box));
+  // Same as the distance to the polygon of the box, without building it.
+  if (IsPointIn(box.center())) {
+    return 0.0;
+  }
+  double distance = std::numeric_limits<double>::infinity();
+  for (int i = 0; i < num_points_; ++i) {
+    distance = std::min(distance, box.DistanceTo(line_segments_[i]));
+    if (distance <= 0.0) {
+      break;
+    }
+  }
+  return distance;
 }
 
 double Polygon2d::DistanceTo(const Polygon2d &polygon) const {
@@ -0,0 +1,453 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace apollo {
+namespace common {
+namespace util {
+
+enum class CachePolicy {
+  // evicts the least recently used entry
+  LRU,
+  // evicts like LRU, but admits a new entry only if it has been asked for
+  // more often than the entry it would evict
+  TINY_LFU,
+};
+
+struct CacheStatistics {
+  uint64_t hit_num = 0;
+  uint64_t miss_num = 0;
+  uint64_t insert_num = 0;
+  uint64_t evict_num = 0;
+  // new entries not admitted by TINY_LFU
+  uint64_t reject_num = 0;
+
+  double HitRate() const {
+    const uint64_t total = hit_num + miss_num;
+    return total == 0 ? 0.0
+                      : static_cast<double>(hit_num) /
+                            static_cast<double>(total);
+  }
+};
+
+/**
+ * @class FrequencySketch
+ * @brief Approximate access counts of keys, a count-min sketch of 4 rows of
+ * 8-bit counters that saturate at 15. All counters are halved after 10
+ * increments per counter of a row, so old accesses fade away.
+ */
+class FrequencySketch {
+ public:
+  explicit FrequencySketch(const size_t capacity) {
+    // small caches still get enough counters to tell keys apart
+    size_t width = 256;
+    while (width < capacity) {
+      width <<= 1;
+    }
+    mask_ = width - 1;
+    counters_.assign(kRowNum * width, 0);
+    sample_size_ = 10 * width;
+  }
+
+  void Increment(const uint64_t hash) {
+    bool incremented = false;
+    for (size_t row = 0; row < kRowNum; ++row) {
+      uint8_t& counter = counters_[Index(hash, row)];
+      if (counter < kMaxCount) {
+        ++counter;
+        incremented = true;
+      }
+    }
+    if (incremented && ++increment_num_ >= sample_size_) {
+      for (auto& counter : counters_) {
+        counter >>= 1;
+      }
+      increment_num_ /= 2;
+    }
+  }
+
+  uint8_t Estimate(const uint64_t hash) const {
+    uint8_t count = kMaxCount;
+    for (size_t row = 0; row < kRowNum; ++row) {
+      count = std::min(count, counters_[Index(hash, row)]);
+    }
+    return count;
+  }
+
+ private:
+  static constexpr size_t kRowNum = 4;
+  static constexpr uint8_t kMaxCount = 15;
+
+  size_t Index(const uint64_t hash, const size_t row) const {
+    // every row hashes the key with a seed of its own, so keys sharing a
+    // counter in one row rarely share one in the others
+    static constexpr uint64_t kSeeds[kRowNum] = {
+        0x97cb3127ULL, 0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+        0x9ae16a3b2f90404fULL};
+    const uint64_t h = (hash + row) * kSeeds[row];
+    return row * (mask_ + 1) + ((h ^ (h >> 32)) & mask_);
+  }
+
+  size_t mask_ = 0;
+  size_t sample_size_ = 0;
+  size_t increment_num_ = 0;
+  std::vector<uint8_t> counters_;
+};
+
+/**
+ * @class ConcurrentCache
+ * @brief A thread safe cache of a fixed capacity.
+ *
+ * Keys are spread over shards by hash, each shard has a mutex of its own, so
+ * concurrent lookups of different keys rarely wait for each other. A shard
+ * keeps its entries in one array linked by index for the recency order, the
+ * index from key to slot is a std::unordered_map and still allocates a node
+ * per entry. The capacity is split over the shards, an entry is evicted once
+ * its own shard is full even if others are not. Values are copied in and out
+ * under the lock of the shard, large values are better cached as
+ * std::shared_ptr<const T>.
+ */
+template <class K, class V, class Hash = std::hash<K>>
+class ConcurrentCache {
+ public:
+  explicit ConcurrentCache(const size_t capacity, const size_t shard_num = 16,
+                           const CachePolicy policy = CachePolicy::LRU)
+      : capacity_(std::max<size_t>(1, capacity)), policy_(policy) {
+    const size_t num = std::max<size_t>(1, std::min(shard_num, capacity_));
+    // the first shards take the remainder, so the shards add up to capacity
+    shards_.reserve(num);
+    for (size_t i = 0; i < num; ++i) {
+      const size_t shard_capacity = capacity_ / num + (i < capacity_ % num);
+      shards_.emplace_back(new Shard(shard_capacity, policy));
+    }
+  }
+
+  ConcurrentCache(const ConcurrentCache&) = delete;
+  ConcurrentCache& operator=(const ConcurrentCache&) = delete;
+
+  bool Get(const K& key, V* const value) {
+    const uint64_t hash = HashOf(key);
+    Shard& shard = ShardOf(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.Get(key, hash, value);
+  }
+
+  std::optional<V> Get(const K& key) {
+    V value;
+    if (Get(key, &value)) {
+      return value;
+    }
+    return std::nullopt;
+  }
+
+  /*
+   * Looks up all keys, locking every shard once. Returns the number of keys
+   * found, values[i] is empty for a key not found.
+   */
+  size_t GetBatch(const std::vector<K>& keys,
+                  std::vector<std::optional<V>>* const values) {
+    values->assign(keys.size(), std::nullopt);
+    // counting sort of the keys by shard
+    std::vector<uint64_t> hashes(keys.size());
+    std::vector<size_t> offsets(shards_.size() + 1, 0);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      hashes[i] = HashOf(keys[i]);
+      ++offsets[ShardIndex(hashes[i]) + 1];
+    }
+    for (size_t i = 0; i < shards_.size(); ++i) {
+      offsets[i + 1] += offsets[i];
+    }
+    std::vector<size_t> order(keys.size());
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      order[next[ShardIndex(hashes[i])]++] = i;
+    }
+
+    size_t found_num = 0;
+    V value;
+    for (size_t s = 0; s < shards_.size(); ++s) {
+      if (offsets[s] == offsets[s + 1]) {
+        continue;
+      }
+      Shard& shard = *shards_[s];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      for (size_t j = offsets[s]; j < offsets[s + 1]; ++j) {
+        const size_t i = order[j];
+        if (shard.Get(keys[i], hashes[i], &value)) {
+          (*values)[i] = std::move(value);
+          ++found_num;
+        }
+      }
+    }
+    return found_num;
+  }
+
+  /*
+   * Adds or updates an entry. Returns false if TINY_LFU does not admit it.
+   */
+  template <typename VV>
+  bool Put(const K& key, VV&& value) {
+    const uint64_t hash = HashOf(key);
+    Shard& shard = ShardOf(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.Put(key, hash, std::forward<VV>(value));
+  }
+
+  /*
+   * Returns the cached value of the key, or computes and caches it. compute
+   * runs without any lock held, two threads missing the same key at the same
+   * time may both compute it.
+   */
+  template <typename F>
+  V GetOrCompute(const K& key, F&& compute) {
+    V value;
+    if (Get(key, &value)) {
+      return value;
+    }
+    value = compute();
+    Put(key, value);
+    return value;
+  }
+
+  bool Remove(const K& key) {
+    const uint64_t hash = HashOf(key);
+    Shard& shard = ShardOf(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.Remove(key);
+  }
+
+  void Clear() {
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      shard->Clear();
+    }
+  }
+
+  size_t size() const {
+    size_t size = 0;
+    for (const auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      size += shard->index.size();
+    }
+    return size;
+  }
+
+  size_t capacity() const { return capacity_; }
+
+  size_t shard_num() const { return shards_.size(); }
+
+  CachePolicy policy() const { return policy_; }
+
+  CacheStatistics statistics() const {
+    CacheStatistics statistics;
+    for (const auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      statistics.hit_num += shard->statistics.hit_num;
+      statistics.miss_num += shard->statistics.miss_num;
+      statistics.insert_num += shard->statistics.insert_num;
+      statistics.evict_num += shard->statistics.evict_num;
+      statistics.reject_num += shard->statistics.reject_num;
+    }
+    return statistics;
+  }
+
+  void ResetStatistics() {
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      shard->statistics = CacheStatistics();
+    }
+  }
+
+ private:
+  static constexpr uint32_t kNil = std::numeric_limits<uint32_t>::max();
+
+  struct Entry {
+    K key;
+    V value;
+    uint32_t prev = kNil;
+    uint32_t next = kNil;
+  };
+
+  struct Shard {
+    Shard(const size_t shard_capacity, const CachePolicy policy)
+        : capacity(shard_capacity) {
+      index.reserve(capacity);
+      entries.reserve(capacity);
+      if (policy == CachePolicy::TINY_LFU) {
+        sketch.reset(new FrequencySketch(capacity));
+      }
+    }
+
+    bool Get(const K& key, const uint64_t hash, V* const value) {
+      if (sketch != nullptr) {
+        sketch->Increment(hash);
+      }
+      auto iter = index.find(key);
+      if (iter == index.end()) {
+        ++statistics.miss_num;
+        return false;
+      }
+      ++statistics.hit_num;
+      MoveToFront(iter->second);
+      *value = entries[iter->second].value;
+      return true;
+    }
+
+    template <typename VV>
+    bool Put(const K& key, const uint64_t hash, VV&& value) {
+      // accesses are counted by Get, a Put mostly follows a missing Get
+      auto iter = index.find(key);
+      if (iter != index.end()) {
+        entries[iter->second].value = std::forward<VV>(value);
+        MoveToFront(iter->second);
+        return true;
+      }
+
+      uint32_t slot = kNil;
+      if (index.size() >= capacity) {
+        slot = tail;
+        if (sketch != nullptr &&
+            sketch->Estimate(hash) <=
+                sketch->Estimate(HashOf(entries[slot].key))) {
+          ++statistics.reject_num;
+          return false;
+        }
+        Unlink(slot);
+        index.erase(entries[slot].key);
+        ++statistics.evict_num;
+      } else if (!free_slots.empty()) {
+        slot = free_slots.back();
+        free_slots.pop_back();
+      } else {
+        slot = static_cast<uint32_t>(entries.size());
+        entries.emplace_back();
+      }
+      entries[slot].key = key;
+      entries[slot].value = std::forward<VV>(value);
+      PushFront(slot);
+      index.emplace(key, slot);
+      ++statistics.insert_num;
+      return true;
+    }
+
+    bool Remove(const K& key) {
+      auto iter = index.find(key);
+      if (iter == index.end()) {
+        return false;
+      }
+      const uint32_t slot = iter->second;
+      Unlink(slot);
+      index.erase(iter);
+      // the value is released now, not when the slot is reused
+      entries[slot].value = V();
+      free_slots.push_back(slot);
+      return true;
+    }
+
+    void Clear() {
+      index.clear();
+      entries.clear();
+      free_slots.clear();
+      head = kNil;
+      tail = kNil;
+    }
+
+    void Unlink(const uint32_t slot) {
+      Entry& entry = entries[slot];
+      if (entry.prev != kNil) {
+        entries[entry.prev].next = entry.next;
+      } else {
+        head = entry.next;
+      }
+      if (entry.next != kNil) {
+        entries[entry.next].prev = entry.prev;
+      } else {
+        tail = entry.prev;
+      }
+      entry.prev = kNil;
+      entry.next = kNil;
+    }
+
+    void PushFront(const uint32_t slot) {
+      Entry& entry = entries[slot];
+      entry.prev = kNil;
+      entry.next = head;
+      if (head != kNil) {
+        entries[head].prev = slot;
+      }
+      head = slot;
+      if (tail == kNil) {
+        tail = slot;
+      }
+    }
+
+    void MoveToFront(const uint32_t slot) {
+      if (slot != head) {
+        Unlink(slot);
+        PushFront(slot);
+      }
+    }
+
+    const size_t capacity;
+    mutable std::mutex mutex;
+    std::unordered_map<K, uint32_t, Hash> index;
+    // most recently used first, from head along next
+    std::vector<Entry> entries;
+    std::vector<uint32_t> free_slots;
+    uint32_t head = kNil;
+    uint32_t tail = kNil;
+    std::unique_ptr<FrequencySketch> sketch;
+    CacheStatistics statistics;
+  };
+
+  static uint64_t HashOf(const K& key) {
+    // std::hash of integers is the identity, the bits are mixed so that both
+    // the shard and the sketch see all of them
+    uint64_t hash = static_cast<uint64_t>(Hash()(key));
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  size_t ShardIndex(const uint64_t hash) const {
+    return static_cast<size_t>((hash >> 40) % shards_.size());
+  }
+
+  Shard& ShardOf(const uint64_t hash) { return *shards_[ShardIndex(hash)]; }
+
+  const size_t capacity_;
+  const CachePolicy policy_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
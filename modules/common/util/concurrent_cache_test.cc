@@ -0,0 +1,176 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/concurrent_cache.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(ConcurrentCache, LRU) {
+  // a single shard evicts in exact LRU order
+  ConcurrentCache<int, std::string> cache(3, 1);
+  EXPECT_TRUE(cache.Put(1, "a"));
+  EXPECT_TRUE(cache.Put(2, "b"));
+  EXPECT_TRUE(cache.Put(3, "c"));
+  std::string value;
+  EXPECT_TRUE(cache.Get(1, &value));
+  EXPECT_EQ("a", value);
+  EXPECT_TRUE(cache.Put(4, "d"));
+  EXPECT_FALSE(cache.Get(2, &value));
+  EXPECT_TRUE(cache.Get(3, &value));
+  EXPECT_EQ(3, cache.size());
+
+  // an update refreshes the entry
+  EXPECT_TRUE(cache.Put(1, "e"));
+  EXPECT_TRUE(cache.Put(5, "f"));
+  EXPECT_FALSE(cache.Get(4).has_value());
+  EXPECT_EQ("e", cache.Get(1).value());
+
+  EXPECT_TRUE(cache.Remove(1));
+  EXPECT_FALSE(cache.Remove(1));
+  EXPECT_EQ(2, cache.size());
+  EXPECT_TRUE(cache.Put(6, "g"));
+  EXPECT_TRUE(cache.Get(3, &value));
+  EXPECT_TRUE(cache.Get(5, &value));
+  EXPECT_TRUE(cache.Get(6, &value));
+
+  const auto statistics = cache.statistics();
+  EXPECT_EQ(6, statistics.hit_num);
+  EXPECT_EQ(2, statistics.miss_num);
+  EXPECT_EQ(6, statistics.insert_num);
+  EXPECT_EQ(2, statistics.evict_num);
+  EXPECT_DOUBLE_EQ(0.75, statistics.HitRate());
+
+  cache.Clear();
+  EXPECT_EQ(0, cache.size());
+  EXPECT_FALSE(cache.Get(3, &value));
+}
+
+TEST(ConcurrentCache, TinyLFU) {
+  ConcurrentCache<int, int> cache(4, 1, CachePolicy::TINY_LFU);
+  for (int i = 0; i < 4; ++i) {
+    cache.Put(i, i);
+  }
+  // frequent keys are not pushed out by a scan of keys asked for once
+  for (int round = 0; round < 5; ++round) {
+    for (int i = 0; i < 4; ++i) {
+      cache.Get(i);
+    }
+  }
+  for (int i = 100; i < 200; ++i) {
+    if (!cache.Get(i).has_value()) {
+      cache.Put(i, i);
+    }
+  }
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(i, cache.Get(i).value_or(-1));
+  }
+  EXPECT_GT(cache.statistics().reject_num, 0);
+
+  // a key asked for often enough gets in
+  for (int round = 0; round < 10; ++round) {
+    if (!cache.Get(1000).has_value()) {
+      cache.Put(1000, 1000);
+    }
+  }
+  EXPECT_EQ(1000, cache.Get(1000).value_or(-1));
+}
+
+TEST(ConcurrentCache, GetBatch) {
+  ConcurrentCache<int, int> cache(1000, 8);
+  EXPECT_EQ(8, cache.shard_num());
+  for (int i = 0; i < 100; i += 2) {
+    cache.Put(i, i * 10);
+  }
+  std::vector<int> keys;
+  for (int i = 0; i < 100; ++i) {
+    keys.push_back(i);
+  }
+  std::vector<std::optional<int>> values;
+  EXPECT_EQ(50, cache.GetBatch(keys, &values));
+  ASSERT_EQ(keys.size(), values.size());
+  for (int i = 0; i < 100; ++i) {
+    if (i % 2 == 0) {
+      EXPECT_EQ(i * 10, values[i].value_or(-1));
+    } else {
+      EXPECT_FALSE(values[i].has_value());
+    }
+  }
+}
+
+TEST(ConcurrentCache, Capacity) {
+  // 10 entries over 4 shards is not a multiple of the shard number
+  ConcurrentCache<int, int> cache(10, 4);
+  EXPECT_EQ(4, cache.shard_num());
+  EXPECT_EQ(10, cache.capacity());
+  for (int i = 0; i < 1000; ++i) {
+    cache.Put(i, i);
+  }
+  EXPECT_EQ(10, cache.size());
+
+  ConcurrentCache<int, int> small_cache(3, 16);
+  EXPECT_EQ(3, small_cache.shard_num());
+  EXPECT_EQ(3, small_cache.capacity());
+}
+
+TEST(ConcurrentCache, GetOrCompute) {
+  ConcurrentCache<std::string, int> cache(10);
+  int compute_num = 0;
+  auto compute = [&compute_num]() {
+    ++compute_num;
+    return 42;
+  };
+  EXPECT_EQ(42, cache.GetOrCompute("lane", compute));
+  EXPECT_EQ(42, cache.GetOrCompute("lane", compute));
+  EXPECT_EQ(1, compute_num);
+}
+
+TEST(ConcurrentCache, Threads) {
+  const int kThreadNum = 8;
+  const int kKeyNum = 512;
+  ConcurrentCache<int, int> cache(256, 16);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreadNum; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int i = 0; i < 20000; ++i) {
+        const int key = (i * 7 + t * 13) % kKeyNum;
+        int value = 0;
+        if (cache.Get(key, &value)) {
+          EXPECT_EQ(key * 3, value);
+        } else {
+          cache.Put(key, key * 3);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_LE(cache.size(), cache.capacity());
+  const auto statistics = cache.statistics();
+  EXPECT_EQ(kThreadNum * 20000, statistics.hit_num + statistics.miss_num);
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
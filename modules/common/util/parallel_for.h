@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Loops split in contiguous blocks over short lived threads.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @brief The number of threads to use, the number of cores if thread_num is
+ * not positive.
+ */
+inline int ResolveThreadNum(const int thread_num) {
+  if (thread_num > 0) {
+    return thread_num;
+  }
+  return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+/**
+ * @brief The number of blocks ParallelForBlocks splits num items into at
+ * most, every block index it passes on is below it.
+ */
+inline size_t ParallelBlockNum(const size_t num, const int thread_num) {
+  return std::max<size_t>(
+      1, std::min(static_cast<size_t>(ResolveThreadNum(thread_num)), num));
+}
+
+/**
+ * @brief Calls func(block, begin, end) for the contiguous blocks [begin, end)
+ * of [0, num), all of the same size but the last one. The first block runs
+ * on the calling thread, every other one on a thread of its own, and the
+ * call returns once all of them are done. Nothing runs for an empty range.
+ */
+template <typename Func>
+void ParallelForBlocks(const size_t num, const int thread_num,
+                       const Func& func) {
+  if (num == 0) {
+    return;
+  }
+  const size_t block_num = ParallelBlockNum(num, thread_num);
+  const size_t block_size = (num + block_num - 1) / block_num;
+  std::vector<std::thread> threads;
+  for (size_t block = 1; block * block_size < num; ++block) {
+    const size_t begin = block * block_size;
+    const size_t end = std::min(num, begin + block_size);
+    threads.emplace_back(
+        [&func, block, begin, end] { func(block, begin, end); });
+  }
+  func(static_cast<size_t>(0), static_cast<size_t>(0),
+       std::min(block_size, num));
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+/**
+ * @brief Calls func(i) for every i in [0, num), split in blocks as
+ * ParallelForBlocks does.
+ */
+template <typename Func>
+void ParallelFor(const size_t num, const int thread_num, const Func& func) {
+  ParallelForBlocks(num, thread_num,
+                    [&func](const size_t, const size_t begin,
+                            const size_t end) {
+                      for (size_t i = begin; i < end; ++i) {
+                        func(i);
+                      }
+                    });
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
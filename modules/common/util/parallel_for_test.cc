@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/parallel_for.h"
+
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(ParallelForTest, ResolveThreadNum) {
+  EXPECT_EQ(3, ResolveThreadNum(3));
+  EXPECT_GE(ResolveThreadNum(0), 1);
+  EXPECT_GE(ResolveThreadNum(-1), 1);
+}
+
+TEST(ParallelForTest, Blocks) {
+  for (const size_t num : {0, 1, 5, 7, 100}) {
+    for (const int thread_num : {1, 3, 4, 200}) {
+      const size_t block_num = ParallelBlockNum(num, thread_num);
+      EXPECT_LE(block_num, static_cast<size_t>(thread_num));
+      std::vector<int> visits(num, 0);
+      std::vector<int> block_visits(block_num, 0);
+      ParallelForBlocks(num, thread_num,
+                        [&](const size_t block, const size_t begin,
+                            const size_t end) {
+                          ASSERT_LT(block, block_num);
+                          ++block_visits[block];
+                          for (size_t i = begin; i < end; ++i) {
+                            ++visits[i];
+                          }
+                        });
+      for (const int visit : visits) {
+        EXPECT_EQ(1, visit);
+      }
+      for (const int visit : block_visits) {
+        EXPECT_LE(visit, 1);
+      }
+    }
+  }
+}
+
+TEST(ParallelForTest, Items) {
+  std::vector<int> values(1000, 0);
+  std::atomic<int> calls(0);
+  ParallelFor(values.size(), 4, [&](const size_t i) {
+    values[i] = static_cast<int>(i);
+    ++calls;
+  });
+  EXPECT_EQ(1000, calls.load());
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(static_cast<int>(i), values[i]);
+  }
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
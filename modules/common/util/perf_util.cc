@@ -15,7 +15,10 @@
  *****************************************************************************/
 #include "modules/common/util/perf_util.h"
 
+#include <unordered_map>
+
 #include "cyber/common/log.h"
+#include "cyber/event/trace.h"
 
 namespace {
 std::string func_name_simplified(const std::string& str) {
@@ -50,18 +53,61 @@ std::string function_signature(const std::string& func_name,
   return absl::StrCat(indicator, "_", simplified_name);
 }
 
-void Timer::Start() { start_time_ = Time::Now(); }
+void Timer::Start() {
+  start_time_ = Time::Now();
+  start_ticks_ = apollo::cyber::event::TraceTicks();
+}
+
+const char* TraceName(const std::string& name) {
+  thread_local std::unordered_map<std::string, const char*> trace_names;
+  auto search = trace_names.find(name);
+  if (search != trace_names.end()) {
+    return search->second;
+  }
+  const char* trace_name =
+      apollo::cyber::event::TraceRegistry::Instance()->InternName(name);
+  // only interned names are cached, so the cache is bounded by the registry
+  if (trace_name != nullptr) {
+    trace_names.emplace(name, trace_name);
+  }
+  return trace_name;
+}
 
 int64_t Timer::End(const std::string& msg) {
+  // the name of a block is only known here
+  const char* trace_name = nullptr;
+  if (apollo::cyber::event::TraceRegistry::Instance()->enabled()) {
+    trace_name = TraceName(msg);
+  }
+  return End(msg, trace_name);
+}
+
+int64_t Timer::End(const std::string& msg, const char* trace_name) {
   end_time_ = Time::Now();
+  uint64_t end_ticks = apollo::cyber::event::TraceTicks();
   int64_t elapsed_time = (end_time_ - start_time_).ToNanosecond() / 1e6;
   ADEBUG << "TIMER " << msg << " elapsed_time: " << elapsed_time << " ms";
 
+  // also recorded as a scope of the trace, nested in the enclosing ones.
+  auto trace_registry = apollo::cyber::event::TraceRegistry::Instance();
+  if (trace_name != nullptr && trace_registry->enabled()) {
+    trace_registry->Record(trace_name, start_ticks_, end_ticks);
+  }
+
   // start new timer.
   start_time_ = end_time_;
+  start_ticks_ = end_ticks;
   return elapsed_time;
 }
 
+TimerWrapper::TimerWrapper(const std::string& msg) : msg_(msg) {
+  // interned once here rather than when the timer ends
+  if (apollo::cyber::event::TraceRegistry::Instance()->enabled()) {
+    trace_name_ = TraceName(msg_);
+  }
+  timer_.Start();
+}
+
 }  // namespace util
 }  // namespace common
 }  // namespace apollo
@@ -60,6 +60,13 @@
 //  I0615 15:49:30.756429 12748 timer.cpp:31] TIMER xx2 elapsed time: 100 ms
 //  I0615 15:49:30.756429 12748 timer.cpp:31] TIMER xx3 elapsed time: 200 ms
 //  >>>>>>>>>>>>>>>
+//
+//  3) With perf_conf.trace_enable set in cyber.pb.conf, the timers above are
+//  recorded by apollo::cyber::event::TraceRegistry as well, nested in the
+//  scope of the component Proc and in CYBER_TRACE_SCOPE(name) scopes. Per
+//  cycle statistics of every scope path are given by Aggregate(), and the
+//  whole trace is written to perf_conf.trace_file at shutdown, to be opened
+//  with chrome://tracing or Perfetto.
 namespace apollo {
 namespace common {
 namespace util {
@@ -67,6 +74,10 @@ namespace util {
 std::string function_signature(const std::string& func_name,
                                const std::string& indicator = "");
 
+// the name interned by the trace registry, cached per thread so that the
+// registry lock is only taken the first time a thread uses a name.
+const char* TraceName(const std::string& name);
+
 class Timer {
  public:
   Timer() = default;
@@ -80,22 +91,28 @@ class Timer {
   // no-thread safe.
   int64_t End(const std::string& msg);
 
+  // same as above, but recorded in the trace as trace_name, a name from
+  // TraceName, or not recorded if it is nullptr.
+  int64_t End(const std::string& msg, const char* trace_name);
+
  private:
   apollo::cyber::Time start_time_;
   apollo::cyber::Time end_time_;
+  uint64_t start_ticks_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(Timer);
 };
 
 class TimerWrapper {
  public:
-  explicit TimerWrapper(const std::string& msg) : msg_(msg) { timer_.Start(); }
+  explicit TimerWrapper(const std::string& msg);
 
-  ~TimerWrapper() { timer_.End(msg_); }
+  ~TimerWrapper() { timer_.End(msg_, trace_name_); }
 
  private:
   Timer timer_;
   std::string msg_;
+  const char* trace_name_ = nullptr;
 
   DISALLOW_COPY_AND_ASSIGN(TimerWrapper);
 };
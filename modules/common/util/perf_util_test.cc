@@ -20,6 +20,8 @@
 
 #include "gtest/gtest.h"
 
+#include "cyber/event/trace.h"
+
 namespace apollo {
 namespace common {
 namespace util {
@@ -53,6 +55,42 @@ TEST(PerfBlockTest, test) {
   PERF_BLOCK_END("BLOCK2");
 }
 
+TEST(TimeTest, test_trace) {
+  auto trace_registry = apollo::cyber::event::TraceRegistry::Instance();
+  trace_registry->set_enabled(true);
+  trace_registry->Clear();
+  {
+    CYBER_TRACE_SCOPE("TraceTest");
+    Timer timer;
+    timer.Start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    timer.End("TraceTimer");
+  }
+  auto stats = trace_registry->Aggregate();
+  trace_registry->set_enabled(false);
+  ASSERT_EQ(2, stats.size());
+  EXPECT_EQ("TraceTest", stats[0].path);
+  EXPECT_EQ("TraceTest;TraceTimer", stats[1].path);
+  EXPECT_GE(stats[1].max_ms, 9.0);
+}
+
+TEST(TimeTest, test_trace_name) {
+  EXPECT_EQ(TraceName("TraceName"), TraceName(std::string("TraceName")));
+  EXPECT_STREQ("TraceName", TraceName("TraceName"));
+
+  auto trace_registry = apollo::cyber::event::TraceRegistry::Instance();
+  trace_registry->set_enabled(true);
+  trace_registry->Clear();
+  {
+    TimerWrapper wrapper("TraceWrapper");
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  auto stats = trace_registry->Aggregate();
+  trace_registry->set_enabled(false);
+  ASSERT_EQ(1, stats.size());
+  EXPECT_EQ("TraceWrapper", stats[0].path);
+}
+
 }  // namespace util
 }  // namespace common
 }  // namespace apollo
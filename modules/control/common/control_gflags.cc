@@ -126,3 +126,7 @@ DEFINE_bool(
 
 DEFINE_double(steer_cmd_interval, 20.0,
               "Steer cmd interval of current and previous in percentage.");
+
+DEFINE_bool(enable_mpc_osqp_workspace_reuse, false,
+            "Keep the MPC OSQP workspace across control cycles, updated in "
+            "place and warm started from the shifted last solution");
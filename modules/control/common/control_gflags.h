@@ -84,3 +84,5 @@ DECLARE_bool(use_acceleration_lookup_limit);
 DECLARE_bool(use_preview_reference_check);
 
 DECLARE_double(steer_cmd_interval);
+
+DECLARE_bool(enable_mpc_osqp_workspace_reuse);
@@ -391,6 +391,9 @@ Status MPCController::ComputeControlCommand(
       matrix_state_, lower_bound, upper_bound, lower_state_bound,
       upper_state_bound, reference_state, mpc_max_iteration_, horizon_,
       mpc_eps_);
+  if (FLAGS_enable_mpc_osqp_workspace_reuse) {
+    mpc_osqp.set_solver(&mpc_solver_);
+  }
   if (!mpc_osqp.Solve(&control_cmd)) {
     AERROR << "MPC OSQP solver failed";
   } else {
@@ -528,6 +531,7 @@ Status MPCController::ComputeControlCommand(
 Status MPCController::Reset() {
   previous_heading_error_ = 0.0;
   previous_lateral_error_ = 0.0;
+  mpc_solver_.Reset();
   return Status::OK();
 }
 
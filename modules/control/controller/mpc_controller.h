@@ -229,6 +229,8 @@ class MPCController : public Controller {
   int mpc_max_iteration_ = 0;
   // parameters for mpc solver; threshold for computation
   double mpc_eps_ = 0.0;
+  // osqp workspace of the last control cycle, warm starts the next one
+  common::math::OsqpSolver mpc_solver_;
 
   common::DigitalFilter digital_filter_;
 
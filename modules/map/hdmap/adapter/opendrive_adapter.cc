@@ -33,7 +33,8 @@ namespace hdmap {
 namespace adapter {
 
 bool OpendriveAdapter::LoadData(const std::string& filename,
-                                apollo::hdmap::Map* pb_map) {
+                                apollo::hdmap::Map* pb_map,
+                                const int thread_num) {
   CHECK_NOTNULL(pb_map);
 
   tinyxml2::XMLDocument document;
@@ -55,7 +56,7 @@ bool OpendriveAdapter::LoadData(const std::string& filename,
 
   // road
   std::vector<RoadInternal> roads;
-  status = RoadsXmlParser::Parse(*root_node, &roads);
+  status = RoadsXmlParser::Parse(*root_node, &roads, thread_num);
   if (!status.ok()) {
     AERROR << "fail to parse opendrive road, " << status.error_message();
     return false;
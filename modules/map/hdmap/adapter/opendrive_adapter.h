@@ -24,7 +24,10 @@ namespace adapter {
 
 class OpendriveAdapter {
  public:
-  static bool LoadData(const std::string& filename, apollo::hdmap::Map* pb_map);
+  // Convert an OpenDRIVE map, of which the roads are parsed on thread_num
+  // threads, the number of cores if 0.
+  static bool LoadData(const std::string& filename, apollo::hdmap::Map* pb_map,
+                       const int thread_num = 0);
 };
 
 }  // namespace adapter
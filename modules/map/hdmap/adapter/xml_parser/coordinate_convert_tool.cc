@@ -14,11 +14,47 @@ limitations under the License.
 =========================================================================*/
 #include "modules/map/hdmap/adapter/xml_parser/coordinate_convert_tool.h"
 
+#include <atomic>
+
 #include "glog/logging.h"
 
 namespace apollo {
 namespace hdmap {
 namespace adapter {
+namespace {
+
+std::atomic<int> next_param_version(0);
+
+// The projections of a thread, created in a proj context of its own since
+// the projections and the context are not safe to share among threads.
+struct ThreadProjections {
+  ~ThreadProjections() { Reset(); }
+
+  void Reset() {
+    if (pj_from) {
+      pj_free(pj_from);
+      pj_from = nullptr;
+    }
+    if (pj_to) {
+      pj_free(pj_to);
+      pj_to = nullptr;
+    }
+    if (ctx) {
+      pj_ctx_free(ctx);
+      ctx = nullptr;
+    }
+    param_version = -1;
+  }
+
+  int param_version = -1;
+  projCtx ctx = nullptr;
+  projPJ pj_from = nullptr;
+  projPJ pj_to = nullptr;
+};
+
+thread_local ThreadProjections thread_projections;
+
+}  // namespace
 
 CoordinateConvertTool::CoordinateConvertTool()
     : pj_from_(nullptr), pj_to_(nullptr) {}
@@ -44,6 +80,7 @@ Status CoordinateConvertTool::SetConvertParam(const std::string& source_param,
                                               const std::string& dst_param) {
   source_convert_param_ = source_param;
   dst_convert_param_ = dst_param;
+  param_version_ = next_param_version++;
   if (pj_from_) {
     pj_free(pj_from_);
     pj_from_ = nullptr;
@@ -82,23 +119,39 @@ Status CoordinateConvertTool::CoordiateConvert(const double longitude,
     return Status(apollo::common::ErrorCode::HDMAP_DATA_ERROR, err_msg);
   }
 
+  ThreadProjections& projections = thread_projections;
+  if (projections.param_version != param_version_) {
+    projections.Reset();
+    projections.ctx = pj_ctx_alloc();
+    projections.pj_from =
+        pj_init_plus_ctx(projections.ctx, source_convert_param_.c_str());
+    projections.pj_to =
+        pj_init_plus_ctx(projections.ctx, dst_convert_param_.c_str());
+    if (!projections.pj_from || !projections.pj_to) {
+      projections.Reset();
+      std::string err_msg = "Fail to pj_init_plus_ctx";
+      return Status(apollo::common::ErrorCode::HDMAP_DATA_ERROR, err_msg);
+    }
+    projections.param_version = param_version_;
+  }
+
   double gps_longitude = longitude;
   double gps_latitude = latitude;
   double gps_alt = height_ellipsoid;
 
-  if (pj_is_latlong(pj_from_)) {
+  if (pj_is_latlong(projections.pj_from)) {
     gps_longitude *= DEG_TO_RAD;
     gps_latitude *= DEG_TO_RAD;
     gps_alt = height_ellipsoid;
   }
 
-  if (0 != pj_transform(pj_from_, pj_to_, 1, 1, &gps_longitude, &gps_latitude,
-                        &gps_alt)) {
+  if (0 != pj_transform(projections.pj_from, projections.pj_to, 1, 1,
+                        &gps_longitude, &gps_latitude, &gps_alt)) {
     std::string err_msg = "fail to transform coordinate";
     return Status(apollo::common::ErrorCode::HDMAP_DATA_ERROR, err_msg);
   }
 
-  if (pj_is_latlong(pj_to_)) {
+  if (pj_is_latlong(projections.pj_to)) {
     gps_longitude *= RAD_TO_DEG;
     gps_latitude *= RAD_TO_DEG;
   }
@@ -25,6 +25,9 @@ namespace apollo {
 namespace hdmap {
 namespace adapter {
 
+// Converts the coordinates of the map. The conversions may run on several
+// threads at once, each of which uses projections of its own, but not
+// together with SetConvertParam.
 class CoordinateConvertTool {
  public:
   CoordinateConvertTool();
@@ -43,6 +46,9 @@ class CoordinateConvertTool {
  private:
   std::string source_convert_param_;
   std::string dst_convert_param_;
+  // changed by each SetConvertParam, the threads create their projections
+  // again when it differs from the one they were created with
+  int param_version_ = -1;
 
   projPJ pj_from_;
   projPJ pj_to_;
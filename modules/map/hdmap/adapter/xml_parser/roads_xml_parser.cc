@@ -12,8 +12,11 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 =========================================================================*/
+#include <algorithm>
+#include <iterator>
 #include <string>
 
+#include "modules/common/util/parallel_for.h"
 #include "modules/map/hdmap/adapter/xml_parser/lanes_xml_parser.h"
 #include "modules/map/hdmap/adapter/xml_parser/objects_xml_parser.h"
 #include "modules/map/hdmap/adapter/xml_parser/roads_xml_parser.h"
@@ -32,52 +35,83 @@ namespace hdmap {
 namespace adapter {
 
 Status RoadsXmlParser::Parse(const tinyxml2::XMLElement& xml_node,
-                             std::vector<RoadInternal>* roads) {
+                             std::vector<RoadInternal>* roads,
+                             const int thread_num) {
   CHECK_NOTNULL(roads);
 
+  std::vector<const tinyxml2::XMLElement*> road_nodes;
   auto road_node = xml_node.FirstChildElement("road");
   while (road_node) {
-    // road attributes
-    std::string id;
-    std::string junction_id;
-    int checker = UtilXmlParser::QueryStringAttribute(*road_node, "id", &id);
-    checker += UtilXmlParser::QueryStringAttribute(*road_node, "junction",
-                                                   &junction_id);
-    if (checker != tinyxml2::XML_SUCCESS) {
-      std::string err_msg = "Error parsing road attributes";
-      return Status(apollo::common::ErrorCode::HDMAP_DATA_ERROR, err_msg);
-    }
-
-    RoadInternal road_internal;
-    road_internal.id = id;
-    road_internal.road.mutable_id()->set_id(id);
-    if (IsRoadBelongToJunction(junction_id)) {
-      road_internal.road.mutable_junction_id()->set_id(junction_id);
-    }
-
-    std::string type;
-    checker = UtilXmlParser::QueryStringAttribute(*road_node, "type", &type);
-    if (checker != tinyxml2::XML_SUCCESS) {
-      // forward compatibility with old data
-      type = "CITYROAD";
-    }
-    PbRoadType pb_road_type;
-    RETURN_IF_ERROR(to_pb_road_type(type, &pb_road_type));
-    road_internal.road.set_type(pb_road_type);
-
-    // lanes
-    RETURN_IF_ERROR(LanesXmlParser::Parse(*road_node, road_internal.id,
-                                          &road_internal.sections));
-
-    // objects
-    Parse_road_objects(*road_node, &road_internal);
-    // signals
-    Parse_road_signals(*road_node, &road_internal);
-
-    roads->push_back(road_internal);
+    road_nodes.push_back(road_node);
     road_node = road_node->NextSiblingElement("road");
   }
 
+  // The roads are parsed independently, in contiguous blocks of one thread
+  // each, since the document is only read.
+  const size_t road_num = road_nodes.size();
+  std::vector<RoadInternal> road_internals(road_num);
+  std::vector<Status> statuses(road_num);
+  common::util::ParallelForBlocks(
+      road_num, thread_num,
+      [&](const size_t, const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          statuses[i] = ParseRoad(*road_nodes[i], &road_internals[i]);
+          if (!statuses[i].ok()) {
+            break;
+          }
+        }
+      });
+
+  for (size_t i = 0; i < road_num; ++i) {
+    RETURN_IF_ERROR(statuses[i]);
+  }
+  roads->reserve(roads->size() + road_num);
+  std::move(road_internals.begin(), road_internals.end(),
+            std::back_inserter(*roads));
+
+  return Status::OK();
+}
+
+Status RoadsXmlParser::ParseRoad(const tinyxml2::XMLElement& road_node,
+                                 RoadInternal* road_internal) {
+  CHECK_NOTNULL(road_internal);
+
+  // road attributes
+  std::string id;
+  std::string junction_id;
+  int checker = UtilXmlParser::QueryStringAttribute(road_node, "id", &id);
+  checker += UtilXmlParser::QueryStringAttribute(road_node, "junction",
+                                                 &junction_id);
+  if (checker != tinyxml2::XML_SUCCESS) {
+    std::string err_msg = "Error parsing road attributes";
+    return Status(apollo::common::ErrorCode::HDMAP_DATA_ERROR, err_msg);
+  }
+
+  road_internal->id = id;
+  road_internal->road.mutable_id()->set_id(id);
+  if (IsRoadBelongToJunction(junction_id)) {
+    road_internal->road.mutable_junction_id()->set_id(junction_id);
+  }
+
+  std::string type;
+  checker = UtilXmlParser::QueryStringAttribute(road_node, "type", &type);
+  if (checker != tinyxml2::XML_SUCCESS) {
+    // forward compatibility with old data
+    type = "CITYROAD";
+  }
+  PbRoadType pb_road_type;
+  RETURN_IF_ERROR(to_pb_road_type(type, &pb_road_type));
+  road_internal->road.set_type(pb_road_type);
+
+  // lanes
+  RETURN_IF_ERROR(LanesXmlParser::Parse(road_node, road_internal->id,
+                                        &road_internal->sections));
+
+  // objects
+  Parse_road_objects(road_node, road_internal);
+  // signals
+  Parse_road_signals(road_node, road_internal);
+
   return Status::OK();
 }
 
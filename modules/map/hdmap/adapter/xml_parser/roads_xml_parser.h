@@ -28,10 +28,15 @@ namespace adapter {
 
 class RoadsXmlParser {
  public:
+  // Parse the roads in the order of the document, on thread_num threads, the
+  // number of cores if 0. The error of the first road failing is returned.
   static Status Parse(const tinyxml2::XMLElement& xml_node,
-                      std::vector<RoadInternal>* roads);
+                      std::vector<RoadInternal>* roads,
+                      const int thread_num = 1);
 
  private:
+  static Status ParseRoad(const tinyxml2::XMLElement& road_node,
+                          RoadInternal* road_internal);
   static void Parse_road_objects(const tinyxml2::XMLElement& xml_node,
                                  RoadInternal* road_info);
   static void Parse_road_signals(const tinyxml2::XMLElement& xml_node,
@@ -0,0 +1,275 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+#include "modules/map/hdmap/compiled_map.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace hdmap {
+namespace {
+
+using apollo::common::math::AABoxKDTreeNode;
+
+constexpr char kMagic[8] = {'A', 'P', 'O', 'L', 'L', 'O', 'M', 'P'};
+constexpr uint32_t kByteOrder = 0x01020304;
+
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t file_size;
+  uint32_t section_num;
+  uint32_t reserved;
+};
+
+struct SectionEntry {
+  uint32_t type;
+  uint32_t reserved;
+  uint64_t offset;
+  uint64_t size;
+};
+
+struct KDTreeHeader {
+  uint32_t object_num;
+  uint32_t node_num;
+};
+
+static_assert(std::is_trivially_copyable<AABoxKDTreeNode>::value,
+              "KD-tree nodes are written as they are");
+static_assert(std::is_trivially_copyable<CompiledKDTree::Object>::value,
+              "KD-tree objects are written as they are");
+
+size_t Align(const size_t offset) {
+  return (offset + kCompiledMapAlignment - 1) / kCompiledMapAlignment *
+         kCompiledMapAlignment;
+}
+
+template <class T>
+void AppendArray(const std::vector<T>& values, std::string* data) {
+  data->append(reinterpret_cast<const char*>(values.data()),
+               values.size() * sizeof(T));
+}
+
+// Reads num values at *offset of data, false if they are beyond its size.
+template <class T>
+bool ReadArray(const char* data, const size_t size, const size_t num,
+               size_t* offset, std::vector<T>* values) {
+  if (num > (size - *offset) / sizeof(T)) {
+    return false;
+  }
+  values->resize(num);
+  std::memcpy(values->data(), data + *offset, num * sizeof(T));
+  *offset += num * sizeof(T);
+  return true;
+}
+
+}  // namespace
+
+std::string CompiledKDTree::Serialize() const {
+  KDTreeHeader header;
+  header.object_num = static_cast<uint32_t>(objects.size());
+  header.node_num = static_cast<uint32_t>(layout.nodes.size());
+  std::string data(reinterpret_cast<const char*>(&header), sizeof(header));
+  AppendArray(objects, &data);
+  AppendArray(layout.nodes, &data);
+  AppendArray(layout.sorted_by_min, &data);
+  AppendArray(layout.sorted_by_max, &data);
+  return data;
+}
+
+bool CompiledKDTree::Parse(const char* data, const size_t size) {
+  KDTreeHeader header;
+  if (size < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(&header, data, sizeof(header));
+  size_t offset = sizeof(header);
+  if (!ReadArray(data, size, header.object_num, &offset, &objects) ||
+      !ReadArray(data, size, header.node_num, &offset, &layout.nodes) ||
+      !ReadArray(data, size, header.object_num, &offset,
+                 &layout.sorted_by_min) ||
+      !ReadArray(data, size, header.object_num, &offset,
+                 &layout.sorted_by_max)) {
+    return false;
+  }
+  return offset == size && layout.IsValid(objects.size());
+}
+
+void CompiledMapWriter::AddSection(const CompiledMapSection type,
+                                   std::string data) {
+  sections_.emplace_back(type, std::move(data));
+}
+
+bool CompiledMapWriter::Write(const std::string& filename) const {
+  FileHeader header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kCompiledMapVersion;
+  header.byte_order = kByteOrder;
+  header.section_num = static_cast<uint32_t>(sections_.size());
+  header.reserved = 0;
+
+  std::vector<SectionEntry> entries;
+  size_t offset =
+      Align(sizeof(header) + sections_.size() * sizeof(SectionEntry));
+  for (const auto& section : sections_) {
+    SectionEntry entry;
+    entry.type = static_cast<uint32_t>(section.first);
+    entry.reserved = 0;
+    entry.offset = offset;
+    entry.size = section.second.size();
+    entries.push_back(entry);
+    offset = Align(offset + section.second.size());
+  }
+  header.file_size = offset;
+
+  const std::string temp_filename = filename + ".tmp";
+  {
+    std::ofstream file(temp_filename, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      AERROR << "Failed to open " << temp_filename;
+      return false;
+    }
+    const std::string padding(kCompiledMapAlignment, '\0');
+    size_t written = sizeof(header) + entries.size() * sizeof(SectionEntry);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()),
+               entries.size() * sizeof(SectionEntry));
+    for (size_t i = 0; i < sections_.size(); ++i) {
+      file.write(padding.data(), entries[i].offset - written);
+      file.write(sections_[i].second.data(), sections_[i].second.size());
+      written = entries[i].offset + sections_[i].second.size();
+    }
+    file.write(padding.data(), header.file_size - written);
+    if (!file.flush()) {
+      AERROR << "Failed to write " << temp_filename;
+      return false;
+    }
+  }
+  if (std::rename(temp_filename.c_str(), filename.c_str()) != 0) {
+    AERROR << "Failed to rename " << temp_filename << " to " << filename
+           << ": " << std::strerror(errno);
+    std::remove(temp_filename.c_str());
+    return false;
+  }
+  return true;
+}
+
+CompiledMap::~CompiledMap() { Close(); }
+
+bool CompiledMap::Open(const std::string& filename) {
+  Close();
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    AERROR << "Failed to open " << filename << ": " << std::strerror(errno);
+    return false;
+  }
+  struct stat file_attr;
+  if (fstat(fd, &file_attr) < 0) {
+    AERROR << "Failed to stat " << filename << ": " << std::strerror(errno);
+    close(fd);
+    return false;
+  }
+  length_ = static_cast<size_t>(file_attr.st_size);
+  if (length_ < sizeof(FileHeader)) {
+    AERROR << filename << " is not a compiled map.";
+    close(fd);
+    length_ = 0;
+    return false;
+  }
+  address_ = mmap(nullptr, length_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (address_ == MAP_FAILED) {
+    AERROR << "Failed to map " << filename << ": " << std::strerror(errno);
+    address_ = nullptr;
+    length_ = 0;
+    return false;
+  }
+
+  const char* begin = static_cast<const char*>(address_);
+  FileHeader header;
+  std::memcpy(&header, begin, sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.byte_order != kByteOrder) {
+    AERROR << filename << " is not a compiled map of this machine.";
+    Close();
+    return false;
+  }
+  if (header.version != kCompiledMapVersion) {
+    AERROR << filename << " is a compiled map of version " << header.version
+           << ", expected " << kCompiledMapVersion << ".";
+    Close();
+    return false;
+  }
+  if (header.file_size != length_ ||
+      header.section_num >
+          (length_ - sizeof(header)) / sizeof(SectionEntry)) {
+    AERROR << filename << " is truncated.";
+    Close();
+    return false;
+  }
+  for (uint32_t i = 0; i < header.section_num; ++i) {
+    SectionEntry entry;
+    std::memcpy(&entry, begin + sizeof(header) + i * sizeof(entry),
+                sizeof(entry));
+    if (entry.offset > length_ || entry.size > length_ - entry.offset) {
+      AERROR << "Section " << entry.type << " of " << filename
+             << " is beyond the end of the file.";
+      Close();
+      return false;
+    }
+    Section section;
+    section.type = static_cast<CompiledMapSection>(entry.type);
+    section.data = begin + entry.offset;
+    section.size = entry.size;
+    sections_.push_back(section);
+  }
+  return true;
+}
+
+void CompiledMap::Close() {
+  if (address_ != nullptr) {
+    munmap(address_, length_);
+  }
+  address_ = nullptr;
+  length_ = 0;
+  sections_.clear();
+}
+
+bool CompiledMap::GetSection(const CompiledMapSection type, const char** data,
+                             size_t* size) const {
+  for (const auto& section : sections_) {
+    if (section.type == type) {
+      *data = section.data;
+      *size = section.size;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,144 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+/**
+ * @file
+ * @brief The compiled map format, a map file which is memory mapped instead
+ * of read, with the spatial indices of the map prebuilt.
+ *
+ * A compiled map is a header, a table of sections and the sections, each of
+ * them aligned to kCompiledMapAlignment bytes. The MAP section is the map
+ * proto in its binary format, the KD-tree sections are CompiledKDTree. All
+ * integers are in the byte order of the machine which compiled the map, the
+ * header tells it apart.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "modules/common/math/aaboxkdtree2d.h"
+
+/**
+ * @namespace apollo::hdmap
+ * @brief apollo::hdmap
+ */
+namespace apollo {
+namespace hdmap {
+
+constexpr char kCompiledMapExtension[] = ".cmap";
+constexpr uint32_t kCompiledMapVersion = 1;
+constexpr size_t kCompiledMapAlignment = 64;
+
+enum class CompiledMapSection : uint32_t {
+  MAP = 1,
+  LANE_SEGMENT_KDTREE = 2,
+  JUNCTION_POLYGON_KDTREE = 3,
+  CROSSWALK_POLYGON_KDTREE = 4,
+  SIGNAL_SEGMENT_KDTREE = 5,
+  STOP_SIGN_SEGMENT_KDTREE = 6,
+  YIELD_SIGN_SEGMENT_KDTREE = 7,
+  CLEAR_AREA_POLYGON_KDTREE = 8,
+  SPEED_BUMP_SEGMENT_KDTREE = 9,
+  PARKING_SPACE_POLYGON_KDTREE = 10,
+  PNC_JUNCTION_POLYGON_KDTREE = 11,
+};
+
+/**
+ * @class CompiledKDTree
+ * @brief A spatial index of a compiled map. The objects of the tree are
+ * segments or polygons of map elements, referred to by the index of the
+ * element in its repeated field of the map proto and the index of the
+ * segment, 0 for polygons.
+ */
+struct CompiledKDTree {
+  struct Object {
+    int32_t element_index = 0;
+    int32_t sub_index = 0;
+  };
+
+  std::vector<Object> objects;
+  apollo::common::math::AABoxKDTreeLayout layout;
+
+  std::string Serialize() const;
+  bool Parse(const char* data, const size_t size);
+};
+
+/**
+ * @class CompiledMapWriter
+ * @brief Writes the sections of a compiled map to a file.
+ */
+class CompiledMapWriter {
+ public:
+  void AddSection(const CompiledMapSection type, std::string data);
+
+  /**
+   * @brief Write the compiled map to a temporary file which is then renamed
+   * to filename, so that processes which mapped a former version of the file
+   * keep reading it as it was.
+   * @return true on success
+   */
+  bool Write(const std::string& filename) const;
+
+ private:
+  std::vector<std::pair<CompiledMapSection, std::string>> sections_;
+};
+
+/**
+ * @class CompiledMap
+ * @brief A compiled map file mapped read only into memory. The pages of the
+ * file are shared by every process which maps it.
+ */
+class CompiledMap {
+ public:
+  CompiledMap() = default;
+  ~CompiledMap();
+  CompiledMap(const CompiledMap&) = delete;
+  CompiledMap& operator=(const CompiledMap&) = delete;
+
+  /**
+   * @brief Map a compiled map file and check its header and its table of
+   * sections.
+   * @return true on success
+   */
+  bool Open(const std::string& filename);
+
+  void Close();
+
+  /**
+   * @brief Get a section of the compiled map, valid until it is closed.
+   * @return false if there is no such section
+   */
+  bool GetSection(const CompiledMapSection type, const char** data,
+                  size_t* size) const;
+
+ private:
+  struct Section {
+    CompiledMapSection type;
+    const char* data = nullptr;
+    size_t size = 0;
+  };
+
+  void* address_ = nullptr;
+  size_t length_ = 0;
+  std::vector<Section> sections_;
+};
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -217,5 +217,43 @@ int HDMap::GetForwardNearestRSUs(const apollo::common::PointENU& point,
                     max_heading_difference, rsus);
 }
 
+int HDMap::GetLanes(const std::vector<apollo::common::PointENU>& points,
+                    double distance,
+                    std::vector<std::vector<LaneInfoConstPtr>>* lanes) const {
+  return impl_.GetLanes(points, distance, lanes);
+}
+
+int HDMap::GetJunctions(
+    const std::vector<apollo::common::PointENU>& points, double distance,
+    std::vector<std::vector<JunctionInfoConstPtr>>* junctions) const {
+  return impl_.GetJunctions(points, distance, junctions);
+}
+
+int HDMap::GetCrosswalks(
+    const std::vector<apollo::common::PointENU>& points, double distance,
+    std::vector<std::vector<CrosswalkInfoConstPtr>>* crosswalks) const {
+  return impl_.GetCrosswalks(points, distance, crosswalks);
+}
+
+int HDMap::GetLanesWithHeading(
+    const std::vector<apollo::common::PointENU>& points, const double distance,
+    const std::vector<double>& central_headings,
+    const double max_heading_difference,
+    std::vector<std::vector<LaneInfoConstPtr>>* lanes) const {
+  return impl_.GetLanesWithHeading(points, distance, central_headings,
+                                   max_heading_difference, lanes);
+}
+
+int HDMap::GetNearestLaneWithHeading(
+    const std::vector<apollo::common::PointENU>& points, const double distance,
+    const std::vector<double>& central_headings,
+    const double max_heading_difference,
+    std::vector<LaneInfoConstPtr>* nearest_lanes,
+    std::vector<double>* nearest_s, std::vector<double>* nearest_l) const {
+  return impl_.GetNearestLaneWithHeading(points, distance, central_headings,
+                                         max_heading_difference, nearest_lanes,
+                                         nearest_s, nearest_l);
+}
+
 }  // namespace hdmap
 }  // namespace apollo
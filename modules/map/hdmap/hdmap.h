@@ -311,6 +311,71 @@ class HDMap {
                     double distance, double central_heading,
                     double max_heading_difference,
                     std::vector<RSUInfoConstPtr>* rsus) const;
+  /**
+   * @brief get all lanes in certain range of every point of a batch, with
+   *        one search of the lane index for the whole batch
+   * @param points the central points of the ranges
+   * @param distance the search radius
+   * @param lanes store all lanes in the range of every point, in the order
+   *        of the points. The vectors are cleared and reused.
+   * @return 0:success, otherwise failed
+   */
+  int GetLanes(const std::vector<apollo::common::PointENU>& points,
+               double distance,
+               std::vector<std::vector<LaneInfoConstPtr>>* lanes) const;
+  /**
+   * @brief get all junctions in certain range of every point of a batch
+   * @param points the central points of the ranges
+   * @param distance the search radius
+   * @param junctions store all junctions in the range of every point
+   * @return 0:success, otherwise failed
+   */
+  int GetJunctions(
+      const std::vector<apollo::common::PointENU>& points, double distance,
+      std::vector<std::vector<JunctionInfoConstPtr>>* junctions) const;
+  /**
+   * @brief get all crosswalks in certain range of every point of a batch
+   * @param points the central points of the ranges
+   * @param distance the search radius
+   * @param crosswalks store all crosswalks in the range of every point
+   * @return 0:success, otherwise failed
+   */
+  int GetCrosswalks(
+      const std::vector<apollo::common::PointENU>& points, double distance,
+      std::vector<std::vector<CrosswalkInfoConstPtr>>* crosswalks) const;
+  /**
+   * @brief get all lanes within a certain range of every pose of a batch
+   * @param points the target positions
+   * @param distance the search radius
+   * @param central_headings the base heading of every position
+   * @param max_heading_difference the heading range
+   * @param lanes all lanes that match search conditions for every position
+   * @return 0:success, otherwise failed
+   */
+  int GetLanesWithHeading(
+      const std::vector<apollo::common::PointENU>& points,
+      const double distance, const std::vector<double>& central_headings,
+      const double max_heading_difference,
+      std::vector<std::vector<LaneInfoConstPtr>>* lanes) const;
+  /**
+   * @brief get the nearest lane within a certain range of every pose of a
+   *        batch
+   * @param points the target positions
+   * @param distance the search radius
+   * @param central_headings the base heading of every position
+   * @param max_heading_difference the heading range
+   * @param nearest_lanes the nearest lane of every position, nullptr if no
+   *        lane matches search conditions
+   * @param nearest_s the offset from lane start point along lane center line
+   * @param nearest_l the lateral offset from lane center line
+   * @return 0:success, otherwise failed
+   */
+  int GetNearestLaneWithHeading(
+      const std::vector<apollo::common::PointENU>& points,
+      const double distance, const std::vector<double>& central_headings,
+      const double max_heading_difference,
+      std::vector<LaneInfoConstPtr>* nearest_lanes,
+      std::vector<double>* nearest_s, std::vector<double>* nearest_l) const;
 
  private:
   HDMapImpl impl_;
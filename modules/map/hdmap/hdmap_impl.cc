@@ -31,7 +31,10 @@ namespace hdmap {
 namespace {
 
 using apollo::common::PointENU;
+using apollo::common::math::AABox2d;
 using apollo::common::math::AABoxKDTreeParams;
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Polygon2d;
 using apollo::common::math::Vec2d;
 
 Id CreateHDMapId(const std::string& string_id) {
@@ -45,9 +48,55 @@ constexpr double kLanesSearchRange = 10.0;
 // backward search distance in GetForwardNearestSignalsOnLane
 constexpr int kBackwardDistance = 4;
 
+// The box of a segment of a map element, as BuildSegmentKDTree makes it.
+template <class Info>
+bool AppendObjectBox(const Info* info, const int sub_index,
+                     std::vector<ObjectWithAABox<Info, LineSegment2d>>* boxes) {
+  if (sub_index < 0 ||
+      sub_index >= static_cast<int>(info->segments().size())) {
+    return false;
+  }
+  const auto& segment = info->segments()[sub_index];
+  boxes->emplace_back(AABox2d(segment.start(), segment.end()), info, &segment,
+                      sub_index);
+  return true;
+}
+
+// The box of the polygon of a map element, as BuildPolygonKDTree makes it.
+template <class Info>
+bool AppendObjectBox(const Info* info, const int sub_index,
+                     std::vector<ObjectWithAABox<Info, Polygon2d>>* boxes) {
+  if (sub_index != 0) {
+    return false;
+  }
+  const auto& polygon = info->polygon();
+  boxes->emplace_back(polygon.AABoundingBox(), info, &polygon, 0);
+  return true;
+}
+
+// The distance from a point to a lane, infinity if the heading of the lane
+// at the point differs from central_heading by more than
+// max_heading_difference.
+double DistanceToLaneWithHeading(const LaneInfo& lane, const Vec2d& point,
+                                 const double central_heading,
+                                 const double max_heading_difference,
+                                 double* const s, int* const s_index) {
+  Vec2d map_point;
+  const double distance = lane.DistanceTo(point, &map_point, s, s_index);
+  const double heading_diff = fabs(lane.headings()[*s_index] - central_heading);
+  if (fabs(apollo::common::math::NormalizeAngle(heading_diff)) >
+      max_heading_difference) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return distance;
+}
+
 }  // namespace
 
 int HDMapImpl::LoadMapFromFile(const std::string& map_filename) {
+  if (absl::EndsWith(map_filename, kCompiledMapExtension)) {
+    return LoadMapFromCompiledMap(map_filename);
+  }
   Clear();
   // TODO(All) seems map_ can be changed to a local variable of this
   // function, but test will fail if I do so. if so.
@@ -67,6 +116,89 @@ int HDMapImpl::LoadMapFromProto(const Map& map_proto) {
     Clear();
     map_ = map_proto;
   }
+  CreateTables();
+  BuildKDTrees();
+  return 0;
+}
+
+int HDMapImpl::LoadMapFromCompiledMap(const std::string& map_filename) {
+  Clear();
+  CompiledMap compiled_map;
+  if (!compiled_map.Open(map_filename)) {
+    return -1;
+  }
+  const char* data = nullptr;
+  size_t size = 0;
+  if (!compiled_map.GetSection(CompiledMapSection::MAP, &data, &size) ||
+      !map_.ParseFromArray(data, static_cast<int>(size))) {
+    AERROR << "Failed to parse the map of " << map_filename;
+    map_.Clear();
+    return -1;
+  }
+  CreateTables();
+  if (!RestoreKDTrees(compiled_map)) {
+    AWARN << "The spatial indices of " << map_filename
+          << " are missing or invalid, build them again.";
+    BuildKDTrees();
+  }
+  return 0;
+}
+
+int HDMapImpl::SaveCompiledMap(const std::string& map_filename) const {
+  CompiledMapWriter writer;
+  std::string map_data;
+  if (!map_.SerializeToString(&map_data)) {
+    AERROR << "Failed to serialize the map.";
+    return -1;
+  }
+  writer.AddSection(CompiledMapSection::MAP, std::move(map_data));
+  const bool added =
+      AddKDTreeSection(CompiledMapSection::LANE_SEGMENT_KDTREE, lane_table_,
+                       map_.lane(), lane_segment_boxes_, lane_segment_kdtree_,
+                       &writer) &&
+      AddKDTreeSection(CompiledMapSection::JUNCTION_POLYGON_KDTREE,
+                       junction_table_, map_.junction(),
+                       junction_polygon_boxes_, junction_polygon_kdtree_,
+                       &writer) &&
+      AddKDTreeSection(CompiledMapSection::CROSSWALK_POLYGON_KDTREE,
+                       crosswalk_table_, map_.crosswalk(),
+                       crosswalk_polygon_boxes_, crosswalk_polygon_kdtree_,
+                       &writer) &&
+      AddKDTreeSection(CompiledMapSection::SIGNAL_SEGMENT_KDTREE,
+                       signal_table_, map_.signal(), signal_segment_boxes_,
+                       signal_segment_kdtree_, &writer) &&
+      AddKDTreeSection(CompiledMapSection::STOP_SIGN_SEGMENT_KDTREE,
+                       stop_sign_table_, map_.stop_sign(),
+                       stop_sign_segment_boxes_, stop_sign_segment_kdtree_,
+                       &writer) &&
+      AddKDTreeSection(CompiledMapSection::YIELD_SIGN_SEGMENT_KDTREE,
+                       yield_sign_table_, map_.yield(),
+                       yield_sign_segment_boxes_, yield_sign_segment_kdtree_,
+                       &writer) &&
+      AddKDTreeSection(CompiledMapSection::CLEAR_AREA_POLYGON_KDTREE,
+                       clear_area_table_, map_.clear_area(),
+                       clear_area_polygon_boxes_, clear_area_polygon_kdtree_,
+                       &writer) &&
+      AddKDTreeSection(CompiledMapSection::SPEED_BUMP_SEGMENT_KDTREE,
+                       speed_bump_table_, map_.speed_bump(),
+                       speed_bump_segment_boxes_, speed_bump_segment_kdtree_,
+                       &writer) &&
+      AddKDTreeSection(CompiledMapSection::PARKING_SPACE_POLYGON_KDTREE,
+                       parking_space_table_, map_.parking_space(),
+                       parking_space_polygon_boxes_,
+                       parking_space_polygon_kdtree_, &writer) &&
+      AddKDTreeSection(CompiledMapSection::PNC_JUNCTION_POLYGON_KDTREE,
+                       pnc_junction_table_, map_.pnc_junction(),
+                       pnc_junction_polygon_boxes_,
+                       pnc_junction_polygon_kdtree_, &writer);
+  if (!added) {
+    AERROR << "The map is not loaded.";
+    return -1;
+  }
+  return writer.Write(map_filename) ? 0 : -1;
+}
+
+void HDMapImpl::CreateTables() {
   for (const auto& lane : map_.lane()) {
     lane_table_[lane.id().id()].reset(new LaneInfo(lane));
   }
@@ -139,6 +271,9 @@ int HDMapImpl::LoadMapFromProto(const Map& map_proto) {
   for (const auto& stop_sign_ptr_pair : stop_sign_table_) {
     stop_sign_ptr_pair.second->PostProcess(*this);
   }
+}
+
+void HDMapImpl::BuildKDTrees() {
   BuildLaneSegmentKDTree();
   BuildJunctionPolygonKDTree();
   BuildSignalSegmentKDTree();
@@ -149,7 +284,52 @@ int HDMapImpl::LoadMapFromProto(const Map& map_proto) {
   BuildSpeedBumpSegmentKDTree();
   BuildParkingSpacePolygonKDTree();
   BuildPNCJunctionPolygonKDTree();
-  return 0;
+}
+
+bool HDMapImpl::RestoreKDTrees(const CompiledMap& compiled_map) {
+  return RestoreKDTree(compiled_map, CompiledMapSection::LANE_SEGMENT_KDTREE,
+                       lane_table_, map_.lane(), &lane_segment_boxes_,
+                       &lane_segment_kdtree_) &&
+         RestoreKDTree(compiled_map,
+                       CompiledMapSection::JUNCTION_POLYGON_KDTREE,
+                       junction_table_, map_.junction(),
+                       &junction_polygon_boxes_, &junction_polygon_kdtree_) &&
+         RestoreKDTree(compiled_map,
+                       CompiledMapSection::CROSSWALK_POLYGON_KDTREE,
+                       crosswalk_table_, map_.crosswalk(),
+                       &crosswalk_polygon_boxes_, &crosswalk_polygon_kdtree_) &&
+         RestoreKDTree(compiled_map, CompiledMapSection::SIGNAL_SEGMENT_KDTREE,
+                       signal_table_, map_.signal(), &signal_segment_boxes_,
+                       &signal_segment_kdtree_) &&
+         RestoreKDTree(compiled_map,
+                       CompiledMapSection::STOP_SIGN_SEGMENT_KDTREE,
+                       stop_sign_table_, map_.stop_sign(),
+                       &stop_sign_segment_boxes_, &stop_sign_segment_kdtree_) &&
+         RestoreKDTree(compiled_map,
+                       CompiledMapSection::YIELD_SIGN_SEGMENT_KDTREE,
+                       yield_sign_table_, map_.yield(),
+                       &yield_sign_segment_boxes_,
+                       &yield_sign_segment_kdtree_) &&
+         RestoreKDTree(compiled_map,
+                       CompiledMapSection::CLEAR_AREA_POLYGON_KDTREE,
+                       clear_area_table_, map_.clear_area(),
+                       &clear_area_polygon_boxes_,
+                       &clear_area_polygon_kdtree_) &&
+         RestoreKDTree(compiled_map,
+                       CompiledMapSection::SPEED_BUMP_SEGMENT_KDTREE,
+                       speed_bump_table_, map_.speed_bump(),
+                       &speed_bump_segment_boxes_,
+                       &speed_bump_segment_kdtree_) &&
+         RestoreKDTree(compiled_map,
+                       CompiledMapSection::PARKING_SPACE_POLYGON_KDTREE,
+                       parking_space_table_, map_.parking_space(),
+                       &parking_space_polygon_boxes_,
+                       &parking_space_polygon_kdtree_) &&
+         RestoreKDTree(compiled_map,
+                       CompiledMapSection::PNC_JUNCTION_POLYGON_KDTREE,
+                       pnc_junction_table_, map_.pnc_junction(),
+                       &pnc_junction_polygon_boxes_,
+                       &pnc_junction_polygon_kdtree_);
 }
 
 LaneInfoConstPtr HDMapImpl::GetLaneById(const Id& id) const {
@@ -619,6 +799,113 @@ int HDMapImpl::GetLanesWithHeading(const Vec2d& point, const double distance,
   return 0;
 }
 
+int HDMapImpl::GetLanes(
+    const std::vector<PointENU>& points, double distance,
+    std::vector<std::vector<LaneInfoConstPtr>>* lanes) const {
+  if (lane_segment_kdtree_ == nullptr) {
+    return -1;
+  }
+  return SearchElements(points, distance, lane_table_, *lane_segment_kdtree_,
+                        lanes);
+}
+
+int HDMapImpl::GetJunctions(
+    const std::vector<PointENU>& points, double distance,
+    std::vector<std::vector<JunctionInfoConstPtr>>* junctions) const {
+  if (junction_polygon_kdtree_ == nullptr) {
+    return -1;
+  }
+  return SearchElements(points, distance, junction_table_,
+                        *junction_polygon_kdtree_, junctions);
+}
+
+int HDMapImpl::GetCrosswalks(
+    const std::vector<PointENU>& points, double distance,
+    std::vector<std::vector<CrosswalkInfoConstPtr>>* crosswalks) const {
+  if (crosswalk_polygon_kdtree_ == nullptr) {
+    return -1;
+  }
+  return SearchElements(points, distance, crosswalk_table_,
+                        *crosswalk_polygon_kdtree_, crosswalks);
+}
+
+int HDMapImpl::GetLanesWithHeading(
+    const std::vector<PointENU>& points, const double distance,
+    const std::vector<double>& central_headings,
+    const double max_heading_difference,
+    std::vector<std::vector<LaneInfoConstPtr>>* lanes) const {
+  CHECK_NOTNULL(lanes);
+  if (points.size() != central_headings.size() ||
+      GetLanes(points, distance, lanes) != 0) {
+    return -1;
+  }
+  for (size_t i = 0; i < points.size(); ++i) {
+    const Vec2d point(points[i].x(), points[i].y());
+    auto& point_lanes = (*lanes)[i];
+    point_lanes.erase(
+        std::remove_if(point_lanes.begin(), point_lanes.end(),
+                       [&](const LaneInfoConstPtr& lane) {
+                         double s = 0.0;
+                         int s_index = 0;
+                         return DistanceToLaneWithHeading(
+                                    *lane, point, central_headings[i],
+                                    max_heading_difference, &s,
+                                    &s_index) > distance;
+                       }),
+        point_lanes.end());
+  }
+  return 0;
+}
+
+int HDMapImpl::GetNearestLaneWithHeading(
+    const std::vector<PointENU>& points, const double distance,
+    const std::vector<double>& central_headings,
+    const double max_heading_difference,
+    std::vector<LaneInfoConstPtr>* nearest_lanes,
+    std::vector<double>* nearest_s, std::vector<double>* nearest_l) const {
+  CHECK_NOTNULL(nearest_lanes);
+  CHECK_NOTNULL(nearest_s);
+  CHECK_NOTNULL(nearest_l);
+  static thread_local std::vector<std::vector<LaneInfoConstPtr>> lanes;
+  if (points.size() != central_headings.size() ||
+      GetLanes(points, distance, &lanes) != 0) {
+    return -1;
+  }
+  nearest_lanes->assign(points.size(), nullptr);
+  nearest_s->assign(points.size(), 0.0);
+  nearest_l->assign(points.size(), 0.0);
+  for (size_t i = 0; i < points.size(); ++i) {
+    const Vec2d point(points[i].x(), points[i].y());
+    double min_distance = distance;
+    int nearest_s_index = 0;
+    for (const auto& lane : lanes[i]) {
+      double s = 0.0;
+      int s_index = 0;
+      const double lane_distance =
+          DistanceToLaneWithHeading(*lane, point, central_headings[i],
+                                    max_heading_difference, &s, &s_index);
+      if (lane_distance < min_distance) {
+        min_distance = lane_distance;
+        (*nearest_lanes)[i] = lane;
+        (*nearest_s)[i] = s;
+        nearest_s_index = s_index;
+      }
+    }
+    // the lanes are not held beyond the call
+    lanes[i].clear();
+    const auto& nearest_lane = (*nearest_lanes)[i];
+    if (nearest_lane == nullptr) {
+      continue;
+    }
+    const int segment_index = std::min(
+        nearest_s_index, static_cast<int>(nearest_lane->segments().size()) - 1);
+    const auto& segment_2d = nearest_lane->segments()[segment_index];
+    (*nearest_l)[i] =
+        segment_2d.unit_direction().CrossProd(point - segment_2d.start());
+  }
+  return 0;
+}
+
 int HDMapImpl::GetRoadBoundaries(
     const PointENU& point, double radius,
     std::vector<RoadROIBoundaryPtr>* road_boundaries,
@@ -1305,6 +1592,73 @@ int HDMapImpl::GetForwardNearestRSUs(const apollo::common::PointENU& point,
   return 0;
 }
 
+template <class Table, class Elements, class BoxTable, class KDTree>
+bool HDMapImpl::RestoreKDTree(const CompiledMap& compiled_map,
+                              const CompiledMapSection type, const Table& table,
+                              const Elements& elements,
+                              BoxTable* const box_table,
+                              std::unique_ptr<KDTree>* const kdtree) {
+  using Info = typename Table::mapped_type::element_type;
+  const char* data = nullptr;
+  size_t size = 0;
+  CompiledKDTree compiled_kdtree;
+  if (!compiled_map.GetSection(type, &data, &size) ||
+      !compiled_kdtree.Parse(data, size)) {
+    return false;
+  }
+  // the elements are looked up by id once, not once for each of their boxes
+  std::vector<const Info*> infos(elements.size(), nullptr);
+  box_table->clear();
+  box_table->reserve(compiled_kdtree.objects.size());
+  for (const auto& object : compiled_kdtree.objects) {
+    if (object.element_index < 0 || object.element_index >= elements.size()) {
+      return false;
+    }
+    const Info*& info = infos[object.element_index];
+    if (info == nullptr) {
+      const auto& id = elements.Get(object.element_index).id().id();
+      const auto iter = table.find(id);
+      if (iter == table.end()) {
+        return false;
+      }
+      info = iter->second.get();
+    }
+    if (!AppendObjectBox(info, object.sub_index, box_table)) {
+      return false;
+    }
+  }
+  kdtree->reset(new KDTree(*box_table, compiled_kdtree.layout));
+  return true;
+}
+
+template <class Table, class Elements, class BoxTable, class KDTree>
+bool HDMapImpl::AddKDTreeSection(const CompiledMapSection type,
+                                 const Table& table, const Elements& elements,
+                                 const BoxTable& box_table,
+                                 const std::unique_ptr<KDTree>& kdtree,
+                                 CompiledMapWriter* const writer) {
+  using Info = typename Table::mapped_type::element_type;
+  if (kdtree == nullptr) {
+    return false;
+  }
+  std::unordered_map<const Info*, int> element_indices;
+  for (int i = 0; i < elements.size(); ++i) {
+    const auto iter = table.find(elements.Get(i).id().id());
+    if (iter != table.end()) {
+      element_indices.emplace(iter->second.get(), i);
+    }
+  }
+  CompiledKDTree compiled_kdtree;
+  compiled_kdtree.objects.reserve(box_table.size());
+  for (const auto& box : box_table) {
+    compiled_kdtree.objects.push_back(
+        {element_indices.at(box.object()), box.id()});
+  }
+  kdtree->GetLayout(box_table, &compiled_kdtree.layout);
+  writer->AddSection(type, compiled_kdtree.Serialize());
+  return true;
+}
+
 template <class Table, class BoxTable, class KDTree>
 void HDMapImpl::BuildSegmentKDTree(const Table& table,
                                    const AABoxKDTreeParams& params,
@@ -1439,6 +1793,49 @@ int HDMapImpl::SearchObjects(const Vec2d& center, const double radius,
   return 0;
 }
 
+template <class Table, class KDTree, class InfoPtr>
+int HDMapImpl::SearchElements(
+    const std::vector<PointENU>& points, const double radius,
+    const Table& table, const KDTree& kdtree,
+    std::vector<std::vector<InfoPtr>>* const results) {
+  static std::mutex mutex_search_elements;
+  UNIQUE_LOCK_MULTITHREAD(mutex_search_elements);
+  if (results == nullptr) {
+    return -1;
+  }
+  static thread_local std::vector<Vec2d> centers;
+  static thread_local std::vector<std::vector<typename KDTree::ObjectPtr>>
+      objects;
+  centers.clear();
+  for (const auto& point : points) {
+    centers.emplace_back(point.x(), point.y());
+  }
+  kdtree.GetObjects(centers, radius, &objects);
+
+  results->resize(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    auto& elements = (*results)[i];
+    elements.clear();
+    // an element is found once for every segment of it in range
+    auto& point_objects = objects[i];
+    std::sort(point_objects.begin(), point_objects.end(),
+              [](const auto* lhs, const auto* rhs) {
+                return lhs->object() < rhs->object();
+              });
+    for (size_t j = 0; j < point_objects.size(); ++j) {
+      const auto* element = point_objects[j]->object();
+      if (j > 0 && element == point_objects[j - 1]->object()) {
+        continue;
+      }
+      const auto iter = table.find(element->id().id());
+      if (iter != table.end()) {
+        elements.emplace_back(iter->second);
+      }
+    }
+  }
+  return 0;
+}
+
 void HDMapImpl::Clear() {
   map_.Clear();
   lane_table_.clear();
@@ -26,6 +26,7 @@ limitations under the License.
 #include "modules/common/math/line_segment2d.h"
 #include "modules/common/math/polygon2d.h"
 #include "modules/common/math/vec2d.h"
+#include "modules/map/hdmap/compiled_map.h"
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/common_msgs/map_msgs/map.pb.h"
 #include "modules/common_msgs/map_msgs/map_clear_area.pb.h"
@@ -95,6 +96,15 @@ class HDMapImpl {
    */
   int LoadMapFromProto(const Map& map_proto);
 
+  /**
+   * @brief save the loaded map as a compiled map, which loads from
+   * LoadMapFromFile without building its spatial indices again
+   * @param map_filename path of the compiled map file, with the extension
+   * kCompiledMapExtension
+   * @return 0:success, otherwise failed
+   */
+  int SaveCompiledMap(const std::string& map_filename) const;
+
   LaneInfoConstPtr GetLaneById(const Id& id) const;
   JunctionInfoConstPtr GetJunctionById(const Id& id) const;
   SignalInfoConstPtr GetSignalById(const Id& id) const;
@@ -344,6 +354,72 @@ class HDMapImpl {
                     double max_heading_difference,
                     std::vector<RSUInfoConstPtr>* rsus) const;
 
+  /**
+   * @brief get all lanes in certain range of every point of a batch, with
+   *        one search of the lane index for the whole batch
+   * @param points the central points of the ranges
+   * @param distance the search radius
+   * @param lanes store all lanes in the range of every point, in the order
+   *        of the points. The vectors are cleared and reused.
+   * @return 0:success, otherwise failed
+   */
+  int GetLanes(const std::vector<apollo::common::PointENU>& points,
+               double distance,
+               std::vector<std::vector<LaneInfoConstPtr>>* lanes) const;
+  /**
+   * @brief get all junctions in certain range of every point of a batch
+   * @param points the central points of the ranges
+   * @param distance the search radius
+   * @param junctions store all junctions in the range of every point
+   * @return 0:success, otherwise failed
+   */
+  int GetJunctions(
+      const std::vector<apollo::common::PointENU>& points, double distance,
+      std::vector<std::vector<JunctionInfoConstPtr>>* junctions) const;
+  /**
+   * @brief get all crosswalks in certain range of every point of a batch
+   * @param points the central points of the ranges
+   * @param distance the search radius
+   * @param crosswalks store all crosswalks in the range of every point
+   * @return 0:success, otherwise failed
+   */
+  int GetCrosswalks(
+      const std::vector<apollo::common::PointENU>& points, double distance,
+      std::vector<std::vector<CrosswalkInfoConstPtr>>* crosswalks) const;
+  /**
+   * @brief get all lanes within a certain range of every pose of a batch
+   * @param points the target positions
+   * @param distance the search radius
+   * @param central_headings the base heading of every position
+   * @param max_heading_difference the heading range
+   * @param lanes all lanes that match search conditions for every position
+   * @return 0:success, otherwise failed
+   */
+  int GetLanesWithHeading(
+      const std::vector<apollo::common::PointENU>& points,
+      const double distance, const std::vector<double>& central_headings,
+      const double max_heading_difference,
+      std::vector<std::vector<LaneInfoConstPtr>>* lanes) const;
+  /**
+   * @brief get the nearest lane within a certain range of every pose of a
+   *        batch
+   * @param points the target positions
+   * @param distance the search radius
+   * @param central_headings the base heading of every position
+   * @param max_heading_difference the heading range
+   * @param nearest_lanes the nearest lane of every position, nullptr if no
+   *        lane matches search conditions
+   * @param nearest_s the offset from lane start point along lane center line
+   * @param nearest_l the lateral offset from lane center line
+   * @return 0:success, otherwise failed
+   */
+  int GetNearestLaneWithHeading(
+      const std::vector<apollo::common::PointENU>& points,
+      const double distance, const std::vector<double>& central_headings,
+      const double max_heading_difference,
+      std::vector<LaneInfoConstPtr>* nearest_lanes,
+      std::vector<double>* nearest_s, std::vector<double>* nearest_l) const;
+
  private:
   int GetLanes(const apollo::common::math::Vec2d& point, double distance,
                std::vector<LaneInfoConstPtr>* lanes) const;
@@ -383,6 +459,24 @@ class HDMapImpl {
   int GetRoads(const apollo::common::math::Vec2d& point, double distance,
                std::vector<RoadInfoConstPtr>* roads) const;
 
+  int LoadMapFromCompiledMap(const std::string& map_filename);
+  void CreateTables();
+  void BuildKDTrees();
+  bool RestoreKDTrees(const CompiledMap& compiled_map);
+
+  template <class Table, class Elements, class BoxTable, class KDTree>
+  static bool RestoreKDTree(const CompiledMap& compiled_map,
+                            const CompiledMapSection type, const Table& table,
+                            const Elements& elements, BoxTable* const box_table,
+                            std::unique_ptr<KDTree>* const kdtree);
+
+  template <class Table, class Elements, class BoxTable, class KDTree>
+  static bool AddKDTreeSection(const CompiledMapSection type,
+                               const Table& table, const Elements& elements,
+                               const BoxTable& box_table,
+                               const std::unique_ptr<KDTree>& kdtree,
+                               CompiledMapWriter* const writer);
+
   template <class Table, class BoxTable, class KDTree>
   static void BuildSegmentKDTree(
       const Table& table, const apollo::common::math::AABoxKDTreeParams& params,
@@ -409,6 +503,12 @@ class HDMapImpl {
                            const double radius, const KDTree& kdtree,
                            std::vector<std::string>* const results);
 
+  template <class Table, class KDTree, class InfoPtr>
+  static int SearchElements(
+      const std::vector<apollo::common::PointENU>& points, const double radius,
+      const Table& table, const KDTree& kdtree,
+      std::vector<std::vector<InfoPtr>>* const results);
+
   void Clear();
 
  private:
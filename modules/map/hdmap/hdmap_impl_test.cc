@@ -15,7 +15,9 @@ limitations under the License.
 
 #include "modules/map/hdmap/hdmap_impl.h"
 
+#include <algorithm>
 #include <chrono>
+#include <fstream>
 
 #include "gtest/gtest.h"
 
@@ -286,6 +288,87 @@ TEST_F(HDMapImplTestSuite, GetSpeedBumps) {
   EXPECT_EQ(0, speed_bumps.size());
 }
 
+TEST_F(HDMapImplTestSuite, BatchQueries) {
+  std::vector<apollo::common::PointENU> points;
+  std::vector<double> headings;
+  for (int i = 0; i < 40; ++i) {
+    apollo::common::PointENU point;
+    point.set_x(586400.0 + 3.0 * i);
+    point.set_y(4140700.0 + 2.0 * i);
+    points.push_back(point);
+    headings.push_back(-3.0 + 0.15 * i);
+  }
+  auto ids = [](const auto& infos) {
+    std::vector<std::string> ids;
+    for (const auto& info : infos) {
+      ids.push_back(info->id().id());
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  };
+
+  std::vector<std::vector<LaneInfoConstPtr>> batch_lanes;
+  std::vector<std::vector<JunctionInfoConstPtr>> batch_junctions;
+  std::vector<std::vector<CrosswalkInfoConstPtr>> batch_crosswalks;
+  std::vector<std::vector<LaneInfoConstPtr>> batch_lanes_with_heading;
+  std::vector<LaneInfoConstPtr> nearest_lanes;
+  std::vector<double> nearest_s;
+  std::vector<double> nearest_l;
+  // twice, the results of the former batch are cleared
+  for (const double distance : {20.0, 5.0}) {
+    EXPECT_EQ(0, hdmap_impl_.GetLanes(points, distance, &batch_lanes));
+    EXPECT_EQ(0, hdmap_impl_.GetJunctions(points, distance, &batch_junctions));
+    EXPECT_EQ(0,
+              hdmap_impl_.GetCrosswalks(points, distance, &batch_crosswalks));
+    EXPECT_EQ(0, hdmap_impl_.GetLanesWithHeading(points, distance, headings,
+                                                 1.0,
+                                                 &batch_lanes_with_heading));
+    EXPECT_EQ(0, hdmap_impl_.GetNearestLaneWithHeading(
+                     points, distance, headings, 1.0, &nearest_lanes,
+                     &nearest_s, &nearest_l));
+    ASSERT_EQ(points.size(), batch_lanes.size());
+    ASSERT_EQ(points.size(), batch_junctions.size());
+    ASSERT_EQ(points.size(), batch_crosswalks.size());
+    ASSERT_EQ(points.size(), batch_lanes_with_heading.size());
+    ASSERT_EQ(points.size(), nearest_lanes.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      std::vector<LaneInfoConstPtr> lanes;
+      EXPECT_EQ(0, hdmap_impl_.GetLanes(points[i], distance, &lanes));
+      EXPECT_EQ(ids(lanes), ids(batch_lanes[i]));
+      std::vector<JunctionInfoConstPtr> junctions;
+      EXPECT_EQ(0, hdmap_impl_.GetJunctions(points[i], distance, &junctions));
+      EXPECT_EQ(ids(junctions), ids(batch_junctions[i]));
+      std::vector<CrosswalkInfoConstPtr> crosswalks;
+      EXPECT_EQ(0,
+                hdmap_impl_.GetCrosswalks(points[i], distance, &crosswalks));
+      EXPECT_EQ(ids(crosswalks), ids(batch_crosswalks[i]));
+
+      lanes.clear();
+      hdmap_impl_.GetLanesWithHeading(points[i], distance, headings[i], 1.0,
+                                      &lanes);
+      EXPECT_EQ(ids(lanes), ids(batch_lanes_with_heading[i]));
+
+      LaneInfoConstPtr nearest_lane;
+      double s = 0.0;
+      double l = 0.0;
+      if (hdmap_impl_.GetNearestLaneWithHeading(points[i], distance,
+                                                headings[i], 1.0,
+                                                &nearest_lane, &s, &l) != 0) {
+        EXPECT_EQ(nullptr, nearest_lanes[i]);
+        continue;
+      }
+      ASSERT_NE(nullptr, nearest_lanes[i]);
+      EXPECT_EQ(nearest_lane->id().id(), nearest_lanes[i]->id().id());
+      EXPECT_DOUBLE_EQ(s, nearest_s[i]);
+      EXPECT_DOUBLE_EQ(l, nearest_l[i]);
+    }
+  }
+
+  headings.pop_back();
+  EXPECT_EQ(-1, hdmap_impl_.GetLanesWithHeading(points, 5.0, headings, 1.0,
+                                                &batch_lanes_with_heading));
+}
+
 TEST_F(HDMapImplTestSuite, GetRoads) {
   std::vector<RoadInfoConstPtr> roads;
 
@@ -434,5 +517,93 @@ TEST_F(HDMapImplTestSuite, GetLocalMap) {
   cyber::common::Remove(output_bin_file);
 }
 
+TEST_F(HDMapImplTestSuite, CompiledMap) {
+  const std::string time_since_epoch = std::to_string(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+  const std::string compiled_map_file = absl::StrCat(
+      FLAGS_output_dir, "/base_map_", time_since_epoch, kCompiledMapExtension);
+  ASSERT_EQ(0, hdmap_impl_.SaveCompiledMap(compiled_map_file));
+
+  HDMapImpl compiled_hdmap_impl;
+  ASSERT_EQ(0, compiled_hdmap_impl.LoadMapFromFile(compiled_map_file));
+  auto ids = [](const auto& infos) {
+    std::vector<std::string> ids;
+    for (const auto& info : infos) {
+      ids.push_back(info->id().id());
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  };
+  for (int i = 0; i < 10; ++i) {
+    apollo::common::PointENU point;
+    point.set_x(586441.73 + 20.0 * i);
+    point.set_y(4140745.25 - 15.0 * i);
+    std::vector<LaneInfoConstPtr> lanes;
+    std::vector<LaneInfoConstPtr> compiled_lanes;
+    EXPECT_EQ(0, hdmap_impl_.GetLanes(point, 20.0, &lanes));
+    EXPECT_EQ(0, compiled_hdmap_impl.GetLanes(point, 20.0, &compiled_lanes));
+    EXPECT_EQ(ids(lanes), ids(compiled_lanes));
+
+    LaneInfoConstPtr nearest_lane;
+    LaneInfoConstPtr compiled_nearest_lane;
+    double s = 0.0;
+    double l = 0.0;
+    double compiled_s = 0.0;
+    double compiled_l = 0.0;
+    EXPECT_EQ(0, hdmap_impl_.GetNearestLane(point, &nearest_lane, &s, &l));
+    EXPECT_EQ(0, compiled_hdmap_impl.GetNearestLane(
+                     point, &compiled_nearest_lane, &compiled_s, &compiled_l));
+    EXPECT_EQ(nearest_lane->id().id(), compiled_nearest_lane->id().id());
+    EXPECT_DOUBLE_EQ(s, compiled_s);
+    EXPECT_DOUBLE_EQ(l, compiled_l);
+
+    std::vector<JunctionInfoConstPtr> junctions;
+    std::vector<JunctionInfoConstPtr> compiled_junctions;
+    EXPECT_EQ(0, hdmap_impl_.GetJunctions(point, 50.0, &junctions));
+    EXPECT_EQ(0, compiled_hdmap_impl.GetJunctions(point, 50.0,
+                                                  &compiled_junctions));
+    EXPECT_EQ(ids(junctions), ids(compiled_junctions));
+
+    std::vector<SignalInfoConstPtr> signals;
+    std::vector<SignalInfoConstPtr> compiled_signals;
+    EXPECT_EQ(0, hdmap_impl_.GetSignals(point, 50.0, &signals));
+    EXPECT_EQ(0,
+              compiled_hdmap_impl.GetSignals(point, 50.0, &compiled_signals));
+    EXPECT_EQ(ids(signals), ids(compiled_signals));
+
+    std::vector<CrosswalkInfoConstPtr> crosswalks;
+    std::vector<CrosswalkInfoConstPtr> compiled_crosswalks;
+    EXPECT_EQ(0, hdmap_impl_.GetCrosswalks(point, 50.0, &crosswalks));
+    EXPECT_EQ(0, compiled_hdmap_impl.GetCrosswalks(point, 50.0,
+                                                   &compiled_crosswalks));
+    EXPECT_EQ(ids(crosswalks), ids(compiled_crosswalks));
+  }
+
+  // without its spatial indices the map loads, building them again
+  Map map;
+  ACHECK(cyber::common::GetProtoFromFile(kMapFilename, &map));
+  CompiledMapWriter writer;
+  writer.AddSection(CompiledMapSection::MAP, map.SerializeAsString());
+  ASSERT_TRUE(writer.Write(compiled_map_file));
+  EXPECT_EQ(0, compiled_hdmap_impl.LoadMapFromFile(compiled_map_file));
+  std::vector<LaneInfoConstPtr> lanes;
+  apollo::common::PointENU point;
+  point.set_x(586441.73);
+  point.set_y(4140745.25);
+  EXPECT_EQ(0, compiled_hdmap_impl.GetLanes(point, 20.0, &lanes));
+  EXPECT_FALSE(lanes.empty());
+
+  // a truncated map does not load
+  std::string content;
+  ACHECK(cyber::common::GetContent(compiled_map_file, &content));
+  content.resize(content.size() / 2);
+  {
+    std::ofstream file(compiled_map_file, std::ios::binary | std::ios::trunc);
+    file << content;
+  }
+  EXPECT_EQ(-1, compiled_hdmap_impl.LoadMapFromFile(compiled_map_file));
+  cyber::common::Remove(compiled_map_file);
+}
+
 }  // namespace hdmap
 }  // namespace apollo
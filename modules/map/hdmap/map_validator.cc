@@ -0,0 +1,418 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+#include "modules/map/hdmap/map_validator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <unordered_map>
+
+#include "absl/strings/str_cat.h"
+#include "cyber/common/log.h"
+#include "modules/common/util/parallel_for.h"
+
+namespace apollo {
+namespace hdmap {
+namespace {
+
+using apollo::common::PointENU;
+using google::protobuf::RepeatedPtrField;
+
+// the largest gap between the segments of a curve, in meters
+constexpr double kMaxSegmentGap = 0.1;
+// the largest difference between the length of a lane and the one of its
+// central curve, in meters and relative to the length
+constexpr double kLengthTolerance = 0.1;
+constexpr double kRelativeLengthTolerance = 0.01;
+
+// The elements of a kind by id, with the overlaps they refer to.
+struct ElementIndex {
+  std::string kind;
+  std::unordered_map<std::string, const RepeatedPtrField<Id>*> overlap_ids;
+};
+
+// An element which refers to overlaps.
+struct ElementRef {
+  const ElementIndex* index;
+  const std::string* id;
+  const RepeatedPtrField<Id>* overlap_ids;
+};
+
+struct MapIndex {
+  std::unordered_map<std::string, const Lane*> lanes;
+  std::unordered_map<std::string, const Road*> roads;
+  std::unordered_map<std::string, const Overlap*> overlaps;
+  std::unordered_map<int, ElementIndex> elements;
+  std::vector<ElementRef> element_refs;
+};
+
+MapIssue Issue(const MapIssue::Category category, const std::string& id,
+               const std::string& message) {
+  MapIssue issue;
+  issue.category = category;
+  issue.element_id = id;
+  issue.message = message;
+  return issue;
+}
+
+template <class T>
+void IndexElements(const RepeatedPtrField<T>& elements,
+                   const ObjectOverlapInfo::OverlapInfoCase overlap_case,
+                   const std::string& kind, MapIndex* const index,
+                   std::vector<MapIssue>* const issues) {
+  ElementIndex& element_index = index->elements[overlap_case];
+  element_index.kind = kind;
+  for (const auto& element : elements) {
+    const auto result = element_index.overlap_ids.emplace(
+        element.id().id(), &element.overlap_id());
+    if (!result.second) {
+      issues->push_back(Issue(MapIssue::TOPOLOGY, element.id().id(),
+                              absl::StrCat("duplicate ", kind, " id")));
+      continue;
+    }
+    index->element_refs.push_back(
+        {&element_index, &result.first->first, &element.overlap_id()});
+  }
+}
+
+void IndexMap(const Map& map, MapIndex* const index,
+              std::vector<MapIssue>* const issues) {
+  // the duplicate lanes are reported with the other elements
+  for (const auto& lane : map.lane()) {
+    index->lanes.emplace(lane.id().id(), &lane);
+  }
+  for (const auto& road : map.road()) {
+    if (!index->roads.emplace(road.id().id(), &road).second) {
+      issues->push_back(
+          Issue(MapIssue::TOPOLOGY, road.id().id(), "duplicate road id"));
+    }
+  }
+  for (const auto& overlap : map.overlap()) {
+    if (!index->overlaps.emplace(overlap.id().id(), &overlap).second) {
+      issues->push_back(Issue(MapIssue::TOPOLOGY, overlap.id().id(),
+                              "duplicate overlap id"));
+    }
+  }
+  IndexElements(map.lane(), ObjectOverlapInfo::kLaneOverlapInfo, "lane", index,
+                issues);
+  IndexElements(map.signal(), ObjectOverlapInfo::kSignalOverlapInfo, "signal",
+                index, issues);
+  IndexElements(map.stop_sign(), ObjectOverlapInfo::kStopSignOverlapInfo,
+                "stop sign", index, issues);
+  IndexElements(map.crosswalk(), ObjectOverlapInfo::kCrosswalkOverlapInfo,
+                "crosswalk", index, issues);
+  IndexElements(map.junction(), ObjectOverlapInfo::kJunctionOverlapInfo,
+                "junction", index, issues);
+  IndexElements(map.yield(), ObjectOverlapInfo::kYieldSignOverlapInfo,
+                "yield sign", index, issues);
+  IndexElements(map.clear_area(), ObjectOverlapInfo::kClearAreaOverlapInfo,
+                "clear area", index, issues);
+  IndexElements(map.speed_bump(), ObjectOverlapInfo::kSpeedBumpOverlapInfo,
+                "speed bump", index, issues);
+  IndexElements(map.parking_space(),
+                ObjectOverlapInfo::kParkingSpaceOverlapInfo, "parking space",
+                index, issues);
+  IndexElements(map.pnc_junction(), ObjectOverlapInfo::kPncJunctionOverlapInfo,
+                "pnc junction", index, issues);
+  IndexElements(map.rsu(), ObjectOverlapInfo::kRsuOverlapInfo, "rsu", index,
+                issues);
+}
+
+bool IsFinite(const PointENU& point) {
+  return std::isfinite(point.x()) && std::isfinite(point.y()) &&
+         std::isfinite(point.z());
+}
+
+bool ContainsId(const RepeatedPtrField<Id>& ids, const std::string& id) {
+  return std::any_of(ids.begin(), ids.end(),
+                     [&id](const Id& other) { return other.id() == id; });
+}
+
+void CheckLaneGeometry(const Lane& lane, std::vector<MapIssue>* const issues) {
+  const std::string& id = lane.id().id();
+  const auto& curve = lane.central_curve();
+  if (curve.segment_size() == 0) {
+    issues->push_back(Issue(MapIssue::GEOMETRY, id, "empty central curve"));
+    return;
+  }
+  double curve_length = 0.0;
+  bool complete = true;
+  const PointENU* last_point = nullptr;
+  for (int i = 0; i < curve.segment_size(); ++i) {
+    const auto& points = curve.segment(i).line_segment().point();
+    if (points.size() < 2) {
+      issues->push_back(Issue(
+          MapIssue::GEOMETRY, id,
+          absl::StrCat("central curve segment ", i, " has ", points.size(),
+                       " points")));
+      complete = false;
+      continue;
+    }
+    if (!std::all_of(points.begin(), points.end(), IsFinite)) {
+      issues->push_back(Issue(
+          MapIssue::GEOMETRY, id,
+          absl::StrCat("central curve segment ", i, " has non-finite points")));
+      return;
+    }
+    if (last_point != nullptr) {
+      const double gap = std::hypot(points.Get(0).x() - last_point->x(),
+                                    points.Get(0).y() - last_point->y());
+      if (gap > kMaxSegmentGap) {
+        issues->push_back(Issue(
+            MapIssue::GEOMETRY, id,
+            absl::StrCat("gap of ", gap, " m before central curve segment ",
+                         i)));
+      }
+    }
+    for (int j = 1; j < points.size(); ++j) {
+      curve_length += std::hypot(points.Get(j).x() - points.Get(j - 1).x(),
+                                 points.Get(j).y() - points.Get(j - 1).y());
+    }
+    last_point = &points.Get(points.size() - 1);
+  }
+  if (complete && lane.has_length() &&
+      std::fabs(lane.length() - curve_length) >
+          std::max(kLengthTolerance, kRelativeLengthTolerance * curve_length)) {
+    issues->push_back(Issue(MapIssue::GEOMETRY, id,
+                            absl::StrCat("length ", lane.length(),
+                                         " differs from the central curve "
+                                         "length ",
+                                         curve_length)));
+  }
+}
+
+void CheckLaneIds(const std::string& id, const RepeatedPtrField<Id>& lane_ids,
+                  const std::string& relation, const MapIndex& index,
+                  std::vector<MapIssue>* const issues) {
+  for (const auto& lane_id : lane_ids) {
+    if (index.lanes.count(lane_id.id()) == 0) {
+      issues->push_back(
+          Issue(MapIssue::TOPOLOGY, id,
+                absl::StrCat(relation, " ", lane_id.id(), " does not exist")));
+    }
+  }
+}
+
+void CheckLaneTopology(const Lane& lane, const MapIndex& index,
+                       std::vector<MapIssue>* const issues) {
+  const std::string& id = lane.id().id();
+  CheckLaneIds(id, lane.predecessor_id(), "predecessor", index, issues);
+  CheckLaneIds(id, lane.successor_id(), "successor", index, issues);
+  CheckLaneIds(id, lane.left_neighbor_forward_lane_id(),
+               "left forward neighbor", index, issues);
+  CheckLaneIds(id, lane.right_neighbor_forward_lane_id(),
+               "right forward neighbor", index, issues);
+  CheckLaneIds(id, lane.left_neighbor_reverse_lane_id(),
+               "left reverse neighbor", index, issues);
+  CheckLaneIds(id, lane.right_neighbor_reverse_lane_id(),
+               "right reverse neighbor", index, issues);
+  CheckLaneIds(id, lane.self_reverse_lane_id(), "self reverse lane", index,
+               issues);
+
+  for (const auto& predecessor_id : lane.predecessor_id()) {
+    const auto iter = index.lanes.find(predecessor_id.id());
+    if (iter != index.lanes.end() &&
+        !ContainsId(iter->second->successor_id(), id)) {
+      issues->push_back(Issue(MapIssue::TOPOLOGY, id,
+                              absl::StrCat("predecessor ", predecessor_id.id(),
+                                           " does not list it as successor")));
+    }
+  }
+  for (const auto& successor_id : lane.successor_id()) {
+    const auto iter = index.lanes.find(successor_id.id());
+    if (iter != index.lanes.end() &&
+        !ContainsId(iter->second->predecessor_id(), id)) {
+      issues->push_back(
+          Issue(MapIssue::TOPOLOGY, id,
+                absl::StrCat("successor ", successor_id.id(),
+                             " does not list it as predecessor")));
+    }
+  }
+
+  if (lane.has_junction_id()) {
+    const auto& junctions =
+        index.elements.at(ObjectOverlapInfo::kJunctionOverlapInfo);
+    if (junctions.overlap_ids.count(lane.junction_id().id()) == 0) {
+      issues->push_back(Issue(MapIssue::TOPOLOGY, id,
+                              absl::StrCat("junction ", lane.junction_id().id(),
+                                           " does not exist")));
+    }
+  }
+}
+
+void CheckRoad(const Road& road, const MapIndex& index,
+               std::vector<MapIssue>* const issues) {
+  const std::string& id = road.id().id();
+  for (const auto& section : road.section()) {
+    CheckLaneIds(id, section.lane_id(), "lane", index, issues);
+  }
+  if (road.has_junction_id()) {
+    const auto& junctions =
+        index.elements.at(ObjectOverlapInfo::kJunctionOverlapInfo);
+    if (junctions.overlap_ids.count(road.junction_id().id()) == 0) {
+      issues->push_back(Issue(MapIssue::TOPOLOGY, id,
+                              absl::StrCat("junction ", road.junction_id().id(),
+                                           " does not exist")));
+    }
+  }
+}
+
+void CheckOverlap(const Overlap& overlap, const MapIndex& index,
+                  std::vector<MapIssue>* const issues) {
+  const std::string& id = overlap.id().id();
+  if (overlap.object_size() < 2) {
+    issues->push_back(
+        Issue(MapIssue::OVERLAP, id,
+              absl::StrCat("has ", overlap.object_size(), " objects")));
+  }
+  for (const auto& object : overlap.object()) {
+    const std::string& object_id = object.id().id();
+    const auto element_iter = index.elements.find(object.overlap_info_case());
+    if (element_iter == index.elements.end()) {
+      issues->push_back(
+          Issue(MapIssue::OVERLAP, id,
+                absl::StrCat("object ", object_id, " has no overlap info")));
+      continue;
+    }
+    const ElementIndex& elements = element_iter->second;
+    const auto iter = elements.overlap_ids.find(object_id);
+    if (iter == elements.overlap_ids.end()) {
+      issues->push_back(Issue(MapIssue::OVERLAP, id,
+                              absl::StrCat(elements.kind, " ", object_id,
+                                           " does not exist")));
+      continue;
+    }
+    if (!ContainsId(*iter->second, id)) {
+      issues->push_back(Issue(MapIssue::OVERLAP, id,
+                              absl::StrCat(elements.kind, " ", object_id,
+                                           " does not refer to it")));
+    }
+    if (object.has_lane_overlap_info()) {
+      const auto& info = object.lane_overlap_info();
+      const double length = index.lanes.at(object_id)->length();
+      if (info.start_s() > info.end_s() ||
+          info.start_s() < -kLengthTolerance ||
+          info.end_s() > length + kLengthTolerance) {
+        issues->push_back(Issue(
+            MapIssue::OVERLAP, id,
+            absl::StrCat("range [", info.start_s(), ", ", info.end_s(),
+                         "] is out of lane ", object_id, " of length ",
+                         length)));
+      }
+    }
+  }
+}
+
+void CheckElementOverlaps(const ElementRef& element, const MapIndex& index,
+                          std::vector<MapIssue>* const issues) {
+  for (const auto& overlap_id : *element.overlap_ids) {
+    if (index.overlaps.count(overlap_id.id()) == 0) {
+      issues->push_back(
+          Issue(MapIssue::OVERLAP, *element.id,
+                absl::StrCat(element.index->kind, " refers to overlap ",
+                             overlap_id.id(), " which does not exist")));
+    }
+  }
+}
+
+// Check the items [0, num) in contiguous blocks, one thread each, and append
+// the issues of the blocks in order.
+template <typename CheckFunc>
+void ParallelCheck(const int num, const int thread_num,
+                   const CheckFunc& check,
+                   std::vector<MapIssue>* const issues) {
+  const size_t item_num = static_cast<size_t>(std::max(0, num));
+  std::vector<std::vector<MapIssue>> block_issues(
+      common::util::ParallelBlockNum(item_num, thread_num));
+  common::util::ParallelForBlocks(
+      item_num, thread_num,
+      [&](const size_t block, const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          check(static_cast<int>(i), &block_issues[block]);
+        }
+      });
+  for (auto& block : block_issues) {
+    std::move(block.begin(), block.end(), std::back_inserter(*issues));
+  }
+}
+
+}  // namespace
+
+int MapValidationReport::IssueNum(const MapIssue::Category category) const {
+  return static_cast<int>(
+      std::count_if(issues.begin(), issues.end(),
+                    [category](const MapIssue& issue) {
+                      return issue.category == category;
+                    }));
+}
+
+std::string MapValidationReport::DebugString() const {
+  static const char* kCategoryNames[] = {"GEOMETRY", "TOPOLOGY", "OVERLAP"};
+  std::string result = absl::StrCat(
+      issues.size(), " issues: ", IssueNum(MapIssue::GEOMETRY), " geometry, ",
+      IssueNum(MapIssue::TOPOLOGY), " topology, ", IssueNum(MapIssue::OVERLAP),
+      " overlap\n");
+  for (const auto& issue : issues) {
+    absl::StrAppend(&result, "[", kCategoryNames[issue.category], "] ",
+                    issue.element_id, ": ", issue.message, "\n");
+  }
+  return result;
+}
+
+MapValidator::MapValidator(const int thread_num)
+    : thread_num_(common::util::ResolveThreadNum(thread_num)) {}
+
+bool MapValidator::Validate(const Map& map,
+                            MapValidationReport* const report) const {
+  CHECK_NOTNULL(report);
+  auto* issues = &report->issues;
+  issues->clear();
+
+  MapIndex index;
+  IndexMap(map, &index, issues);
+
+  ParallelCheck(
+      map.lane_size(), thread_num_,
+      [&](const int i, std::vector<MapIssue>* const lane_issues) {
+        CheckLaneGeometry(map.lane(i), lane_issues);
+        CheckLaneTopology(map.lane(i), index, lane_issues);
+      },
+      issues);
+  ParallelCheck(
+      map.road_size(), thread_num_,
+      [&](const int i, std::vector<MapIssue>* const road_issues) {
+        CheckRoad(map.road(i), index, road_issues);
+      },
+      issues);
+  ParallelCheck(
+      map.overlap_size(), thread_num_,
+      [&](const int i, std::vector<MapIssue>* const overlap_issues) {
+        CheckOverlap(map.overlap(i), index, overlap_issues);
+      },
+      issues);
+  ParallelCheck(
+      static_cast<int>(index.element_refs.size()), thread_num_,
+      [&](const int i, std::vector<MapIssue>* const element_issues) {
+        CheckElementOverlaps(index.element_refs[i], index, element_issues);
+      },
+      issues);
+
+  AINFO_IF(!report->ok()) << "Found " << issues->size() << " map issues.";
+  return report->ok();
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,96 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "modules/common_msgs/map_msgs/map.pb.h"
+
+/**
+ * @namespace apollo::hdmap
+ * @brief apollo::hdmap
+ */
+namespace apollo {
+namespace hdmap {
+
+/**
+ * @class MapIssue
+ * @brief An inconsistency of a map element.
+ */
+struct MapIssue {
+  enum Category {
+    GEOMETRY = 0,
+    TOPOLOGY = 1,
+    OVERLAP = 2,
+  };
+
+  Category category;
+  std::string element_id;
+  std::string message;
+};
+
+/**
+ * @class MapValidationReport
+ * @brief The issues found in a map, in the order of the elements having them.
+ */
+struct MapValidationReport {
+  std::vector<MapIssue> issues;
+
+  bool ok() const { return issues.empty(); }
+  /**
+   * @brief the number of issues of a category.
+   */
+  int IssueNum(const MapIssue::Category category) const;
+  /**
+   * @brief one line per issue, after a summary line.
+   */
+  std::string DebugString() const;
+};
+
+/**
+ * @class MapValidator
+ * @brief Check the geometry, topology and overlaps of a map, which are
+ * split over threads by element.
+ */
+class MapValidator {
+ public:
+  /**
+   * @param thread_num the number of threads, the number of cores if 0.
+   */
+  explicit MapValidator(const int thread_num = 0);
+
+  /**
+   * @brief check the map:
+   * geometry: the central curves of the lanes have points, all finite, of
+   * which the length matches the one of the lane;
+   * topology: the ids of the elements are unique, the lanes and junctions
+   * the lanes and roads refer to exist, and the predecessors and successors
+   * of a lane refer back to it;
+   * overlaps: the objects of an overlap exist and refer back to it, within
+   * the length of the lanes, and the overlaps the elements refer to exist.
+   * @param map the map to check.
+   * @param report the issues found, replacing its former ones.
+   * @return true if no issue is found.
+   */
+  bool Validate(const Map& map, MapValidationReport* const report) const;
+
+ private:
+  int thread_num_ = 1;
+};
+
+}  // namespace hdmap
+}  // namespace apollo
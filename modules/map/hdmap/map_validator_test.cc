@@ -0,0 +1,154 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+#include "modules/map/hdmap/map_validator.h"
+
+#include <limits>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "cyber/common/file.h"
+
+namespace apollo {
+namespace hdmap {
+
+class MapValidatorTestSuite : public ::testing::Test {
+ protected:
+  // lane_1 -> lane_2 along the x axis, each 10 m long, and crosswalk_1 on
+  // lane_2 over overlap_1
+  void InitMapProto(Map* map_proto) {
+    for (int i = 1; i <= 2; ++i) {
+      auto* lane = map_proto->add_lane();
+      lane->mutable_id()->set_id("lane_" + std::to_string(i));
+      lane->set_length(10.0);
+      auto* line_segment =
+          lane->mutable_central_curve()->add_segment()->mutable_line_segment();
+      for (int j = 0; j <= 10; ++j) {
+        auto* point = line_segment->add_point();
+        point->set_x((i - 1) * 10.0 + j);
+        point->set_y(0.0);
+      }
+    }
+    map_proto->mutable_lane(0)->add_successor_id()->set_id("lane_2");
+    map_proto->mutable_lane(1)->add_predecessor_id()->set_id("lane_1");
+    map_proto->mutable_lane(1)->add_overlap_id()->set_id("overlap_1");
+
+    auto* road = map_proto->add_road();
+    road->mutable_id()->set_id("road_1");
+    auto* section = road->add_section();
+    section->add_lane_id()->set_id("lane_1");
+    section->add_lane_id()->set_id("lane_2");
+
+    auto* crosswalk = map_proto->add_crosswalk();
+    crosswalk->mutable_id()->set_id("crosswalk_1");
+    crosswalk->add_overlap_id()->set_id("overlap_1");
+
+    auto* overlap = map_proto->add_overlap();
+    overlap->mutable_id()->set_id("overlap_1");
+    auto* lane_object = overlap->add_object();
+    lane_object->mutable_id()->set_id("lane_2");
+    lane_object->mutable_lane_overlap_info()->set_start_s(4.0);
+    lane_object->mutable_lane_overlap_info()->set_end_s(6.0);
+    auto* crosswalk_object = overlap->add_object();
+    crosswalk_object->mutable_id()->set_id("crosswalk_1");
+    crosswalk_object->mutable_crosswalk_overlap_info();
+  }
+};
+
+TEST_F(MapValidatorTestSuite, ValidMap) {
+  Map map_proto;
+  InitMapProto(&map_proto);
+  MapValidationReport report;
+  EXPECT_TRUE(MapValidator(2).Validate(map_proto, &report));
+  EXPECT_TRUE(report.ok()) << report.DebugString();
+}
+
+TEST_F(MapValidatorTestSuite, Geometry) {
+  Map map_proto;
+  InitMapProto(&map_proto);
+  map_proto.mutable_lane(0)->set_length(12.0);
+  map_proto.mutable_lane(1)
+      ->mutable_central_curve()
+      ->mutable_segment(0)
+      ->mutable_line_segment()
+      ->mutable_point(3)
+      ->set_x(std::numeric_limits<double>::quiet_NaN());
+  map_proto.add_lane()->mutable_id()->set_id("lane_3");
+
+  MapValidationReport report;
+  EXPECT_FALSE(MapValidator(2).Validate(map_proto, &report));
+  EXPECT_EQ(3, report.IssueNum(MapIssue::GEOMETRY)) << report.DebugString();
+  EXPECT_EQ(0, report.IssueNum(MapIssue::TOPOLOGY));
+  EXPECT_EQ(0, report.IssueNum(MapIssue::OVERLAP));
+  ASSERT_EQ(3, report.issues.size());
+  EXPECT_EQ("lane_1", report.issues[0].element_id);
+  EXPECT_EQ("lane_2", report.issues[1].element_id);
+  EXPECT_EQ("lane_3", report.issues[2].element_id);
+}
+
+TEST_F(MapValidatorTestSuite, Topology) {
+  Map map_proto;
+  InitMapProto(&map_proto);
+  // lane_2 does not list lane_1 as predecessor
+  map_proto.mutable_lane(1)->clear_predecessor_id();
+  map_proto.mutable_lane(1)->add_left_neighbor_forward_lane_id()->set_id(
+      "lane_4");
+  map_proto.mutable_road(0)->mutable_junction_id()->set_id("junction_1");
+  *map_proto.add_road() = map_proto.road(0);
+
+  MapValidationReport report;
+  EXPECT_FALSE(MapValidator(2).Validate(map_proto, &report));
+  EXPECT_EQ(0, report.IssueNum(MapIssue::GEOMETRY));
+  EXPECT_EQ(0, report.IssueNum(MapIssue::OVERLAP));
+  // the duplicate road, the successor of lane_1, the neighbor of lane_2 and
+  // the junction of both roads
+  EXPECT_EQ(5, report.IssueNum(MapIssue::TOPOLOGY)) << report.DebugString();
+}
+
+TEST_F(MapValidatorTestSuite, Overlap) {
+  Map map_proto;
+  InitMapProto(&map_proto);
+  map_proto.mutable_overlap(0)
+      ->mutable_object(0)
+      ->mutable_lane_overlap_info()
+      ->set_end_s(12.0);
+  map_proto.mutable_crosswalk(0)->clear_overlap_id();
+  map_proto.mutable_lane(0)->add_overlap_id()->set_id("overlap_2");
+
+  MapValidationReport report;
+  EXPECT_FALSE(MapValidator(2).Validate(map_proto, &report));
+  EXPECT_EQ(0, report.IssueNum(MapIssue::GEOMETRY));
+  EXPECT_EQ(0, report.IssueNum(MapIssue::TOPOLOGY));
+  // the range on lane_2, crosswalk_1 not referring to overlap_1 and
+  // overlap_2 not existing
+  EXPECT_EQ(3, report.IssueNum(MapIssue::OVERLAP)) << report.DebugString();
+}
+
+TEST_F(MapValidatorTestSuite, ThreadNum) {
+  Map map_proto;
+  ASSERT_TRUE(cyber::common::GetProtoFromFile(
+      "modules/map/hdmap/test-data/base_map.bin", &map_proto));
+  MapValidationReport report;
+  MapValidator(1).Validate(map_proto, &report);
+  const std::string expected = report.DebugString();
+  for (const int thread_num : {0, 3, 8}) {
+    MapValidator(thread_num).Validate(map_proto, &report);
+    EXPECT_EQ(expected, report.DebugString());
+  }
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,522 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+#include "modules/map/hdmap/tiled_map.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <set>
+#include <unordered_set>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace hdmap {
+namespace {
+
+using apollo::common::PointENU;
+using apollo::common::math::Vec2d;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+
+// the first line is the tile size, then a line "x y" for every tile
+constexpr char kTileIndexFile[] = "tile_index.txt";
+
+// an element of a map, the number of its field in Map and its index
+using ElementRef = std::pair<int, int>;
+using TileIndex = std::pair<int, int>;
+
+std::string TileFile(const int x, const int y) {
+  return absl::StrCat("tile_", x, "_", y, ".bin");
+}
+
+struct Bounds {
+  double min_x = std::numeric_limits<double>::infinity();
+  double min_y = std::numeric_limits<double>::infinity();
+  double max_x = -std::numeric_limits<double>::infinity();
+  double max_y = -std::numeric_limits<double>::infinity();
+};
+
+// Extends the bounds by all the points of any message nested in a message.
+void ExtendBounds(const Message& message, Bounds* const bounds) {
+  if (message.GetDescriptor() == PointENU::descriptor()) {
+    const auto& point = static_cast<const PointENU&>(message);
+    bounds->min_x = std::min(bounds->min_x, point.x());
+    bounds->min_y = std::min(bounds->min_y, point.y());
+    bounds->max_x = std::max(bounds->max_x, point.x());
+    bounds->max_y = std::max(bounds->max_y, point.y());
+    return;
+  }
+  const auto* reflection = message.GetReflection();
+  std::vector<const FieldDescriptor*> fields;
+  reflection->ListFields(message, &fields);
+  for (const auto* field : fields) {
+    if (field->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE) {
+      continue;
+    }
+    if (field->is_repeated()) {
+      for (int i = 0; i < reflection->FieldSize(message, field); ++i) {
+        ExtendBounds(reflection->GetRepeatedMessage(message, field, i),
+                     bounds);
+      }
+    } else {
+      ExtendBounds(reflection->GetMessage(message, field), bounds);
+    }
+  }
+}
+
+const Message& GetElement(const Map& map, const ElementRef& ref) {
+  const auto* field = Map::descriptor()->FindFieldByNumber(ref.first);
+  return map.GetReflection()->GetRepeatedMessage(map, field, ref.second);
+}
+
+// The ids of a repeated Id field of an element, e.g. its overlap_id.
+std::vector<std::string> GetIds(const Message& element,
+                                const std::string& field_name) {
+  std::vector<std::string> ids;
+  const auto* field = element.GetDescriptor()->FindFieldByName(field_name);
+  if (field == nullptr) {
+    return ids;
+  }
+  const auto* reflection = element.GetReflection();
+  if (field->is_repeated()) {
+    for (int i = 0; i < reflection->FieldSize(element, field); ++i) {
+      ids.push_back(static_cast<const Id&>(
+                        reflection->GetRepeatedMessage(element, field, i))
+                        .id());
+    }
+  } else if (reflection->HasField(element, field)) {
+    ids.push_back(
+        static_cast<const Id&>(reflection->GetMessage(element, field)).id());
+  }
+  return ids;
+}
+
+// The id of an element, empty if it has none.
+std::string GetId(const Message& element) {
+  const auto ids = GetIds(element, "id");
+  return ids.empty() ? std::string() : ids.front();
+}
+
+// The fields of Map which have a geometry of their own. Overlaps, roads and
+// rsus go to the tiles of the elements they refer to.
+std::vector<const FieldDescriptor*> GeometryFields() {
+  std::vector<const FieldDescriptor*> fields;
+  const auto* descriptor = Map::descriptor();
+  for (int i = 0; i < descriptor->field_count(); ++i) {
+    const auto* field = descriptor->field(i);
+    if (field->is_repeated() && field->number() != Map::kOverlapFieldNumber &&
+        field->number() != Map::kRoadFieldNumber &&
+        field->number() != Map::kRsuFieldNumber) {
+      fields.push_back(field);
+    }
+  }
+  return fields;
+}
+
+// The indices of the roads of every lane and of the rsus of every junction.
+struct ParentIndex {
+  std::unordered_map<std::string, std::vector<int>> lane_roads;
+  std::unordered_map<std::string, std::vector<int>> junction_rsus;
+};
+
+ParentIndex BuildParentIndex(const Map& map) {
+  ParentIndex index;
+  for (int i = 0; i < map.road_size(); ++i) {
+    for (const auto& section : map.road(i).section()) {
+      for (const auto& lane_id : section.lane_id()) {
+        index.lane_roads[lane_id.id()].push_back(i);
+      }
+    }
+  }
+  for (int i = 0; i < map.rsu_size(); ++i) {
+    index.junction_rsus[map.rsu(i).junction_id().id()].push_back(i);
+  }
+  return index;
+}
+
+// Adds the overlaps of the elements of a tile and the objects of these
+// overlaps, then the roads of its lanes and the rsus of its junctions.
+void CompleteTile(
+    const Map& map,
+    const std::unordered_map<std::string, std::vector<ElementRef>>& elements,
+    const std::unordered_map<std::string, int>& overlaps,
+    const ParentIndex& parents, std::set<ElementRef>* const tile) {
+  std::set<int> overlap_indices;
+  for (const auto& ref : *tile) {
+    for (const auto& id : GetIds(GetElement(map, ref), "overlap_id")) {
+      const auto iter = overlaps.find(id);
+      if (iter != overlaps.end()) {
+        overlap_indices.insert(iter->second);
+      }
+    }
+  }
+  for (const int index : overlap_indices) {
+    tile->emplace(Map::kOverlapFieldNumber, index);
+    for (const auto& object : map.overlap(index).object()) {
+      const auto iter = elements.find(object.id().id());
+      if (iter != elements.end()) {
+        tile->insert(iter->second.begin(), iter->second.end());
+      }
+    }
+  }
+
+  std::set<int> road_indices;
+  std::set<int> rsu_indices;
+  for (const auto& ref : *tile) {
+    if (ref.first == Map::kLaneFieldNumber) {
+      const auto iter =
+          parents.lane_roads.find(map.lane(ref.second).id().id());
+      if (iter != parents.lane_roads.end()) {
+        road_indices.insert(iter->second.begin(), iter->second.end());
+      }
+    } else if (ref.first == Map::kJunctionFieldNumber) {
+      const auto iter =
+          parents.junction_rsus.find(map.junction(ref.second).id().id());
+      if (iter != parents.junction_rsus.end()) {
+        rsu_indices.insert(iter->second.begin(), iter->second.end());
+      }
+    }
+  }
+  for (const int index : road_indices) {
+    tile->emplace(Map::kRoadFieldNumber, index);
+  }
+  for (const int index : rsu_indices) {
+    tile->emplace(Map::kRsuFieldNumber, index);
+    for (const auto& id : map.rsu(index).overlap_id()) {
+      const auto iter = overlaps.find(id.id());
+      if (iter != overlaps.end()) {
+        tile->emplace(Map::kOverlapFieldNumber, iter->second);
+      }
+    }
+  }
+}
+
+// Merges tiles into one map, an element which is in several of them once.
+void MergeTiles(const std::vector<std::shared_ptr<const Map>>& tiles,
+                Map* const map) {
+  map->Clear();
+  const auto* reflection = map->GetReflection();
+  const auto* descriptor = Map::descriptor();
+  std::unordered_map<int, std::unordered_set<std::string>> ids;
+  for (const auto& tile : tiles) {
+    if (!map->has_header() && tile->has_header()) {
+      *map->mutable_header() = tile->header();
+    }
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+      const auto* field = descriptor->field(i);
+      if (!field->is_repeated()) {
+        continue;
+      }
+      auto& field_ids = ids[field->number()];
+      for (int j = 0; j < reflection->FieldSize(*tile, field); ++j) {
+        const auto& element = reflection->GetRepeatedMessage(*tile, field, j);
+        const std::string id = GetId(element);
+        if (id.empty()) {
+          AWARN << "Skip a " << field->name() << " without id in a tile.";
+          continue;
+        }
+        if (field_ids.insert(id).second) {
+          reflection->AddMessage(map, field)->CopyFrom(element);
+        }
+      }
+    }
+  }
+
+  // roads keep the lanes which are in the map
+  const auto& lane_ids = ids[Map::kLaneFieldNumber];
+  for (auto& road : *map->mutable_road()) {
+    for (auto& section : *road.mutable_section()) {
+      auto* section_lane_ids = section.mutable_lane_id();
+      section_lane_ids->erase(
+          std::remove_if(section_lane_ids->begin(), section_lane_ids->end(),
+                         [&lane_ids](const Id& id) {
+                           return lane_ids.count(id.id()) == 0;
+                         }),
+          section_lane_ids->end());
+    }
+  }
+}
+
+}  // namespace
+
+bool TiledMap::SaveTiles(const Map& map, const double tile_size,
+                         const std::string& tile_dir) {
+  if (tile_size <= 0.0) {
+    AERROR << "Invalid tile size " << tile_size;
+    return false;
+  }
+  if (!cyber::common::EnsureDirectory(tile_dir)) {
+    AERROR << "Failed to create " << tile_dir;
+    return false;
+  }
+
+  std::unordered_map<std::string, std::vector<ElementRef>> elements;
+  std::map<TileIndex, std::set<ElementRef>> tiles;
+  const auto* reflection = map.GetReflection();
+  for (const auto* field : GeometryFields()) {
+    for (int i = 0; i < reflection->FieldSize(map, field); ++i) {
+      const auto& element = reflection->GetRepeatedMessage(map, field, i);
+      const std::string id = GetId(element);
+      if (id.empty()) {
+        AWARN << "Skip " << field->name() << " " << i
+              << " without id, it is in no tile.";
+        continue;
+      }
+      const ElementRef ref(field->number(), i);
+      elements[id].push_back(ref);
+      Bounds bounds;
+      ExtendBounds(element, &bounds);
+      if (bounds.min_x > bounds.max_x) {
+        AWARN << "Element " << id << " has no geometry, it is in no tile.";
+        continue;
+      }
+      const int min_x = static_cast<int>(std::floor(bounds.min_x / tile_size));
+      const int max_x = static_cast<int>(std::floor(bounds.max_x / tile_size));
+      const int min_y = static_cast<int>(std::floor(bounds.min_y / tile_size));
+      const int max_y = static_cast<int>(std::floor(bounds.max_y / tile_size));
+      for (int x = min_x; x <= max_x; ++x) {
+        for (int y = min_y; y <= max_y; ++y) {
+          tiles[{x, y}].insert(ref);
+        }
+      }
+    }
+  }
+  std::unordered_map<std::string, int> overlaps;
+  for (int i = 0; i < map.overlap_size(); ++i) {
+    overlaps.emplace(map.overlap(i).id().id(), i);
+  }
+
+  const ParentIndex parents = BuildParentIndex(map);
+
+  std::ofstream index_file(absl::StrCat(tile_dir, "/", kTileIndexFile));
+  index_file.precision(17);
+  index_file << tile_size << "\n";
+  for (auto& tile : tiles) {
+    CompleteTile(map, elements, overlaps, parents, &tile.second);
+    Map tile_map;
+    *tile_map.mutable_header() = map.header();
+    // the refs are sorted by field and index, so the elements of a tile are
+    // in the order of the map
+    for (const auto& ref : tile.second) {
+      const auto* field = Map::descriptor()->FindFieldByNumber(ref.first);
+      tile_map.GetReflection()->AddMessage(&tile_map, field)->CopyFrom(
+          GetElement(map, ref));
+    }
+    const std::string tile_file = absl::StrCat(
+        tile_dir, "/", TileFile(tile.first.first, tile.first.second));
+    if (!cyber::common::SetProtoToBinaryFile(tile_map, tile_file)) {
+      AERROR << "Failed to write " << tile_file;
+      return false;
+    }
+    index_file << tile.first.first << " " << tile.first.second << "\n";
+  }
+  index_file.flush();
+  return static_cast<bool>(index_file);
+}
+
+TiledMap::TiledMap(const std::string& tile_dir, const double radius,
+                   const int max_tile_num)
+    : tile_dir_(tile_dir),
+      radius_(radius),
+      max_tile_num_(std::max(1, max_tile_num)) {}
+
+TiledMap::~TiledMap() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  request_cv_.notify_all();
+  loaded_cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+int TiledMap::Init() {
+  const std::string index_filename =
+      absl::StrCat(tile_dir_, "/", kTileIndexFile);
+  std::ifstream index_file(index_filename);
+  if (!(index_file >> tile_size_) || tile_size_ <= 0.0) {
+    AERROR << "Failed to read the tile size from " << index_filename;
+    return -1;
+  }
+  int x = 0;
+  int y = 0;
+  while (index_file >> x >> y) {
+    tile_files_[TileKey(x, y)] = absl::StrCat(tile_dir_, "/", TileFile(x, y));
+  }
+  AINFO << "Found " << tile_files_.size() << " map tiles of " << tile_size_
+        << " meters in " << tile_dir_;
+  thread_ = std::thread(&TiledMap::LoadTiles, this);
+  return 0;
+}
+
+void TiledMap::UpdatePosition(const Vec2d& position) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    position_ = position;
+    has_position_ = true;
+    ++request_seq_;
+  }
+  request_cv_.notify_one();
+}
+
+void TiledMap::Prefetch(const std::vector<Vec2d>& route) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    route_ = route;
+    ++request_seq_;
+  }
+  request_cv_.notify_one();
+}
+
+std::shared_ptr<const HDMap> TiledMap::map() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return map_;
+}
+
+void TiledMap::WaitForLoading() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  loaded_cv_.wait(lock, [this]() {
+    return stop_ || !thread_.joinable() || loaded_seq_ == request_seq_;
+  });
+}
+
+void TiledMap::LoadTiles() {
+  while (true) {
+    Vec2d position;
+    bool has_position = false;
+    std::vector<Vec2d> route;
+    uint64_t seq = 0;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      request_cv_.wait(
+          lock, [this]() { return stop_ || request_seq_ != loaded_seq_; });
+      if (stop_) {
+        return;
+      }
+      position = position_;
+      has_position = has_position_;
+      route = route_;
+      seq = request_seq_;
+    }
+
+    std::vector<int64_t> keys;
+    if (has_position) {
+      AddTilesAround(position, &keys);
+    }
+    for (const auto& point : route) {
+      if (keys.size() >= max_tile_num_) {
+        break;
+      }
+      AddTilesAround(point, &keys);
+    }
+    if (keys.size() > max_tile_num_) {
+      keys.resize(max_tile_num_);
+    }
+
+    std::unordered_map<int64_t, std::shared_ptr<const Map>> tiles;
+    std::vector<std::shared_ptr<const Map>> tile_list;
+    bool changed = false;
+    for (const int64_t key : keys) {
+      auto iter = tiles_.find(key);
+      if (iter != tiles_.end()) {
+        tiles.insert(*iter);
+        tile_list.push_back(iter->second);
+        continue;
+      }
+      auto tile = std::make_shared<Map>();
+      if (!cyber::common::GetProtoFromBinaryFile(tile_files_.at(key),
+                                                 tile.get())) {
+        AERROR << "Failed to load map tile " << tile_files_.at(key);
+        continue;
+      }
+      tiles.emplace(key, tile);
+      tile_list.push_back(tile);
+      changed = true;
+    }
+    // tiles which are no longer needed are dropped
+    changed = changed || tiles.size() != tiles_.size() ||
+              std::any_of(tiles_.begin(), tiles_.end(),
+                          [&tiles](const auto& t) {
+                            return tiles.count(t.first) == 0;
+                          });
+    tiles_.swap(tiles);
+
+    std::shared_ptr<const HDMap> map;
+    if (changed) {
+      Map merged_map;
+      MergeTiles(tile_list, &merged_map);
+      auto hdmap = std::make_shared<HDMap>();
+      if (hdmap->LoadMapFromProto(merged_map) == 0) {
+        map = hdmap;
+      } else {
+        AERROR << "Failed to load the map of " << tile_list.size()
+               << " tiles.";
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (map != nullptr) {
+        map_ = map;
+      }
+      loaded_seq_ = seq;
+    }
+    loaded_cv_.notify_all();
+  }
+}
+
+void TiledMap::AddTilesAround(const Vec2d& point,
+                              std::vector<int64_t>* const keys) const {
+  const int min_x = static_cast<int>(std::floor((point.x() - radius_) /
+                                                tile_size_));
+  const int max_x = static_cast<int>(std::floor((point.x() + radius_) /
+                                                tile_size_));
+  const int min_y = static_cast<int>(std::floor((point.y() - radius_) /
+                                                tile_size_));
+  const int max_y = static_cast<int>(std::floor((point.y() + radius_) /
+                                                tile_size_));
+  for (int x = min_x; x <= max_x; ++x) {
+    for (int y = min_y; y <= max_y; ++y) {
+      // the distance from the point to the tile
+      const double dx = std::max({x * tile_size_ - point.x(), 0.0,
+                                  point.x() - (x + 1) * tile_size_});
+      const double dy = std::max({y * tile_size_ - point.y(), 0.0,
+                                  point.y() - (y + 1) * tile_size_});
+      const int64_t key = TileKey(x, y);
+      if (dx * dx + dy * dy > radius_ * radius_ ||
+          tile_files_.count(key) == 0 ||
+          std::find(keys->begin(), keys->end(), key) != keys->end()) {
+        continue;
+      }
+      keys->push_back(key);
+    }
+  }
+}
+
+int64_t TiledMap::TileKey(const int x, const int y) const {
+  return (static_cast<int64_t>(x) << 32) |
+         static_cast<int64_t>(static_cast<uint32_t>(y));
+}
+
+}  // namespace hdmap
+}  // namespace apollo
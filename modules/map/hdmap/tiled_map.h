@@ -0,0 +1,146 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+/**
+ * @file
+ * @brief A map split into square tiles, of which only the tiles around the
+ * vehicle and along its route are in memory.
+ *
+ * Every element of the map is in all the tiles its bounding box overlaps,
+ * together with the overlaps it refers to and the objects of these overlaps,
+ * so that the tiles within a radius of a point answer the queries within
+ * that radius as the whole map does.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "modules/common/math/vec2d.h"
+#include "modules/common_msgs/map_msgs/map.pb.h"
+#include "modules/map/hdmap/hdmap.h"
+
+/**
+ * @namespace apollo::hdmap
+ * @brief apollo::hdmap
+ */
+namespace apollo {
+namespace hdmap {
+
+/**
+ * @class TiledMap
+ *
+ * @brief Keeps the tiles within a radius of the vehicle and along its route
+ * loaded, on a thread of its own. Queries go to the map of the loaded tiles,
+ * which is replaced as a whole once the tiles change, so that they never
+ * wait for tiles to load.
+ *
+ * Every change of the loaded tiles merges all of them into one Map and
+ * builds a new HDMap from it, including its kd-trees. The cost of a change
+ * grows with the loaded tiles, not with the tiles which changed, so the
+ * radius and max_tile_num bound it.
+ */
+class TiledMap {
+ public:
+  /**
+   * @brief split a map into tiles and write them to a directory
+   * @param map the map
+   * @param tile_size the size of the tiles in meters
+   * @param tile_dir the directory of the tiles, created if it does not exist
+   * @return true on success
+   */
+  static bool SaveTiles(const Map& map, const double tile_size,
+                        const std::string& tile_dir);
+
+  /**
+   * @param tile_dir the directory of the tiles written by SaveTiles
+   * @param radius the tiles within the radius of the vehicle and of the
+   *        points of its route are loaded
+   * @param max_tile_num the number of tiles which are loaded at most, the
+   *        tiles around the vehicle first and then the tiles along its route
+   */
+  TiledMap(const std::string& tile_dir, const double radius,
+           const int max_tile_num);
+  ~TiledMap();
+
+  /**
+   * @brief read the tile index and start loading tiles
+   * @return 0:success, otherwise failed
+   */
+  int Init();
+
+  /**
+   * @brief move the vehicle, the tiles around it are loaded and the tiles
+   *        far from it and from its route are dropped in the background
+   */
+  void UpdatePosition(const apollo::common::math::Vec2d& position);
+
+  /**
+   * @brief prefetch the tiles along a route, e.g. the points of the lanes of
+   *        a routing response
+   */
+  void Prefetch(const std::vector<apollo::common::math::Vec2d>& route);
+
+  /**
+   * @brief the map of the loaded tiles, nullptr before the first tiles are
+   *        loaded. It stays valid as long as it is held.
+   */
+  std::shared_ptr<const HDMap> map() const;
+
+  /**
+   * @brief wait until the tiles of the last position and route are loaded
+   */
+  void WaitForLoading();
+
+  double tile_size() const { return tile_size_; }
+
+ private:
+  void LoadTiles();
+  void AddTilesAround(const apollo::common::math::Vec2d& point,
+                      std::vector<int64_t>* const keys) const;
+  int64_t TileKey(const int x, const int y) const;
+
+ private:
+  const std::string tile_dir_;
+  const double radius_;
+  const size_t max_tile_num_;
+  double tile_size_ = 0.0;
+  std::unordered_map<int64_t, std::string> tile_files_;
+
+  // the tiles loaded by the loading thread, only accessed by it
+  std::unordered_map<int64_t, std::shared_ptr<const Map>> tiles_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable request_cv_;
+  std::condition_variable loaded_cv_;
+  apollo::common::math::Vec2d position_;
+  std::vector<apollo::common::math::Vec2d> route_;
+  bool has_position_ = false;
+  uint64_t request_seq_ = 0;
+  uint64_t loaded_seq_ = 0;
+  bool stop_ = false;
+  std::shared_ptr<const HDMap> map_;
+  std::thread thread_;
+};
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,177 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+#include "modules/map/hdmap/tiled_map.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "gtest/gtest.h"
+
+#include "absl/strings/str_cat.h"
+
+#include "cyber/common/file.h"
+#include "modules/map/hdmap/hdmap_impl.h"
+
+namespace {
+
+constexpr char kMapFilename[] = "modules/map/hdmap/test-data/base_map.bin";
+
+}  // namespace
+
+namespace apollo {
+namespace hdmap {
+
+using apollo::common::math::Vec2d;
+
+class TiledMapTest : public ::testing::Test {
+ public:
+  TiledMapTest() {
+    tile_dir_ = absl::StrCat(
+        "/tmp/tiled_map_",
+        std::chrono::steady_clock::now().time_since_epoch().count());
+    EXPECT_EQ(0, hdmap_impl_.LoadMapFromFile(kMapFilename));
+    Map map;
+    EXPECT_TRUE(cyber::common::GetProtoFromBinaryFile(kMapFilename, &map));
+    EXPECT_TRUE(TiledMap::SaveTiles(map, 50.0, tile_dir_));
+  }
+
+  ~TiledMapTest() { cyber::common::RemoveAll(tile_dir_); }
+
+ protected:
+  template <class T>
+  static std::vector<std::string> Ids(const std::vector<T>& infos) {
+    std::vector<std::string> ids;
+    for (const auto& info : infos) {
+      ids.push_back(info->id().id());
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  }
+
+  std::string tile_dir_;
+  HDMapImpl hdmap_impl_;
+};
+
+TEST_F(TiledMapTest, QueriesAroundPosition) {
+  TiledMap tiled_map(tile_dir_, 150.0, 16);
+  ASSERT_EQ(0, tiled_map.Init());
+  EXPECT_DOUBLE_EQ(50.0, tiled_map.tile_size());
+  EXPECT_EQ(nullptr, tiled_map.map());
+
+  const Vec2d position(586441.73, 4140745.25);
+  tiled_map.UpdatePosition(position);
+  tiled_map.WaitForLoading();
+  const auto map = tiled_map.map();
+  ASSERT_NE(nullptr, map);
+
+  apollo::common::PointENU point;
+  point.set_x(position.x());
+  point.set_y(position.y());
+  std::vector<LaneInfoConstPtr> lanes;
+  std::vector<LaneInfoConstPtr> tiled_lanes;
+  EXPECT_EQ(0, hdmap_impl_.GetLanes(point, 50.0, &lanes));
+  EXPECT_EQ(0, map->GetLanes(point, 50.0, &tiled_lanes));
+  EXPECT_FALSE(lanes.empty());
+  EXPECT_EQ(Ids(lanes), Ids(tiled_lanes));
+
+  std::vector<JunctionInfoConstPtr> junctions;
+  std::vector<JunctionInfoConstPtr> tiled_junctions;
+  EXPECT_EQ(0, hdmap_impl_.GetJunctions(point, 50.0, &junctions));
+  EXPECT_EQ(0, map->GetJunctions(point, 50.0, &tiled_junctions));
+  EXPECT_EQ(Ids(junctions), Ids(tiled_junctions));
+
+  std::vector<SignalInfoConstPtr> signals;
+  std::vector<SignalInfoConstPtr> tiled_signals;
+  EXPECT_EQ(0, hdmap_impl_.GetSignals(point, 50.0, &signals));
+  EXPECT_EQ(0, map->GetSignals(point, 50.0, &tiled_signals));
+  EXPECT_EQ(Ids(signals), Ids(tiled_signals));
+
+  // the lanes of the tiled map have the overlaps of the whole map
+  for (const auto& lane : lanes) {
+    const auto tiled_lane = map->GetLaneById(lane->id());
+    ASSERT_NE(nullptr, tiled_lane);
+    EXPECT_EQ(lane->lane().overlap_id_size(),
+              tiled_lane->lane().overlap_id_size());
+    for (const auto& overlap_id : lane->lane().overlap_id()) {
+      EXPECT_NE(nullptr, map->GetOverlapById(overlap_id));
+    }
+  }
+
+  // the tiles far from the vehicle are dropped, the former map stays valid
+  tiled_map.UpdatePosition(Vec2d(0.0, 0.0));
+  tiled_map.WaitForLoading();
+  EXPECT_EQ(0, map->GetLanes(point, 50.0, &tiled_lanes));
+  EXPECT_EQ(Ids(lanes), Ids(tiled_lanes));
+  const auto empty_map = tiled_map.map();
+  ASSERT_NE(nullptr, empty_map);
+  EXPECT_EQ(0, empty_map->GetLanes(point, 50.0, &tiled_lanes));
+  EXPECT_TRUE(tiled_lanes.empty());
+}
+
+TEST_F(TiledMapTest, PrefetchRoute) {
+  TiledMap tiled_map(tile_dir_, 100.0, 64);
+  ASSERT_EQ(0, tiled_map.Init());
+  const Vec2d position(586441.73, 4140745.25);
+  const Vec2d destination(586441.73 + 500.0, 4140745.25);
+  tiled_map.UpdatePosition(position);
+  tiled_map.Prefetch({position, destination});
+  tiled_map.WaitForLoading();
+  const auto map = tiled_map.map();
+  ASSERT_NE(nullptr, map);
+
+  apollo::common::PointENU point;
+  point.set_x(destination.x());
+  point.set_y(destination.y());
+  std::vector<LaneInfoConstPtr> lanes;
+  std::vector<LaneInfoConstPtr> tiled_lanes;
+  EXPECT_EQ(0, hdmap_impl_.GetLanes(point, 50.0, &lanes));
+  EXPECT_EQ(0, map->GetLanes(point, 50.0, &tiled_lanes));
+  EXPECT_EQ(Ids(lanes), Ids(tiled_lanes));
+}
+
+TEST_F(TiledMapTest, ElementWithoutId) {
+  Map map;
+  ASSERT_TRUE(cyber::common::GetProtoFromBinaryFile(kMapFilename, &map));
+  ASSERT_GT(map.lane_size(), 1);
+  const std::string lane_id = map.lane(0).id().id();
+  map.mutable_lane(0)->clear_id();
+  const std::string tile_dir = absl::StrCat(tile_dir_, "_without_id");
+  ASSERT_TRUE(TiledMap::SaveTiles(map, 50.0, tile_dir));
+
+  // the lane without id is in no tile, the others are
+  TiledMap tiled_map(tile_dir, 150.0, 16);
+  ASSERT_EQ(0, tiled_map.Init());
+  const auto& point =
+      map.lane(1).central_curve().segment(0).line_segment().point(0);
+  tiled_map.UpdatePosition(Vec2d(point.x(), point.y()));
+  tiled_map.WaitForLoading();
+  const auto tiled = tiled_map.map();
+  ASSERT_NE(nullptr, tiled);
+  EXPECT_NE(nullptr, tiled->GetLaneById(map.lane(1).id()));
+  Id id;
+  id.set_id(lane_id);
+  EXPECT_EQ(nullptr, tiled->GetLaneById(id));
+  cyber::common::RemoveAll(tile_dir);
+}
+
+TEST(TiledMap, MissingTileIndex) {
+  TiledMap tiled_map("/tmp/no_such_tile_dir", 100.0, 16);
+  EXPECT_EQ(-1, tiled_map.Init());
+  EXPECT_EQ(nullptr, tiled_map.map());
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,174 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/map/pnc_map/nearest_segment.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "modules/common/util/parallel_for.h"
+
+namespace apollo {
+namespace pnc_map {
+
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
+
+namespace {
+
+// the distances are computed for blocks of segments, of which the minimum is
+// searched afterwards, so that the loop computing them vectorizes
+constexpr size_t kBlockSize = 256;
+
+// the number of point and segment pairs below which a batch is not split
+// over threads
+constexpr size_t kMinParallelWork = 1 << 18;
+
+// The squared distances of (x, y) to num segments. On x86-64 it is also
+// compiled for AVX2, which is picked at run time on the CPUs having it.
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+__attribute__((target_clones("avx2", "default")))
+#endif
+void DistanceSqrs(const double x, const double y, const double* start_x,
+                  const double* start_y, const double* direction_x,
+                  const double* direction_y,
+                  const double* inverse_length_sqr, const size_t num,
+                  double* distances) {
+  for (size_t i = 0; i < num; ++i) {
+    const double dx = x - start_x[i];
+    const double dy = y - start_y[i];
+    // the projection onto the segment, clamped to its end points
+    const double t =
+        std::min(std::max((dx * direction_x[i] + dy * direction_y[i]) *
+                              inverse_length_sqr[i],
+                          0.0),
+                 1.0);
+    const double ex = dx - t * direction_x[i];
+    const double ey = dy - t * direction_y[i];
+    distances[i] = ex * ex + ey * ey;
+  }
+}
+
+// the minimum of num distances, in kLanes independent minimums, which the
+// compiler keeps in vector registers
+double BlockMin(const double* distances, const size_t num) {
+  constexpr size_t kLanes = 4;
+  double lane_mins[kLanes];
+  std::fill(lane_mins, lane_mins + kLanes,
+            std::numeric_limits<double>::infinity());
+  size_t i = 0;
+  for (; i + kLanes <= num; i += kLanes) {
+    for (size_t j = 0; j < kLanes; ++j) {
+      lane_mins[j] =
+          distances[i + j] < lane_mins[j] ? distances[i + j] : lane_mins[j];
+    }
+  }
+  for (; i < num; ++i) {
+    lane_mins[0] = distances[i] < lane_mins[0] ? distances[i] : lane_mins[0];
+  }
+  return *std::min_element(lane_mins, lane_mins + kLanes);
+}
+
+}  // namespace
+
+bool NearestSegment::UpdateLineSegment(
+    const std::vector<LineSegment2d>& segments) {
+  const size_t num = segments.size();
+  start_x_.resize(num);
+  start_y_.resize(num);
+  direction_x_.resize(num);
+  direction_y_.resize(num);
+  inverse_length_sqr_.resize(num);
+  for (size_t i = 0; i < num; ++i) {
+    const Vec2d& start = segments[i].start();
+    const Vec2d direction = segments[i].end() - start;
+    const double length_sqr = direction.LengthSquare();
+    start_x_[i] = start.x();
+    start_y_[i] = start.y();
+    direction_x_[i] = direction.x();
+    direction_y_[i] = direction.y();
+    inverse_length_sqr_[i] = length_sqr > 0.0 ? 1.0 / length_sqr : 0.0;
+  }
+  return true;
+}
+
+int NearestSegment::FindNearestSegment(const double x, const double y) const {
+  double distance_sqr = 0.0;
+  return FindNearestSegment(x, y, &distance_sqr);
+}
+
+int NearestSegment::FindNearestSegment(const double x, const double y,
+                                       double* const distance_sqr) const {
+  const size_t num = start_x_.size();
+  const double* start_x = start_x_.data();
+  const double* start_y = start_y_.data();
+  const double* direction_x = direction_x_.data();
+  const double* direction_y = direction_y_.data();
+  const double* inverse_length_sqr = inverse_length_sqr_.data();
+
+  double distances[kBlockSize];
+  double min_distance_sqr = std::numeric_limits<double>::infinity();
+  int min_index = -1;
+  for (size_t begin = 0; begin < num; begin += kBlockSize) {
+    const size_t size = std::min(kBlockSize, num - begin);
+    DistanceSqrs(x, y, start_x + begin, start_y + begin, direction_x + begin,
+                 direction_y + begin, inverse_length_sqr + begin, size,
+                 distances);
+    const double block_min = BlockMin(distances, size);
+    if (block_min < min_distance_sqr) {
+      min_distance_sqr = block_min;
+      min_index = static_cast<int>(
+          begin + (std::find(distances, distances + size, block_min) -
+                   distances));
+    }
+  }
+  *distance_sqr = min_distance_sqr;
+  return min_index;
+}
+
+void NearestSegment::FindNearestSegments(const Vec2d* points,
+                                         const size_t num, int* indices,
+                                         double* distance_sqrs) const {
+  for (size_t i = 0; i < num; ++i) {
+    indices[i] =
+        FindNearestSegment(points[i].x(), points[i].y(), &distance_sqrs[i]);
+  }
+}
+
+void NearestSegment::FindNearestSegments(const std::vector<Vec2d>& points,
+                                         std::vector<int>* const indices,
+                                         std::vector<double>* const
+                                             distance_sqrs,
+                                         const int thread_num) const {
+  std::vector<double> distances;
+  std::vector<double>* const sqrs =
+      distance_sqrs != nullptr ? distance_sqrs : &distances;
+  indices->resize(points.size());
+  sqrs->resize(points.size());
+
+  // small batches stay on the calling thread
+  const bool parallel =
+      thread_num > 1 && points.size() * size() >= kMinParallelWork;
+  common::util::ParallelForBlocks(
+      points.size(), parallel ? thread_num : 1,
+      [&](const size_t, const size_t begin, const size_t end) {
+        FindNearestSegments(points.data() + begin, end - begin,
+                            indices->data() + begin, sqrs->data() + begin);
+      });
+}
+
+}  // namespace pnc_map
+}  // namespace apollo
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief The CPU counterpart of CudaNearestSegment.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "modules/common/math/line_segment2d.h"
+#include "modules/common/math/vec2d.h"
+
+namespace apollo {
+namespace pnc_map {
+
+/**
+ * @class NearestSegment
+ *
+ * @brief Finds the segment nearest to a point among a set of segments, as
+ * CudaNearestSegment does on a GPU. The segments are kept as arrays of their
+ * coordinates, over which the distances are computed without branches, so
+ * that the compiler vectorizes the scan.
+ */
+class NearestSegment {
+ public:
+  NearestSegment() = default;
+
+  /**
+   * @brief replace the segments to search.
+   * @return always true, there is no device to copy the segments to.
+   */
+  bool UpdateLineSegment(
+      const std::vector<apollo::common::math::LineSegment2d>& segments);
+
+  /**
+   * @brief the index of the segment nearest to (x, y), the lowest index of
+   * the nearest ones on ties, -1 if there are no segments.
+   */
+  int FindNearestSegment(const double x, const double y) const;
+
+  /**
+   * @brief as above, also giving the squared distance to the segment.
+   */
+  int FindNearestSegment(const double x, const double y,
+                         double* const distance_sqr) const;
+
+  /**
+   * @brief the index of the nearest segment of each point.
+   * @param points the points.
+   * @param indices the index of the nearest segment of each point.
+   * @param distance_sqrs the squared distance to the nearest segment of each
+   *        point, may be nullptr.
+   * @param thread_num the number of threads to split large batches over.
+   */
+  void FindNearestSegments(
+      const std::vector<apollo::common::math::Vec2d>& points,
+      std::vector<int>* const indices,
+      std::vector<double>* const distance_sqrs = nullptr,
+      const int thread_num = 1) const;
+
+  size_t size() const { return start_x_.size(); }
+
+ private:
+  void FindNearestSegments(const apollo::common::math::Vec2d* points,
+                           const size_t num, int* indices,
+                           double* distance_sqrs) const;
+
+ private:
+  // start point, direction and inverse squared length of each segment, 0 for
+  // segments of zero length
+  std::vector<double> start_x_;
+  std::vector<double> start_y_;
+  std::vector<double> direction_x_;
+  std::vector<double> direction_y_;
+  std::vector<double> inverse_length_sqr_;
+};
+
+}  // namespace pnc_map
+}  // namespace apollo
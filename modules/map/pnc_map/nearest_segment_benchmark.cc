@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/map/pnc_map/nearest_segment.h"
+
+#if USE_GPU == 1
+#include "modules/map/pnc_map/cuda_util.h"
+#endif
+
+namespace apollo {
+namespace pnc_map {
+namespace {
+
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
+
+// a winding path of num segments of 1m
+std::vector<LineSegment2d> Segments(int64_t num) {
+  std::vector<LineSegment2d> segments;
+  Vec2d point(0.0, 0.0);
+  double heading = 0.0;
+  for (int64_t i = 0; i < num; ++i) {
+    heading += 0.05 * std::sin(0.01 * static_cast<double>(i));
+    const Vec2d next = point + Vec2d::CreateUnitVec2d(heading);
+    segments.emplace_back(point, next);
+    point = next;
+  }
+  return segments;
+}
+
+std::vector<Vec2d> Points(const std::vector<LineSegment2d>& segments,
+                          int64_t num) {
+  std::mt19937 engine(static_cast<unsigned int>(num));
+  std::uniform_int_distribution<size_t> index(0, segments.size() - 1);
+  std::uniform_real_distribution<double> offset(-5.0, 5.0);
+  std::vector<Vec2d> points;
+  for (int64_t i = 0; i < num; ++i) {
+    const Vec2d& center = segments[index(engine)].center();
+    points.emplace_back(center.x() + offset(engine),
+                        center.y() + offset(engine));
+  }
+  return points;
+}
+
+// the scalar loop of the callers without a GPU
+void BM_LineSegmentScan(benchmark::State& state) {  // NOLINT
+  const auto segments = Segments(state.range(0));
+  const auto points = Points(segments, 64);
+  std::vector<int> indices(points.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < points.size(); ++i) {
+      double min_distance_sqr = std::numeric_limits<double>::infinity();
+      for (size_t j = 0; j < segments.size(); ++j) {
+        const double distance_sqr = segments[j].DistanceSquareTo(points[i]);
+        if (distance_sqr < min_distance_sqr) {
+          min_distance_sqr = distance_sqr;
+          indices[i] = static_cast<int>(j);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(indices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+void BM_NearestSegment(benchmark::State& state) {  // NOLINT
+  const auto segments = Segments(state.range(0));
+  const auto points = Points(segments, 64);
+  NearestSegment nearest_segment;
+  nearest_segment.UpdateLineSegment(segments);
+  std::vector<int> indices(points.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < points.size(); ++i) {
+      indices[i] =
+          nearest_segment.FindNearestSegment(points[i].x(), points[i].y());
+    }
+    benchmark::DoNotOptimize(indices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+void BM_NearestSegmentBatch(benchmark::State& state) {  // NOLINT
+  const auto segments = Segments(2000);
+  const auto points = Points(segments, state.range(0));
+  NearestSegment nearest_segment;
+  nearest_segment.UpdateLineSegment(segments);
+  std::vector<int> indices;
+  for (auto _ : state) {
+    nearest_segment.FindNearestSegments(points, &indices, nullptr,
+                                        static_cast<int>(state.range(1)));
+    benchmark::DoNotOptimize(indices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+#if USE_GPU == 1
+void BM_CudaNearestSegment(benchmark::State& state) {  // NOLINT
+  const auto segments = Segments(state.range(0));
+  const auto points = Points(segments, 64);
+  CudaNearestSegment nearest_segment;
+  nearest_segment.UpdateLineSegment(segments);
+  std::vector<int> indices(points.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < points.size(); ++i) {
+      indices[i] =
+          nearest_segment.FindNearestSegment(points[i].x(), points[i].y());
+    }
+    benchmark::DoNotOptimize(indices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+// CudaNearestSegment keeps at most 2000 segments
+BENCHMARK(BM_CudaNearestSegment)->Range(64, 2000);
+#endif
+
+BENCHMARK(BM_LineSegmentScan)->Range(64, 2000);
+BENCHMARK(BM_NearestSegment)->Range(64, 2000);
+BENCHMARK(BM_NearestSegmentBatch)
+    ->Args({64, 1})
+    ->Args({4096, 1})
+    ->Args({4096, 4});
+
+}  // namespace
+}  // namespace pnc_map
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/map/pnc_map/nearest_segment.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace pnc_map {
+
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
+
+TEST(NearestSegment, FindNearestSegment) {
+  NearestSegment segment_tool;
+  EXPECT_EQ(-1, segment_tool.FindNearestSegment(0.0, 0.0));
+
+  Vec2d p1(0, 0);
+  Vec2d p2(1, 0);
+  Vec2d p3(2, 0);
+  Vec2d p4(3, 0);
+
+  std::vector<LineSegment2d> segments;
+  segments.emplace_back(p1, p2);
+  segments.emplace_back(p2, p3);
+  segments.emplace_back(p3, p4);
+  // a segment of zero length
+  segments.emplace_back(Vec2d(5, 5), Vec2d(5, 5));
+
+  EXPECT_TRUE(segment_tool.UpdateLineSegment(segments));
+  EXPECT_EQ(4, segment_tool.size());
+  EXPECT_EQ(0, segment_tool.FindNearestSegment(0.5, 1.0));
+  EXPECT_EQ(1, segment_tool.FindNearestSegment(1.5, 1.0));
+  // the lowest index on ties
+  EXPECT_EQ(0, segment_tool.FindNearestSegment(1.0, 1.0));
+
+  double distance_sqr = 0.0;
+  EXPECT_EQ(2, segment_tool.FindNearestSegment(4.0, 1.0, &distance_sqr));
+  EXPECT_DOUBLE_EQ(2.0, distance_sqr);
+  EXPECT_EQ(3, segment_tool.FindNearestSegment(5.0, 6.0, &distance_sqr));
+  EXPECT_DOUBLE_EQ(1.0, distance_sqr);
+}
+
+TEST(NearestSegment, FindNearestSegments) {
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> coordinate(-100.0, 100.0);
+  std::vector<LineSegment2d> segments;
+  for (int i = 0; i < 1000; ++i) {
+    const Vec2d start(coordinate(engine), coordinate(engine));
+    const Vec2d end(start.x() + coordinate(engine) * 0.1,
+                    start.y() + coordinate(engine) * 0.1);
+    segments.emplace_back(start, end);
+  }
+  std::vector<Vec2d> points;
+  for (int i = 0; i < 500; ++i) {
+    points.emplace_back(coordinate(engine), coordinate(engine));
+  }
+
+  NearestSegment segment_tool;
+  segment_tool.UpdateLineSegment(segments);
+  std::vector<int> indices;
+  std::vector<double> distance_sqrs;
+  segment_tool.FindNearestSegments(points, &indices, &distance_sqrs);
+  ASSERT_EQ(points.size(), indices.size());
+  ASSERT_EQ(points.size(), distance_sqrs.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    double min_distance_sqr = std::numeric_limits<double>::infinity();
+    for (const auto& segment : segments) {
+      min_distance_sqr =
+          std::min(min_distance_sqr, segment.DistanceSquareTo(points[i]));
+    }
+    EXPECT_NEAR(min_distance_sqr, distance_sqrs[i], 1e-9);
+    EXPECT_NEAR(min_distance_sqr,
+                segments[indices[i]].DistanceSquareTo(points[i]), 1e-9);
+  }
+
+  // the same results when split over threads
+  std::vector<int> parallel_indices;
+  segment_tool.FindNearestSegments(points, &parallel_indices, nullptr, 4);
+  EXPECT_EQ(indices, parallel_indices);
+
+  segment_tool.FindNearestSegments({}, &parallel_indices, nullptr, 4);
+  EXPECT_TRUE(parallel_indices.empty());
+}
+
+}  // namespace pnc_map
+}  // namespace apollo
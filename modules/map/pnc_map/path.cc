@@ -47,6 +47,28 @@ namespace {
 
 const double kSampleDistance = 0.25;
 
+// Paths of fewer segments are searched without a grid.
+constexpr int kMinGridSegments = 32;
+// The least size of the cells of the projection grid.
+constexpr double kMinGridCellSize = 0.5;
+
+// Whether two path points are the same, with the same lane waypoints.
+bool SamePathPoint(const MapPathPoint& p1, const MapPathPoint& p2) {
+  if (p1.x() != p2.x() || p1.y() != p2.y() || p1.heading() != p2.heading() ||
+      p1.lane_waypoints().size() != p2.lane_waypoints().size()) {
+    return false;
+  }
+  for (size_t i = 0; i < p1.lane_waypoints().size(); ++i) {
+    const auto& waypoint1 = p1.lane_waypoints()[i];
+    const auto& waypoint2 = p2.lane_waypoints()[i];
+    if (waypoint1.lane != waypoint2.lane || waypoint1.s != waypoint2.s ||
+        waypoint1.l != waypoint2.l) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool FindLaneSegment(const MapPathPoint& p1, const MapPathPoint& p2,
                      LaneSegment* const lane_segment) {
   for (const auto& wp1 : p1.lane_waypoints()) {
@@ -348,15 +370,39 @@ Path::Path(std::vector<MapPathPoint>&& path_points,
   }
 }
 
-void Path::Init() {
-  InitPoints();
-  InitLaneSegments();
+Path::Path(const std::vector<LaneSegment>& lane_segments,
+           const Path& previous_path)
+    : lane_segments_(lane_segments) {
+  for (const auto& segment : lane_segments_) {
+    const auto points = MapPathPoint::GetPointsFromLane(
+        segment.lane, segment.start_s, segment.end_s);
+    path_points_.insert(path_points_.end(), points.begin(), points.end());
+  }
+  MapPathPoint::RemoveDuplicates(&path_points_);
+  CHECK_GE(path_points_.size(), 2U);
+  Init(&previous_path);
+}
+
+void Path::Init(const Path* previous_path) {
+  int num_reused_points = 0;
+  if (previous_path != nullptr) {
+    const int num_points = static_cast<int>(std::min(
+        path_points_.size(), previous_path->path_points_.size()));
+    while (num_reused_points < num_points &&
+           SamePathPoint(path_points_[num_reused_points],
+                         previous_path->path_points_[num_reused_points])) {
+      ++num_reused_points;
+    }
+  }
+  InitPoints(previous_path, num_reused_points);
+  InitLaneSegments(previous_path, num_reused_points);
   InitPointIndex();
-  InitWidth();
+  InitWidth(previous_path, num_reused_points);
   InitOverlaps();
+  InitProjectionGrid();
 }
 
-void Path::InitPoints() {
+void Path::InitPoints(const Path* previous_path, const int num_reused_points) {
   num_points_ = static_cast<int>(path_points_.size());
   CHECK_GE(num_points_, 2);
 
@@ -367,7 +413,21 @@ void Path::InitPoints() {
   unit_directions_.clear();
   unit_directions_.reserve(num_points_);
   double s = 0.0;
-  for (int i = 0; i < num_points_; ++i) {
+  // the segment from a reused point to the next one is reused if the next
+  // point is reused as well
+  const int num_reused_segments = std::max(0, num_reused_points - 1);
+  if (num_reused_segments > 0) {
+    accumulated_s_.assign(
+        previous_path->accumulated_s_.begin(),
+        previous_path->accumulated_s_.begin() + num_reused_segments);
+    segments_.assign(previous_path->segments_.begin(),
+                     previous_path->segments_.begin() + num_reused_segments);
+    unit_directions_.assign(
+        previous_path->unit_directions_.begin(),
+        previous_path->unit_directions_.begin() + num_reused_segments);
+    s = previous_path->accumulated_s_[num_reused_segments];
+  }
+  for (int i = num_reused_segments; i < num_points_; ++i) {
     accumulated_s_.push_back(s);
     Vec2d heading;
     if (i + 1 >= num_points_) {
@@ -391,7 +451,8 @@ void Path::InitPoints() {
   CHECK_EQ(segments_.size(), static_cast<size_t>(num_segments_));
 }
 
-void Path::InitLaneSegments() {
+void Path::InitLaneSegments(const Path* previous_path,
+                            const int num_reused_points) {
   if (lane_segments_.empty()) {
     for (int i = 0; i + 1 < num_points_; ++i) {
       LaneSegment lane_segment;
@@ -414,7 +475,16 @@ void Path::InitLaneSegments() {
 
   lane_segments_to_next_point_.clear();
   lane_segments_to_next_point_.reserve(num_points_);
-  for (int i = 0; i + 1 < num_points_; ++i) {
+  int num_reused_segments = 0;
+  if (previous_path != nullptr && num_reused_points > 1 &&
+      !previous_path->lane_segments_to_next_point_.empty()) {
+    num_reused_segments = num_reused_points - 1;
+    lane_segments_to_next_point_.assign(
+        previous_path->lane_segments_to_next_point_.begin(),
+        previous_path->lane_segments_to_next_point_.begin() +
+            num_reused_segments);
+  }
+  for (int i = num_reused_segments; i + 1 < num_points_; ++i) {
     LaneSegment lane_segment;
     if (FindLaneSegment(path_points_[i], path_points_[i + 1], &lane_segment)) {
       lane_segments_to_next_point_.push_back(lane_segment);
@@ -426,7 +496,7 @@ void Path::InitLaneSegments() {
            static_cast<size_t>(num_segments_));
 }
 
-void Path::InitWidth() {
+void Path::InitWidth(const Path* previous_path, const int num_reused_points) {
   lane_left_width_.clear();
   lane_left_width_.reserve(num_sample_points_);
   lane_right_width_.clear();
@@ -438,7 +508,19 @@ void Path::InitWidth() {
   road_right_width_.reserve(num_sample_points_);
 
   double s = 0;
-  for (int i = 0; i < num_sample_points_; ++i) {
+  int i = 0;
+  // a sample before the last reused point only depends on reused points
+  if (previous_path != nullptr && num_reused_points > 1) {
+    const double reused_s = accumulated_s_[num_reused_points - 1];
+    for (; i < num_sample_points_ && s < reused_s; ++i) {
+      lane_left_width_.push_back(previous_path->lane_left_width_[i]);
+      lane_right_width_.push_back(previous_path->lane_right_width_[i]);
+      road_left_width_.push_back(previous_path->road_left_width_[i]);
+      road_right_width_.push_back(previous_path->road_right_width_[i]);
+      s += kSampleDistance;
+    }
+  }
+  for (; i < num_sample_points_; ++i) {
     const MapPathPoint point = GetSmoothPoint(s);
     if (point.lane_waypoints().empty()) {
       lane_left_width_.push_back(FLAGS_default_lane_width / 2.0);
@@ -492,6 +574,154 @@ void Path::InitPointIndex() {
   CHECK_EQ(last_point_index_.size(), static_cast<size_t>(num_sample_points_));
 }
 
+void Path::InitProjectionGrid() {
+  grid_num_x_ = 0;
+  grid_num_y_ = 0;
+  grid_cell_start_.clear();
+  grid_segments_.clear();
+  if (num_segments_ < kMinGridSegments) {
+    return;
+  }
+  double min_x = std::numeric_limits<double>::infinity();
+  double min_y = std::numeric_limits<double>::infinity();
+  double max_x = -std::numeric_limits<double>::infinity();
+  double max_y = -std::numeric_limits<double>::infinity();
+  for (const auto& point : path_points_) {
+    min_x = std::min(min_x, point.x());
+    min_y = std::min(min_y, point.y());
+    max_x = std::max(max_x, point.x());
+    max_y = std::max(max_y, point.y());
+  }
+  // about one segment per cell, and no more cells than three per segment
+  grid_cell_size_ = std::max(
+      {std::sqrt((max_x - min_x) * (max_y - min_y) / num_segments_),
+       std::max(max_x - min_x, max_y - min_y) / num_segments_,
+       kMinGridCellSize});
+  grid_min_x_ = min_x;
+  grid_min_y_ = min_y;
+  grid_num_x_ = static_cast<int>((max_x - min_x) / grid_cell_size_) + 1;
+  grid_num_y_ = static_cast<int>((max_y - min_y) / grid_cell_size_) + 1;
+
+  // the cells a segment overlaps, counted and then filled
+  auto for_each_cell = [this](const LineSegment2d& segment, auto&& func) {
+    const int min_cx = static_cast<int>(
+        (std::min(segment.start().x(), segment.end().x()) - grid_min_x_) /
+        grid_cell_size_);
+    const int max_cx = std::min(
+        grid_num_x_ - 1,
+        static_cast<int>(
+            (std::max(segment.start().x(), segment.end().x()) - grid_min_x_) /
+            grid_cell_size_));
+    const int min_cy = static_cast<int>(
+        (std::min(segment.start().y(), segment.end().y()) - grid_min_y_) /
+        grid_cell_size_);
+    const int max_cy = std::min(
+        grid_num_y_ - 1,
+        static_cast<int>(
+            (std::max(segment.start().y(), segment.end().y()) - grid_min_y_) /
+            grid_cell_size_));
+    for (int cy = min_cy; cy <= max_cy; ++cy) {
+      for (int cx = min_cx; cx <= max_cx; ++cx) {
+        func(cy * grid_num_x_ + cx);
+      }
+    }
+  };
+  grid_cell_start_.assign(grid_num_x_ * grid_num_y_ + 1, 0);
+  for (const auto& segment : segments_) {
+    for_each_cell(segment, [this](const int cell) {
+      ++grid_cell_start_[cell + 1];
+    });
+  }
+  for (size_t i = 1; i < grid_cell_start_.size(); ++i) {
+    grid_cell_start_[i] += grid_cell_start_[i - 1];
+  }
+  grid_segments_.resize(grid_cell_start_.back());
+  std::vector<int> cell_end(grid_cell_start_.begin(),
+                            grid_cell_start_.end() - 1);
+  for (int i = 0; i < num_segments_; ++i) {
+    for_each_cell(segments_[i], [this, i, &cell_end](const int cell) {
+      grid_segments_[cell_end[cell]++] = i;
+    });
+  }
+}
+
+int Path::GetNearestSegment(const Vec2d& point,
+                            double* const min_distance_sqr) const {
+  *min_distance_sqr = std::numeric_limits<double>::infinity();
+  int min_index = 0;
+  // the first of the nearest segments, as a search of all of them finds it
+  auto update_nearest = [&](const int index) {
+    const double distance = segments_[index].DistanceSquareTo(point);
+    if (distance < *min_distance_sqr ||
+        (distance == *min_distance_sqr && index < min_index)) {
+      min_index = index;
+      *min_distance_sqr = distance;
+    }
+  };
+  auto update_nearest_in_cell = [&](const int x, const int y) {
+    const int cell = y * grid_num_x_ + x;
+    for (int i = grid_cell_start_[cell]; i < grid_cell_start_[cell + 1]; ++i) {
+      update_nearest(grid_segments_[i]);
+    }
+  };
+  if (grid_cell_start_.empty()) {
+    for (int i = 0; i < num_segments_; ++i) {
+      update_nearest(i);
+    }
+    return min_index;
+  }
+
+  // The cells are searched ring by ring around the cell of the point, which
+  // may be out of the grid. The segments in ring r are at least r - 1 cells
+  // away from the point.
+  const double max_cell =
+      static_cast<double>(std::max(grid_num_x_, grid_num_y_) + 1);
+  const int cx = static_cast<int>(common::math::Clamp(
+      std::floor((point.x() - grid_min_x_) / grid_cell_size_), -max_cell,
+      max_cell));
+  const int cy = static_cast<int>(common::math::Clamp(
+      std::floor((point.y() - grid_min_y_) / grid_cell_size_), -max_cell,
+      max_cell));
+  const int first_ring =
+      std::max({0, -cx, cx - grid_num_x_ + 1, -cy, cy - grid_num_y_ + 1});
+  const int last_ring =
+      std::max({cx, grid_num_x_ - 1 - cx, cy, grid_num_y_ - 1 - cy});
+  int num_cells = 0;
+  for (int ring = first_ring; ring <= last_ring; ++ring) {
+    if (ring > 0 && *min_distance_sqr < Sqr((ring - 1) * grid_cell_size_)) {
+      break;
+    }
+    if (num_cells > num_segments_) {
+      // far from the path the rings have more cells than the path segments
+      for (int i = 0; i < num_segments_; ++i) {
+        update_nearest(i);
+      }
+      break;
+    }
+    const int min_x = std::max(0, cx - ring);
+    const int max_x = std::min(grid_num_x_ - 1, cx + ring);
+    const int min_y = std::max(0, cy - ring);
+    const int max_y = std::min(grid_num_y_ - 1, cy + ring);
+    for (int y = min_y; y <= max_y; ++y) {
+      if (y == cy - ring || y == cy + ring) {
+        for (int x = min_x; x <= max_x; ++x) {
+          update_nearest_in_cell(x, y);
+        }
+        num_cells += max_x - min_x + 1;
+        continue;
+      }
+      if (cx - ring >= 0) {
+        update_nearest_in_cell(cx - ring, y);
+      }
+      if (cx + ring < grid_num_x_) {
+        update_nearest_in_cell(cx + ring, y);
+      }
+      num_cells += 2;
+    }
+  }
+  return min_index;
+}
+
 void Path::GetAllOverlaps(GetOverlapFromLaneFunc GetOverlaps_from_lane,
                           std::vector<PathOverlap>* const overlaps) const {
   if (overlaps == nullptr) {
@@ -799,15 +1029,7 @@ bool Path::GetProjection(const Vec2d& point, double* accumulate_s,
                                         min_distance);
   }
   CHECK_GE(num_points_, 2);
-  *min_distance = std::numeric_limits<double>::infinity();
-  int min_index = 0;
-  for (int i = 0; i < num_segments_; ++i) {
-    const double distance = segments_[i].DistanceSquareTo(point);
-    if (distance < *min_distance) {
-      min_index = i;
-      *min_distance = distance;
-    }
-  }
+  const int min_index = GetNearestSegment(point, min_distance);
   *min_distance = std::sqrt(*min_distance);
   const auto& nearest_seg = segments_[min_index];
   const auto prod = nearest_seg.ProductOntoUnit(point);
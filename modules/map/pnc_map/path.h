@@ -230,6 +230,12 @@ class Path {
        std::vector<LaneSegment>&& lane_segments,
        const double max_approximation_error);
 
+  // Build the path of lane segments as Path(lane_segments) does, reusing the
+  // segments and the width samples of a previous path for the points both
+  // paths begin with, e.g. when the route ahead changes or is extended.
+  Path(const std::vector<LaneSegment>& lane_segments,
+       const Path& previous_path);
+
   // Return smooth coordinate by interpolated index or accumulate_s.
   MapPathPoint GetSmoothPoint(const InterpolatedIndex& index) const;
   MapPathPoint GetSmoothPoint(double s) const;
@@ -333,12 +339,21 @@ class Path {
   std::string DebugString() const;
 
  protected:
-  void Init();
-  void InitPoints();
-  void InitLaneSegments();
-  void InitWidth();
+  // The data of the first num_reused_points points, which are the same as
+  // the points of previous_path, is copied from it instead of computed.
+  void Init(const Path* previous_path = nullptr);
+  void InitPoints(const Path* previous_path, const int num_reused_points);
+  void InitLaneSegments(const Path* previous_path,
+                        const int num_reused_points);
+  void InitWidth(const Path* previous_path, const int num_reused_points);
   void InitPointIndex();
   void InitOverlaps();
+  void InitProjectionGrid();
+
+  // The index of the segment nearest to a point, the first one of the
+  // nearest segments, and its squared distance to the point.
+  int GetNearestSegment(const common::math::Vec2d& point,
+                        double* const min_distance_sqr) const;
 
   double GetSample(const std::vector<double>& samples, const double s) const;
 
@@ -369,6 +384,18 @@ class Path {
   std::vector<double> road_right_width_;
   std::vector<int> last_point_index_;
 
+  // A grid over the bounding box of the path, to find the segments near a
+  // point without going through all of them. The segments whose boxes
+  // overlap cell i are grid_segments_[grid_cell_start_[i]] to
+  // grid_segments_[grid_cell_start_[i + 1] - 1]. No grid for short paths.
+  double grid_min_x_ = 0.0;
+  double grid_min_y_ = 0.0;
+  double grid_cell_size_ = 0.0;
+  int grid_num_x_ = 0;
+  int grid_num_y_ = 0;
+  std::vector<int> grid_cell_start_;
+  std::vector<int> grid_segments_;
+
   std::vector<PathOverlap> lane_overlaps_;
   std::vector<PathOverlap> signal_overlaps_;
   std::vector<PathOverlap> yield_sign_overlaps_;
@@ -16,6 +16,8 @@
 
 #include "modules/map/pnc_map/path.h"
 
+#include <algorithm>
+#include <limits>
 #include <string>
 
 #include "absl/strings/str_cat.h"
@@ -864,5 +866,111 @@ TEST(TestSuite, lane_info) {
   EXPECT_NEAR(effective_width, 0.0, 1e-6);
 }
 
+TEST(TestSuite, hdmap_long_path_projection) {
+  std::vector<MapPathPoint> points;
+  double x = 0.0;
+  double y = 0.0;
+  double heading = 0.0;
+  for (int i = 0; i < 500; ++i) {
+    points.push_back(MakeMapPathPoint(x, y, heading));
+    heading += RandomDouble(-0.3, 0.3);
+    const double length = RandomDouble(0.5, 3.0);
+    x += length * cos(heading);
+    y += length * sin(heading);
+  }
+  const Path path(points);
+  ASSERT_EQ(path.num_segments(), 499);
+
+  for (int i = 0; i < 1000; ++i) {
+    const int index = RandomInt(0, 498);
+    const double range = (i % 2 == 0) ? 5.0 : 200.0;
+    const Vec2d point(points[index].x() + RandomDouble(-range, range),
+                      points[index].y() + RandomDouble(-range, range));
+    double min_distance = std::numeric_limits<double>::infinity();
+    for (const auto& segment : path.segments()) {
+      min_distance = std::min(min_distance, segment.DistanceTo(point));
+    }
+    double accumulate_s = 0.0;
+    double lateral = 0.0;
+    double distance = 0.0;
+    EXPECT_TRUE(
+        path.GetProjection(point, &accumulate_s, &lateral, &distance));
+    EXPECT_NEAR(distance, min_distance, 1e-6);
+    const MapPathPoint smooth_point = path.GetSmoothPoint(accumulate_s);
+    if (accumulate_s > 0.0 && accumulate_s < path.length()) {
+      EXPECT_NEAR(smooth_point.DistanceTo(point), min_distance, 1e-6);
+    }
+  }
+}
+
+TEST(TestSuite, hdmap_incremental_path) {
+  std::vector<Lane> lane_protos(4);
+  std::vector<LaneInfoConstPtr> lanes;
+  for (int i = 0; i < 4; ++i) {
+    Lane& lane = lane_protos[i];
+    lane.mutable_id()->set_id(absl::StrCat("id", i));
+    auto* segment =
+        lane.mutable_central_curve()->add_segment()->mutable_line_segment();
+    for (int j = 0; j <= 20; ++j) {
+      const double s = 20.0 * i + j;
+      *segment->add_point() = MakePoint(s, 0.02 * s * s, 0);
+    }
+    *lane.add_left_sample() = MakeSample(0.0, 1.5 + i);
+    *lane.add_left_sample() = MakeSample(10.0, 2.0 + i);
+    *lane.add_right_sample() = MakeSample(0.0, 1.0 + i);
+    *lane.add_right_sample() = MakeSample(15.0, 2.5 + i);
+    lanes.emplace_back(new LaneInfo(lane));
+  }
+  const std::vector<LaneSegment> segments = {
+      {lanes[0], 0.0, lanes[0]->total_length()},
+      {lanes[1], 0.0, lanes[1]->total_length()},
+      {lanes[2], 0.0, 8.0}};
+  const std::vector<LaneSegment> new_segments = {
+      {lanes[0], 0.0, lanes[0]->total_length()},
+      {lanes[1], 0.0, lanes[1]->total_length()},
+      {lanes[2], 0.0, lanes[2]->total_length()},
+      {lanes[3], 0.0, 12.0}};
+  const Path previous_path(segments);
+  const Path path(new_segments, previous_path);
+  const Path expected_path(new_segments);
+
+  ASSERT_EQ(path.num_points(), expected_path.num_points());
+  for (int i = 0; i < path.num_points(); ++i) {
+    EXPECT_NEAR(path.accumulated_s()[i], expected_path.accumulated_s()[i],
+                1e-9);
+    EXPECT_EQ(path.lane_segments_to_next_point()[i].lane,
+              expected_path.lane_segments_to_next_point()[i].lane);
+  }
+  ASSERT_EQ(path.lane_segments().size(), expected_path.lane_segments().size());
+  for (double s = 0.0; s < path.length(); s += 0.7) {
+    double left_width = 0.0;
+    double right_width = 0.0;
+    double expected_left_width = 0.0;
+    double expected_right_width = 0.0;
+    EXPECT_TRUE(path.GetLaneWidth(s, &left_width, &right_width));
+    EXPECT_TRUE(expected_path.GetLaneWidth(s, &expected_left_width,
+                                           &expected_right_width));
+    EXPECT_NEAR(left_width, expected_left_width, 1e-9);
+    EXPECT_NEAR(right_width, expected_right_width, 1e-9);
+  }
+  double accumulate_s = 0.0;
+  double lateral = 0.0;
+  double expected_accumulate_s = 0.0;
+  double expected_lateral = 0.0;
+  EXPECT_TRUE(path.GetProjection({50.0, 40.0}, &accumulate_s, &lateral));
+  EXPECT_TRUE(expected_path.GetProjection({50.0, 40.0}, &expected_accumulate_s,
+                                          &expected_lateral));
+  EXPECT_NEAR(accumulate_s, expected_accumulate_s, 1e-9);
+  EXPECT_NEAR(lateral, expected_lateral, 1e-9);
+
+  // a path which does not begin as the previous one is built from scratch
+  const std::vector<LaneSegment> other_segments = {
+      {lanes[1], 2.0, lanes[1]->total_length()}};
+  const Path other_path(other_segments, previous_path);
+  const Path expected_other_path(other_segments);
+  ASSERT_EQ(other_path.num_points(), expected_other_path.num_points());
+  EXPECT_NEAR(other_path.length(), expected_other_path.length(), 1e-9);
+}
+
 }  // namespace hdmap
 }  // namespace apollo
@@ -0,0 +1,61 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/log.h"
+#include "modules/map/hdmap/compiled_map.h"
+#include "modules/map/hdmap/hdmap_impl.h"
+#include "modules/map/hdmap/hdmap_util.h"
+
+/**
+ * A map tool to compile the base map to a .cmap map, which is memory mapped
+ * and loads without building its spatial indices again. Load it with e.g.
+ * --base_map_filename=base_map.cmap|base_map.bin|base_map.xml|base_map.txt
+ */
+
+DEFINE_string(output_dir, "", "output map directory, map_dir if empty");
+
+int main(int argc, char *argv[]) {
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_alsologtostderr = true;
+
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  const std::string map_filename = apollo::hdmap::BaseMapFile();
+  apollo::hdmap::HDMapImpl hdmap_impl;
+  if (hdmap_impl.LoadMapFromFile(map_filename) != 0) {
+    AERROR << "Failed to load map from " << map_filename;
+    return -1;
+  }
+  AINFO << "Loaded map from " << map_filename;
+
+  const std::string output_dir =
+      FLAGS_output_dir.empty() ? FLAGS_map_dir : FLAGS_output_dir;
+  const std::string output_file = output_dir + "/base_map" +
+                                  apollo::hdmap::kCompiledMapExtension;
+  if (hdmap_impl.SaveCompiledMap(output_file) != 0) {
+    AERROR << "Failed to generate compiled base map";
+    return -1;
+  }
+
+  apollo::hdmap::HDMapImpl compiled_hdmap_impl;
+  ACHECK(compiled_hdmap_impl.LoadMapFromFile(output_file) == 0)
+      << "Failed to load generated compiled base map";
+
+  AINFO << "Successfully compiled " << map_filename << " to " << output_file;
+
+  return 0;
+}
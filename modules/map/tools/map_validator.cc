@@ -0,0 +1,68 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+#include <fstream>
+
+#include "absl/strings/match.h"
+#include "gflags/gflags.h"
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/map/hdmap/adapter/opendrive_adapter.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/map/hdmap/map_validator.h"
+#include "modules/common_msgs/map_msgs/map.pb.h"
+
+/**
+ * A map tool to check the geometry, topology and overlaps of a map
+ */
+
+DEFINE_int32(validator_thread_num, 0,
+             "number of threads converting and checking the map, the number "
+             "of cores if 0");
+DEFINE_string(validation_report_file, "",
+              "file to write the report to, logged if empty");
+
+int main(int argc, char **argv) {
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_alsologtostderr = true;
+
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  const auto map_filename = apollo::hdmap::BaseMapFile();
+  apollo::hdmap::Map pb_map;
+  if (absl::EndsWith(map_filename, ".xml")) {
+    ACHECK(apollo::hdmap::adapter::OpendriveAdapter::LoadData(
+        map_filename, &pb_map, FLAGS_validator_thread_num))
+        << "fail to load data from : " << map_filename;
+  } else {
+    ACHECK(apollo::cyber::common::GetProtoFromFile(map_filename, &pb_map))
+        << "fail to load data from : " << map_filename;
+  }
+
+  apollo::hdmap::MapValidationReport report;
+  const bool valid = apollo::hdmap::MapValidator(FLAGS_validator_thread_num)
+                         .Validate(pb_map, &report);
+  if (FLAGS_validation_report_file.empty()) {
+    AINFO << report.DebugString();
+  } else {
+    std::ofstream report_file(FLAGS_validation_report_file);
+    ACHECK(report_file) << "fail to open " << FLAGS_validation_report_file;
+    report_file << report.DebugString();
+    AINFO << "report written to " << FLAGS_validation_report_file;
+  }
+
+  return valid ? 0 : 1;
+}
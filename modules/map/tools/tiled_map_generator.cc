@@ -0,0 +1,54 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/map/hdmap/tiled_map.h"
+
+/**
+ * A map tool to split the base map into square tiles, which are loaded by
+ * apollo::hdmap::TiledMap around the vehicle and along its route.
+ */
+
+DEFINE_string(output_dir, "", "output tile directory, map_dir/tiles if empty");
+DEFINE_double(tile_size, 500.0, "the size of the map tiles in meters");
+
+int main(int argc, char *argv[]) {
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_alsologtostderr = true;
+
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  const std::string map_filename = apollo::hdmap::BaseMapFile();
+  apollo::hdmap::Map map;
+  ACHECK(apollo::cyber::common::GetProtoFromFile(map_filename, &map))
+      << "Failed to load map from " << map_filename;
+  AINFO << "Loaded map from " << map_filename;
+
+  const std::string output_dir =
+      FLAGS_output_dir.empty() ? FLAGS_map_dir + "/tiles" : FLAGS_output_dir;
+  if (!apollo::hdmap::TiledMap::SaveTiles(map, FLAGS_tile_size, output_dir)) {
+    AERROR << "Failed to generate map tiles";
+    return -1;
+  }
+
+  AINFO << "Successfully split " << map_filename << " into tiles of "
+        << FLAGS_tile_size << " meters in " << output_dir;
+
+  return 0;
+}
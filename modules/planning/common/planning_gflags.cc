@@ -477,6 +477,9 @@ DEFINE_bool(
 
 DEFINE_bool(enable_osqp_debug, false,
             "True to turn on OSQP verbose debug output in log.");
+DEFINE_bool(enable_piecewise_jerk_osqp_workspace_reuse, false,
+            "True to keep the OSQP workspaces of the piecewise jerk path and "
+            "speed optimizers across planning cycles.");
 
 DEFINE_bool(export_chart, false, "export chart in planning");
 DEFINE_bool(enable_record_debug, true,
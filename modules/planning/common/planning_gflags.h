@@ -226,6 +226,7 @@ DECLARE_bool(use_iterative_anchoring_smoother);
 DECLARE_bool(enable_parallel_trajectory_smoothing);
 
 DECLARE_bool(enable_osqp_debug);
+DECLARE_bool(enable_piecewise_jerk_osqp_workspace_reuse);
 DECLARE_bool(export_chart);
 DECLARE_bool(enable_record_debug);
 
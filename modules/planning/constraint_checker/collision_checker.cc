@@ -105,10 +105,8 @@ bool CollisionChecker::InCollision(
                     shift_distance * std::sin(ego_theta)};
     ego_box.Shift(shift_vec);
 
-    for (const auto& obstacle_box : predicted_bounding_rectangles_[i]) {
-      if (ego_box.HasOverlap(obstacle_box)) {
-        return true;
-      }
+    if (ego_box.HasOverlap(predicted_bounding_rectangles_[i])) {
+      return true;
     }
   }
   return false;
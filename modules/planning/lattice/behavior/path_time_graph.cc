@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 
 #include "modules/common_msgs/planning_msgs/sl_boundary.pb.h"
 
@@ -36,8 +37,8 @@ namespace planning {
 using apollo::common::PathPoint;
 using apollo::common::TrajectoryPoint;
 using apollo::common::math::Box2d;
+using apollo::common::math::IndexedPathMatcher;
 using apollo::common::math::lerp;
-using apollo::common::math::PathMatcher;
 using apollo::common::math::Polygon2d;
 
 PathTimeGraph::PathTimeGraph(
@@ -60,19 +61,20 @@ PathTimeGraph::PathTimeGraph(
 
 SLBoundary PathTimeGraph::ComputeObstacleBoundary(
     const std::vector<common::math::Vec2d>& vertices,
-    const std::vector<PathPoint>& discretized_ref_points) const {
+    const IndexedPathMatcher& path_matcher) const {
   double start_s(std::numeric_limits<double>::max());
   double end_s(std::numeric_limits<double>::lowest());
   double start_l(std::numeric_limits<double>::max());
   double end_l(std::numeric_limits<double>::lowest());
 
-  for (const auto& point : vertices) {
-    auto sl_point = PathMatcher::GetPathFrenetCoordinate(discretized_ref_points,
-                                                         point.x(), point.y());
-    start_s = std::fmin(start_s, sl_point.first);
-    end_s = std::fmax(end_s, sl_point.first);
-    start_l = std::fmin(start_l, sl_point.second);
-    end_l = std::fmax(end_l, sl_point.second);
+  std::vector<double> s;
+  std::vector<double> l;
+  path_matcher.GetPathFrenetCoordinates(vertices, &s, &l);
+  for (std::size_t i = 0; i < vertices.size(); ++i) {
+    start_s = std::fmin(start_s, s[i]);
+    end_s = std::fmax(end_s, s[i]);
+    start_l = std::fmin(start_l, l[i]);
+    end_l = std::fmax(end_l, l[i]);
   }
 
   SLBoundary sl_boundary;
@@ -87,14 +89,21 @@ SLBoundary PathTimeGraph::ComputeObstacleBoundary(
 void PathTimeGraph::SetupObstacles(
     const std::vector<const Obstacle*>& obstacles,
     const std::vector<PathPoint>& discretized_ref_points) {
+  // the reference line is indexed once for the corners of all obstacles, and
+  // only when there is an obstacle to project on it
+  std::unique_ptr<IndexedPathMatcher> path_matcher;
   for (const Obstacle* obstacle : obstacles) {
     if (obstacle->IsVirtual()) {
       continue;
     }
+    if (path_matcher == nullptr) {
+      path_matcher =
+          std::make_unique<IndexedPathMatcher>(discretized_ref_points);
+    }
     if (!obstacle->HasTrajectory()) {
-      SetStaticObstacle(obstacle, discretized_ref_points);
+      SetStaticObstacle(obstacle, *path_matcher);
     } else {
-      SetDynamicObstacle(obstacle, discretized_ref_points);
+      SetDynamicObstacle(obstacle, *path_matcher);
     }
   }
 
@@ -109,13 +118,12 @@ void PathTimeGraph::SetupObstacles(
 }
 
 void PathTimeGraph::SetStaticObstacle(
-    const Obstacle* obstacle,
-    const std::vector<PathPoint>& discretized_ref_points) {
+    const Obstacle* obstacle, const IndexedPathMatcher& path_matcher) {
   const Polygon2d& polygon = obstacle->PerceptionPolygon();
 
   std::string obstacle_id = obstacle->Id();
   SLBoundary sl_boundary =
-      ComputeObstacleBoundary(polygon.GetAllVertices(), discretized_ref_points);
+      ComputeObstacleBoundary(polygon.GetAllVertices(), path_matcher);
 
   double left_width = FLAGS_default_reference_line_width * 0.5;
   double right_width = FLAGS_default_reference_line_width * 0.5;
@@ -147,14 +155,13 @@ void PathTimeGraph::SetStaticObstacle(
 }
 
 void PathTimeGraph::SetDynamicObstacle(
-    const Obstacle* obstacle,
-    const std::vector<PathPoint>& discretized_ref_points) {
+    const Obstacle* obstacle, const IndexedPathMatcher& path_matcher) {
   double relative_time = time_range_.first;
   while (relative_time < time_range_.second) {
     TrajectoryPoint point = obstacle->GetPointAtTime(relative_time);
     Box2d box = obstacle->GetBoundingBox(point);
     SLBoundary sl_boundary =
-        ComputeObstacleBoundary(box.GetAllCorners(), discretized_ref_points);
+        ComputeObstacleBoundary(box.GetAllCorners(), path_matcher);
 
     double left_width = FLAGS_default_reference_line_width * 0.5;
     double right_width = FLAGS_default_reference_line_width * 0.5;
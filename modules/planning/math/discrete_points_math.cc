@@ -23,6 +23,7 @@
 #include <cmath>
 
 #include "cyber/common/log.h"
+#include "modules/common/math/batch_math.h"
 
 namespace apollo {
 namespace planning {
@@ -69,9 +70,7 @@ bool DiscretePointsMath::ComputePathProfile(
   }
 
   // Heading calculation
-  for (std::size_t i = 0; i < points_size; ++i) {
-    headings->push_back(std::atan2(dys[i], dxs[i]));
-  }
+  common::math::Atan2(dys, dxs, headings);
 
   // Get linear interpolated s for dkappa calculation
   double distance = 0.0;
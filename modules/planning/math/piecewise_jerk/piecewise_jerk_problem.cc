@@ -88,6 +88,9 @@ OSQPData* PiecewiseJerkProblem::FormulateProblem() {
 }
 
 bool PiecewiseJerkProblem::Optimize(const int max_iter) {
+  if (solver_ != nullptr) {
+    return OptimizeWithSolver(max_iter);
+  }
   OSQPData* data = FormulateProblem();
 
   OSQPSettings* settings = SolverDefaultSettings();
@@ -133,6 +136,47 @@ bool PiecewiseJerkProblem::Optimize(const int max_iter) {
   return true;
 }
 
+bool PiecewiseJerkProblem::OptimizeWithSolver(const int max_iter) {
+  std::vector<c_float> P_data;
+  std::vector<c_int> P_indices;
+  std::vector<c_int> P_indptr;
+  std::vector<c_float> q;
+  std::vector<c_float> A_data;
+  std::vector<c_int> A_indices;
+  std::vector<c_int> A_indptr;
+  std::vector<c_float> lower_bounds;
+  std::vector<c_float> upper_bounds;
+  CalculateKernel(&P_data, &P_indices, &P_indptr);
+  CalculateAffineConstraint(&A_data, &A_indices, &A_indptr, &lower_bounds,
+                            &upper_bounds);
+  CalculateOffset(&q);
+
+  OSQPSettings* settings = SolverDefaultSettings();
+  settings->max_iter = max_iter;
+  // with warm_start set, an updated workspace starts from the last solution
+  // as it is. It is not shifted in time: the knots of a new cycle start at a
+  // new init state and are not aligned with the knots of the last one.
+  const bool setup =
+      solver_->Setup(P_data, P_indices, P_indptr, q, A_data, A_indices,
+                     A_indptr, lower_bounds, upper_bounds, *settings);
+  c_free(settings);
+  if (!setup || !solver_->Solve()) {
+    return false;
+  }
+
+  // extract primal results
+  const c_float* solution = solver_->x();
+  x_.resize(num_of_knots_);
+  dx_.resize(num_of_knots_);
+  ddx_.resize(num_of_knots_);
+  for (size_t i = 0; i < num_of_knots_; ++i) {
+    x_.at(i) = solution[i] / scale_factor_[0];
+    dx_.at(i) = solution[i + num_of_knots_] / scale_factor_[1];
+    ddx_.at(i) = solution[i + 2 * num_of_knots_] / scale_factor_[2];
+  }
+  return true;
+}
+
 void PiecewiseJerkProblem::CalculateAffineConstraint(
     std::vector<c_float>* A_data, std::vector<c_int>* A_indices,
     std::vector<c_int>* A_indptr, std::vector<c_float>* lower_bounds,
@@ -20,10 +20,12 @@
 
 #pragma once
 
+#include <array>
 #include <tuple>
 #include <utility>
 #include <vector>
 
+#include "modules/common/math/osqp_solver.h"
 #include "osqp/osqp.h"
 
 namespace apollo {
@@ -110,6 +112,14 @@ class PiecewiseJerkProblem {
 
   virtual bool Optimize(const int max_iter = 4000);
 
+  /**
+   * @brief Optimizes with a solver kept by the caller across planning cycles.
+   * A problem of the same size as the last one of the solver is updated in
+   * its workspace and, through OSQP's warm_start, starts from the last
+   * solution as it is, without any shift in time.
+   */
+  void set_solver(common::math::OsqpSolver* solver) { solver_ = solver; }
+
   const std::vector<double>& opt_x() const { return x_; }
 
   const std::vector<double>& opt_dx() const { return dx_; }
@@ -134,6 +144,8 @@ class PiecewiseJerkProblem {
 
   OSQPData* FormulateProblem();
 
+  bool OptimizeWithSolver(const int max_iter);
+
   void FreeData(OSQPData* data);
 
   template <typename T>
@@ -175,6 +187,8 @@ class PiecewiseJerkProblem {
   bool has_end_state_ref_ = false;
   std::array<double, 3> weight_end_state_ = {{0.0, 0.0, 0.0}};
   std::array<double, 3> end_state_ref_;
+
+  common::math::OsqpSolver* solver_ = nullptr;
 };
 
 }  // namespace planning
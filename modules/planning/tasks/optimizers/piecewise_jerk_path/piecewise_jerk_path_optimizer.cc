@@ -245,6 +245,9 @@ bool PiecewiseJerkPathOptimizer::OptimizePath(
   const size_t kNumKnots = lat_boundaries.size();
   PiecewiseJerkPathProblem piecewise_jerk_problem(kNumKnots, delta_s,
                                                   init_state.second);
+  if (FLAGS_enable_piecewise_jerk_osqp_workspace_reuse) {
+    piecewise_jerk_problem.set_solver(&solver_);
+  }
 
   // TODO(Hongyi): update end_state settings
   piecewise_jerk_problem.set_end_state_ref({1000.0, 0.0, 0.0}, end_state);
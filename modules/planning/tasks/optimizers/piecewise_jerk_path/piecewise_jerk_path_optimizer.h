@@ -24,6 +24,7 @@
 #include <utility>
 #include <vector>
 
+#include "modules/common/math/osqp_solver.h"
 #include "modules/planning/tasks/optimizers/path_optimizer.h"
 
 namespace apollo {
@@ -93,6 +94,10 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
 
   double GaussianWeighting(const double x, const double peak_weighting,
                            const double peak_weighting_x) const;
+
+  // osqp workspace of the last path optimized, reused by the next one of the
+  // same size
+  common::math::OsqpSolver solver_;
 };
 
 }  // namespace planning
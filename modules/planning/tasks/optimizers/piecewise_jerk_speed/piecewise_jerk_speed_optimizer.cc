@@ -77,6 +77,9 @@ Status PiecewiseJerkSpeedOptimizer::Process(const PathData& path_data,
 
   PiecewiseJerkSpeedProblem piecewise_jerk_problem(num_of_knots, delta_t,
                                                    init_s);
+  if (FLAGS_enable_piecewise_jerk_osqp_workspace_reuse) {
+    piecewise_jerk_problem.set_solver(&solver_);
+  }
 
   const auto& config = config_.piecewise_jerk_speed_optimizer_config();
   piecewise_jerk_problem.set_weight_ddx(config.acc_weight());
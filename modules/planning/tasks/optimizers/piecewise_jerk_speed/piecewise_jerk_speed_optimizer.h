@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include "modules/common/math/osqp_solver.h"
 #include "modules/planning/tasks/optimizers/speed_optimizer.h"
 
 namespace apollo {
@@ -35,6 +36,9 @@ class PiecewiseJerkSpeedOptimizer : public SpeedOptimizer {
   common::Status Process(const PathData& path_data,
                          const common::TrajectoryPoint& init_point,
                          SpeedData* const speed_data) override;
+
+  // osqp workspace of the last planning cycle
+  common::math::OsqpSolver solver_;
 };
 
 }  // namespace planning
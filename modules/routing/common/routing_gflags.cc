@@ -32,3 +32,31 @@ DEFINE_bool(enable_change_lane_in_result, true,
 
 DEFINE_uint32(routing_response_history_interval_ms, 1000,
               "ms, emit routing resposne for this time interval");
+
+DEFINE_string(routing_strategy, "a_star",
+              "the search of the routes, a_star or landmark, which is guided "
+              "by the landmarks of the topology graph");
+
+DEFINE_int32(routing_cache_capacity, 32,
+             "the number of responses kept for the requests repeated with "
+             "the same waypoints and black lists, 0 for none");
+
+DEFINE_bool(enable_incremental_rerouting, true,
+            "a request to the same destination from a point on the last "
+            "route follows the rest of it instead of searching again");
+
+DEFINE_int32(routing_landmark_num, 8,
+             "the number of landmarks topo_creator adds to the topology "
+             "graph, 0 for none");
+
+DEFINE_int32(routing_topo_creator_thread_num, 0,
+             "the number of threads topo_creator creates the topology graph "
+             "on, 0 for the number of cores");
+
+DEFINE_string(routing_previous_topo_file, "",
+              "the topology graph of the map before a patch, of which "
+              "topo_creator keeps the nodes of the lanes not patched");
+
+DEFINE_string(routing_patched_lane_ids, "",
+              "the comma separated ids of the lanes changed by the patch of "
+              "the map since routing_previous_topo_file");
@@ -24,3 +24,12 @@ DECLARE_string(routing_node_name);
 DECLARE_double(min_length_for_lane_change);
 DECLARE_bool(enable_change_lane_in_result);
 DECLARE_uint32(routing_response_history_interval_ms);
+
+DECLARE_string(routing_strategy);
+DECLARE_int32(routing_cache_capacity);
+DECLARE_bool(enable_incremental_rerouting);
+DECLARE_int32(routing_landmark_num);
+
+DECLARE_int32(routing_topo_creator_thread_num);
+DECLARE_string(routing_previous_topo_file);
+DECLARE_string(routing_patched_lane_ids);
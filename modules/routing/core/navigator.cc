@@ -20,6 +20,7 @@
 #include "modules/routing/common/routing_gflags.h"
 #include "modules/routing/graph/sub_topo_graph.h"
 #include "modules/routing/strategy/a_star_strategy.h"
+#include "modules/routing/strategy/landmark_strategy.h"
 
 namespace apollo {
 namespace routing {
@@ -81,6 +82,31 @@ void SetErrorCode(const common::ErrorCode& error_code_id,
   }
 }
 
+// the key of the waypoints of a request from first_waypoint on and its black
+// lists, which determine the route
+std::string GetRouteKey(const RoutingRequest& request,
+                        const int first_waypoint) {
+  std::string key;
+  const auto append_s = [&key](const double s) {
+    key.append(reinterpret_cast<const char*>(&s), sizeof(s));
+  };
+  for (int i = first_waypoint; i < request.waypoint_size(); ++i) {
+    key.append(request.waypoint(i).id()).push_back('\0');
+    append_s(request.waypoint(i).s());
+  }
+  key.push_back('\1');
+  for (const auto& lane : request.blacklisted_lane()) {
+    key.append(lane.id()).push_back('\0');
+    append_s(lane.start_s());
+    append_s(lane.end_s());
+  }
+  key.push_back('\1');
+  for (const auto& road : request.blacklisted_road()) {
+    key.append(road).push_back('\0');
+  }
+  return key;
+}
+
 void PrintDebugData(const std::vector<NodeWithRange>& nodes) {
   AINFO << "Route lane id\tis virtual\tstart s\tend s";
   for (const auto& node : nodes) {
@@ -107,6 +133,18 @@ Navigator::Navigator(const std::string& topo_file_path) {
   }
   black_list_generator_.reset(new BlackListRangeGenerator);
   result_generator_.reset(new ResultGenerator);
+  if (FLAGS_routing_cache_capacity > 0) {
+    response_cache_.reset(new common::util::ConcurrentCache<
+                          std::string, std::shared_ptr<const RoutingResponse>>(
+        FLAGS_routing_cache_capacity));
+  }
+  if (FLAGS_routing_strategy == "landmark") {
+    AINFO << "Search routes with " << graph_->Landmarks().LandmarkNum()
+          << " landmarks.";
+    strategy_.reset(new LandmarkStrategy(FLAGS_enable_change_lane_in_result));
+  } else {
+    strategy_.reset(new AStarStrategy(FLAGS_enable_change_lane_in_result));
+  }
   is_ready_ = true;
   AINFO << "The navigator is ready.";
 }
@@ -148,13 +186,35 @@ bool Navigator::MergeRoute(
   return true;
 }
 
+bool Navigator::ReuseLastRoute(
+    const TopoNode* start_node, const double start_s,
+    std::vector<NodeWithRange>* const result_nodes) const {
+  for (size_t i = 0; i < last_route_.size(); ++i) {
+    const auto& node = last_route_[i];
+    if (node.GetTopoNode() != start_node || start_s < node.StartS() ||
+        start_s > node.EndS()) {
+      continue;
+    }
+    // the lane change out of the start node needs room
+    if (i + 1 < last_route_.size()) {
+      const auto* edge =
+          start_node->GetOutEdgeTo(last_route_[i + 1].GetTopoNode());
+      if (edge != nullptr && edge->Type() != TopoEdgeType::TET_FORWARD &&
+          node.EndS() - start_s < FLAGS_min_length_for_lane_change) {
+        return false;
+      }
+    }
+    result_nodes->assign(last_route_.begin() + i, last_route_.end());
+    result_nodes->front().SetStartS(start_s);
+    return true;
+  }
+  return false;
+}
+
 bool Navigator::SearchRouteByStrategy(
     const TopoGraph* graph, const std::vector<const TopoNode*>& way_nodes,
     const std::vector<double>& way_s,
-    std::vector<NodeWithRange>* const result_nodes) const {
-  std::unique_ptr<Strategy> strategy_ptr;
-  strategy_ptr.reset(new AStarStrategy(FLAGS_enable_change_lane_in_result));
-
+    std::vector<NodeWithRange>* const result_nodes) {
   result_nodes->clear();
   std::vector<NodeWithRange> node_vec;
   for (size_t i = 1; i < way_nodes.size(); ++i) {
@@ -182,8 +242,8 @@ bool Navigator::SearchRouteByStrategy(
     }
 
     std::vector<NodeWithRange> cur_result_nodes;
-    if (!strategy_ptr->Search(graph, &sub_graph, start, end,
-                              &cur_result_nodes)) {
+    if (!strategy_->Search(graph, &sub_graph, start, end,
+                           &cur_result_nodes)) {
       AERROR << "Failed to search route with waypoint from " << start->LaneId()
              << " to " << end->LaneId();
       return false;
@@ -214,6 +274,16 @@ bool Navigator::SearchRoute(const RoutingRequest& request,
                  response->mutable_status());
     return false;
   }
+  const std::string request_key = GetRouteKey(request, 0);
+  std::shared_ptr<const RoutingResponse> cached_response;
+  if (response_cache_ != nullptr &&
+      response_cache_->Get(request_key, &cached_response)) {
+    response->CopyFrom(*cached_response);
+    response->mutable_routing_request()->CopyFrom(request);
+    AINFO << "Reused the response of the same request.";
+    return true;
+  }
+
   std::vector<const TopoNode*> way_nodes;
   std::vector<double> way_s;
   if (!Init(request, graph_.get(), &way_nodes, &way_s)) {
@@ -223,19 +293,38 @@ bool Navigator::SearchRoute(const RoutingRequest& request,
   }
 
   std::vector<NodeWithRange> result_nodes;
-  if (!SearchRouteByStrategy(graph_.get(), way_nodes, way_s, &result_nodes)) {
-    SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE,
-                 "Failed to find route with request!",
-                 response->mutable_status());
-    return false;
-  }
-  if (result_nodes.empty()) {
-    SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE, "Failed to result nodes!",
-                 response->mutable_status());
-    return false;
+  // a reroute to the same destination from a point on the last route follows
+  // the rest of it
+  const std::string route_key = GetRouteKey(request, 1);
+  const bool is_reroute = FLAGS_enable_incremental_rerouting &&
+                          request.waypoint_size() == 2 &&
+                          route_key == last_route_key_ &&
+                          ReuseLastRoute(way_nodes.front(), way_s.front(),
+                                         &result_nodes);
+  if (is_reroute) {
+    AINFO << "Reused the last route from lane " << way_nodes.front()->LaneId();
+  } else {
+    last_route_key_.clear();
+    last_route_.clear();
+    if (!SearchRouteByStrategy(graph_.get(), way_nodes, way_s,
+                               &result_nodes)) {
+      SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE,
+                   "Failed to find route with request!",
+                   response->mutable_status());
+      return false;
+    }
+    if (result_nodes.empty()) {
+      SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE,
+                   "Failed to result nodes!", response->mutable_status());
+      return false;
+    }
+    result_nodes.front().SetStartS(request.waypoint().begin()->s());
+    result_nodes.back().SetEndS(request.waypoint().rbegin()->s());
+    if (request.waypoint_size() == 2) {
+      last_route_key_ = route_key;
+      last_route_ = result_nodes;
+    }
   }
-  result_nodes.front().SetStartS(request.waypoint().begin()->s());
-  result_nodes.back().SetEndS(request.waypoint().rbegin()->s());
 
   if (!result_generator_->GeneratePassageRegion(
           graph_->MapVersion(), request, result_nodes, topo_range_manager_,
@@ -246,6 +335,10 @@ bool Navigator::SearchRoute(const RoutingRequest& request,
     return false;
   }
   SetErrorCode(ErrorCode::OK, "Success!", response->mutable_status());
+  if (response_cache_ != nullptr) {
+    response_cache_->Put(request_key,
+                         std::make_shared<const RoutingResponse>(*response));
+  }
 
   PrintDebugData(result_nodes);
   return true;
@@ -20,8 +20,10 @@
 #include <string>
 #include <vector>
 
+#include "modules/common/util/concurrent_cache.h"
 #include "modules/routing/core/black_list_range_generator.h"
 #include "modules/routing/core/result_generator.h"
+#include "modules/routing/strategy/strategy.h"
 
 namespace apollo {
 namespace routing {
@@ -46,11 +48,16 @@ class Navigator {
   bool SearchRouteByStrategy(
       const TopoGraph* graph, const std::vector<const TopoNode*>& way_nodes,
       const std::vector<double>& way_s,
-      std::vector<NodeWithRange>* const result_nodes) const;
+      std::vector<NodeWithRange>* const result_nodes);
 
   bool MergeRoute(const std::vector<NodeWithRange>& node_vec,
                   std::vector<NodeWithRange>* const result_node_vec) const;
 
+  // The part of the last route from a point on it, if it stays a route from
+  // there, for a request to the same destination.
+  bool ReuseLastRoute(const TopoNode* start_node, double start_s,
+                      std::vector<NodeWithRange>* const result_nodes) const;
+
  private:
   bool is_ready_ = false;
   std::unique_ptr<TopoGraph> graph_;
@@ -59,6 +66,16 @@ class Navigator {
 
   std::unique_ptr<BlackListRangeGenerator> black_list_generator_;
   std::unique_ptr<ResultGenerator> result_generator_;
+  std::unique_ptr<Strategy> strategy_;
+
+  // the responses of the latest requests, by their waypoints and black lists
+  std::unique_ptr<common::util::ConcurrentCache<
+      std::string, std::shared_ptr<const RoutingResponse>>>
+      response_cache_;
+  // the last route of two waypoints, and the key of its end waypoint and
+  // black lists
+  std::string last_route_key_;
+  std::vector<NodeWithRange> last_route_;
 };
 
 }  // namespace routing
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/core/navigator.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "cyber/common/file.h"
+#include "modules/routing/common/routing_gflags.h"
+#include "modules/routing/graph/topo_test_utils.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+RoutingRequest GetRequest(const std::string& start_id, const double start_s,
+                          const std::string& end_id, const double end_s) {
+  RoutingRequest request;
+  auto* start = request.add_waypoint();
+  start->set_id(start_id);
+  start->set_s(start_s);
+  auto* end = request.add_waypoint();
+  end->set_id(end_id);
+  end->set_s(end_s);
+  return request;
+}
+
+class NavigatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Graph graph;
+    GetGraph3ForTest(&graph);
+    topo_file_ = ::testing::TempDir() + "navigator_test_graph.bin";
+    ASSERT_TRUE(cyber::common::SetProtoToBinaryFile(graph, topo_file_));
+  }
+
+  std::string topo_file_;
+};
+
+}  // namespace
+
+TEST_F(NavigatorTest, ResponseCache) {
+  Navigator navigator(topo_file_);
+  ASSERT_TRUE(navigator.IsReady());
+  RoutingRequest request = GetRequest(TEST_L1, 10.0, TEST_L5, 90.0);
+  RoutingResponse response;
+  ASSERT_TRUE(navigator.SearchRoute(request, &response));
+
+  // the cached response, for the new request
+  request.mutable_header()->set_sequence_num(1);
+  RoutingResponse cached_response;
+  ASSERT_TRUE(navigator.SearchRoute(request, &cached_response));
+  EXPECT_EQ(1, cached_response.routing_request().header().sequence_num());
+  cached_response.mutable_routing_request()->clear_header();
+  EXPECT_EQ(response.SerializeAsString(), cached_response.SerializeAsString());
+}
+
+TEST_F(NavigatorTest, IncrementalRerouting) {
+  FLAGS_routing_cache_capacity = 0;
+  Navigator navigator(topo_file_);
+  ASSERT_TRUE(navigator.IsReady());
+  RoutingResponse response;
+  ASSERT_TRUE(navigator.SearchRoute(GetRequest(TEST_L1, 10.0, TEST_L5, 90.0),
+                                    &response));
+
+  const RoutingRequest reroute = GetRequest(TEST_L3, 50.0, TEST_L5, 90.0);
+  RoutingResponse rerouted_response;
+  ASSERT_TRUE(navigator.SearchRoute(reroute, &rerouted_response));
+
+  // the same route as searched again
+  FLAGS_enable_incremental_rerouting = false;
+  Navigator searching_navigator(topo_file_);
+  RoutingResponse searched_response;
+  ASSERT_TRUE(searching_navigator.SearchRoute(reroute, &searched_response));
+  EXPECT_EQ(searched_response.SerializeAsString(),
+            rerouted_response.SerializeAsString());
+  FLAGS_enable_incremental_rerouting = true;
+  FLAGS_routing_cache_capacity = 32;
+}
+
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,219 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/graph/landmark_table.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace routing {
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+// The edges of a graph by node index, out_edges of node i are
+// [out_begin[i], out_begin[i + 1]).
+struct Adjacency {
+  std::vector<int> out_begin;
+  std::vector<std::pair<int, double>> out_edges;
+};
+
+void BuildAdjacency(const Graph& graph, const bool reverse,
+                    Adjacency* const adjacency) {
+  std::unordered_map<std::string, int> node_index_map;
+  for (int i = 0; i < graph.node_size(); ++i) {
+    node_index_map[graph.node(i).lane_id()] = i;
+  }
+  std::vector<std::pair<int, std::pair<int, double>>> edges;
+  for (const auto& edge : graph.edge()) {
+    const auto from_iter = node_index_map.find(edge.from_lane_id());
+    const auto to_iter = node_index_map.find(edge.to_lane_id());
+    if (from_iter == node_index_map.end() || to_iter == node_index_map.end()) {
+      continue;
+    }
+    const double cost = LandmarkEdgeCost(
+        edge.cost(), graph.node(from_iter->second).cost(),
+        graph.node(to_iter->second).cost(),
+        edge.direction_type() == Edge::FORWARD);
+    if (reverse) {
+      edges.emplace_back(to_iter->second,
+                         std::make_pair(from_iter->second, cost));
+    } else {
+      edges.emplace_back(from_iter->second,
+                         std::make_pair(to_iter->second, cost));
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  adjacency->out_begin.assign(graph.node_size() + 1, 0);
+  adjacency->out_edges.clear();
+  for (const auto& edge : edges) {
+    ++adjacency->out_begin[edge.first + 1];
+    adjacency->out_edges.push_back(edge.second);
+  }
+  for (int i = 0; i < graph.node_size(); ++i) {
+    adjacency->out_begin[i + 1] += adjacency->out_begin[i];
+  }
+}
+
+void Dijkstra(const Adjacency& adjacency, const int source,
+              std::vector<double>* const costs) {
+  using QueueEntry = std::pair<double, int>;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+                      std::greater<QueueEntry>>
+      open_set;
+  costs->assign(adjacency.out_begin.size() - 1, kInfinity);
+  (*costs)[source] = 0.0;
+  open_set.emplace(0.0, source);
+  while (!open_set.empty()) {
+    const auto entry = open_set.top();
+    open_set.pop();
+    if (entry.first > (*costs)[entry.second]) {
+      continue;
+    }
+    for (int i = adjacency.out_begin[entry.second];
+         i < adjacency.out_begin[entry.second + 1]; ++i) {
+      const auto& edge = adjacency.out_edges[i];
+      const double cost = entry.first + edge.second;
+      if (cost < (*costs)[edge.first]) {
+        (*costs)[edge.first] = cost;
+        open_set.emplace(cost, edge.first);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void LandmarkTable::CreateLandmarks(const int landmark_num,
+                                    Graph* const graph) {
+  graph->clear_landmark();
+  const int node_num = graph->node_size();
+  if (landmark_num <= 0 || node_num == 0) {
+    return;
+  }
+  Adjacency forward;
+  Adjacency backward;
+  BuildAdjacency(*graph, false, &forward);
+  BuildAdjacency(*graph, true, &backward);
+
+  // Each landmark is the node farthest from the former ones, by the cost of
+  // the routes there and back, which prefers unreachable nodes. The first one
+  // is the node farthest from node 0.
+  std::vector<double> cost_from;
+  std::vector<double> cost_to;
+  std::vector<double> separation(node_num, 0.0);
+  int landmark = 0;
+  for (int k = 0; k <= landmark_num; ++k) {
+    Dijkstra(forward, landmark, &cost_from);
+    Dijkstra(backward, landmark, &cost_to);
+    if (k > 0) {
+      auto* pb_landmark = graph->add_landmark();
+      pb_landmark->set_node_index(landmark);
+      for (int i = 0; i < node_num; ++i) {
+        pb_landmark->add_cost_from(std::isinf(cost_from[i]) ? -1.0
+                                                            : cost_from[i]);
+        pb_landmark->add_cost_to(std::isinf(cost_to[i]) ? -1.0 : cost_to[i]);
+        separation[i] = std::min(separation[i], cost_from[i] + cost_to[i]);
+      }
+    } else {
+      for (int i = 0; i < node_num; ++i) {
+        separation[i] = cost_from[i] + cost_to[i];
+      }
+    }
+    separation[landmark] = -1.0;
+    landmark = static_cast<int>(
+        std::max_element(separation.begin(), separation.end()) -
+        separation.begin());
+    if (separation[landmark] < 0.0) {
+      break;
+    }
+    if (k == 0) {
+      // node 0 is not a landmark
+      std::fill(separation.begin(), separation.end(), kInfinity);
+    }
+  }
+  AINFO << "Created " << graph->landmark_size() << " landmarks for "
+        << node_num << " nodes.";
+}
+
+bool LandmarkTable::Load(const Graph& graph) {
+  Clear();
+  const int node_num = graph.node_size();
+  for (const auto& landmark : graph.landmark()) {
+    if (landmark.cost_from_size() != node_num ||
+        landmark.cost_to_size() != node_num) {
+      AERROR << "Landmark " << landmark.node_index() << " has costs of "
+             << landmark.cost_from_size() << " nodes, expected " << node_num;
+      Clear();
+      return false;
+    }
+  }
+  landmark_num_ = graph.landmark_size();
+  cost_from_.resize(static_cast<size_t>(node_num) * landmark_num_);
+  cost_to_.resize(static_cast<size_t>(node_num) * landmark_num_);
+  for (int k = 0; k < landmark_num_; ++k) {
+    const auto& landmark = graph.landmark(k);
+    for (int i = 0; i < node_num; ++i) {
+      const double cost_from = landmark.cost_from(i);
+      const double cost_to = landmark.cost_to(i);
+      cost_from_[i * landmark_num_ + k] = cost_from < 0.0 ? kInfinity
+                                                          : cost_from;
+      cost_to_[i * landmark_num_ + k] = cost_to < 0.0 ? kInfinity : cost_to;
+    }
+  }
+  return true;
+}
+
+void LandmarkTable::Clear() {
+  landmark_num_ = 0;
+  cost_from_.clear();
+  cost_to_.clear();
+}
+
+double LandmarkTable::LowerBound(const int from_index,
+                                 const int to_index) const {
+  if (landmark_num_ == 0 || from_index < 0 || to_index < 0) {
+    return 0.0;
+  }
+  const double* from_cost_from = &cost_from_[from_index * landmark_num_];
+  const double* from_cost_to = &cost_to_[from_index * landmark_num_];
+  const double* to_cost_from = &cost_from_[to_index * landmark_num_];
+  const double* to_cost_to = &cost_to_[to_index * landmark_num_];
+  double lower_bound = 0.0;
+  for (int k = 0; k < landmark_num_; ++k) {
+    // cost(landmark, to) <= cost(landmark, from) + cost(from, to)
+    if (!std::isinf(to_cost_from[k]) && !std::isinf(from_cost_from[k])) {
+      lower_bound = std::max(lower_bound, to_cost_from[k] - from_cost_from[k]);
+    }
+    // cost(from, landmark) <= cost(from, to) + cost(to, landmark)
+    if (!std::isinf(from_cost_to[k]) && !std::isinf(to_cost_to[k])) {
+      lower_bound = std::max(lower_bound, from_cost_to[k] - to_cost_to[k]);
+    }
+  }
+  return lower_bound;
+}
+
+}  // namespace routing
+}  // namespace apollo
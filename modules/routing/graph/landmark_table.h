@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "modules/routing/proto/topo_graph.pb.h"
+
+namespace apollo {
+namespace routing {
+
+// The cost of an edge between lanes of the landmarks: the cost the search
+// adds for the edge, plus half of the cost of its from node and minus half
+// of the cost of its to node. It differs from the cost of the search by the
+// same amount for all the routes between two nodes and, unlike it, is never
+// negative for lane changes.
+inline double LandmarkEdgeCost(const double edge_cost,
+                               const double from_node_cost,
+                               const double to_node_cost,
+                               const bool is_forward) {
+  return is_forward ? edge_cost + 0.5 * (from_node_cost + to_node_cost)
+                    : edge_cost;
+}
+
+// The costs of the routes from and to a few landmark nodes, of which the
+// triangle inequality bounds the cost of the route between any two nodes
+// from below (ALT).
+class LandmarkTable {
+ public:
+  // Select landmark_num landmarks far from each other and add their costs to
+  // the graph, replacing its former ones.
+  static void CreateLandmarks(const int landmark_num, Graph* const graph);
+
+  // Load the landmarks of a graph, false if they do not match its nodes.
+  bool Load(const Graph& graph);
+
+  void Clear();
+
+  int LandmarkNum() const { return landmark_num_; }
+
+  // A lower bound of the landmark cost of the routes between the nodes of
+  // the given indices, 0 without landmarks.
+  double LowerBound(const int from_index, const int to_index) const;
+
+ private:
+  int landmark_num_ = 0;
+  // the costs from and to the landmarks, landmark_num_ for each node,
+  // infinity if there is no route
+  std::vector<double> cost_from_;
+  std::vector<double> cost_to_;
+};
+
+}  // namespace routing
+}  // namespace apollo
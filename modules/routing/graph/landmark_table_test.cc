@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/graph/landmark_table.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/routing/graph/topo_graph.h"
+#include "modules/routing/graph/topo_test_utils.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+// the landmark costs between all the nodes, by Floyd-Warshall
+std::vector<std::vector<double>> GetCosts(const Graph& graph) {
+  const int node_num = graph.node_size();
+  std::vector<std::vector<double>> costs(
+      node_num,
+      std::vector<double>(node_num, std::numeric_limits<double>::infinity()));
+  for (int i = 0; i < node_num; ++i) {
+    costs[i][i] = 0.0;
+  }
+  const auto index = [&graph](const std::string& lane_id) {
+    for (int i = 0; i < graph.node_size(); ++i) {
+      if (graph.node(i).lane_id() == lane_id) {
+        return i;
+      }
+    }
+    return -1;
+  };
+  for (const auto& edge : graph.edge()) {
+    const int from = index(edge.from_lane_id());
+    const int to = index(edge.to_lane_id());
+    costs[from][to] = std::min(
+        costs[from][to],
+        LandmarkEdgeCost(edge.cost(), graph.node(from).cost(),
+                         graph.node(to).cost(),
+                         edge.direction_type() == Edge::FORWARD));
+  }
+  for (int k = 0; k < node_num; ++k) {
+    for (int i = 0; i < node_num; ++i) {
+      for (int j = 0; j < node_num; ++j) {
+        costs[i][j] = std::min(costs[i][j], costs[i][k] + costs[k][j]);
+      }
+    }
+  }
+  return costs;
+}
+
+}  // namespace
+
+TEST(LandmarkTableTestSuit, lower_bound) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  LandmarkTable::CreateLandmarks(3, &graph);
+  ASSERT_EQ(3, graph.landmark_size());
+
+  LandmarkTable landmarks;
+  ASSERT_TRUE(landmarks.Load(graph));
+  ASSERT_EQ(3, landmarks.LandmarkNum());
+
+  const auto costs = GetCosts(graph);
+  for (int i = 0; i < graph.node_size(); ++i) {
+    for (int j = 0; j < graph.node_size(); ++j) {
+      const double lower_bound = landmarks.LowerBound(i, j);
+      EXPECT_GE(lower_bound, 0.0);
+      EXPECT_LE(lower_bound, costs[i][j] + 1e-9);
+    }
+    EXPECT_DOUBLE_EQ(0.0, landmarks.LowerBound(i, i));
+  }
+  // the bounds from the landmarks are exact
+  for (const auto& landmark : graph.landmark()) {
+    for (int j = 0; j < graph.node_size(); ++j) {
+      if (!std::isinf(costs[landmark.node_index()][j])) {
+        EXPECT_DOUBLE_EQ(costs[landmark.node_index()][j],
+                         landmarks.LowerBound(landmark.node_index(), j));
+      }
+    }
+  }
+  EXPECT_DOUBLE_EQ(0.0, landmarks.LowerBound(-1, 0));
+}
+
+TEST(LandmarkTableTestSuit, mismatched_landmarks) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  LandmarkTable::CreateLandmarks(2, &graph);
+  graph.mutable_landmark(1)->mutable_cost_to()->RemoveLast();
+
+  LandmarkTable landmarks;
+  EXPECT_FALSE(landmarks.Load(graph));
+  EXPECT_EQ(0, landmarks.LandmarkNum());
+  EXPECT_DOUBLE_EQ(0.0, landmarks.LowerBound(0, 5));
+
+  // the graph loads without its landmarks
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  EXPECT_EQ(6, topo_graph.NodeNum());
+  EXPECT_EQ(0, topo_graph.Landmarks().LandmarkNum());
+}
+
+}  // namespace routing
+}  // namespace apollo
@@ -117,13 +117,14 @@ void SubTopoGraph::GetSubInEdgesIntoSubGraph(
     std::unordered_set<const TopoEdge*>* const sub_edges) const {
   const auto* from_node = edge->FromNode();
   const auto* to_node = edge->ToNode();
-  std::unordered_set<TopoNode*> sub_nodes;
-  if (from_node->IsSubNode() || to_node->IsSubNode() ||
-      !GetSubNodes(to_node, &sub_nodes)) {
+  const auto* sub_nodes =
+      from_node->IsSubNode() || to_node->IsSubNode() ? nullptr
+                                                      : FindSubNodes(to_node);
+  if (sub_nodes == nullptr) {
     sub_edges->insert(edge);
     return;
   }
-  for (const auto* sub_node : sub_nodes) {
+  for (const auto* sub_node : *sub_nodes) {
     for (const auto* in_edge : sub_node->InFromAllEdge()) {
       if (in_edge->FromNode() == from_node) {
         sub_edges->insert(in_edge);
@@ -137,13 +138,14 @@ void SubTopoGraph::GetSubOutEdgesIntoSubGraph(
     std::unordered_set<const TopoEdge*>* const sub_edges) const {
   const auto* from_node = edge->FromNode();
   const auto* to_node = edge->ToNode();
-  std::unordered_set<TopoNode*> sub_nodes;
-  if (from_node->IsSubNode() || to_node->IsSubNode() ||
-      !GetSubNodes(from_node, &sub_nodes)) {
+  const auto* sub_nodes =
+      from_node->IsSubNode() || to_node->IsSubNode() ? nullptr
+                                                      : FindSubNodes(from_node);
+  if (sub_nodes == nullptr) {
     sub_edges->insert(edge);
     return;
   }
-  for (const auto* sub_node : sub_nodes) {
+  for (const auto* sub_node : *sub_nodes) {
     for (const auto* out_edge : sub_node->OutToAllEdge()) {
       if (out_edge->ToNode() == to_node) {
         sub_edges->insert(out_edge);
@@ -152,6 +154,10 @@ void SubTopoGraph::GetSubOutEdgesIntoSubGraph(
   }
 }
 
+bool SubTopoGraph::HasSubNodes(const TopoNode* topo_node) const {
+  return FindSubNodes(topo_node) != nullptr;
+}
+
 const TopoNode* SubTopoGraph::GetSubNodeWithS(const TopoNode* topo_node,
                                               double s) const {
   const auto& map_iter = sub_node_range_sorted_map_.find(topo_node);
@@ -271,6 +277,12 @@ void SubTopoGraph::InitOutSubNodeSubEdge(
   }
 }
 
+const std::unordered_set<TopoNode*>* SubTopoGraph::FindSubNodes(
+    const TopoNode* node) const {
+  const auto iter = sub_node_map_.find(node);
+  return iter == sub_node_map_.end() ? nullptr : &iter->second;
+}
+
 bool SubTopoGraph::GetSubNodes(
     const TopoNode* node,
     std::unordered_set<TopoNode*>* const sub_nodes) const {
@@ -66,6 +66,10 @@ class SubTopoGraph {
       const TopoEdge* edge,
       std::unordered_set<const TopoEdge*>* const sub_edges) const;
 
+  // whether the node is split into sub nodes, by which the edges into and
+  // out of it are replaced
+  bool HasSubNodes(const TopoNode* topo_node) const;
+
   const TopoNode* GetSubNodeWithS(const TopoNode* topo_node, double s) const;
 
  private:
@@ -80,6 +84,9 @@ class SubTopoGraph {
       TopoNode* const sub_node,
       const std::unordered_set<const TopoEdge*> origin_edge);
 
+  // the sub nodes of a node without copying them, nullptr if it has none
+  const std::unordered_set<TopoNode*>* FindSubNodes(
+      const TopoNode* node) const;
   bool GetSubNodes(const TopoNode* node,
                    std::unordered_set<TopoNode*>* const sub_nodes) const;
 
@@ -52,6 +52,8 @@ TEST(SubTopoGraphTestSuit, one_sub_graph_all_valid) {
   std::unordered_map<const TopoNode*, std::vector<NodeSRange>> range_list;
   range_list[node_2].push_back(GetSRange(20.0, 50.0));
   SubTopoGraph sub_topo_graph(range_list);
+  ASSERT_TRUE(sub_topo_graph.HasSubNodes(node_2));
+  ASSERT_FALSE(sub_topo_graph.HasSubNodes(node_1));
 
   ASSERT_EQ(1, node_1->InFromAllEdge().size());
   ASSERT_EQ(1, node_1->InFromRightEdge().size());
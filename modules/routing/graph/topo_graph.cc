@@ -16,6 +16,8 @@
 
 #include "modules/routing/graph/topo_graph.h"
 
+#include <algorithm>
+#include <tuple>
 #include <utility>
 
 namespace apollo {
@@ -24,7 +26,10 @@ namespace routing {
 void TopoGraph::Clear() {
   topo_nodes_.clear();
   topo_edges_.clear();
+  out_edge_begin_.clear();
+  out_change_begin_.clear();
   node_index_map_.clear();
+  landmarks_.Clear();
 }
 
 bool TopoGraph::LoadNodes(const Graph& graph) {
@@ -36,6 +41,7 @@ bool TopoGraph::LoadNodes(const Graph& graph) {
     node_index_map_[node.lane_id()] = static_cast<int>(topo_nodes_.size());
     std::shared_ptr<TopoNode> topo_node;
     topo_node.reset(new TopoNode(node));
+    topo_node->SetIndex(static_cast<int>(topo_nodes_.size()));
     road_node_map_[node.road_id()].insert(topo_node.get());
     topo_nodes_.push_back(std::move(topo_node));
   }
@@ -44,24 +50,50 @@ bool TopoGraph::LoadNodes(const Graph& graph) {
 
 // Need to execute load_nodes() firstly
 bool TopoGraph::LoadEdges(const Graph& graph) {
+  out_edge_begin_.assign(topo_nodes_.size() + 1, 0);
+  out_change_begin_.assign(topo_nodes_.size(), 0);
   if (graph.edge().empty()) {
     AINFO << "0 edges found in topology graph, but it's fine";
     return true;
   }
-  for (const auto& edge : graph.edge()) {
-    const std::string& from_lane_id = edge.from_lane_id();
-    const std::string& to_lane_id = edge.to_lane_id();
-    if (node_index_map_.count(from_lane_id) != 1 ||
-        node_index_map_.count(to_lane_id) != 1) {
+  // (from node index, is lane change, edge index), in which order the edges
+  // are stored
+  std::vector<std::tuple<int, bool, int>> edge_order;
+  edge_order.reserve(graph.edge_size());
+  for (int i = 0; i < graph.edge_size(); ++i) {
+    const auto& edge = graph.edge(i);
+    const auto from_iter = node_index_map_.find(edge.from_lane_id());
+    if (from_iter == node_index_map_.end() ||
+        node_index_map_.count(edge.to_lane_id()) != 1) {
       return false;
     }
-    std::shared_ptr<TopoEdge> topo_edge;
-    TopoNode* from_node = topo_nodes_[node_index_map_[from_lane_id]].get();
-    TopoNode* to_node = topo_nodes_[node_index_map_[to_lane_id]].get();
-    topo_edge.reset(new TopoEdge(edge, from_node, to_node));
-    from_node->AddOutEdge(topo_edge.get());
-    to_node->AddInEdge(topo_edge.get());
-    topo_edges_.push_back(std::move(topo_edge));
+    edge_order.emplace_back(from_iter->second,
+                            edge.direction_type() != Edge::FORWARD, i);
+  }
+  std::sort(edge_order.begin(), edge_order.end());
+
+  // the edges are not moved once added, as the nodes point to them
+  topo_edges_.reserve(edge_order.size());
+  for (const auto& order : edge_order) {
+    const int from_index = std::get<0>(order);
+    const auto& edge = graph.edge(std::get<2>(order));
+    TopoNode* from_node = topo_nodes_[from_index].get();
+    TopoNode* to_node = topo_nodes_[node_index_map_[edge.to_lane_id()]].get();
+    if (from_node->GetOutEdgeTo(to_node) != nullptr) {
+      // the nodes keep a single edge between them
+      continue;
+    }
+    topo_edges_.emplace_back(edge, from_node, to_node);
+    from_node->AddOutEdge(&topo_edges_.back());
+    to_node->AddInEdge(&topo_edges_.back());
+    ++out_edge_begin_[from_index + 1];
+    if (!std::get<1>(order)) {
+      ++out_change_begin_[from_index];
+    }
+  }
+  for (size_t i = 0; i < topo_nodes_.size(); ++i) {
+    out_edge_begin_[i + 1] += out_edge_begin_[i];
+    out_change_begin_[i] += out_edge_begin_[i];
   }
   return true;
 }
@@ -80,6 +112,9 @@ bool TopoGraph::LoadGraph(const Graph& graph) {
     AERROR << "Failed to load edges from topology graph.";
     return false;
   }
+  if (!landmarks_.Load(graph)) {
+    AWARN << "Ignored the landmarks of the topology graph.";
+  }
   AINFO << "Load Topo data successful.";
   return true;
 }
@@ -96,6 +131,24 @@ const TopoNode* TopoGraph::GetNode(const std::string& id) const {
   return topo_nodes_[iter->second].get();
 }
 
+int TopoGraph::NodeNum() const { return static_cast<int>(topo_nodes_.size()); }
+
+const TopoNode* TopoGraph::GetNode(const int index) const {
+  return topo_nodes_[index].get();
+}
+
+TopoEdgeRange TopoGraph::OutEdges(const int index) const {
+  return TopoEdgeRange(topo_edges_.data() + out_edge_begin_[index],
+                       topo_edges_.data() + out_edge_begin_[index + 1]);
+}
+
+TopoEdgeRange TopoGraph::OutToSucEdges(const int index) const {
+  return TopoEdgeRange(topo_edges_.data() + out_edge_begin_[index],
+                       topo_edges_.data() + out_change_begin_[index]);
+}
+
+const LandmarkTable& TopoGraph::Landmarks() const { return landmarks_; }
+
 void TopoGraph::GetNodesByRoadId(
     const std::string& road_id,
     std::unordered_set<const TopoNode*>* const node_in_road) const {
@@ -23,11 +23,30 @@
 #include <vector>
 
 #include "cyber/common/log.h"
+#include "modules/routing/graph/landmark_table.h"
 #include "modules/routing/graph/topo_node.h"
 
 namespace apollo {
 namespace routing {
 
+// A contiguous range of the edges of a graph.
+class TopoEdgeRange {
+ public:
+  TopoEdgeRange(const TopoEdge* begin, const TopoEdge* end)
+      : begin_(begin), end_(end) {}
+
+  const TopoEdge* begin() const { return begin_; }
+  const TopoEdge* end() const { return end_; }
+  size_t size() const { return end_ - begin_; }
+  bool empty() const { return begin_ == end_; }
+
+ private:
+  const TopoEdge* begin_;
+  const TopoEdge* end_;
+};
+
+// The graph is not modified once loaded, so that the searches of concurrent
+// requests may share it, each with its own SubTopoGraph for the black lists.
 class TopoGraph {
  public:
   TopoGraph() = default;
@@ -38,6 +57,13 @@ class TopoGraph {
   const std::string& MapVersion() const;
   const std::string& MapDistrict() const;
   const TopoNode* GetNode(const std::string& id) const;
+  int NodeNum() const;
+  // the node of an index in [0, NodeNum())
+  const TopoNode* GetNode(int index) const;
+  // the out edges of the node of an index, those to its successors first
+  TopoEdgeRange OutEdges(int index) const;
+  TopoEdgeRange OutToSucEdges(int index) const;
+  const LandmarkTable& Landmarks() const;
   void GetNodesByRoadId(
       const std::string& road_id,
       std::unordered_set<const TopoNode*>* const node_in_road) const;
@@ -51,10 +77,16 @@ class TopoGraph {
   std::string map_version_;
   std::string map_district_;
   std::vector<std::shared_ptr<TopoNode> > topo_nodes_;
-  std::vector<std::shared_ptr<TopoEdge> > topo_edges_;
+  // the edges by from node index and by type, the out edges of node i are
+  // [out_edge_begin_[i], out_edge_begin_[i + 1]), the ones from
+  // out_change_begin_[i] on change lanes
+  std::vector<TopoEdge> topo_edges_;
+  std::vector<int> out_edge_begin_;
+  std::vector<int> out_change_begin_;
   std::unordered_map<std::string, int> node_index_map_;
   std::unordered_map<std::string, std::unordered_set<const TopoNode*> >
       road_node_map_;
+  LandmarkTable landmarks_;
 };
 
 }  // namespace routing
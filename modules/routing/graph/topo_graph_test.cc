@@ -65,5 +65,40 @@ TEST(TopoGraphTestSuit, test_graph_1) {
   ASSERT_FALSE(node_4->IsSubNode());
 }
 
+TEST(TopoGraphTestSuit, out_edge_arrays) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  // a second edge between the same nodes is ignored
+  GetEdgeForTest(graph.add_edge(), TEST_L1, TEST_L3, Edge::FORWARD);
+
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  ASSERT_EQ(6, topo_graph.NodeNum());
+
+  const TopoNode* node_1 = topo_graph.GetNode(TEST_L1);
+  ASSERT_TRUE(node_1 != nullptr);
+  ASSERT_EQ(0, node_1->Index());
+  ASSERT_EQ(node_1, topo_graph.GetNode(node_1->Index()));
+
+  const auto out_edges = topo_graph.OutEdges(node_1->Index());
+  ASSERT_EQ(node_1->OutToAllEdge().size(), out_edges.size());
+  // the edges to the successors first
+  ASSERT_EQ(TopoEdgeType::TET_FORWARD, out_edges.begin()->Type());
+  ASSERT_EQ(topo_graph.GetNode(TEST_L3), out_edges.begin()->ToNode());
+  ASSERT_EQ(TopoEdgeType::TET_RIGHT, (out_edges.begin() + 1)->Type());
+  for (const auto& edge : out_edges) {
+    ASSERT_EQ(node_1, edge.FromNode());
+    ASSERT_EQ(&edge, node_1->GetOutEdgeTo(edge.ToNode()));
+  }
+  const auto suc_edges = topo_graph.OutToSucEdges(node_1->Index());
+  ASSERT_EQ(1, suc_edges.size());
+  ASSERT_EQ(out_edges.begin(), suc_edges.begin());
+
+  const TopoNode* node_6 = topo_graph.GetNode(TEST_L6);
+  ASSERT_TRUE(node_6 != nullptr);
+  ASSERT_EQ(1, topo_graph.OutEdges(node_6->Index()).size());
+  ASSERT_TRUE(topo_graph.OutToSucEdges(node_6->Index()).empty());
+}
+
 }  // namespace routing
 }  // namespace apollo
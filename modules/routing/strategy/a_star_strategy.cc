@@ -23,6 +23,7 @@
 #include "modules/routing/graph/sub_topo_graph.h"
 #include "modules/routing/graph/topo_graph.h"
 #include "modules/routing/strategy/a_star_strategy.h"
+#include "modules/routing/strategy/strategy_util.h"
 
 namespace apollo {
 namespace routing {
@@ -51,130 +52,6 @@ double GetCostToNeighbor(const TopoEdge* edge) {
   return (edge->Cost() + edge->ToNode()->Cost());
 }
 
-const TopoNode* GetLargestNode(const std::vector<const TopoNode*>& nodes) {
-  double max_range = 0.0;
-  const TopoNode* largest = nullptr;
-  for (const auto* node : nodes) {
-    const double temp_range = node->EndS() - node->StartS();
-    if (temp_range > max_range) {
-      max_range = temp_range;
-      largest = node;
-    }
-  }
-  return largest;
-}
-
-bool AdjustLaneChangeBackward(
-    std::vector<const TopoNode*>* const result_node_vec) {
-  for (int i = static_cast<int>(result_node_vec->size()) - 2; i > 0; --i) {
-    const auto* from_node = result_node_vec->at(i);
-    const auto* to_node = result_node_vec->at(i + 1);
-    const auto* base_node = result_node_vec->at(i - 1);
-    const auto* from_to_edge = from_node->GetOutEdgeTo(to_node);
-    if (from_to_edge == nullptr) {
-      // may need to recalculate edge,
-      // because only edge from origin node to subnode is saved
-      from_to_edge = to_node->GetInEdgeFrom(from_node);
-    }
-    if (from_to_edge == nullptr) {
-      AERROR << "Get null ptr to edge:" << from_node->LaneId() << " ("
-             << from_node->StartS() << ", " << from_node->EndS() << ")"
-             << " --> " << to_node->LaneId() << " (" << to_node->StartS()
-             << ", " << to_node->EndS() << ")";
-      return false;
-    }
-    if (from_to_edge->Type() != TopoEdgeType::TET_FORWARD) {
-      if (base_node->EndS() - base_node->StartS() <
-          from_node->EndS() - from_node->StartS()) {
-        continue;
-      }
-      std::vector<const TopoNode*> candidate_set;
-      candidate_set.push_back(from_node);
-      const auto& out_edges = base_node->OutToLeftOrRightEdge();
-      for (const auto* edge : out_edges) {
-        const auto* candidate_node = edge->ToNode();
-        if (candidate_node == from_node) {
-          continue;
-        }
-        if (candidate_node->GetOutEdgeTo(to_node) != nullptr) {
-          candidate_set.push_back(candidate_node);
-        }
-      }
-      const auto* largest_node = GetLargestNode(candidate_set);
-      if (largest_node == nullptr) {
-        return false;
-      }
-      if (largest_node != from_node) {
-        result_node_vec->at(i) = largest_node;
-      }
-    }
-  }
-  return true;
-}
-
-bool AdjustLaneChangeForward(
-    std::vector<const TopoNode*>* const result_node_vec) {
-  for (size_t i = 1; i < result_node_vec->size() - 1; ++i) {
-    const auto* from_node = result_node_vec->at(i - 1);
-    const auto* to_node = result_node_vec->at(i);
-    const auto* base_node = result_node_vec->at(i + 1);
-    const auto* from_to_edge = from_node->GetOutEdgeTo(to_node);
-    if (from_to_edge == nullptr) {
-      // may need to recalculate edge,
-      // because only edge from origin node to subnode is saved
-      from_to_edge = to_node->GetInEdgeFrom(from_node);
-    }
-    if (from_to_edge == nullptr) {
-      AERROR << "Get null ptr to edge:" << from_node->LaneId() << " ("
-             << from_node->StartS() << ", " << from_node->EndS() << ")"
-             << " --> " << to_node->LaneId() << " (" << to_node->StartS()
-             << ", " << to_node->EndS() << ")";
-      return false;
-    }
-    if (from_to_edge->Type() != TopoEdgeType::TET_FORWARD) {
-      if (base_node->EndS() - base_node->StartS() <
-          to_node->EndS() - to_node->StartS()) {
-        continue;
-      }
-      std::vector<const TopoNode*> candidate_set;
-      candidate_set.push_back(to_node);
-      const auto& in_edges = base_node->InFromLeftOrRightEdge();
-      for (const auto* edge : in_edges) {
-        const auto* candidate_node = edge->FromNode();
-        if (candidate_node == to_node) {
-          continue;
-        }
-        if (candidate_node->GetInEdgeFrom(from_node) != nullptr) {
-          candidate_set.push_back(candidate_node);
-        }
-      }
-      const auto* largest_node = GetLargestNode(candidate_set);
-      if (largest_node == nullptr) {
-        return false;
-      }
-      if (largest_node != to_node) {
-        result_node_vec->at(i) = largest_node;
-      }
-    }
-  }
-  return true;
-}
-
-bool AdjustLaneChange(std::vector<const TopoNode*>* const result_node_vec) {
-  if (result_node_vec->size() < 3) {
-    return true;
-  }
-  if (!AdjustLaneChangeBackward(result_node_vec)) {
-    AERROR << "Failed to adjust lane change backward";
-    return false;
-  }
-  if (!AdjustLaneChangeForward(result_node_vec)) {
-    AERROR << "Failed to adjust lane change backward";
-    return false;
-  }
-  return true;
-}
-
 bool Reconstruct(
     const std::unordered_map<const TopoNode*, const TopoNode*>& came_from,
     const TopoNode* dest_node, std::vector<NodeWithRange>* result_nodes) {
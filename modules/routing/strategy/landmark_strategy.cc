@@ -0,0 +1,246 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/strategy/landmark_strategy.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <unordered_set>
+
+#include "modules/routing/common/routing_gflags.h"
+#include "modules/routing/strategy/strategy_util.h"
+
+namespace apollo {
+namespace routing {
+namespace {
+
+using OpenSetEntry = std::pair<double, int>;
+
+const TopoNode* GetSuccessorOfSameLane(const TopoNode* node) {
+  for (const auto* edge : node->OutToAllEdge()) {
+    if (edge->ToNode()->LaneId() == node->LaneId()) {
+      return edge->ToNode();
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+LandmarkStrategy::LandmarkStrategy(bool enable_change)
+    : change_lane_enabled_(enable_change) {}
+
+void LandmarkStrategy::Reset(const TopoGraph* graph) {
+  ++search_id_;
+  if (search_id_ == 0) {
+    for (auto& state : states_) {
+      state.search_id = 0;
+    }
+    search_id_ = 1;
+  }
+  node_num_ = graph->NodeNum();
+  states_.resize(node_num_);
+  sub_node_index_.clear();
+  open_set_.clear();
+}
+
+int LandmarkStrategy::StateIndex(const TopoNode* node) {
+  int index = node->Index();
+  if (index < 0 || index >= node_num_) {
+    const auto iter = sub_node_index_.find(node);
+    if (iter != sub_node_index_.end()) {
+      index = iter->second;
+    } else {
+      index = static_cast<int>(states_.size());
+      sub_node_index_[node] = index;
+      states_.emplace_back();
+    }
+  }
+  auto& state = states_[index];
+  if (state.search_id != search_id_) {
+    state.node = node;
+    state.g = std::numeric_limits<double>::infinity();
+    state.enter_s = node->StartS();
+    state.came_from = -1;
+    state.search_id = search_id_;
+    state.closed = false;
+  }
+  return index;
+}
+
+bool LandmarkStrategy::Search(const TopoGraph* graph,
+                              const SubTopoGraph* sub_graph,
+                              const TopoNode* src_node,
+                              const TopoNode* dest_node,
+                              std::vector<NodeWithRange>* const result_nodes) {
+  Reset(graph);
+  AINFO << "Start landmark search algorithm.";
+
+  const auto& landmarks = graph->Landmarks();
+  const int dest_index = dest_node->OriginNode()->Index();
+  const auto heuristic_cost = [&landmarks, dest_index](const TopoNode* node) {
+    return landmarks.LowerBound(node->OriginNode()->Index(), dest_index);
+  };
+
+  const int src_index = StateIndex(src_node);
+  states_[src_index].g = 0.0;
+  open_set_.emplace_back(heuristic_cost(src_node), src_index);
+
+  std::unordered_set<const TopoEdge*> sub_edge_set;
+  int expanded_num = 0;
+  while (!open_set_.empty()) {
+    std::pop_heap(open_set_.begin(), open_set_.end(),
+                  std::greater<OpenSetEntry>());
+    const int from_index = open_set_.back().second;
+    open_set_.pop_back();
+    if (states_[from_index].closed) {
+      continue;
+    }
+    const auto* from_node = states_[from_index].node;
+    if (from_node == dest_node) {
+      ADEBUG << "Expanded " << expanded_num << " nodes.";
+      if (!Reconstruct(from_index, result_nodes)) {
+        AERROR << "Failed to reconstruct route.";
+        return false;
+      }
+      return true;
+    }
+    states_[from_index].closed = true;
+    ++expanded_num;
+
+    // if residual_s is less than FLAGS_min_length_for_lane_change, only move
+    // forward
+    const bool change_lane = GetResidualS(states_[from_index]) >
+                                 FLAGS_min_length_for_lane_change &&
+                             change_lane_enabled_;
+    next_edges_.clear();
+    if (from_node->IsSubNode()) {
+      const auto& edges = change_lane ? from_node->OutToAllEdge()
+                                      : from_node->OutToSucEdge();
+      next_edges_.insert(next_edges_.end(), edges.begin(), edges.end());
+    } else {
+      // the out edges of the graph, replaced by the ones into the sub nodes
+      // for the nodes the sub graph splits
+      const int index = from_node->Index();
+      for (const auto& edge : change_lane ? graph->OutEdges(index)
+                                          : graph->OutToSucEdges(index)) {
+        if (!sub_graph->HasSubNodes(edge.ToNode())) {
+          next_edges_.push_back(&edge);
+          continue;
+        }
+        sub_edge_set.clear();
+        sub_graph->GetSubInEdgesIntoSubGraph(&edge, &sub_edge_set);
+        next_edges_.insert(next_edges_.end(), sub_edge_set.begin(),
+                           sub_edge_set.end());
+      }
+    }
+
+    for (const auto* edge : next_edges_) {
+      const auto* to_node = edge->ToNode();
+      // reaching a sub node may grow states_, so look the states up after
+      const int to_index = StateIndex(to_node);
+      const auto& from_state = states_[from_index];
+      auto& to_state = states_[to_index];
+      if (to_state.closed) {
+        continue;
+      }
+      if (GetResidualS(edge, from_state, to_node) <
+          FLAGS_min_length_for_lane_change) {
+        continue;
+      }
+      const bool is_forward = edge->Type() == TopoEdgeType::TET_FORWARD;
+      const double g =
+          from_state.g + LandmarkEdgeCost(edge->Cost(), from_node->Cost(),
+                                          to_node->Cost(), is_forward);
+      if (g >= to_state.g) {
+        continue;
+      }
+      // if to_node is reached by forward, reset enter_s to start_s
+      double to_node_enter_s = to_node->StartS();
+      if (!is_forward) {
+        // else, add enter_s with FLAGS_min_length_for_lane_change
+        to_node_enter_s =
+            (from_state.enter_s + FLAGS_min_length_for_lane_change) /
+            from_node->Length() * to_node->Length();
+        // enter s could be larger than end_s but should be less than length
+        to_node_enter_s = std::min(to_node_enter_s, to_node->Length());
+        // if enter_s is larger than end_s and to_node is dest_node
+        if (to_node_enter_s > to_node->EndS() && to_node == dest_node) {
+          continue;
+        }
+      }
+      to_state.g = g;
+      to_state.enter_s = to_node_enter_s;
+      to_state.came_from = from_index;
+      open_set_.emplace_back(g + heuristic_cost(to_node), to_index);
+      std::push_heap(open_set_.begin(), open_set_.end(),
+                     std::greater<OpenSetEntry>());
+    }
+  }
+  AERROR << "Failed to find goal lane with id: " << dest_node->LaneId();
+  return false;
+}
+
+double LandmarkStrategy::GetResidualS(const NodeState& state) const {
+  if (state.enter_s > state.node->EndS()) {
+    return 0.0;
+  }
+  const auto* succ_node = GetSuccessorOfSameLane(state.node);
+  const double end_s =
+      succ_node != nullptr ? succ_node->EndS() : state.node->EndS();
+  return end_s - state.enter_s;
+}
+
+double LandmarkStrategy::GetResidualS(const TopoEdge* edge,
+                                      const NodeState& from_state,
+                                      const TopoNode* to_node) const {
+  if (edge->Type() == TopoEdgeType::TET_FORWARD) {
+    return std::numeric_limits<double>::max();
+  }
+  const double start_s =
+      std::max(to_node->StartS(), from_state.enter_s /
+                                      from_state.node->Length() *
+                                      to_node->Length());
+  const auto* succ_node = GetSuccessorOfSameLane(to_node);
+  const double end_s =
+      succ_node != nullptr ? succ_node->EndS() : to_node->EndS();
+  return end_s - start_s;
+}
+
+bool LandmarkStrategy::Reconstruct(
+    const int dest_index,
+    std::vector<NodeWithRange>* const result_nodes) const {
+  std::vector<const TopoNode*> result_node_vec;
+  for (int index = dest_index; index >= 0;
+       index = states_[index].came_from) {
+    result_node_vec.push_back(states_[index].node);
+  }
+  std::reverse(result_node_vec.begin(), result_node_vec.end());
+  if (!AdjustLaneChange(&result_node_vec)) {
+    AERROR << "Failed to adjust lane change";
+    return false;
+  }
+  result_nodes->clear();
+  for (const auto* node : result_node_vec) {
+    result_nodes->emplace_back(node->OriginNode(), node->StartS(),
+                               node->EndS());
+  }
+  return true;
+}
+
+}  // namespace routing
+}  // namespace apollo
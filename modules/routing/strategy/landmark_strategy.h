@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "modules/routing/strategy/strategy.h"
+
+namespace apollo {
+namespace routing {
+
+// A* search guided by the landmarks of the graph (ALT). Its heuristic never
+// overestimates the cost left, so that it expands far fewer nodes than
+// Dijkstra while finding the same routes, and it falls back to Dijkstra on
+// graphs without landmarks. The search state is kept by node index and
+// reused across the searches, which follow the out edge arrays of the graph.
+class LandmarkStrategy : public Strategy {
+ public:
+  explicit LandmarkStrategy(bool enable_change);
+  ~LandmarkStrategy() = default;
+
+  virtual bool Search(const TopoGraph* graph, const SubTopoGraph* sub_graph,
+                      const TopoNode* src_node, const TopoNode* dest_node,
+                      std::vector<NodeWithRange>* const result_nodes);
+
+ private:
+  struct NodeState {
+    const TopoNode* node = nullptr;
+    // the landmark cost of the best route found from the source
+    double g = 0.0;
+    double enter_s = 0.0;
+    int came_from = -1;
+    // the search which last reached the node, older states are stale
+    uint32_t search_id = 0;
+    bool closed = false;
+  };
+
+  void Reset(const TopoGraph* graph);
+  // the index of the state of a node, which is reset when first reached
+  int StateIndex(const TopoNode* node);
+  double GetResidualS(const NodeState& state) const;
+  double GetResidualS(const TopoEdge* edge, const NodeState& from_state,
+                      const TopoNode* to_node) const;
+  bool Reconstruct(int dest_index,
+                   std::vector<NodeWithRange>* const result_nodes) const;
+
+ private:
+  bool change_lane_enabled_;
+  uint32_t search_id_ = 0;
+  int node_num_ = 0;
+  // the states of the nodes of the graph by index, followed by the sub nodes
+  std::vector<NodeState> states_;
+  std::unordered_map<const TopoNode*, int> sub_node_index_;
+  // (f, index) of the states to expand, as a heap
+  std::vector<std::pair<double, int>> open_set_;
+  std::vector<const TopoEdge*> next_edges_;
+};
+
+}  // namespace routing
+}  // namespace apollo
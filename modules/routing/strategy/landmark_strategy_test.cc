@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/strategy/landmark_strategy.h"
+
+#include <unordered_map>
+
+#include "gtest/gtest.h"
+#include "modules/routing/graph/topo_test_utils.h"
+#include "modules/routing/strategy/a_star_strategy.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+double GetRouteCost(const std::vector<NodeWithRange>& route) {
+  double cost = 0.0;
+  for (size_t i = 1; i < route.size(); ++i) {
+    const auto* from_node = route[i - 1].GetTopoNode();
+    const auto* to_node = route[i].GetTopoNode();
+    const auto* edge = from_node->GetOutEdgeTo(to_node);
+    EXPECT_TRUE(edge != nullptr);
+    if (edge == nullptr) {
+      return 0.0;
+    }
+    cost += LandmarkEdgeCost(edge->Cost(), from_node->Cost(), to_node->Cost(),
+                             edge->Type() == TopoEdgeType::TET_FORWARD);
+  }
+  return cost;
+}
+
+// the routes may differ among the ones of the same cost
+void ExpectSameRoute(const std::vector<NodeWithRange>& expected,
+                     const std::vector<NodeWithRange>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  EXPECT_EQ(expected.front().GetTopoNode(), actual.front().GetTopoNode());
+  EXPECT_EQ(expected.back().GetTopoNode(), actual.back().GetTopoNode());
+  EXPECT_DOUBLE_EQ(expected.back().EndS(), actual.back().EndS());
+  EXPECT_DOUBLE_EQ(GetRouteCost(expected), GetRouteCost(actual));
+}
+
+void SearchRoutes(const int landmark_num) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  LandmarkTable::CreateLandmarks(landmark_num, &graph);
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  ASSERT_EQ(landmark_num, topo_graph.Landmarks().LandmarkNum());
+
+  std::unordered_map<const TopoNode*, std::vector<NodeSRange>> range_list;
+  SubTopoGraph sub_topo_graph(range_list);
+  AStarStrategy a_star_strategy(true);
+  // one strategy for all the searches, which reuse its state
+  LandmarkStrategy landmark_strategy(true);
+  for (const auto* from_id : {TEST_L1, TEST_L2}) {
+    for (const auto* to_id : {TEST_L5, TEST_L6}) {
+      const TopoNode* from_node = topo_graph.GetNode(from_id);
+      const TopoNode* to_node = topo_graph.GetNode(to_id);
+      std::vector<NodeWithRange> expected;
+      ASSERT_TRUE(a_star_strategy.Search(&topo_graph, &sub_topo_graph,
+                                         from_node, to_node, &expected));
+      std::vector<NodeWithRange> actual;
+      ASSERT_TRUE(landmark_strategy.Search(&topo_graph, &sub_topo_graph,
+                                           from_node, to_node, &actual));
+      ExpectSameRoute(expected, actual);
+    }
+  }
+  // no route backward
+  std::vector<NodeWithRange> result;
+  EXPECT_FALSE(landmark_strategy.Search(&topo_graph, &sub_topo_graph,
+                                        topo_graph.GetNode(TEST_L5),
+                                        topo_graph.GetNode(TEST_L1),
+                                        &result));
+}
+
+}  // namespace
+
+TEST(LandmarkStrategyTestSuit, same_routes_as_a_star) { SearchRoutes(3); }
+
+TEST(LandmarkStrategyTestSuit, without_landmarks) { SearchRoutes(0); }
+
+TEST(LandmarkStrategyTestSuit, sub_nodes) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  LandmarkTable::CreateLandmarks(3, &graph);
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+
+  const TopoNode* node_1 = topo_graph.GetNode(TEST_L1);
+  const TopoNode* node_6 = topo_graph.GetNode(TEST_L6);
+  std::unordered_map<const TopoNode*, std::vector<NodeSRange>> range_list;
+  range_list[node_1].emplace_back(20.0, 20.0);
+  range_list[node_6].emplace_back(80.0, 80.0);
+  SubTopoGraph sub_topo_graph(range_list);
+  const TopoNode* from_node = sub_topo_graph.GetSubNodeWithS(node_1, 30.0);
+  const TopoNode* to_node = sub_topo_graph.GetSubNodeWithS(node_6, 70.0);
+  ASSERT_TRUE(from_node != nullptr);
+  ASSERT_TRUE(to_node != nullptr);
+
+  AStarStrategy a_star_strategy(true);
+  std::vector<NodeWithRange> expected;
+  ASSERT_TRUE(a_star_strategy.Search(&topo_graph, &sub_topo_graph, from_node,
+                                     to_node, &expected));
+  LandmarkStrategy landmark_strategy(true);
+  std::vector<NodeWithRange> actual;
+  ASSERT_TRUE(landmark_strategy.Search(&topo_graph, &sub_topo_graph,
+                                       from_node, to_node, &actual));
+  ExpectSameRoute(expected, actual);
+}
+
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,31 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "modules/routing/graph/topo_node.h"
+
+namespace apollo {
+namespace routing {
+
+// Move the lane changes of a route of nodes to the longest ones among the
+// parallel nodes, so that there is room to change lanes.
+bool AdjustLaneChange(std::vector<const TopoNode*>* const result_node_vec);
+
+}  // namespace routing
+}  // namespace apollo
@@ -16,16 +16,21 @@
 
 #include "modules/routing/topo_creator/graph_creator.h"
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 #include "absl/strings/match.h"
+#include "absl/strings/str_split.h"
 
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/math/math_utils.h"
+#include "modules/common/util/parallel_for.h"
 #include "modules/map/hdmap/adapter/opendrive_adapter.h"
 #include "modules/routing/common/routing_gflags.h"
+#include "modules/routing/graph/landmark_table.h"
 #include "modules/routing/topo_creator/edge_creator.h"
 #include "modules/routing/topo_creator/node_creator.h"
 
@@ -36,6 +41,7 @@ using apollo::common::PointENU;
 using apollo::common::VehicleConfigHelper;
 using apollo::common::math::kMathEpsilon;
 using apollo::common::math::Vec2d;
+using apollo::common::util::ParallelFor;
 using apollo::hdmap::Id;
 using apollo::hdmap::LaneBoundary;
 using apollo::hdmap::LaneBoundaryType;
@@ -78,12 +84,67 @@ bool GraphCreator::Create() {
 
   AINFO << "Number of lanes: " << pbmap_.lane_size();
 
+  Graph previous_graph;
+  std::unordered_set<std::string> patched_lane_ids;
+  if (!FLAGS_routing_previous_topo_file.empty()) {
+    if (!cyber::common::GetProtoFromFile(FLAGS_routing_previous_topo_file,
+                                         &previous_graph)) {
+      AERROR << "Failed to load the previous topo data from "
+             << FLAGS_routing_previous_topo_file;
+      return false;
+    }
+    for (const auto& lane_id :
+         absl::StrSplit(FLAGS_routing_patched_lane_ids, ',',
+                        absl::SkipEmpty())) {
+      patched_lane_ids.emplace(lane_id);
+    }
+    AINFO << "Update the previous topo data for " << patched_lane_ids.size()
+          << " patched lanes.";
+  }
+
+  const int thread_num =
+      common::util::ResolveThreadNum(FLAGS_routing_topo_creator_thread_num);
+  const double min_turn_radius =
+      VehicleConfigHelper::GetConfig().vehicle_param().min_turn_radius();
+  BuildGraph(min_turn_radius, thread_num,
+             FLAGS_routing_previous_topo_file.empty() ? nullptr
+                                                      : &previous_graph,
+             patched_lane_ids);
+  LandmarkTable::CreateLandmarks(FLAGS_routing_landmark_num, &graph_);
+
+  if (!absl::EndsWith(dump_topo_file_path_, ".bin") &&
+      !absl::EndsWith(dump_topo_file_path_, ".txt")) {
+    AERROR << "Failed to dump topo data into file, incorrect file type "
+           << dump_topo_file_path_;
+    return false;
+  }
+  auto type_pos = dump_topo_file_path_.find_last_of(".") + 1;
+  std::string bin_file = dump_topo_file_path_.replace(type_pos, 3, "bin");
+  std::string txt_file = dump_topo_file_path_.replace(type_pos, 3, "txt");
+  if (!cyber::common::SetProtoToASCIIFile(graph_, txt_file)) {
+    AERROR << "Failed to dump topo data into file " << txt_file;
+    return false;
+  }
+  AINFO << "Txt file is dumped successfully. Path: " << txt_file;
+  if (!cyber::common::SetProtoToBinaryFile(graph_, bin_file)) {
+    AERROR << "Failed to dump topo data into file " << bin_file;
+    return false;
+  }
+  AINFO << "Bin file is dumped successfully. Path: " << bin_file;
+  return true;
+}
+
+void GraphCreator::BuildGraph(
+    const double min_turn_radius, const int thread_num,
+    Graph* const previous_graph,
+    const std::unordered_set<std::string>& patched_lane_ids) {
+  graph_.Clear();
   graph_.set_hdmap_version(pbmap_.header().version());
   graph_.set_hdmap_district(pbmap_.header().district());
 
   node_index_map_.clear();
   road_id_map_.clear();
-  showed_edge_id_set_.clear();
+  forbidden_lane_id_set_.clear();
 
   for (const auto& road : pbmap_.road()) {
     for (const auto& section : road.section()) {
@@ -94,103 +155,137 @@ bool GraphCreator::Create() {
   }
 
   InitForbiddenLanes();
-  const double min_turn_radius =
-      VehicleConfigHelper::GetConfig().vehicle_param().min_turn_radius();
 
-  for (const auto& lane : pbmap_.lane()) {
-    const auto& lane_id = lane.id().id();
-    if (forbidden_lane_id_set_.find(lane_id) != forbidden_lane_id_set_.end()) {
+  // the lanes of the nodes, in the order of the map
+  std::vector<char> is_node_lane(pbmap_.lane_size(), 0);
+  ParallelFor(pbmap_.lane_size(), thread_num, [&](const int i) {
+    const auto& lane = pbmap_.lane(i);
+    is_node_lane[i] =
+        forbidden_lane_id_set_.count(lane.id().id()) == 0 &&
+        (lane.turn() != hdmap::Lane::U_TURN ||
+         IsValidUTurn(lane, min_turn_radius));
+  });
+  std::vector<int> node_lanes;
+  for (int i = 0; i < pbmap_.lane_size(); ++i) {
+    const auto& lane_id = pbmap_.lane(i).id().id();
+    if (forbidden_lane_id_set_.count(lane_id) != 0) {
       ADEBUG << "Ignored lane id: " << lane_id
              << " because its type is NOT CITY_DRIVING.";
       continue;
     }
-    if (lane.turn() == hdmap::Lane::U_TURN &&
-        !IsValidUTurn(lane, min_turn_radius)) {
+    if (!is_node_lane[i]) {
       ADEBUG << "The u-turn lane radius is too small for the vehicle to turn";
       continue;
     }
-    AINFO << "Current lane id: " << lane_id;
-    node_index_map_[lane_id] = graph_.node_size();
-    const auto iter = road_id_map_.find(lane_id);
-    if (iter != road_id_map_.end()) {
-      node_creator::GetPbNode(lane, iter->second, routing_conf_,
-                              graph_.add_node());
-    } else {
-      AWARN << "Failed to find road id of lane " << lane_id;
-      node_creator::GetPbNode(lane, "", routing_conf_, graph_.add_node());
-    }
+    ADEBUG << "Current lane id: " << lane_id;
+    node_index_map_[lane_id] = static_cast<int>(node_lanes.size());
+    node_lanes.push_back(i);
   }
 
-  for (const auto& lane : pbmap_.lane()) {
-    const auto& lane_id = lane.id().id();
-    if (forbidden_lane_id_set_.find(lane_id) != forbidden_lane_id_set_.end()) {
-      ADEBUG << "Ignored lane id: " << lane_id
-             << " because its type is NOT CITY_DRIVING.";
-      continue;
+  // the nodes of the lanes which are not patched are taken from the previous
+  // graph, the others are created
+  std::vector<int> previous_nodes(node_lanes.size(), -1);
+  if (previous_graph != nullptr) {
+    std::unordered_map<std::string, int> previous_node_index_map;
+    for (int i = 0; i < previous_graph->node_size(); ++i) {
+      previous_node_index_map[previous_graph->node(i).lane_id()] = i;
+    }
+    for (size_t i = 0; i < node_lanes.size(); ++i) {
+      const auto& lane_id = pbmap_.lane(node_lanes[i]).id().id();
+      const auto iter = previous_node_index_map.find(lane_id);
+      if (iter != previous_node_index_map.end() &&
+          patched_lane_ids.count(lane_id) == 0) {
+        previous_nodes[i] = iter->second;
+        // a node is taken once
+        previous_node_index_map.erase(iter);
+      }
+    }
+  }
+  graph_.mutable_node()->Reserve(static_cast<int>(node_lanes.size()));
+  for (size_t i = 0; i < node_lanes.size(); ++i) {
+    graph_.add_node();
+  }
+  int created_node_num = 0;
+  for (const int previous_node : previous_nodes) {
+    created_node_num += previous_node < 0 ? 1 : 0;
+  }
+  ParallelFor(node_lanes.size(), thread_num, [&](const int i) {
+    Node* const node = graph_.mutable_node(i);
+    if (previous_nodes[i] >= 0) {
+      node->Swap(previous_graph->mutable_node(previous_nodes[i]));
+      return;
+    }
+    const auto& lane = pbmap_.lane(node_lanes[i]);
+    const auto iter = road_id_map_.find(lane.id().id());
+    if (iter != road_id_map_.end()) {
+      node_creator::GetPbNode(lane, iter->second, routing_conf_, node);
+    } else {
+      AWARN << "Failed to find road id of lane " << lane.id().id();
+      node_creator::GetPbNode(lane, "", routing_conf_, node);
     }
-    const auto& from_node = graph_.node(node_index_map_[lane_id]);
+  });
+  AINFO << "Created " << created_node_num << " of " << graph_.node_size()
+        << " nodes.";
 
-    AddEdge(from_node, lane.successor_id(), Edge::FORWARD);
+  // the edges out of each lane, in the order they are added
+  std::vector<std::vector<std::pair<int, Edge::DirectionType>>> lane_edges(
+      node_lanes.size());
+  ParallelFor(node_lanes.size(), thread_num, [&](const int i) {
+    const auto& lane = pbmap_.lane(node_lanes[i]);
+    auto* edges = &lane_edges[i];
+    AddEdges(lane.successor_id(), Edge::FORWARD, edges);
     if (lane.length() < FLAGS_min_length_for_lane_change) {
-      continue;
+      return;
     }
     if (lane.has_left_boundary() && IsAllowedToCross(lane.left_boundary())) {
-      AddEdge(from_node, lane.left_neighbor_forward_lane_id(), Edge::LEFT);
+      AddEdges(lane.left_neighbor_forward_lane_id(), Edge::LEFT, edges);
     }
-
     if (lane.has_right_boundary() && IsAllowedToCross(lane.right_boundary())) {
-      AddEdge(from_node, lane.right_neighbor_forward_lane_id(), Edge::RIGHT);
+      AddEdges(lane.right_neighbor_forward_lane_id(), Edge::RIGHT, edges);
+    }
+  });
+  // a single edge between two nodes, the first one
+  std::vector<std::pair<int, int>> edge_nodes;
+  std::vector<Edge::DirectionType> edge_types;
+  std::unordered_set<int64_t> showed_edge_set;
+  for (size_t i = 0; i < node_lanes.size(); ++i) {
+    const int from_index =
+        node_index_map_[pbmap_.lane(node_lanes[i]).id().id()];
+    for (const auto& edge : lane_edges[i]) {
+      const int64_t edge_key =
+          static_cast<int64_t>(from_index) * graph_.node_size() + edge.first;
+      if (!showed_edge_set.insert(edge_key).second) {
+        continue;
+      }
+      edge_nodes.emplace_back(from_index, edge.first);
+      edge_types.push_back(edge.second);
     }
   }
-
-  if (!absl::EndsWith(dump_topo_file_path_, ".bin") &&
-      !absl::EndsWith(dump_topo_file_path_, ".txt")) {
-    AERROR << "Failed to dump topo data into file, incorrect file type "
-           << dump_topo_file_path_;
-    return false;
-  }
-  auto type_pos = dump_topo_file_path_.find_last_of(".") + 1;
-  std::string bin_file = dump_topo_file_path_.replace(type_pos, 3, "bin");
-  std::string txt_file = dump_topo_file_path_.replace(type_pos, 3, "txt");
-  if (!cyber::common::SetProtoToASCIIFile(graph_, txt_file)) {
-    AERROR << "Failed to dump topo data into file " << txt_file;
-    return false;
+  graph_.mutable_edge()->Reserve(static_cast<int>(edge_nodes.size()));
+  for (size_t i = 0; i < edge_nodes.size(); ++i) {
+    graph_.add_edge();
   }
-  AINFO << "Txt file is dumped successfully. Path: " << txt_file;
-  if (!cyber::common::SetProtoToBinaryFile(graph_, bin_file)) {
-    AERROR << "Failed to dump topo data into file " << bin_file;
-    return false;
-  }
-  AINFO << "Bin file is dumped successfully. Path: " << bin_file;
-  return true;
+  ParallelFor(edge_nodes.size(), thread_num, [&](const int i) {
+    edge_creator::GetPbEdge(graph_.node(edge_nodes[i].first),
+                            graph_.node(edge_nodes[i].second), edge_types[i],
+                            routing_conf_, graph_.mutable_edge(i));
+  });
 }
 
-std::string GraphCreator::GetEdgeID(const std::string& from_id,
-                                    const std::string& to_id) {
-  return from_id + "->" + to_id;
-}
-
-void GraphCreator::AddEdge(const Node& from_node,
-                           const RepeatedPtrField<Id>& to_node_vec,
-                           const Edge::DirectionType& type) {
+void GraphCreator::AddEdges(
+    const RepeatedPtrField<Id>& to_node_vec, const Edge::DirectionType& type,
+    std::vector<std::pair<int, Edge::DirectionType>>* const edges) const {
   for (const auto& to_id : to_node_vec) {
     if (forbidden_lane_id_set_.find(to_id.id()) !=
         forbidden_lane_id_set_.end()) {
       ADEBUG << "Ignored lane [id = " << to_id.id();
       continue;
     }
-    const std::string edge_id = GetEdgeID(from_node.lane_id(), to_id.id());
-    if (showed_edge_id_set_.count(edge_id) != 0) {
-      continue;
-    }
-    showed_edge_id_set_.insert(edge_id);
     const auto& iter = node_index_map_.find(to_id.id());
     if (iter == node_index_map_.end()) {
       continue;
     }
-    const auto& to_node = graph_.node(iter->second);
-    edge_creator::GetPbEdge(from_node, to_node, type, routing_conf_,
-                            graph_.add_edge());
+    edges->emplace_back(iter->second, type);
   }
 }
 
@@ -19,6 +19,8 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "modules/common_msgs/map_msgs/map.pb.h"
 #include "modules/routing/proto/routing_config.pb.h"
@@ -38,13 +40,19 @@ class GraphCreator {
   bool Create();
 
  private:
+  // Build graph_ from pbmap_ on thread_num threads, the same for any number
+  // of them. The nodes of the lanes of previous_graph which are not patched
+  // are moved from it instead of being created again.
+  void BuildGraph(const double min_turn_radius, const int thread_num,
+                  Graph* const previous_graph,
+                  const std::unordered_set<std::string>& patched_lane_ids);
   void InitForbiddenLanes();
-  std::string GetEdgeID(const std::string& from_id, const std::string& to_id);
 
-  void AddEdge(
-      const Node& from_node,
+  // add the indices of the nodes of the lanes to the edges, with their type
+  void AddEdges(
       const ::google::protobuf::RepeatedPtrField<hdmap::Id>& to_node_vec,
-      const Edge::DirectionType& type);
+      const Edge::DirectionType& type,
+      std::vector<std::pair<int, Edge::DirectionType>>* const edges) const;
 
   static bool IsValidUTurn(const hdmap::Lane& lane, const double radius);
 
@@ -55,7 +63,6 @@ class GraphCreator {
   Graph graph_;
   std::unordered_map<std::string, int> node_index_map_;
   std::unordered_map<std::string, std::string> road_id_map_;
-  std::unordered_set<std::string> showed_edge_id_set_;
   std::unordered_set<std::string> forbidden_lane_id_set_;
 
   const RoutingConfig& routing_conf_;
@@ -16,10 +16,50 @@
 
 #include "modules/routing/topo_creator/graph_creator.h"
 
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 using apollo::hdmap::Lane;
+using apollo::hdmap::LaneBoundaryType;
+using apollo::hdmap::Map;
+using apollo::routing::Graph;
 using apollo::routing::GraphCreator;
+using apollo::routing::RoutingConfig;
+
+namespace {
+
+Lane* AddLane(const std::string& id, const std::vector<std::string>& successors,
+              const std::string& left_neighbor, Map* const map) {
+  auto* lane = map->add_lane();
+  lane->mutable_id()->set_id(id);
+  lane->set_type(Lane::CITY_DRIVING);
+  lane->set_length(100.0);
+  lane->set_speed_limit(10.0);
+  auto* segment = lane->mutable_central_curve()->add_segment();
+  segment->set_length(100.0);
+  auto* point = segment->mutable_line_segment()->add_point();
+  point->set_x(0.0);
+  point->set_y(0.0);
+  point = segment->mutable_line_segment()->add_point();
+  point->set_x(100.0);
+  point->set_y(0.0);
+  for (const auto& successor : successors) {
+    lane->add_successor_id()->set_id(successor);
+  }
+  if (!left_neighbor.empty()) {
+    lane->add_left_neighbor_forward_lane_id()->set_id(left_neighbor);
+    auto* boundary = lane->mutable_left_boundary();
+    boundary->set_length(100.0);
+    auto* boundary_type = boundary->add_boundary_type();
+    boundary_type->set_s(0.0);
+    boundary_type->add_types(LaneBoundaryType::DOTTED_WHITE);
+  }
+  return lane;
+}
+
+}  // namespace
 
 TEST(GraphCreatorTest, IsValidUTurn) {
   const double min_turn_radius = 6.0;
@@ -76,3 +116,44 @@ TEST(GraphCreatorTest, IsValidUTurn) {
     EXPECT_TRUE(GraphCreator::IsValidUTurn(lane, min_turn_radius));
   }
 }
+
+TEST(GraphCreatorTest, BuildGraph) {
+  RoutingConfig routing_conf;
+  routing_conf.set_base_speed(4.167);
+  GraphCreator creator("", "", routing_conf);
+  AddLane("l1", {"l3", "l3"}, "l2", &creator.pbmap_);
+  AddLane("l2", {"l4"}, "", &creator.pbmap_);
+  AddLane("l3", {"l5"}, "l4", &creator.pbmap_);
+  AddLane("l4", {"l5"}, "", &creator.pbmap_);
+  AddLane("l5", {}, "", &creator.pbmap_)->set_type(Lane::BIKING);
+
+  creator.BuildGraph(6.0, 1, nullptr, {});
+  const Graph graph = creator.graph_;
+  // no node of the biking lane and a single edge between two nodes
+  ASSERT_EQ(4, graph.node_size());
+  ASSERT_EQ(4, graph.edge_size());
+  EXPECT_EQ("l1", graph.edge(0).from_lane_id());
+  EXPECT_EQ("l3", graph.edge(0).to_lane_id());
+  EXPECT_EQ(apollo::routing::Edge::FORWARD, graph.edge(0).direction_type());
+  EXPECT_EQ("l2", graph.edge(1).to_lane_id());
+  EXPECT_EQ(apollo::routing::Edge::LEFT, graph.edge(1).direction_type());
+
+  // the same graph on any number of threads
+  creator.BuildGraph(6.0, 3, nullptr, {});
+  EXPECT_EQ(graph.SerializeAsString(), creator.graph_.SerializeAsString());
+
+  // the nodes of the lanes not patched are kept
+  creator.pbmap_.mutable_lane(1)->set_speed_limit(20.0);
+  creator.pbmap_.mutable_lane(2)->set_speed_limit(20.0);
+  Graph previous_graph = graph;
+  creator.BuildGraph(6.0, 2, &previous_graph, {"l2"});
+  const Graph patched_graph = creator.graph_;
+  ASSERT_EQ(4, patched_graph.node_size());
+  EXPECT_NE(graph.node(1).cost(), patched_graph.node(1).cost());
+  EXPECT_EQ(graph.node(2).cost(), patched_graph.node(2).cost());
+
+  creator.pbmap_.mutable_lane(2)->set_speed_limit(10.0);
+  creator.BuildGraph(6.0, 1, nullptr, {});
+  EXPECT_EQ(creator.graph_.SerializeAsString(),
+            patched_graph.SerializeAsString());
+}